@@ -0,0 +1,44 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <skland/gui/theme.hpp>
+
+#include <iostream>
+
+/**
+ * Compile a theme into a binary bundle, which can be loaded at startup with
+ * the SKLAND_THEME environment variable:
+ *
+ *   theme-compiler ocean.txt ocean.skt
+ *   SKLAND_THEME=ocean.skt hello
+ */
+int main(int argc, char *argv[]) {
+  using namespace skland;
+  using namespace skland::gui;
+
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <light|dark|plugin.so|theme.txt> <output>" << std::endl;
+    return 1;
+  }
+
+  if (!Theme::Compile(argv[1], argv[2])) {
+    std::cerr << "Error! Cannot compile theme: " << argv[1] << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
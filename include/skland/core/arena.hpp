@@ -0,0 +1,241 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_CORE_ARENA_HPP_
+#define SKLAND_CORE_ARENA_HPP_
+
+#include "defines.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace skland {
+namespace core {
+
+/**
+ * @ingroup core
+ * @brief A bump allocator for short-lived temporaries
+ *
+ * Arena allocates memory by moving a pointer forward in large chunks, memory
+ * is not freed one by one but all at once in Reset(). It's used as the
+ * per-frame allocator in gui so drawing code can create temporaries without
+ * touching malloc.
+ *
+ * When a frame needs more than one chunk, Reset() replaces all chunks with one
+ * chunk large enough for all, so the steady state of a frame loop does no heap
+ * allocation at all.
+ *
+ * Objects created by New() are destroyed in reverse order in Reset(), memory
+ * got from Allocate() or ArenaAllocator is just dropped.
+ *
+ * @note This class is not thread safe, it's designed to be used in the GUI
+ * thread.
+ */
+class Arena {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(Arena);
+
+  /**
+   * @brief Constructor
+   * @param chunk_size The size of the first chunk, no memory is allocated
+   * until the first Allocate()
+   */
+  explicit Arena(size_t chunk_size = 4096);
+
+  /**
+   * @brief Destructor, calls Reset() and release all chunks
+   */
+  ~Arena();
+
+  /**
+   * @brief Allocate memory
+   * @param size The size in bytes
+   * @param alignment The alignment, must be a power of 2
+   * @return A pointer valid until Reset(), throws std::bad_alloc if out of
+   * memory
+   */
+  void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(current_);
+    char *p = reinterpret_cast<char *>((address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1));
+    if (nullptr == current_ || p + size > end_) return AllocateSlow(size, alignment);
+
+    current_ = p + size;
+    allocation_count_++;
+    return p;
+  }
+
+  /**
+   * @brief Create an object in this arena
+   *
+   * The object is destroyed in Reset() if it has a non-trivial destructor.
+   */
+  template<typename T, typename ... Args>
+  T *New(Args &&... args) {
+    if (std::is_trivially_destructible<T>::value) {
+      return new(Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    Finalizer *finalizer = static_cast<Finalizer *>(Allocate(sizeof(Finalizer), alignof(Finalizer)));
+    T *object = new(Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    finalizer->destroy = &Destroy<T>;
+    finalizer->object = object;
+    finalizer->next = finalizers_;
+    finalizers_ = finalizer;
+    return object;
+  }
+
+  /**
+   * @brief Destroy objects created by New() and make all memory available
+   */
+  void Reset();
+
+  /**
+   * @brief Count of allocations since the last Reset()
+   */
+  size_t GetAllocationCount() const { return allocation_count_; }
+
+  /**
+   * @brief Bytes used since the last Reset(), including chunks filled
+   */
+  size_t GetUsedSize() const;
+
+  /**
+   * @brief Total size of all chunks
+   */
+  size_t GetCapacity() const { return capacity_; }
+
+  /**
+   * @brief Count of chunks allocated from heap since constructed
+   */
+  size_t GetChunkAllocationCount() const { return chunk_allocation_count_; }
+
+ private:
+
+  struct Chunk {
+    Chunk *next;
+    size_t size;
+  };
+
+  struct Finalizer {
+    void (*destroy)(void *);
+    void *object;
+    Finalizer *next;
+  };
+
+  template<typename T>
+  static void Destroy(void *object) {
+    static_cast<T *>(object)->~T();
+  }
+
+  void *AllocateSlow(size_t size, size_t alignment);
+
+  void AddChunk(size_t size);
+
+  void ReleaseChunks();
+
+  size_t chunk_size_;
+
+  Chunk *chunks_;
+
+  char *current_;
+  char *end_;
+
+  Finalizer *finalizers_;
+
+  size_t capacity_;
+
+  /** Bytes in the chunks already filled */
+  size_t filled_size_;
+
+  size_t allocation_count_;
+
+  size_t chunk_allocation_count_;
+
+};
+
+/**
+ * @ingroup core
+ * @brief An STL-compatible allocator using an Arena
+ *
+ * deallocate() does nothing, memory is reclaimed when the arena is reset, so
+ * a container using this allocator must not outlive the current frame.
+ *
+ * @code
+ * core::ArenaVector<float> radii(context.arena());
+ * @endcode
+ */
+template<typename T>
+class ArenaAllocator {
+
+  template<typename U> friend class ArenaAllocator;
+
+ public:
+
+  typedef T value_type;
+
+  template<typename U>
+  struct rebind {
+    typedef ArenaAllocator<U> other;
+  };
+
+  explicit ArenaAllocator(Arena *arena) noexcept
+      : arena_(arena) {}
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other) noexcept
+      : arena_(other.arena_) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *, size_t) noexcept {}
+
+  Arena *arena() const { return arena_; }
+
+ private:
+
+  Arena *arena_;
+
+};
+
+template<typename T, typename U>
+inline bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+  return a.arena() == b.arena();
+}
+
+template<typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+  return a.arena() != b.arena();
+}
+
+/**
+ * @brief A std::vector allocated in an Arena
+ */
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T> >;
+
+} // namespace core
+} // namespace skland
+
+#endif // SKLAND_CORE_ARENA_HPP_
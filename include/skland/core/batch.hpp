@@ -0,0 +1,220 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_CORE_BATCH_HPP_
+#define SKLAND_CORE_BATCH_HPP_
+
+#include "rect.hpp"
+#include "color.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace skland {
+namespace core {
+
+/**
+ * @ingroup core
+ * @brief Operations on contiguous arrays of rects, points and colors
+ * @tparam T The value type of Rect, Vector2 and Color
+ *
+ * Each method gives the same result as calling the scalar operator of the
+ * type on every element in a loop. The generic version is such a loop, the
+ * float and int specializations are implemented with SIMD instructions where
+ * available, which is decided at compile time.
+ */
+template<typename T>
+struct Batch {
+
+  Batch() = delete;
+
+  /**
+   * @brief Test which rects intersect a given rect, like Rect::Intersect()
+   * @param rect The rect to test against
+   * @param rects An array of rects
+   * @param count Number of rects
+   * @param results Output array of count booleans
+   * @return Number of rects intersecting the given one
+   */
+  static size_t Intersect(const Rect<T> &rect, const Rect<T> *rects, size_t count, bool *results);
+
+  /**
+   * @brief Test which rects contain a given point, like Rect::Contain(x, y)
+   * @return Number of rects containing the point
+   */
+  static size_t Contain(const Rect<T> *rects, size_t count, T x, T y, bool *results);
+
+  /**
+   * @brief Test which points are contained in a given rect, like Rect::Contain(x, y)
+   * @return Number of points in the rect
+   */
+  static size_t Contain(const Rect<T> &rect, const Vector2<T> *points, size_t count, bool *results);
+
+  /**
+   * @brief Get the smallest rect enclosing all the non-empty rects
+   * @return An empty rect if all rects are empty
+   */
+  static Rect<T> Union(const Rect<T> *rects, size_t count);
+
+  /**
+   * @brief Convert colors to ARGB8888 values, like Color::argb()
+   *
+   * Components must be in range [0, 1].
+   */
+  static void Pack(const Color<T> *colors, size_t count, uint32_t *argb);
+
+  /**
+   * @brief Convert ARGB8888 values to colors, like Color::operator=(uint32_t)
+   */
+  static void Unpack(const uint32_t *argb, size_t count, Color<T> *colors);
+
+  /**
+   * @brief Linear interpolation between two arrays of colors
+   *
+   * Each component of result is from + (to - from) * t.
+   */
+  static void Lerp(const Color<T> *from, const Color<T> *to, T t, size_t count, Color<T> *result);
+
+};
+
+template<typename T>
+size_t Batch<T>::Intersect(const Rect<T> &rect, const Rect<T> *rects, size_t count, bool *results) {
+  size_t n = 0;
+  for (size_t i = 0; i < count; ++i) {
+    results[i] = rect.Intersect(rects[i]);
+    n += results[i];
+  }
+  return n;
+}
+
+template<typename T>
+size_t Batch<T>::Contain(const Rect<T> *rects, size_t count, T x, T y, bool *results) {
+  size_t n = 0;
+  for (size_t i = 0; i < count; ++i) {
+    results[i] = rects[i].Contain(x, y);
+    n += results[i];
+  }
+  return n;
+}
+
+template<typename T>
+size_t Batch<T>::Contain(const Rect<T> &rect, const Vector2<T> *points, size_t count, bool *results) {
+  size_t n = 0;
+  for (size_t i = 0; i < count; ++i) {
+    results[i] = rect.Contain(points[i].x, points[i].y);
+    n += results[i];
+  }
+  return n;
+}
+
+template<typename T>
+Rect<T> Batch<T>::Union(const Rect<T> *rects, size_t count) {
+  Rect<T> result;
+  bool found = false;
+
+  for (size_t i = 0; i < count; ++i) {
+    if (rects[i].IsEmpty()) continue;
+
+    if (!found) {
+      result = rects[i];
+      found = true;
+      continue;
+    }
+
+    result.left = std::min(result.left, rects[i].left);
+    result.top = std::min(result.top, rects[i].top);
+    result.right = std::max(result.right, rects[i].right);
+    result.bottom = std::max(result.bottom, rects[i].bottom);
+  }
+
+  return result;
+}
+
+template<typename T>
+void Batch<T>::Pack(const Color<T> *colors, size_t count, uint32_t *argb) {
+  for (size_t i = 0; i < count; ++i) {
+    argb[i] = colors[i].argb();
+  }
+}
+
+template<typename T>
+void Batch<T>::Unpack(const uint32_t *argb, size_t count, Color<T> *colors) {
+  for (size_t i = 0; i < count; ++i) {
+    colors[i] = argb[i];
+  }
+}
+
+template<typename T>
+void Batch<T>::Lerp(const Color<T> *from, const Color<T> *to, T t, size_t count, Color<T> *result) {
+  for (size_t i = 0; i < count; ++i) {
+    result[i].r = from[i].r + (to[i].r - from[i].r) * t;
+    result[i].g = from[i].g + (to[i].g - from[i].g) * t;
+    result[i].b = from[i].b + (to[i].b - from[i].b) * t;
+    result[i].a = from[i].a + (to[i].a - from[i].a) * t;
+  }
+}
+
+// Specializations implemented in batch.cpp
+
+template<>
+size_t Batch<float>::Intersect(const Rect<float> &rect, const Rect<float> *rects, size_t count, bool *results);
+
+template<>
+size_t Batch<float>::Contain(const Rect<float> *rects, size_t count, float x, float y, bool *results);
+
+template<>
+size_t Batch<float>::Contain(const Rect<float> &rect, const Vector2<float> *points, size_t count, bool *results);
+
+template<>
+Rect<float> Batch<float>::Union(const Rect<float> *rects, size_t count);
+
+template<>
+void Batch<float>::Pack(const Color<float> *colors, size_t count, uint32_t *argb);
+
+template<>
+void Batch<float>::Unpack(const uint32_t *argb, size_t count, Color<float> *colors);
+
+template<>
+void Batch<float>::Lerp(const Color<float> *from, const Color<float> *to, float t, size_t count, Color<float> *result);
+
+template<>
+size_t Batch<int>::Intersect(const Rect<int> &rect, const Rect<int> *rects, size_t count, bool *results);
+
+template<>
+size_t Batch<int>::Contain(const Rect<int> *rects, size_t count, int x, int y, bool *results);
+
+template<>
+size_t Batch<int>::Contain(const Rect<int> &rect, const Vector2<int> *points, size_t count, bool *results);
+
+template<>
+Rect<int> Batch<int>::Union(const Rect<int> *rects, size_t count);
+
+/**
+ * @ingroup core
+ */
+typedef Batch<float> BatchF;
+
+/**
+ * @ingroup core
+ */
+typedef Batch<int> BatchI;
+
+} // namespace core
+} // namespace skland
+
+#endif // SKLAND_CORE_BATCH_HPP_
@@ -18,6 +18,7 @@
 #define SKLAND_CORE_COMPOUND_DEQUE_HPP_
 
 #include "defines.hpp"
+#include "list-index.hpp"
 
 namespace skland {
 namespace core {
@@ -61,6 +62,9 @@ class CompoundDeque {
     Element *next_;
     CompoundDeque *deque_;
 
+    /* The position hint used by the index table in deque */
+    int index_;
+
   };
 
   /**
@@ -146,6 +150,14 @@ class CompoundDeque {
 
   void Clear();
 
+  /**
+   * @brief Get the element at the given index
+   * @param index The index, a negative value counts from the end
+   * @return The element or nullptr if the index is out of range
+   *
+   * This uses a lazily built index table, repeated access without changing
+   * the deque is O(1).
+   */
   Element *operator[](int index) const;
 
   Iterator begin() const {
@@ -174,10 +186,18 @@ class CompoundDeque {
 
  private:
 
+  struct IndexTraits {
+    static Element *Next(Element *element) { return element->next_; }
+    static Element *Previous(Element *element) { return element->previous_; }
+    static int &Index(Element *element) { return element->index_; }
+  };
+
   Element *first_;
   Element *last_;
   int count_;
 
+  mutable ListIndex<Element, IndexTraits> index_;
+
 };
 
 } // namespace core
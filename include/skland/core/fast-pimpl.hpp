@@ -0,0 +1,107 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_CORE_FAST_PIMPL_HPP_
+#define SKLAND_CORE_FAST_PIMPL_HPP_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace skland {
+namespace core {
+
+/**
+ * @ingroup core
+ * @brief In-place storage for a private implementation
+ * @tparam T The private structure, can be incomplete where the owner is
+ * declared
+ * @tparam Size The size reserved for T, must be >= sizeof(T)
+ * @tparam Align The alignment reserved for T, must be a multiple of alignof(T)
+ *
+ * This works like std::unique_ptr<Private> in the pimpl idiom but keeps the
+ * private structure inside the owner object, so constructing a value type on
+ * stack (e.g. a Paint in every OnDraw()) does not allocate memory.
+ *
+ * The constructor, destructor and assignment of the owner must be defined in
+ * the source file where T is complete, the size and alignment are checked
+ * there by static_assert:
+ *
+ * @code
+ * // paint.hpp
+ * class Paint {
+ *   ...
+ *   struct Private;
+ *   core::FastPimpl<Private, 128, 8> p_;
+ * };
+ *
+ * // paint.cpp
+ * Paint::Paint() : p_() {}
+ * Paint::Paint(const Paint &orig) : p_(*orig.p_) {}
+ * @endcode
+ */
+template<typename T, size_t Size, size_t Align = alignof(std::max_align_t)>
+class FastPimpl {
+
+ public:
+
+  FastPimpl(const FastPimpl &) = delete;
+  FastPimpl &operator=(const FastPimpl &) = delete;
+
+  /**
+   * @brief Construct T in place with the given arguments
+   */
+  template<typename ... Args>
+  explicit FastPimpl(Args &&... args) {
+    Check<sizeof(T), alignof(T)>();
+    new(&storage_) T(std::forward<Args>(args)...);
+  }
+
+  ~FastPimpl() {
+    Check<sizeof(T), alignof(T)>();
+    get()->~T();
+  }
+
+  T *get() { return reinterpret_cast<T *>(&storage_); }
+
+  const T *get() const { return reinterpret_cast<const T *>(&storage_); }
+
+  T *operator->() { return get(); }
+
+  const T *operator->() const { return get(); }
+
+  T &operator*() { return *get(); }
+
+  const T &operator*() const { return *get(); }
+
+ private:
+
+  template<size_t ActualSize, size_t ActualAlign>
+  static void Check() {
+    static_assert(Size >= ActualSize, "Size is too small for the private structure");
+    static_assert(Align % ActualAlign == 0, "Align does not fit the private structure");
+  }
+
+  typename std::aligned_storage<Size, Align>::type storage_;
+
+};
+
+} // namespace core
+} // namespace skland
+
+#endif // SKLAND_CORE_FAST_PIMPL_HPP_
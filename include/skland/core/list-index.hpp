@@ -0,0 +1,178 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_CORE_LIST_INDEX_HPP_
+#define SKLAND_CORE_LIST_INDEX_HPP_
+
+#include "defines.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace skland {
+namespace core {
+
+/**
+ * @ingroup core
+ * @brief A lazily built index table for an intrusive doubly-linked list
+ * @tparam T The element type
+ * @tparam Traits A structure with static methods to access the links and an
+ * index hint stored in each element:
+ * @code
+ *  struct Traits {
+ *    static T *Next(T *element);
+ *    static T *Previous(T *element);
+ *    static int &Index(T *element);
+ *  };
+ * @endcode
+ *
+ * A linked list keeps O(1) insert and remove by node but needs O(n) to find an
+ * element by index. A ListIndex is kept along with the list: it's an array of
+ * the first N elements (the valid part), filled when an element is looked up
+ * and cut when the list is changed before its end:
+ *
+ *   - Get() in the valid part is O(1), otherwise it walks from the end of the
+ *     valid part (and extends it) or from the last element, whichever is nearer
+ *   - appending an element to a fully indexed list keeps it valid
+ *   - inserting or removing an element invalidates the table from its position
+ *     in O(1), the index hint in each element tells the position
+ *
+ * So repeated index access without changing the list (e.g. in layout) is O(1)
+ * per access after the first walk, and never slower than walking the list.
+ */
+template<typename T, typename Traits>
+class ListIndex {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(ListIndex);
+
+  ListIndex()
+      : valid_count_(0) {}
+
+  ~ListIndex() {}
+
+  /**
+   * @brief Get the element at the given index
+   * @param index The index, must be in [0, count)
+   * @param count The number of elements in the list
+   * @param first The first element in the list
+   * @param last The last element in the list
+   */
+  T *Get(int index, int count, T *first, T *last) {
+    _ASSERT(index >= 0 && index < count);
+
+    if (index < valid_count_) return table_[index];
+
+    if ((count - 1 - index) < (index - valid_count_)) {
+      // Nearer to the end
+      T *element = last;
+      for (int i = count - 1; i > index; --i) element = Traits::Previous(element);
+      return element;
+    }
+
+    if (table_.size() < static_cast<std::size_t>(count)) table_.resize(count);
+
+    T *element = valid_count_ > 0 ? Traits::Next(table_[valid_count_ - 1]) : first;
+    while (valid_count_ <= index) {
+      table_[valid_count_] = element;
+      Traits::Index(element) = valid_count_;
+      valid_count_++;
+      element = Traits::Next(element);
+    }
+
+    return table_[index];
+  }
+
+  /**
+   * @brief Update after an element was linked in the list
+   */
+  void OnInserted(T *element) {
+    T *previous = Traits::Previous(element);
+    int position = 0;
+
+    if (nullptr != previous) {
+      if (!IsValid(previous)) return;  // after the valid part
+      position = Traits::Index(previous) + 1;
+    }
+
+    if (position == valid_count_) {
+      // Appended to the valid part
+      if (table_.size() <= static_cast<std::size_t>(position)) {
+        table_.resize(table_.empty() ? 8 : table_.size() * 2);
+      }
+      table_[position] = element;
+      Traits::Index(element) = position;
+      valid_count_++;
+    } else if (position < valid_count_) {
+      valid_count_ = position;
+    }
+  }
+
+  /**
+   * @brief Update before an element is unlinked from the list
+   */
+  void OnRemoving(T *element) {
+    InvalidateFrom(element);
+  }
+
+  /**
+   * @brief Invalidate the table from the position of the given element
+   *
+   * Call this with the first element affected before the list is reordered.
+   */
+  void InvalidateFrom(T *element) {
+    if (IsValid(element)) valid_count_ = Traits::Index(element);
+  }
+
+  /**
+   * @brief Invalidate the whole table
+   */
+  void Invalidate() {
+    valid_count_ = 0;
+  }
+
+  /**
+   * @brief Invalidate the table and release the memory
+   */
+  void Clear() {
+    std::vector<T *>().swap(table_);
+    valid_count_ = 0;
+  }
+
+  /**
+   * @brief The number of elements already indexed
+   */
+  int valid_count() const { return valid_count_; }
+
+ private:
+
+  bool IsValid(T *element) const {
+    int index = Traits::Index(element);
+    return index >= 0 && index < valid_count_ && table_[index] == element;
+  }
+
+  std::vector<T *> table_;
+
+  int valid_count_;
+
+};
+
+} // namespace core
+} // namespace skland
+
+#endif // SKLAND_CORE_LIST_INDEX_HPP_
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_CORE_MEMORY_STATS_HPP_
+#define SKLAND_CORE_MEMORY_STATS_HPP_
+
+#include "defines.hpp"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace skland {
+namespace core {
+
+/**
+ * @ingroup core
+ * @brief A process-wide registry of memory used by subsystems
+ *
+ * Subsystems report the bytes they allocate and free with Add() and Remove()
+ * by category, optionally attributed to an owner, which is usually an
+ * AbstractShellView. Caches which already know their usage can be registered
+ * as a probe instead, the probe is called when the category is queried.
+ *
+ * Only large blocks are reported: shared memory pools, pixels, caches and
+ * arena chunks, not every object on the heap.
+ *
+ * All methods are thread safe. Reporting without an owner only touches
+ * atomic counters, reporting with an owner locks a mutex.
+ */
+class MemoryStats {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(MemoryStats);
+  MemoryStats() = delete;
+  ~MemoryStats() = delete;
+
+  enum Category {
+
+    /** Mapped memory of SharedMemoryPool */
+    kSharedMemoryPool,
+
+    /** wl_buffers created in a pool, part of kSharedMemoryPool */
+    kBuffer,
+
+    /** Pixels allocated by graphic::Bitmap */
+    kBitmap,
+
+    /** Decoded images in graphic::ImageCache */
+    kImageCache,
+
+    /** The glyph cache in Skia */
+    kGlyphCache,
+
+    /** Pre-rendered images in Theme */
+    kTheme,
+
+    /** Chunks of core::Arena */
+    kArena,
+
+    kOther,
+
+    kCategoryCount
+
+  };
+
+  struct Usage {
+
+    Usage()
+        : current(0), peak(0) {}
+
+    size_t current;
+
+    size_t peak;
+
+  };
+
+  /**
+   * @brief A function returns the current bytes of a category
+   */
+  typedef size_t (*Probe)();
+
+  /**
+   * @brief Report allocated bytes
+   * @param category The category
+   * @param bytes Size in bytes
+   * @param owner The object this memory is used for, can be nullptr
+   */
+  static void Add(Category category, size_t bytes, const void *owner = nullptr);
+
+  /**
+   * @brief Report freed bytes, must match a previous Add()
+   */
+  static void Remove(Category category, size_t bytes, const void *owner = nullptr);
+
+  /**
+   * @brief Use a probe to get the current bytes of a category
+   * @param category The category
+   * @param probe The function to call, or nullptr to use the reported bytes
+   */
+  static void SetProbe(Category category, Probe probe);
+
+  static Usage GetUsage(Category category);
+
+  /**
+   * @brief Sum of current bytes of all categories
+   *
+   * kBuffer is not counted as it's a part of kSharedMemoryPool.
+   */
+  static size_t GetTotalUsage();
+
+  static Usage GetOwnerUsage(const void *owner, Category category);
+
+  /**
+   * @brief Sum of current bytes reported for an owner, excluding kBuffer
+   */
+  static size_t GetOwnerTotalUsage(const void *owner);
+
+  /**
+   * @brief Set the name used for an owner in Dump()
+   */
+  static void SetOwnerName(const void *owner, const std::string &name);
+
+  /**
+   * @brief Forget the usage and name of an owner
+   *
+   * Call this when the owner is destroyed, any bytes still reported for it
+   * stay in the category.
+   */
+  static void ReleaseOwner(const void *owner);
+
+  /**
+   * @brief Set a budget of a category in bytes, 0 means no budget
+   */
+  static void SetBudget(Category category, size_t bytes);
+
+  static size_t GetBudget(Category category);
+
+  /**
+   * @brief Check if the current bytes of a category exceeds its budget
+   */
+  static bool IsOverBudget(Category category);
+
+  static const char *GetCategoryName(Category category);
+
+  /**
+   * @brief Write a readable report of all categories and owners
+   */
+  static void Dump(std::ostream &out);
+
+  /**
+   * @brief Dump the report periodically in a background thread
+   * @param interval_ms Interval in milliseconds
+   * @param filename The file to append to, write to stderr if it's empty
+   * @return false if it's already started or the file cannot be opened
+   */
+  static bool StartPeriodicDump(int interval_ms, const std::string &filename = std::string());
+
+  static void StopPeriodicDump();
+
+  /**
+   * @brief Clear all counters, owners, probes and budgets
+   *
+   * Used in tests only.
+   */
+  static void Reset();
+
+ private:
+
+  struct Private;
+
+};
+
+} // namespace core
+} // namespace skland
+
+#endif // SKLAND_CORE_MEMORY_STATS_HPP_
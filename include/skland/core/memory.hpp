@@ -21,41 +21,104 @@
 
 #include <memory>
 #include <atomic>
+#include <new>
+#include <type_traits>
 
 namespace skland {
 namespace core {
 
+// forward declarations
+template<typename T>
+class SharedPtr;
+
+template<typename T, typename ... Args>
+SharedPtr<T> MakeShared(Args &&... args);
+
+/**
+ * @ingroup core
+ * @brief Counter policy using atomic operations, a shared object can be
+ * referenced in multiple threads
+ */
+struct AtomicCountPolicy {
+
+  typedef std::atomic_ulong CountType;
+
+  template<typename T>
+  using PointerType = std::atomic<T *>;
+
+  /**
+   * @brief Store the value if the pointer is still nullptr
+   * @return The value stored in the pointer, which may be published by another
+   * thread
+   */
+  template<typename T>
+  static T *Publish(PointerType<T> &pointer, T *value) {
+    T *expected = nullptr;
+    return pointer.compare_exchange_strong(expected, value) ? value : expected;
+  }
+
+};
+
+/**
+ * @ingroup core
+ * @brief Counter policy using plain integers, for objects only shared in one
+ * thread (e.g. the GUI thread)
+ */
+struct PlainCountPolicy {
+
+  typedef unsigned long CountType;
+
+  template<typename T>
+  using PointerType = T *;
+
+  template<typename T>
+  static T *Publish(PointerType<T> &pointer, T *value) {
+    pointer = value;
+    return value;
+  }
+
+};
+
 /**
  * @ingroup core
  * @brief The base class for objects that may be shared by multiple objects.
  *
- * SPCountedBase is the base class to be used in SharedPtr and WeakPtr for
+ * BasicSPCountedBase is the base class to be used in SharedPtr and WeakPtr for
  * implementing our custom reference counting smart pointer. Though we can use
  * std::shared_ptr to store any type of object, there still be situation that we
  * need to indicate what kind of object can be used in a shared pointer.
  *
- * You usually define your own sub class of SPCountedBase, create and contain an
- * instance in a SharedPtr. Use WeakPtr to avoid curcular references in
- * appropriate time.
+ * You usually define your own sub class of SPCountedBase (or
+ * PlainSPCountedBase), create and contain an instance in a SharedPtr. Use
+ * WeakPtr to avoid curcular references in appropriate time.
  *
- * Each SPCountedBase object has a pointer to a Counter object which stores 2
- * different counters:
+ * Each object has a pointer to a Counter object which stores 2 different
+ * counters:
  *
  *   - use_count: the number of SharedPtr instances pointing to this
- *     SPCountedBase object
+ *     object
  *
  *   - weak_count: the number of WeakPtr instances pointing to this
- *     SPCountedBase object
+ *     object
+ *
+ * The counter is created when the object is contained in a SharedPtr at the
+ * first time. MakeShared() allocates the counter and the object in one memory
+ * block, so a shared object only costs one allocation.
+ *
+ * The CountPolicy decides the type of counters: AtomicCountPolicy makes every
+ * copy of SharedPtr an atomic operation, PlainCountPolicy uses plain integers
+ * and is cheaper, but the object must not be shared across threads.
  *
- * A SPCountedBase object knows its reference status by checking the counters by
- * use_count() or weak_count(). When a SPCountedBase object is created by new
- * operator and not controled by any SharedPtr or WeakPtr, both use_count and
- * weak_count are zero, in this case you can safely delete the
- * instance. Otherwise, it must be destroyed by a SharedPtr.
+ * An object knows its reference status by checking the counters by use_count()
+ * or weak_count(). When an object is created by new operator and not controled
+ * by any SharedPtr or WeakPtr, both use_count and weak_count are zero, in this
+ * case you can safely delete the instance. Otherwise, it must be destroyed by a
+ * SharedPtr.
  *
- * A SPCountedBase object is non-copyable and non-movable.
+ * A BasicSPCountedBase object is non-copyable and non-movable.
  */
-class SPCountedBase {
+template<typename CountPolicy>
+class BasicSPCountedBase {
 
   template<typename T> friend
   class SharedPtr;
@@ -63,6 +126,9 @@ class SPCountedBase {
   template<typename T> friend
   class WeakPtr;
 
+  template<typename T, typename ... Args> friend
+  SharedPtr<T> MakeShared(Args &&... args);
+
  public:
 
   /**
@@ -70,8 +136,10 @@ class SPCountedBase {
    */
   struct Counter {
 
-    Counter()
-        : use_count(0), weak_count(0) {
+    typedef typename CountPolicy::CountType CountType;
+
+    explicit Counter(bool in_block = false)
+        : use_count(0), weak_count(0), embedded(in_block) {
 #ifdef UNIT_TEST
       _DEBUG("%s\n", __func__);
 #endif  // UNIT_TEST
@@ -86,26 +154,32 @@ class SPCountedBase {
     /**
      * @brief The number of SharedPtr instances pointing to the object
      */
-    std::atomic_ulong use_count;
+    CountType use_count;
 
     /**
      * @brief The number of WeakPtr instances pointing to the object, plus one
      * if the "use_count" is still > 0
      */
-    std::atomic_ulong weak_count;
+    CountType weak_count;
+
+    /**
+     * @brief If this counter is allocated in the same memory block of the
+     * object by MakeShared()
+     */
+    bool embedded;
 
   };
 
   /**
    * @brief Disable copy and move constructors
    */
-  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(SPCountedBase);
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(BasicSPCountedBase);
 
   /**
    * @brief Default constructor
    */
-  SPCountedBase()
-      : counter_(new Counter) {}
+  BasicSPCountedBase()
+      : counter_(nullptr) {}
 
   /**
    * @brief Destructor
@@ -113,41 +187,111 @@ class SPCountedBase {
    * The destructor will try to delete the internal counter object, but in most
    * cases it's deleted by SharedPtr or WeakPtr.
    */
-  virtual ~SPCountedBase() {
+  virtual ~BasicSPCountedBase() {
+    Counter *counter = counter_;
 #ifdef UNIT_TEST
-    if (nullptr != counter_) {
+    if (nullptr != counter) {
       _DEBUG("use_count: %ld, weak_count: %ld\n",
-             counter_->use_count.load(),
-             counter_->weak_count.load());
+             (unsigned long) counter->use_count,
+             (unsigned long) counter->weak_count);
     }
 #endif  // TEST
-    delete counter_;
+    if (nullptr != counter && !counter->embedded) delete counter;
   }
 
   /**
    * @brief Get the use count
    */
   size_t use_count() const {
-    return counter_->use_count.load();
+    Counter *counter = counter_;
+    return nullptr == counter ? 0 : (size_t) counter->use_count;
   }
 
   /**
    * @brief Get the weak count
    */
   size_t weak_count() const {
-    return counter_->weak_count.load();
+    Counter *counter = counter_;
+    return nullptr == counter ? 0 : (size_t) counter->weak_count;
   }
 
  private:
 
-  Counter *counter_;
+  /**
+   * @brief Get the counter, create one if this object is not shared yet
+   *
+   * With AtomicCountPolicy, SharedPtrs may be created from the same raw pointer
+   * in different threads. Only the first counter published is used, the others
+   * are deleted.
+   */
+  Counter *GetCounter() {
+    Counter *counter = counter_;
+    if (nullptr != counter) return counter;
+
+    counter = new Counter;
+    Counter *published = CountPolicy::Publish(counter_, counter);
+    if (published != counter) delete counter;
+    return published;
+  }
+
+  /**
+   * @brief Destroy the object when the use count drops to zero
+   *
+   * The counter is kept until the weak count is zero, this method returns true
+   * if it can be released at the same time.
+   */
+  static bool Destroy(BasicSPCountedBase *object, Counter *counter) {
+    object->counter_ = nullptr; // set this value to avoid destroying the counter
+
+    // Important: increase the weak count before delete the pointer, then
+    // decrease it to avoid double delete counter in cross-reference
+    // situation:
+    ++counter->weak_count;
+    if (counter->embedded) {
+      object->~BasicSPCountedBase();  // the memory is released with the counter
+    } else {
+      delete object;
+    }
+    return 0 == --counter->weak_count;
+  }
+
+  /**
+   * @brief Release the counter, and the memory block if it's created by
+   * MakeShared()
+   */
+  static void Release(Counter *counter) {
+    if (counter->embedded) {
+      counter->~Counter();
+      ::operator delete(counter);
+    } else {
+      delete counter;
+    }
+  }
+
+  typename CountPolicy::template PointerType<Counter> counter_;
 
 };
 
+/**
+ * @ingroup core
+ * @brief The base class for objects shared with atomic reference counts
+ */
+typedef BasicSPCountedBase<AtomicCountPolicy> SPCountedBase;
+
+/**
+ * @ingroup core
+ * @brief The base class for objects shared in one thread with plain reference
+ * counts
+ */
+typedef BasicSPCountedBase<PlainCountPolicy> PlainSPCountedBase;
+
 /**
  * @ingroup core
  * @brief Shared pointer
- * @tparam T Must be SPCountedBase or the sub class
+ * @tparam T Must be a sub class of SPCountedBase or PlainSPCountedBase
+ *
+ * A SharedPtr only stores the pointer to the object, the counter is found in
+ * the object. T can be an incomplete type where a SharedPtr is declared.
  */
 template<typename T>
 class SharedPtr {
@@ -173,8 +317,7 @@ class SharedPtr {
    */
   explicit SharedPtr(T *obj) noexcept
       : ptr_(obj) {
-    counter_ = ptr_->counter_;
-    ++counter_->use_count;
+    ++ptr_->GetCounter()->use_count;
   }
 
   /**
@@ -184,10 +327,7 @@ class SharedPtr {
    */
   SharedPtr(const SharedPtr &orig) noexcept
       : ptr_(orig.ptr_) {
-    if (nullptr != ptr_) {
-      counter_ = ptr_->counter_;
-      ++counter_->use_count;
-    }
+    if (nullptr != ptr_) ++ptr_->GetCounter()->use_count;
   }
 
   /**
@@ -195,9 +335,8 @@ class SharedPtr {
    * @param orig
    */
   SharedPtr(SharedPtr &&orig) noexcept
-      : ptr_(orig.ptr_), counter_(orig.counter_) {
+      : ptr_(orig.ptr_) {
     orig.ptr_ = nullptr;
-    orig.counter_ = nullptr;
   }
 
   /**
@@ -207,25 +346,7 @@ class SharedPtr {
    * delete the object it points to if use count == 0.
    */
   ~SharedPtr() {
-    if (nullptr != counter_) {
-      _ASSERT((nullptr != ptr_) && (ptr_->counter_ == counter_));
-
-      --counter_->use_count;
-      if (0 == counter_->use_count) {
-        ptr_->counter_ = nullptr; // set this value to avoid destroying the counter
-
-        // Important: increase the weak count before delete the pointer, then
-        // decrease it to avoid double delete counter_ in cross-reference
-        // situation:
-        ++counter_->weak_count;
-        delete ptr_;
-        --counter_->weak_count;
-
-        if (0 == counter_->weak_count) delete counter_;
-      }
-    } else {
-      _ASSERT(nullptr == ptr_);
-    }
+    if (nullptr != ptr_) Release(ptr_);
   }
 
   /**
@@ -247,10 +368,11 @@ class SharedPtr {
    * @return
    */
   SharedPtr &operator=(SharedPtr &&other) noexcept {
+    T *old_object = ptr_;
     ptr_ = other.ptr_;
-    counter_ = other.counter_;
     other.ptr_ = nullptr;
-    other.counter_ = nullptr;
+
+    if (nullptr != old_object) Release(old_object);
     return *this;
   }
 
@@ -270,13 +392,8 @@ class SharedPtr {
    */
   void Swap(SharedPtr &other) noexcept {
     T *object = ptr_;
-    SPCountedBase::Counter *counter = counter_;
-
     ptr_ = other.ptr_;
-    counter_ = other.counter_;
-
     other.ptr_ = object;
-    other.counter_ = counter;
   }
 
   /**
@@ -285,32 +402,11 @@ class SharedPtr {
    */
   void Reset(T *obj = nullptr) noexcept {
     T *old_object = ptr_;
-    SPCountedBase::Counter *old_counter = counter_;
 
     ptr_ = obj;
-    counter_ = nullptr;
-    if (nullptr != ptr_) {
-      counter_ = ptr_->counter_;
-      ++counter_->use_count;
-    }
-
-    if (nullptr != old_counter) {
-      _ASSERT((nullptr != old_object) && (old_object->counter_ == old_counter));
-
-      --old_counter->use_count;
-      if (0 == old_counter->use_count) {
-        old_object->counter_ = nullptr;
+    if (nullptr != ptr_) ++ptr_->GetCounter()->use_count;
 
-        // Important: avoid double delete old_counter:
-        ++old_counter->weak_count;
-        delete old_object;
-        --old_counter->weak_count;
-
-        if (0 == old_counter->weak_count) delete old_counter;
-      }
-    } else {
-      _ASSERT(nullptr == old_object);
-    }
+    if (nullptr != old_object) Release(old_object);
   }
 
   /**
@@ -347,14 +443,14 @@ class SharedPtr {
    * If this is an empty SharedPtr, the function returns zero.
    */
   size_t use_count() const noexcept {
-    return nullptr == counter_ ? 0 : counter_->use_count.load();
+    return nullptr == ptr_ ? 0 : ptr_->use_count();
   }
 
   /**
    * @brief Get the weak count
    */
   size_t weak_count() const noexcept {
-    return nullptr == counter_ ? 0 : counter_->weak_count.load();
+    return nullptr == ptr_ ? 0 : ptr_->weak_count();
   }
 
   /**
@@ -370,20 +466,27 @@ class SharedPtr {
    * @brief bool operator
    */
   explicit operator bool() const noexcept {
-    if (nullptr == ptr_) {
-      _ASSERT(nullptr == counter_);
-      return false;
-    }
+    if (nullptr == ptr_) return false;
 
-    _ASSERT(ptr_->counter_ == counter_);
+    _ASSERT(nullptr != ptr_->counter_);
     return true;
   }
 
  private:
 
-  T *ptr_ = nullptr;
+  /**
+   * @brief Decrease the use count of an object, destroy it if no one uses it
+   */
+  static void Release(T *object) {
+    typename T::Counter *counter = object->counter_;
+    _ASSERT(nullptr != counter);
 
-  SPCountedBase::Counter *counter_ = nullptr;
+    if (0 == --counter->use_count) {
+      if (T::Destroy(object, counter)) T::Release(counter);
+    }
+  }
+
+  T *ptr_ = nullptr;
 
 };
 
@@ -391,6 +494,9 @@ class SharedPtr {
  * @ingroup core
  * @brief Weak ptr
  * @tparam T
+ *
+ * The counter is stored without type so T can be an incomplete type where a
+ * WeakPtr is declared.
  */
 template<typename T>
 class WeakPtr {
@@ -411,7 +517,7 @@ class WeakPtr {
   WeakPtr(const WeakPtr &orig) noexcept {
     ptr_ = orig.ptr_;
     counter_ = orig.counter_;
-    if (nullptr != counter_) ++counter_->weak_count;
+    if (nullptr != counter_) ++counter()->weak_count;
   }
 
   /**
@@ -419,39 +525,28 @@ class WeakPtr {
    */
   explicit WeakPtr(const SharedPtr<T> &orig) noexcept {
     ptr_ = orig.ptr_;
-    counter_ = orig.counter_;
-    if (nullptr != counter_) ++counter_->weak_count;
+    counter_ = nullptr == ptr_ ? nullptr : ptr_->GetCounter();
+    if (nullptr != counter_) ++counter()->weak_count;
   }
 
   /**
    * @brief Destructor
    */
   ~WeakPtr() {
-    if (nullptr != counter_) {
-      --counter_->weak_count;
-      if ((0 == counter_->use_count) && (0 == counter_->weak_count)) {
-        delete counter_;
-      }
-    }
+    if (nullptr != counter_) Release(counter());
   }
 
   /**
    * @brief Assignment from a SharedPtr
    */
   WeakPtr &operator=(const SharedPtr<T> &other) noexcept {
-    SPCountedBase::Counter *old_counter = counter_;
+    void *old_counter = counter_;
 
     ptr_ = other.ptr_;
-    counter_ = other.counter_;
-
-    if (nullptr != counter_) ++counter_->weak_count;
+    counter_ = nullptr == ptr_ ? nullptr : ptr_->GetCounter();
 
-    if (nullptr != old_counter) {
-      --old_counter->weak_count;
-      if ((0 == old_counter->use_count) && (0 == old_counter->weak_count)) {
-        delete old_counter;
-      }
-    }
+    if (nullptr != counter_) ++counter()->weak_count;
+    if (nullptr != old_counter) Release(static_cast<typename T::Counter *>(old_counter));
 
     return *this;
   }
@@ -460,19 +555,13 @@ class WeakPtr {
    * @brief Copy assignment
    */
   WeakPtr &operator=(const WeakPtr &other) noexcept {
-    SPCountedBase::Counter *old_counter = counter_;
+    void *old_counter = counter_;
 
     ptr_ = other.ptr_;
     counter_ = other.counter_;
 
-    if (nullptr != counter_) ++counter_->weak_count;
-
-    if (nullptr != old_counter) {
-      --old_counter->weak_count;
-      if ((0 == old_counter->use_count) && (0 == old_counter->weak_count)) {
-        delete old_counter;
-      }
-    }
+    if (nullptr != counter_) ++counter()->weak_count;
+    if (nullptr != old_counter) Release(static_cast<typename T::Counter *>(old_counter));
 
     return *this;
   }
@@ -483,10 +572,7 @@ class WeakPtr {
   void Reset() noexcept {
     ptr_ = nullptr;
     if (nullptr != counter_) {
-      --counter_->weak_count;
-      if ((0 == counter_->use_count) && (0 == counter_->weak_count)) {
-        delete counter_;
-      }
+      Release(counter());
       counter_ = nullptr;
     }
   }
@@ -495,14 +581,14 @@ class WeakPtr {
    * @brief Get use count
    */
   size_t use_count() const noexcept {
-    return nullptr == counter_ ? 0 : counter_->use_count.load();
+    return nullptr == counter_ ? 0 : (size_t) counter()->use_count;
   }
 
   /**
    * @brief Get weak count
    */
   size_t weak_count() const noexcept {
-    return nullptr == counter_ ? 0 : counter_->weak_count.load();
+    return nullptr == counter_ ? 0 : (size_t) counter()->weak_count;
   }
 
   /**
@@ -513,7 +599,7 @@ class WeakPtr {
    * was already zero you get an empty SharedPtr instance instead.
    */
   SharedPtr<T> Lock() const noexcept {
-    if (counter_->use_count > 0) {
+    if (counter()->use_count > 0) {
       return SharedPtr<T>(ptr_);
     }
 
@@ -526,7 +612,7 @@ class WeakPtr {
    */
   explicit operator bool() const noexcept {
     if (nullptr != counter_) {
-      _ASSERT(0 != counter_->use_count || 0 != counter_->weak_count);
+      _ASSERT(0 != counter()->use_count || 0 != counter()->weak_count);
       return true;
     }
     
@@ -535,9 +621,24 @@ class WeakPtr {
 
  private:
 
+  template<typename R = T>
+  typename R::Counter *counter() const noexcept {
+    return static_cast<typename R::Counter *>(counter_);
+  }
+
+  /**
+   * @brief Decrease the weak count, release the counter if it's not used
+   */
+  template<typename Counter>
+  static void Release(Counter *counter) {
+    if ((0 == --counter->weak_count) && (0 == counter->use_count)) {
+      T::Release(counter);
+    }
+  }
+
   T *ptr_ = nullptr;
 
-  SPCountedBase::Counter *counter_ = nullptr;
+  void *counter_ = nullptr;
 
 };
 
@@ -556,13 +657,51 @@ std::unique_ptr<T> MakeUnique(Args &&... args) {
   return std::unique_ptr<T>(new T(std::forward<Args>(args)...));
 }
 
+/// @cond IGNORE
+namespace detail {
+
+/**
+ * @brief The memory block allocated in MakeShared()
+ *
+ * The counter must be the first member, the block is released from its
+ * address.
+ */
+template<typename T>
+struct SharedBlock {
+  typename T::Counter counter;
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+};
+
+}  // namespace detail
+/// @endcond
+
 /**
  * @ingroup core
  * @brief Constructs an object of tyep T and wraps it in a SharedPtr
+ *
+ * The object and its counter are allocated in one memory block, the block is
+ * released when both the use count and the weak count drop to zero.
  */
 template<typename T, typename ... Args>
 SharedPtr<T> MakeShared(Args &&... args) {
-  return SharedPtr<T>(new T(std::forward<Args>(args)...));
+  typedef typename T::Counter Counter;
+  typedef detail::SharedBlock<T> Block;
+
+  void *memory = ::operator new(sizeof(Block));
+  Block *block = static_cast<Block *>(memory);
+  Counter *counter = new(&block->counter) Counter(true);
+
+  T *obj = nullptr;
+  try {
+    obj = new(&block->storage) T(std::forward<Args>(args)...);
+  } catch (...) {
+    counter->~Counter();
+    ::operator delete(memory);
+    throw;
+  }
+
+  obj->counter_ = counter;
+  return SharedPtr<T>(obj);
 };
 
 /**
@@ -571,14 +710,7 @@ SharedPtr<T> MakeShared(Args &&... args) {
  */
 template<typename T>
 void Swap(SharedPtr<T> &src, SharedPtr<T> &dst) {
-  T *object = src.ptr_;
-  SPCountedBase::Counter *counter = src.counter_;
-
-  src.ptr_ = dst.ptr_;
-  src.counter_ = dst.counter_;
-
-  dst.ptr_ = object;
-  dst.counter_ = counter;
+  src.Swap(dst);
 }
 
 /**
@@ -588,7 +720,7 @@ void Swap(SharedPtr<T> &src, SharedPtr<T> &dst) {
 template<typename T>
 void Swap(WeakPtr<T> &src, WeakPtr<T> &dst) {
   T *object = src.ptr_;
-  SPCountedBase::Counter *counter = src.counter_;
+  void *counter = src.counter_;
 
   src.ptr_ = dst.ptr_;
   src.counter_ = dst.counter_;
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_CORE_MPSC_QUEUE_HPP_
+#define SKLAND_CORE_MPSC_QUEUE_HPP_
+
+#include "defines.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace skland {
+namespace core {
+
+/**
+ * @ingroup core
+ * @brief A node used in MPSCQueue
+ *
+ * Like BiNode in Deque, you create a subclass and push objects to a queue, the
+ * queue never allocates memory:
+ * @code
+ *  class Message: public core::MPSCNode {}
+ *
+ *  core::MPSCQueue<Message> queue;
+ *  queue.Push(new Message);  // in any thread
+ *  Message *message = queue.Pop();  // in the consumer thread
+ * @endcode
+ *
+ * A node can be in only one queue at a time.
+ */
+class MPSCNode {
+
+  template<typename T> friend
+  class MPSCQueue;
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(MPSCNode);
+
+  /**
+   * @brief Default constructor
+   */
+  MPSCNode()
+      : next_(nullptr) {}
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~MPSCNode() {}
+
+ private:
+
+  std::atomic<MPSCNode *> next_;
+
+};
+
+/**
+ * @ingroup core
+ * @brief An intrusive lock-free multi-producer single-consumer queue
+ * @tparam T Must be a MPSCNode class or subclass
+ *
+ * This is Dmitry Vyukov's intrusive MPSC queue. Push() can be called in any
+ * thread, it swaps the head pointer and links the previous node, no lock, no
+ * loop and no allocation. Pop() and IsEmpty() must be called in one consumer
+ * thread.
+ *
+ * A producer interrupted between the two steps of Push() leaves the queue
+ * unlinked for a moment. Pop() yields until the link is done in this case, so
+ * it never misses a node which is pushed before it's called.
+ *
+ * The nodes still in the queue are not deleted when the queue is destroyed.
+ */
+template<typename T = MPSCNode>
+class MPSCQueue {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(MPSCQueue);
+
+  /**
+   * @brief Default constructor
+   */
+  MPSCQueue()
+      : head_(&stub_), tail_(&stub_) {}
+
+  /**
+   * @brief Destructor
+   */
+  ~MPSCQueue() {}
+
+  /**
+   * @brief Push a node to the back, thread safe
+   */
+  void Push(T *node) {
+    PushNode(node);
+  }
+
+  /**
+   * @brief Take the node in the front
+   * @return The node or nullptr if the queue is empty
+   *
+   * Only call this in the consumer thread.
+   */
+  T *Pop() {
+    MPSCNode *tail = tail_;
+    MPSCNode *next = tail->next_.load(std::memory_order_acquire);
+
+    if (tail == &stub_) {
+      if (nullptr == next) return nullptr;
+      tail_ = next;
+      tail = next;
+      next = next->next_.load(std::memory_order_acquire);
+    }
+
+    if (nullptr == next) {
+      // Push the stub back so the last node can be taken
+      if (tail == head_.load(std::memory_order_acquire)) PushNode(&stub_);
+
+      // A producer has swapped the head but not linked the node yet, this only
+      // takes a few instructions
+      while (nullptr == (next = tail->next_.load(std::memory_order_acquire))) {
+        std::this_thread::yield();
+      }
+    }
+
+    tail_ = next;
+    return static_cast<T *>(tail);
+  }
+
+  /**
+   * @brief Check if there's no node in the queue
+   *
+   * Only call this in the consumer thread.
+   */
+  bool IsEmpty() const {
+    return (tail_ == &stub_) && (nullptr == stub_.next_.load(std::memory_order_acquire));
+  }
+
+ private:
+
+  void PushNode(MPSCNode *node) {
+    node->next_.store(nullptr, std::memory_order_relaxed);
+    MPSCNode *previous = head_.exchange(node, std::memory_order_acq_rel);
+    previous->next_.store(node, std::memory_order_release);
+  }
+
+  /** The last pushed node, swapped by producers */
+  std::atomic<MPSCNode *> head_;
+
+  /** Keep the producer and consumer data in different cache lines */
+  char padding_[64 - sizeof(std::atomic<MPSCNode *>)];
+
+  /** The next node to pop, only used in the consumer thread */
+  MPSCNode *tail_;
+
+  MPSCNode stub_;
+
+};
+
+} // namespace core
+} // namespace skland
+
+#endif // SKLAND_CORE_MPSC_QUEUE_HPP_
@@ -19,6 +19,7 @@
 
 #include "sigcxx.hpp"
 #include "defines.hpp"
+#include "list-index.hpp"
 
 #include <string>
 
@@ -60,6 +61,14 @@ class Object : public Trackable {
 
   int children_count() const { return children_count_; }
 
+  /**
+   * @brief Get the child object at the given index
+   * @param index The index, a negative value counts from the end
+   * @return The child object or nullptr if the index is out of range
+   *
+   * Children are indexed in a lazily built table, repeated access without
+   * changing the children list is O(1).
+   */
   Object *GetChildAt(int index) const;
 
   /**
@@ -163,6 +172,12 @@ class Object : public Trackable {
 
  private:
 
+  struct ChildIndexTraits {
+    static Object *Next(Object *object) { return object->next_; }
+    static Object *Previous(Object *object) { return object->previous_; }
+    static int &Index(Object *object) { return object->index_; }
+  };
+
   Object *previous_;
   Object *next_;
 
@@ -172,6 +187,11 @@ class Object : public Trackable {
   Object *parent_;
   int children_count_;
 
+  /* The position hint used by the index table in parent */
+  int index_;
+
+  mutable ListIndex<Object, ChildIndexTraits> children_index_;
+
 };
 
 template<typename T>
@@ -28,9 +28,15 @@
 #define SKLAND_CORE_SIGCXX_HPP_
 
 #include <cstddef>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 #include "delegate.hpp"
 #include "deque.hpp"
+#include "signal-queue.hpp"
 
 #ifdef DEBUG
 #include <cassert>
@@ -61,6 +67,8 @@ namespace detail {
 struct Token;
 template<typename ... ParamTypes>
 class SignalToken;
+template<typename ... ParamTypes>
+class QueuedCall;
 
 /**
  * @brief A simple structure works as a list node in Trackable object
@@ -87,13 +95,19 @@ struct Token {
 
   virtual ~Token();
 
+  /**
+   * @brief Remove this token from the signal
+   *
+   * Called in destructor, a sub class calls it earlier if its members must
+   * not be used by the signal any more.
+   */
+  void Unlink();
+
   Trackable *trackable = nullptr;
   Token *previous = nullptr;
   Token *next = nullptr;
   Binding *binding = nullptr;
 
-  BiNode slot_mark_head;
-
 };
 
 template<typename ... ParamTypes>
@@ -130,9 +144,9 @@ class DelegateToken : public CallableToken<ParamTypes...> {
   explicit DelegateToken(const Delegate<void(ParamTypes...)> &d)
       : CallableToken<ParamTypes...>(), delegate_(d) {}
 
-  ~DelegateToken() final = default;
+  ~DelegateToken() override = default;
 
-  virtual void Invoke(ParamTypes... Args) final {
+  virtual void Invoke(ParamTypes... Args) override {
     delegate_(Args...);
   }
 
@@ -147,7 +161,7 @@ class DelegateToken : public CallableToken<ParamTypes...> {
 };
 
 template<typename ... ParamTypes>
-class SignalToken : public CallableToken<ParamTypes...> {
+class SignalToken : public CallableToken<ParamTypes..., SLOT> {
 
  public:
 
@@ -158,11 +172,11 @@ class SignalToken : public CallableToken<ParamTypes...> {
   SignalToken &operator=(SignalToken &&) = delete;
 
   explicit SignalToken(Signal<ParamTypes...> &signal)
-      : CallableToken<ParamTypes...>(), signal_(&signal) {}
+      : CallableToken<ParamTypes..., SLOT>(), signal_(&signal) {}
 
   ~SignalToken() final = default;
 
-  virtual void Invoke(ParamTypes... Args) final {
+  virtual void Invoke(ParamTypes... Args, SLOT) final {
     signal_->Emit(Args...);
   }
 
@@ -201,26 +215,10 @@ class Slot {
   template<typename ... ParamTypes> friend
   class Signal;
 
- public:
-
-  class Mark : public BiNode {
-
-   public:
-
-    Mark() = delete;
-
-    explicit Mark(Slot *slot)
-        : slot_(slot) {}
-
-    virtual ~Mark() = default;
-
-    Slot *slot() const { return slot_; }
-
-   private:
-
-    Slot *slot_ = nullptr;
+  template<typename ... ParamTypes> friend
+  class detail::QueuedCall;
 
-  };
+ public:
 
   Slot() = delete;
   Slot(const Slot &) = delete;
@@ -247,7 +245,7 @@ class Slot {
  private:
 
   explicit Slot(detail::Token *token)
-      : token_(token), skip_(false), mark_(this) {}
+      : token_(token), skip_(false), detached_(false), outer_(nullptr) {}
 
   ~Slot() = default;
 
@@ -265,10 +263,131 @@ class Slot {
 
   bool skip_;
 
-  Mark mark_;
+  /**
+   * @brief If the signal was destroyed in a slot method during emission
+   */
+  bool detached_;
+
+  /**
+   * @brief The slot of an outer (re-entrant) emission of the same signal
+   */
+  Slot *outer_;
 
 };
 
+/// @cond IGNORE
+namespace detail {
+
+template<int ... Indices>
+struct IndexSequence {};
+
+template<int N, int ... Indices>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, Indices...> {};
+
+template<int ... Indices>
+struct MakeIndexSequence<0, Indices...> {
+  typedef IndexSequence<Indices...> type;
+};
+
+template<typename ... ParamTypes>
+class QueuedToken;
+
+/**
+ * @brief The state of a queued connection shared with pending calls
+ *
+ * The token is reset to nullptr when the connection is destroyed, pending
+ * calls check it before running in the queue thread.
+ */
+template<typename ... ParamTypes>
+struct QueuedConnection {
+
+  QueuedConnection(QueuedToken<ParamTypes...> *t, SignalQueue *q)
+      : token(t), queue(q) {}
+
+  QueuedToken<ParamTypes...> *token;
+
+  SignalQueue *queue;
+
+};
+
+/**
+ * @brief A signal emission with the copied arguments waiting in a SignalQueue
+ */
+template<typename ... ParamTypes>
+class QueuedCall : public SignalQueue::Call {
+
+ public:
+
+  QueuedCall(const std::shared_ptr<QueuedConnection<ParamTypes...> > &connection,
+             ParamTypes ... Args)
+      : SignalQueue::Call(), connection_(connection), args_(Args...) {}
+
+  virtual ~QueuedCall() {}
+
+  virtual void Run() final {
+    Run(typename MakeIndexSequence<sizeof...(ParamTypes)>::type());
+  }
+
+ private:
+
+  template<int ... Indices>
+  void Run(IndexSequence<Indices...>) {
+    QueuedToken<ParamTypes...> *token = connection_->token;
+    if (nullptr == token) return;  // disconnected or the receiver was destroyed
+
+    Slot slot(token);
+    token->delegate()(std::get<Indices>(args_)..., &slot);
+  }
+
+  std::shared_ptr<QueuedConnection<ParamTypes...> > connection_;
+
+  std::tuple<typename std::decay<ParamTypes>::type...> args_;
+
+};
+
+/**
+ * @brief A token posts calls to a SignalQueue instead of calling the delegate
+ *
+ * The calls are posted by Signal::Emit() from a snapshot of the connection
+ * states taken under the signal's mutex, so Invoke() does nothing.
+ */
+template<typename ... ParamTypes>
+class QueuedToken : public DelegateToken<ParamTypes..., SLOT> {
+
+ public:
+
+  QueuedToken() = delete;
+  QueuedToken(const QueuedToken &) = delete;
+  QueuedToken &operator=(const QueuedToken &) = delete;
+  QueuedToken(QueuedToken &&) = delete;
+  QueuedToken &operator=(QueuedToken &&)= delete;
+
+  QueuedToken(const Delegate<void(ParamTypes..., SLOT)> &d, SignalQueue *queue)
+      : DelegateToken<ParamTypes..., SLOT>(d),
+        connection_(std::make_shared<QueuedConnection<ParamTypes...> >(this, queue)) {}
+
+  ~QueuedToken() final {
+    // Leave the signal before connection_ is destroyed, Emit() in another
+    // thread may be copying it
+    this->Unlink();
+    connection_->token = nullptr;
+  }
+
+  virtual void Invoke(ParamTypes..., SLOT) final {}
+
+  const std::shared_ptr<QueuedConnection<ParamTypes...> > &connection() const {
+    return connection_;
+  }
+
+ private:
+
+  std::shared_ptr<QueuedConnection<ParamTypes...> > connection_;
+
+};
+
+}  // namespace detail
+/// @endcond
+
 /**
  * @ingroup core
  * @brief The basic class for an object which can provide slot methods
@@ -431,6 +550,13 @@ class Signal : public Trackable {
 
   ~Signal() final {
     DisconnectAll();
+
+    // Tell the emissions in progress this signal is gone
+    for (Slot *slot = emitting_slot_; slot; slot = slot->outer_) {
+      slot->token_ = nullptr;
+      slot->skip_ = true;
+      slot->detached_ = true;
+    }
   }
 
   /**
@@ -441,6 +567,40 @@ class Signal : public Trackable {
 
   void Connect(Signal<ParamTypes...> &other, int index = -1);
 
+  /**
+   * @brief Connect this signal to a slot method called in the receiver's event loop
+   * @param obj The receiver
+   * @param method The slot method
+   * @param queue The queue dispatched by the receiver's event loop, nullptr
+   *        means the queue of the current thread (SignalQueue::GetCurrent())
+   * @param index The position of this connection
+   *
+   * Emitting the signal copies the arguments and posts them to the queue, the
+   * slot method is called later when the queue is dispatched. If the receiver
+   * is destroyed or the connection is removed before that, the pending calls
+   * are dropped.
+   *
+   * This makes it possible to emit a signal in a worker or timer thread and
+   * handle it in the main thread. The rules for this are:
+   *
+   * - Only one thread emits a signal, use one signal per emitting thread
+   * - A signal emitted in another thread has only queued connections
+   * - The first queued connection is made before the other thread starts
+   *   emitting, the connections are created and removed in the thread
+   *   dispatching the queue
+   * - The signal outlives the emitting thread
+   *
+   * The receiver may be destroyed or disconnected while the other thread is
+   * emitting, the token list is guarded by a mutex and the calls are posted
+   * outside of it. Pointer arguments are copied as is, the objects they point
+   * to must outlive the delivery.
+   *
+   * If there's no queue at all this is the same as Connect().
+   */
+  template<typename T>
+  void ConnectQueued(T *obj, void (T::*method)(ParamTypes..., SLOT),
+                     SignalQueue *queue = nullptr, int index = -1);
+
   /**
    * @brief Disconnect all delegates to a method
    */
@@ -523,6 +683,11 @@ class Signal : public Trackable {
 
   void InsertToken(int index, detail::Token *token);
 
+  /**
+   * @brief Post the queued connections, return true if there're direct ones
+   */
+  bool PostQueued(ParamTypes ... Args);
+
   inline detail::Token *first_token() const {
     return first_token_;
   }
@@ -534,6 +699,19 @@ class Signal : public Trackable {
   detail::Token *first_token_ = nullptr;
   detail::Token *last_token_ = nullptr;
 
+  /**
+   * @brief The innermost slot being emitted, linked to outer ones by Slot::outer_
+   */
+  Slot *emitting_slot_ = nullptr;
+
+  /**
+   * @brief Guards the token list against Emit() in other threads
+   *
+   * Created by the first ConnectQueued(), signals without queued connections
+   * don't lock.
+   */
+  std::unique_ptr<std::mutex> mutex_;
+
 };
 
 // Signal implementation:
@@ -552,6 +730,28 @@ void Signal<ParamTypes...>::Connect(T *obj, void (T::*method)(ParamTypes..., SLO
   push_back(obj, downstream);  // always push back binding, don't care about the position in observer
 }
 
+template<typename ... ParamTypes>
+template<typename T>
+void Signal<ParamTypes...>::ConnectQueued(T *obj, void (T::*method)(ParamTypes..., SLOT),
+                                          SignalQueue *queue, int index) {
+  if (nullptr == queue) queue = SignalQueue::GetCurrent();
+  if (nullptr == queue) {
+    Connect(obj, method, index);
+    return;
+  }
+
+  detail::Binding *downstream = new detail::Binding;
+  Delegate<void(ParamTypes..., SLOT)> d =
+      Delegate<void(ParamTypes..., SLOT)>::template FromMethod<T>(obj, method);
+  detail::QueuedToken<ParamTypes...> *token = new detail::QueuedToken<ParamTypes...>(d, queue);
+
+  if (!mutex_) mutex_.reset(new std::mutex);
+
+  link(token, downstream);
+  InsertToken(index, token);
+  push_back(obj, downstream);
+}
+
 template<typename ... ParamTypes>
 void Signal<ParamTypes...>::Connect(Signal<ParamTypes...> &other, int index) {
   detail::SignalToken<ParamTypes...> *token = new detail::SignalToken<ParamTypes...>(
@@ -852,10 +1052,14 @@ int Signal<ParamTypes...>::CountConnections() const {
 
 template<typename ... ParamTypes>
 void Signal<ParamTypes...>::Emit(ParamTypes ... Args) {
-  Slot slot(first_token());
+  if (mutex_ && !PostQueued(Args...)) return;
+  if (nullptr == first_token_) return;
 
-  while (nullptr != slot.token_) {
-    slot.token_->slot_mark_head.PushBack(&slot.mark_);
+  Slot slot(first_token_);
+  slot.outer_ = emitting_slot_;
+  emitting_slot_ = &slot;
+
+  do {
     static_cast<detail::CallableToken<ParamTypes..., SLOT> * > (slot.token_)->Invoke(Args..., &slot);
 
     if (slot.skip_) {
@@ -863,13 +1067,55 @@ void Signal<ParamTypes...>::Emit(ParamTypes ... Args) {
     } else {
       ++slot;
     }
+  } while (nullptr != slot.token_);
+
+  // This signal may be deleted in a slot method
+  if (!slot.detached_) emitting_slot_ = slot.outer_;
+}
+
+template<typename ... ParamTypes>
+bool Signal<ParamTypes...>::PostQueued(ParamTypes ... Args) {
+  std::vector<std::shared_ptr<detail::QueuedConnection<ParamTypes...> > > connections;
+  detail::QueuedToken<ParamTypes...> *queued_token = nullptr;
+  bool direct = false;
+
+  {
+    std::lock_guard<std::mutex> lock(*mutex_);
+    for (detail::Token *it = first_token_; it; it = it->next) {
+      queued_token = dynamic_cast<detail::QueuedToken<ParamTypes...> *>(it);
+      if (queued_token) connections.push_back(queued_token->connection());
+      else direct = true;
+    }
+  }
+
+  for (const auto &connection : connections) {
+    connection->queue->Post(new detail::QueuedCall<ParamTypes...>(connection, Args...));
   }
+
+  return direct;
 }
 
 template<typename ... ParamTypes>
 void Signal<ParamTypes...>::AuditDestroyingToken(detail::Token *token) {
+  std::unique_lock<std::mutex> lock;
+  if (mutex_) lock = std::unique_lock<std::mutex>(*mutex_);
+
   if (token == first_token_) first_token_ = token->next;
   if (token == last_token_) last_token_ = token->previous;
+
+  // Move the slots being emitted on this token to the next one
+  for (Slot *slot = emitting_slot_; slot; slot = slot->outer_) {
+    if (slot->token_ == token) {
+      slot->token_ = token->next;
+      slot->skip_ = true;
+    }
+  }
+
+  // Unlink under the lock, Token::Unlink() has nothing left to do
+  if (token->previous) token->previous->next = token->next;
+  if (token->next) token->next->previous = token->previous;
+  token->previous = nullptr;
+  token->next = nullptr;
 }
 
 template<typename ... ParamTypes>
@@ -921,6 +1167,9 @@ void Signal<ParamTypes...>::InsertToken(int index, detail::Token *token) {
   assert(nullptr == token->trackable);
 #endif
 
+  std::unique_lock<std::mutex> lock;
+  if (mutex_) lock = std::unique_lock<std::mutex>(*mutex_);
+
   if (nullptr == first_token_) {
 #ifdef DEBUG
     assert(nullptr == last_token_);
@@ -1038,6 +1287,12 @@ class SignalRef {
     signal_->Connect(signal, index);
   }
 
+  template<typename T>
+  void ConnectQueued(T *obj, void (T::*method)(ParamTypes..., SLOT),
+                     SignalQueue *queue = nullptr, int index = -1) {
+    signal_->ConnectQueued(obj, method, queue, index);
+  }
+
   template<typename T>
   void DisconnectAll(T *obj, void (T::*method)(ParamTypes..., SLOT)) {
     signal_->DisconnectAll(obj, method);
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_CORE_SIGNAL_QUEUE_HPP_
+#define SKLAND_CORE_SIGNAL_QUEUE_HPP_
+
+#include "defines.hpp"
+#include "mpsc-queue.hpp"
+
+#include <atomic>
+
+namespace skland {
+namespace core {
+
+/**
+ * @ingroup core
+ * @brief A lock-free queue delivering queued signal emissions to an event loop
+ *
+ * A queued connection (see Signal::ConnectQueued()) does not call the slot
+ * method in the emitting thread. It copies the arguments into a Call object
+ * and posts it to the SignalQueue of the receiver, the thread which owns the
+ * queue runs the slot methods in Dispatch().
+ *
+ * Post() can be called from any thread. Calls are kept in a lock-free
+ * MPSCQueue, no lock and no allocation in the queue itself.
+ *
+ * The file descriptor returned by GetFd() is an eventfd which becomes readable
+ * when calls are posted to an idle queue, so an epoll based event loop can
+ * watch it and call Dispatch(). The Application in gui module does this for
+ * the main thread.
+ */
+class SignalQueue {
+
+ public:
+
+  /**
+   * @brief The base class of a queued call
+   */
+  class Call : public MPSCNode {
+
+   public:
+
+    SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(Call);
+
+    Call() = default;
+
+    virtual ~Call() {}
+
+    /**
+     * @brief Run the call in the thread dispatching the queue
+     */
+    virtual void Run() = 0;
+
+  };
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(SignalQueue);
+
+  SignalQueue();
+
+  /**
+   * @brief Destructor
+   *
+   * Calls not dispatched yet are deleted without running.
+   */
+  ~SignalQueue();
+
+  /**
+   * @brief Post a call to this queue, thread safe
+   * @param call A call object created by new, the queue takes the ownership
+   */
+  void Post(Call *call);
+
+  /**
+   * @brief Run and delete all posted calls
+   * @return The number of calls dispatched
+   *
+   * This should only be called in the thread owning this queue.
+   */
+  int Dispatch();
+
+  /**
+   * @brief Get the eventfd which is readable when there're calls posted
+   * @return A file descriptor, or -1 if fail to create the eventfd
+   */
+  int GetFd() const { return fd_; }
+
+  /**
+   * @brief Get the queue dispatched in the current thread
+   * @return A pointer to the queue set by SetCurrent(), or nullptr
+   */
+  static SignalQueue *GetCurrent();
+
+  /**
+   * @brief Set the queue dispatched in the current thread
+   *
+   * Queued connections made in this thread deliver calls to this queue by
+   * default.
+   */
+  static void SetCurrent(SignalQueue *queue);
+
+ private:
+
+  MPSCQueue<Call> queue_;
+
+  int fd_;
+
+  /** If the eventfd was written and not dispatched yet */
+  std::atomic<bool> notified_;
+
+};
+
+} // namespace core
+} // namespace skland
+
+#endif // SKLAND_CORE_SIGNAL_QUEUE_HPP_
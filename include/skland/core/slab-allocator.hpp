@@ -0,0 +1,227 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_CORE_SLAB_ALLOCATOR_HPP_
+#define SKLAND_CORE_SLAB_ALLOCATOR_HPP_
+
+#include "defines.hpp"
+
+#include <cstddef>
+#include <new>
+
+namespace skland {
+namespace core {
+
+/**
+ * @ingroup core
+ * @brief A fixed-size block allocator
+ *
+ * SlabAllocator allocates memory in chunks, each chunk holds a number of
+ * blocks with the same size. Freed blocks are kept in a free list and reused
+ * by the next allocation, chunks are released when the allocator is
+ * destroyed.
+ *
+ * Every block is preceded by a pointer to its chunk, so Free() can return a
+ * block to the allocator it came from, or to the heap if it was allocated
+ * with AllocateFromHeap(). If the allocator is destroyed while blocks are
+ * still in use, their chunks are kept and released when the last block is
+ * freed.
+ *
+ * This allocator keeps counters of allocations and chunks so the number of
+ * real heap allocations can be checked in tests.
+ *
+ * @note This class is not thread safe, it's designed to be used in the GUI
+ * thread.
+ */
+class SlabAllocator {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(SlabAllocator);
+  SlabAllocator() = delete;
+
+  /**
+   * @brief Constructor
+   * @param block_size The size of each block, will be aligned
+   * @param blocks_per_chunk Block count in each chunk
+   */
+  explicit SlabAllocator(size_t block_size, size_t blocks_per_chunk = 64);
+
+  /**
+   * @brief Destructor
+   *
+   * Release all chunks. Chunks with blocks still in use are released when
+   * their last block is freed, debug builds print the count of live blocks.
+   */
+  ~SlabAllocator();
+
+  /**
+   * @brief Allocate a block
+   * @return A pointer to a block, throws std::bad_alloc if out of memory
+   */
+  void *Allocate();
+
+  /**
+   * @brief Return a block to this allocator
+   * @param ptr A pointer returned by Allocate(), can be nullptr
+   */
+  void Deallocate(void *ptr);
+
+  size_t GetBlockSize() const { return block_size_; }
+
+  size_t GetBlocksPerChunk() const { return blocks_per_chunk_; }
+
+  /**
+   * @brief Total count of Allocate() calls
+   */
+  size_t GetAllocationCount() const { return allocation_count_; }
+
+  /**
+   * @brief Total count of Deallocate() calls with a valid pointer
+   */
+  size_t GetDeallocationCount() const { return deallocation_count_; }
+
+  /**
+   * @brief Count of chunks allocated from heap
+   */
+  size_t GetChunkCount() const { return chunk_count_; }
+
+  /**
+   * @brief Count of blocks in use
+   */
+  size_t GetInUseCount() const { return allocation_count_ - deallocation_count_; }
+
+  /**
+   * @brief The maximal count of blocks in use at the same time
+   */
+  size_t GetPeakInUseCount() const { return peak_in_use_count_; }
+
+  /**
+   * @brief Allocate memory from heap which can be released by Free()
+   */
+  static void *AllocateFromHeap(size_t size);
+
+  /**
+   * @brief Free a block allocated by any allocator or AllocateFromHeap()
+   * @param ptr A pointer to the block, can be nullptr
+   */
+  static void Free(void *ptr);
+
+ private:
+
+  struct Block {
+    Block *next;
+  };
+
+  struct Chunk {
+    Chunk *next;
+    SlabAllocator *owner;
+    size_t in_use_count;
+  };
+
+  static Chunk *&GetChunkOf(void *ptr);
+
+  void AllocateChunk();
+
+  size_t block_size_;
+  size_t blocks_per_chunk_;
+
+  Block *free_list_;
+  Chunk *chunks_;
+
+  size_t allocation_count_;
+  size_t deallocation_count_;
+  size_t chunk_count_;
+  size_t peak_in_use_count_;
+
+};
+
+/**
+ * @ingroup core
+ * @brief A base class template makes objects of T allocated from a SlabAllocator
+ * @tparam T The class derived from this template
+ *
+ * Inherit this template to use class-specific operator new/delete. Objects
+ * are allocated from the heap until a SlabAllocator is set by the owner of
+ * the slab (e.g. the application), and from that allocator until it's unset.
+ * Objects always go back to where they were allocated, no matter which
+ * allocator is set when they are deleted. Objects of sub classes larger than
+ * the block size are allocated from the heap.
+ *
+ * @code
+ * struct Foo : public core::SlabObject<Foo> {
+ *   int value;
+ * };
+ *
+ * core::SlabAllocator allocator(sizeof(Foo));
+ * Foo::SetSlabAllocator(&allocator);
+ * Foo *foo = new Foo;  // allocated in allocator
+ * delete foo;
+ * Foo::SetSlabAllocator(nullptr);
+ * @endcode
+ */
+template<typename T>
+class SlabObject {
+
+ public:
+
+  static void *operator new(size_t size) {
+    if (nullptr == kSlabAllocator || size > kSlabAllocator->GetBlockSize())
+      return SlabAllocator::AllocateFromHeap(size);
+
+    return kSlabAllocator->Allocate();
+  }
+
+  static void operator delete(void *ptr) {
+    SlabAllocator::Free(ptr);
+  }
+
+  /**
+   * @brief Set the allocator used by new objects of T
+   * @param allocator A slab allocator, or nullptr to allocate from heap
+   */
+  static void SetSlabAllocator(SlabAllocator *allocator) {
+    _ASSERT(nullptr == allocator || allocator->GetBlockSize() >= sizeof(T));
+    kSlabAllocator = allocator;
+  }
+
+  /**
+   * @brief Get the allocator used by new objects of T, nullptr if not set
+   */
+  static SlabAllocator *GetSlabAllocator() {
+    return kSlabAllocator;
+  }
+
+ protected:
+
+  SlabObject() = default;
+
+  ~SlabObject() = default;
+
+ private:
+
+  static SlabAllocator *kSlabAllocator;
+
+};
+
+template<typename T>
+SlabAllocator *SlabObject<T>::kSlabAllocator = nullptr;
+
+} // namespace core
+} // namespace skland
+
+#endif // SKLAND_CORE_SLAB_ALLOCATOR_HPP_
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_CORE_SPSC_RING_HPP_
+#define SKLAND_CORE_SPSC_RING_HPP_
+
+#include "defines.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+namespace skland {
+namespace core {
+
+/**
+ * @ingroup core
+ * @brief A bounded lock-free single-producer single-consumer ring buffer
+ * @tparam T The element type, must be default constructible and copyable,
+ * usually a pointer or a small record
+ *
+ * The buffer is allocated once in the constructor, Push() and Pop() never
+ * allocate memory. Push() must be called in one producer thread and Pop() in
+ * one consumer thread.
+ *
+ * Each side keeps a cached copy of the other side's index, so the shared
+ * atomic index is only loaded when the cached one says the ring is full or
+ * empty.
+ */
+template<typename T>
+class SPSCRing {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(SPSCRing);
+  SPSCRing() = delete;
+
+  /**
+   * @brief Constructor
+   * @param capacity The max number of elements, rounded up to a power of two
+   */
+  explicit SPSCRing(size_t capacity)
+      : buffer_(nullptr), mask_(0),
+        write_index_(0), cached_read_index_(0),
+        read_index_(0), cached_write_index_(0) {
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    buffer_ = new T[size];
+    mask_ = size - 1;
+  }
+
+  /**
+   * @brief Destructor
+   */
+  ~SPSCRing() {
+    delete[] buffer_;
+  }
+
+  /**
+   * @brief Push an element in the producer thread
+   * @return false if the ring is full
+   */
+  bool Push(const T &value) {
+    size_t write_index = write_index_.load(std::memory_order_relaxed);
+
+    if (write_index - cached_read_index_ > mask_) {
+      cached_read_index_ = read_index_.load(std::memory_order_acquire);
+      if (write_index - cached_read_index_ > mask_) return false;
+    }
+
+    buffer_[write_index & mask_] = value;
+    write_index_.store(write_index + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Pop an element in the consumer thread
+   * @param value Output of the element
+   * @return false if the ring is empty
+   */
+  bool Pop(T *value) {
+    size_t read_index = read_index_.load(std::memory_order_relaxed);
+
+    if (read_index == cached_write_index_) {
+      cached_write_index_ = write_index_.load(std::memory_order_acquire);
+      if (read_index == cached_write_index_) return false;
+    }
+
+    *value = buffer_[read_index & mask_];
+    read_index_.store(read_index + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Get the max number of elements
+   */
+  size_t GetCapacity() const {
+    return mask_ + 1;
+  }
+
+  /**
+   * @brief Get the number of elements
+   *
+   * The result is exact only when neither side is running.
+   */
+  size_t GetSize() const {
+    return write_index_.load(std::memory_order_acquire) - read_index_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Check if there's no element in the ring
+   */
+  bool IsEmpty() const {
+    return 0 == GetSize();
+  }
+
+ private:
+
+  T *buffer_;
+
+  size_t mask_;
+
+  /** Keep the producer and consumer data in different cache lines */
+  char padding0_[64];
+
+  /** Written by the producer */
+  std::atomic<size_t> write_index_;
+
+  /** The last read index the producer saw */
+  size_t cached_read_index_;
+
+  char padding1_[64];
+
+  /** Written by the consumer */
+  std::atomic<size_t> read_index_;
+
+  /** The last write index the consumer saw */
+  size_t cached_write_index_;
+
+  char padding2_[64];
+
+};
+
+} // namespace core
+} // namespace skland
+
+#endif // SKLAND_CORE_SPSC_RING_HPP_
@@ -17,24 +17,240 @@
 #ifndef SKLAND_CORE_TRACE_HPP_
 #define SKLAND_CORE_TRACE_HPP_
 
+#include "defines.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <string>
-#include <ctime>
 
 #ifdef TRACE
 
 #define _TRACE(fmt, args...) \
   do { \
-    Trace trace(__PRETTY_FUNCTION__, fmt, args); \
+    skland::Trace trace(__PRETTY_FUNCTION__, fmt, args); \
   } while(0)
 
+#define SKLAND_TRACE_CONCAT_IMPL(a, b) a ## b
+#define SKLAND_TRACE_CONCAT(a, b) SKLAND_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Record a span from here to the end of the current scope
+ * @param name A string literal
+ */
+#define SKLAND_TRACE_SCOPE(name) \
+  skland::core::TraceScope SKLAND_TRACE_CONCAT(skland_trace_scope_, __LINE__)(name)
+
+/**
+ * @brief Record a span of the current function
+ */
+#define SKLAND_TRACE_FUNCTION() SKLAND_TRACE_SCOPE(__PRETTY_FUNCTION__)
+
+/**
+ * @brief Record the begin of a span, must be paired with SKLAND_TRACE_END()
+ * in the same thread
+ * @param name A string literal
+ */
+#define SKLAND_TRACE_BEGIN(name) skland::core::Tracer::Begin(name)
+
+/**
+ * @brief Record the end of a span
+ * @param name A string literal
+ */
+#define SKLAND_TRACE_END(name) skland::core::Tracer::End(name)
+
+/**
+ * @brief Record an instant event
+ * @param name A string literal
+ */
+#define SKLAND_TRACE_INSTANT(name) skland::core::Tracer::Instant(name)
+
+/**
+ * @brief Record a counter value
+ * @param name A string literal
+ */
+#define SKLAND_TRACE_COUNTER(name, value) skland::core::Tracer::Counter(name, value)
+
 #else // NOT TRACE
 
 #define _TRACE(fmt, args...) ((void)0)
 
+#define SKLAND_TRACE_SCOPE(name) ((void)0)
+
+#define SKLAND_TRACE_FUNCTION() ((void)0)
+
+#define SKLAND_TRACE_BEGIN(name) ((void)0)
+
+#define SKLAND_TRACE_END(name) ((void)0)
+
+#define SKLAND_TRACE_INSTANT(name) ((void)0)
+
+#define SKLAND_TRACE_COUNTER(name, value) ((void)0)
+
 #endif  // TRACE
 
 namespace skland {
+namespace core {
+
+/**
+ * @ingroup core
+ * @brief The tracing backend
+ *
+ * Each thread records events into its own lock-free ring buffer
+ * (SPSCRing) as fixed-size binary records: a timestamp, a pointer to a
+ * static string as the name, a value and the event type. Recording an event
+ * never locks or allocates, if the ring is full the event is dropped and
+ * counted.
+ *
+ * A background thread started by Start() drains all rings periodically and
+ * writes the events in Chrome trace-event JSON format, which can be opened in
+ * chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Names are stored as pointers and must point to static strings (string
+ * literals or __PRETTY_FUNCTION__).
+ */
+class Tracer {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(Tracer);
+  Tracer() = delete;
+  ~Tracer() = delete;
+
+  /**
+   * @brief The event types, same as the 'ph' field in trace-event format
+   */
+  enum Phase {
+    kPhaseBegin = 'B',
+    kPhaseEnd = 'E',
+    kPhaseComplete = 'X',
+    kPhaseInstant = 'i',
+    kPhaseCounter = 'C'
+  };
+
+  /**
+   * @brief A binary trace record, one cache line
+   */
+  struct Record {
+
+    /** Nanoseconds since the tracer started */
+    int64_t timestamp;
+
+    /** A static string */
+    const char *name;
+
+    /** The duration in nanoseconds for a complete event, or a counter value */
+    int64_t value;
+
+    /** One of Phase */
+    char phase;
+
+    /** An optional short message, used by the formatted Trace */
+    char message[39];
+
+  };
+
+  /**
+   * @brief The per-thread ring buffer, defined in source
+   */
+  struct Buffer;
+
+  /**
+   * @brief Start tracing and the background flushing thread
+   * @param filename The JSON file to write, use the name set by
+   * Trace::SetFileName() ("trace.json" by default) if it's empty
+   * @param buffer_size The number of records in the ring of each new thread
+   * @return false if it's already started or the file cannot be opened
+   */
+  static bool Start(const std::string &filename = std::string(), size_t buffer_size = 16384);
+
+  /**
+   * @brief Stop tracing, write all pending events and close the file
+   */
+  static void Stop();
+
+  /**
+   * @brief Write all pending events now
+   */
+  static void Flush();
+
+  static bool IsEnabled() {
+    return kEnabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the current time in nanoseconds used in records
+   */
+  static int64_t GetTimestamp() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  static void Begin(const char *name, const char *message = nullptr);
+
+  static void End(const char *name);
+
+  static void Complete(const char *name, int64_t start, int64_t duration);
+
+  static void Instant(const char *name, const char *message = nullptr);
+
+  static void Counter(const char *name, int64_t value);
+
+  /**
+   * @brief The number of records dropped because a ring was full since the
+   * last Start()
+   */
+  static size_t GetDroppedCount();
+
+ private:
+
+  static void Push(const Record &record);
+
+  static Buffer *GetThreadBuffer();
+
+  static std::atomic<bool> kEnabled;
+
+};
+
+/**
+ * @ingroup core
+ * @brief Record a complete event for the lifetime of this object
+ *
+ * Use SKLAND_TRACE_SCOPE() instead of this class directly.
+ */
+class TraceScope {
+
+ public:
 
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(TraceScope);
+  TraceScope() = delete;
+
+  explicit TraceScope(const char *name)
+      : name_(name), start_(0) {
+    if (Tracer::IsEnabled()) start_ = Tracer::GetTimestamp();
+  }
+
+  ~TraceScope() {
+    if (start_ != 0 && Tracer::IsEnabled())
+      Tracer::Complete(name_, start_, Tracer::GetTimestamp() - start_);
+  }
+
+ private:
+
+  const char *name_;
+
+  int64_t start_;
+
+};
+
+} // namespace core
+
+/**
+ * @brief A scoped trace with a formatted message
+ *
+ * Records a begin event in constructor and an end event in destructor with
+ * core::Tracer. The message is truncated to fit in a record.
+ */
 class Trace {
 
   Trace(const Trace &) = delete;
@@ -42,33 +258,25 @@ class Trace {
 
  public:
 
-  Trace() {
-    ++kDepth;
-  }
+  Trace()
+      : func_name_(nullptr) {}
 
   Trace(const char *func_name, const char *format, ...);
 
   ~Trace() {
-    --kDepth;
+    if (nullptr != func_name_) core::Tracer::End(func_name_);
   }
 
   void Log(const char *func_name, const char *format, ...);
 
+  /**
+   * @brief Set the default file name used by core::Tracer::Start()
+   */
   static void SetFileName(const std::string &filename);
 
  private:
 
-  int SaveLine(int depth, int align, const char *format, va_list args);
-
-  static std::string kFileName;
-
-  static const int kBufferSize = 256;
-
-  static int kDepth;
-
-  static const char *kNestString;
-
-  static time_t kLastTime;
+  const char *func_name_;
 
 };
 
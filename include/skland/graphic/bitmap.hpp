@@ -18,8 +18,11 @@
 #define SKLAND_GRAPHIC_BITMAP_HPP_
 
 #include <memory>
+#include <functional>
 #include "image-info.hpp"
 
+#include "../core/size.hpp"
+
 namespace skland {
 namespace graphic {
 
@@ -30,6 +33,8 @@ namespace graphic {
 class Bitmap {
 
   friend class Canvas;
+  friend class ImageWriter;
+  friend class ImageCache;
 
  public:
 
@@ -55,6 +60,37 @@ class Bitmap {
 
   bool InstallPixels(const ImageInfo &info, void *pixels, size_t row_bytes);
 
+  /**
+   * @brief Load an image file in the calling thread
+   * @param path The image file
+   * @param target_size The size the image is going to be displayed in, the
+   *        image is scaled down close to (but not smaller than) this size, 0
+   *        width or height means no limit
+   * @return false if the file cannot be loaded
+   *
+   * The result is shared through ImageCache.
+   */
+  bool Load(const std::string &path, const core::SizeI &target_size = core::SizeI(0, 0));
+
+  /**
+   * @brief Load an image file in a worker thread
+   * @param path The image file
+   * @param target_size The same as in Load()
+   * @param callback Called with the loaded bitmap, which is empty if the file
+   *        cannot be loaded
+   *
+   * The callback is called right away in the calling thread if the image is
+   * in ImageCache, otherwise it's called in a worker thread.
+   */
+  static void LoadAsync(const std::string &path,
+                        const core::SizeI &target_size,
+                        const std::function<void(const Bitmap &)> &callback);
+
+  /**
+   * @brief Write the pixels to an image file on the calling thread
+   *
+   * Use ImageWriter to take a snapshot and encode it on another thread.
+   */
   void WriteToFile(const std::string &filename) const;
 
   int GetWidth() const;
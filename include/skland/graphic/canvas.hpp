@@ -41,6 +41,9 @@ class Matrix;
 class Bitmap;
 class ImageInfo;
 class Surface;
+class TextLayout;
+class Picture;
+class GPUContext;
 
 /**
  * @ingroup graphic
@@ -49,6 +52,7 @@ class Surface;
 class Canvas {
 
   friend class Surface;
+  friend class PictureRecorder;
 
  public:
 
@@ -63,6 +67,28 @@ class Canvas {
                                     unsigned char *pixels,
                                     int format = kPixelFormatABGR8888);
 
+  /**
+   * @brief Create a canvas drawing into an offscreen GPU render target
+   * @param context The GPU context, its GL context must be current
+   * @return A new canvas, or nullptr if the render target cannot be created
+   */
+  static Canvas *CreateGPU(GPUContext *context, int width, int height);
+
+  /**
+   * @brief Create a canvas drawing into a GL framebuffer
+   * @param context The GPU context, its GL context must be current
+   * @param framebuffer The framebuffer object, 0 for the current window surface
+   * @param sample_count Samples per pixel of the framebuffer
+   * @param stencil_bits Stencil bits of the framebuffer
+   * @return A new canvas, or nullptr if the framebuffer cannot be wrapped
+   */
+  static Canvas *CreateGPUFramebuffer(GPUContext *context,
+                                      int width,
+                                      int height,
+                                      unsigned int framebuffer = 0,
+                                      int sample_count = 0,
+                                      int stencil_bits = 0);
+
   /**
    * @brief Create an empty canvas with no backing device/pixels, and zero dimentions
    */
@@ -101,8 +127,32 @@ class Canvas {
 
   void DrawText(const void *text, size_t byte_length, float x, float y, const Paint &paint);
 
+  /**
+   * @brief Draw a prepared text layout
+   * @param layout The text layout
+   * @param x The left of the layout
+   * @param y The top of the layout
+   * @param paint The paint, the typeface and text size are taken from the layout
+   */
+  void DrawTextLayout(const TextLayout &layout, float x, float y, const Paint &paint);
+
   void DrawPaint(const Paint &paint);
 
+  /**
+   * @brief Play back the commands recorded in a picture
+   */
+  void DrawPicture(const Picture &picture);
+
+  /**
+   * @brief Draw the pixels of another canvas created with CreateGPU()
+   * @param canvas The source canvas, must use the same GPU context
+   * @param x The left of the pixels in this canvas
+   * @param y The top of the pixels in this canvas
+   *
+   * Does nothing if the source canvas does not own a render target.
+   */
+  void DrawCanvas(const Canvas &canvas, float x, float y);
+
   void Translate(float dx, float dy);
 
   void Scale(float sx, float sy);
@@ -158,6 +208,15 @@ class Canvas {
 
   void Flush();
 
+  /**
+   * @brief Copy pixels from the canvas into a bitmap
+   * @param bitmap A bitmap with allocated pixels
+   * @param src_x The left of the pixels to copy
+   * @param src_y The top of the pixels to copy
+   * @return true if the pixels are copied
+   */
+  bool ReadPixels(Bitmap *bitmap, int src_x = 0, int src_y = 0);
+
   const core::PointF &GetOrigin() const;
 
   SkCanvas *GetSkCanvas() const;
@@ -167,6 +226,11 @@ class Canvas {
   struct LockGuardNode;
   struct Private;
 
+  /**
+   * @brief Create a canvas drawing on a SkCanvas owned by others
+   */
+  explicit Canvas(SkCanvas *sk_canvas);
+
   std::unique_ptr<Private> p_;
 
 };
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_FONT_CACHE_HPP_
+#define SKLAND_GRAPHIC_FONT_CACHE_HPP_
+
+#include "font-style.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace skland {
+namespace graphic {
+
+class Font;
+class Typeface;
+
+/**
+ * @ingroup graphic
+ * @brief A process-wide cache of typefaces and fonts
+ *
+ * Resolving a typeface from a family name goes through fontconfig matching
+ * which is slow. Font and Typeface objects created with a family name look up
+ * this cache first, so each family/style pair is resolved only once, and
+ * fonts with the same typeface, size and flags share one SkFont instance.
+ *
+ * A list of fonts can be resolved in a background thread with WarmUp() before
+ * they are used, a lookup of a font being resolved waits for the result
+ * instead of resolving it again.
+ *
+ * Lookups are thread safe, WarmUp() and WaitForWarmUp() are supposed to be
+ * called in the main thread.
+ */
+class FontCache {
+
+  friend class Font;
+  friend class Typeface;
+
+ public:
+
+  FontCache() = delete;
+
+  /**
+   * @brief Add a font to the warm-up list
+   */
+  static void AddWarmUpFont(const char *family_name, FontStyle font_style = FontStyle());
+
+  /**
+   * @brief Resolve all fonts in the warm-up list
+   * @param async If true, resolve in a background thread and return immediately
+   */
+  static void WarmUp(bool async = true);
+
+  /**
+   * @brief Wait for the background warm-up to finish
+   */
+  static void WaitForWarmUp();
+
+  static size_t GetTypefaceCount();
+
+  static size_t GetFontCount();
+
+  /**
+   * @brief Count of typeface lookups found in cache
+   */
+  static uint64_t GetHitCount();
+
+  /**
+   * @brief Count of typeface lookups resolved with fontconfig
+   */
+  static uint64_t GetMissCount();
+
+  /**
+   * @brief Bytes used by the glyph cache in Skia
+   */
+  static size_t GetGlyphCacheUsage();
+
+  /**
+   * @brief Drop all cached typefaces and fonts
+   *
+   * Font and Typeface objects still hold their own references.
+   */
+  static void Clear();
+
+ private:
+
+  struct Private;
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_FONT_CACHE_HPP_
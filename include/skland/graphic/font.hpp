@@ -18,6 +18,7 @@
 #define SKLAND_GRAPHIC_FONT_HPP_
 
 #include "../core/types.hpp"
+#include "../core/fast-pimpl.hpp"
 
 #include "font-style.hpp"
 #include "typeface.hpp"
@@ -152,7 +153,7 @@ class Font {
 
   struct Private;
 
-  std::unique_ptr<Private> p_;
+  core::FastPimpl<Private, sizeof(void *), alignof(void *)> p_;
 
 };
 
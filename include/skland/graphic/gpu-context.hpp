@@ -0,0 +1,107 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_GPU_CONTEXT_HPP_
+#define SKLAND_GRAPHIC_GPU_CONTEXT_HPP_
+
+#include "../core/defines.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace skland {
+namespace graphic {
+
+class Canvas;
+
+/**
+ * @ingroup graphic
+ * @brief The GPU backend used by GPU canvases
+ *
+ * A GPUContext is created on the OpenGL or OpenGL ES context current in the
+ * calling thread, and the same GL context must be current whenever a canvas
+ * created with it draws or flushes. Textures, glyph atlases and gradient
+ * tables are cached in the context and shared by all of its canvases.
+ */
+class GPUContext {
+
+  friend class Canvas;
+
+ public:
+
+  typedef void (*GLProc)();
+
+  /**
+   * @brief Function type to look up a GL function, e.g. a wrapper of eglGetProcAddress
+   */
+  typedef GLProc (*GetGLProc)(void *data, const char *name);
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(GPUContext);
+
+  /**
+   * @brief Create a context on the GL context current in this thread
+   * @param get_proc Function to look up GL functions, nullptr to use the
+   *        native interface built in Skia
+   * @param data User data passed to get_proc
+   * @return A new object, or nullptr if the GPU backend is not available
+   */
+  static GPUContext *CreateGL(GetGLProc get_proc = nullptr, void *data = nullptr);
+
+  ~GPUContext();
+
+  /**
+   * @brief Submit all pending draw commands to GL
+   */
+  void Flush();
+
+  /**
+   * @brief Tell the context the GL state was changed by other code
+   */
+  void ResetState();
+
+  /**
+   * @brief Free all cached GPU resources
+   */
+  void FreeResources();
+
+  /**
+   * @brief Tell the context the GL context is lost
+   *
+   * No GL function is called after this, including in the destructor, call
+   * this before the GL context is destroyed.
+   */
+  void Abandon();
+
+  /**
+   * @brief Get the bytes of GPU resources cached
+   */
+  size_t GetResourceCacheUsage() const;
+
+ private:
+
+  struct Private;
+
+  GPUContext();
+
+  std::unique_ptr<Private> p_;
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_GPU_CONTEXT_HPP_
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_IMAGE_CACHE_HPP_
+#define SKLAND_GRAPHIC_IMAGE_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace skland {
+namespace graphic {
+
+/**
+ * @ingroup graphic
+ * @brief A process-wide cache of decoded images
+ *
+ * Bitmap::Load() and Bitmap::LoadAsync() decode image files with OIIO and keep
+ * the result here, keyed by the file path, its modification time and the
+ * requested size. An image is scaled down by halves (or a mipmap level stored
+ * in the file is picked) until it is no more than twice the requested size, so
+ * a thumbnail of a large photo costs a thumbnail worth of memory.
+ *
+ * The least recently used images are dropped when the memory budget is
+ * exceeded. Asynchronous loads run on a small pool of worker threads, requests
+ * for an image already being decoded wait for it instead of decoding again.
+ *
+ * All methods are thread safe.
+ */
+class ImageCache {
+
+  friend class Bitmap;
+
+ public:
+
+  ImageCache() = delete;
+
+  /**
+   * @brief Set the memory budget in bytes, default is 64MB
+   */
+  static void SetMemoryBudget(size_t budget);
+
+  static size_t GetMemoryBudget();
+
+  static size_t GetMemoryUsage();
+
+  static size_t GetCount();
+
+  static uint64_t GetHitCount();
+
+  static uint64_t GetMissCount();
+
+  /**
+   * @brief Number of asynchronous loads queued or being decoded
+   */
+  static size_t GetPendingCount();
+
+  /**
+   * @brief Block until all asynchronous loads finished
+   */
+  static void WaitForIdle();
+
+  static void Clear();
+
+ private:
+
+  struct Private;
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_IMAGE_CACHE_HPP_
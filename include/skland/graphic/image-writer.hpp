@@ -0,0 +1,96 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_IMAGE_WRITER_HPP_
+#define SKLAND_GRAPHIC_IMAGE_WRITER_HPP_
+
+#include "../core/defines.hpp"
+
+#include <memory>
+#include <string>
+
+namespace skland {
+namespace graphic {
+
+class Bitmap;
+
+/**
+ * @ingroup graphic
+ * @brief Encodes a snapshot of a bitmap to an image file
+ *
+ * The constructor copies the pixels of the given bitmap, so the bitmap (e.g. a
+ * shared memory buffer of a window) can be drawn again right away. Write() does
+ * not touch the source bitmap and can run on a worker thread, the rows are
+ * converted and written to the file in small chunks.
+ */
+class ImageWriter {
+
+ public:
+
+  enum Format {
+    kFormatAuto,  /**< Guess the format from the file name */
+    kFormatPNG,
+    kFormatJPEG,
+    kFormatEXR
+  };
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(ImageWriter);
+  ImageWriter() = delete;
+
+  /**
+   * @brief Take a snapshot of the bitmap
+   */
+  explicit ImageWriter(const Bitmap &bitmap);
+
+  ~ImageWriter();
+
+  /**
+   * @brief Encode the snapshot to a file
+   * @param filename The file to write
+   * @param format The file format
+   * @return true if the file was written
+   */
+  bool Write(const std::string &filename, Format format = kFormatAuto) const;
+
+  /**
+   * @brief Set the JPEG compression quality in range [1, 100], default is 90
+   */
+  void SetQuality(int quality);
+
+  int GetQuality() const;
+
+  int GetWidth() const;
+
+  int GetHeight() const;
+
+  /**
+   * @brief Encode the pixels of a bitmap in place without taking a snapshot
+   */
+  static bool Write(const Bitmap &bitmap, const std::string &filename, Format format = kFormatAuto, int quality = 90);
+
+ private:
+
+  struct Private;
+
+  std::unique_ptr<Private> p_;
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_IMAGE_WRITER_HPP_
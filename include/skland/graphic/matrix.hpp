@@ -17,6 +17,8 @@
 #ifndef SKLAND_GRAPHIC_MATRIX_HPP_
 #define SKLAND_GRAPHIC_MATRIX_HPP_
 
+#include "../core/fast-pimpl.hpp"
+
 #include <memory>
 
 class SkMatrix;
@@ -48,7 +50,7 @@ class Matrix {
 
   struct Private;
 
-  std::unique_ptr<Private> p_;
+  core::FastPimpl<Private, 48, alignof(void *)> p_;
 
 };
 
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_PAINT_CACHE_HPP_
+#define SKLAND_GRAPHIC_PAINT_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace skland {
+namespace graphic {
+
+class Paint;
+class GradientShader;
+
+/**
+ * @ingroup graphic
+ * @brief A process-wide table of interned paints and gradient shaders
+ *
+ * Gradient shaders created by GradientShader without a local matrix are
+ * looked up by their parameters first, so drawing the same gradient in every
+ * frame or in several windows shares one SkShader, and Skia builds its color
+ * table only once.
+ *
+ * Intern() returns a handle of an immutable paint equal to the given one,
+ * keyed by Paint::GetHash(). The hash includes the address of the shader and
+ * typeface, so paints using an interned shader hash the same. Views keep the
+ * handles and draw with them in every frame.
+ *
+ * Both tables keep the most recently used entries up to the same capacity.
+ * A handle keeps its paint alive after the paint is evicted or Clear() is
+ * called, it's just no longer shared with new lookups.
+ *
+ * All functions are thread safe.
+ */
+class PaintCache {
+
+  friend class GradientShader;
+
+ public:
+
+  PaintCache() = delete;
+
+  /**
+   * @brief Get the interned paint equal to the given one
+   * @return A shared handle of the interned paint
+   */
+  static std::shared_ptr<const Paint> Intern(const Paint &paint);
+
+  static size_t GetPaintCount();
+
+  static size_t GetShaderCount();
+
+  /**
+   * @brief Set the max count of interned paints and of cached gradient
+   * shaders, 256 by default
+   *
+   * A capacity of 0 disables both tables, Intern() then returns a new paint.
+   */
+  static void SetCapacity(size_t capacity);
+
+  static size_t GetCapacity();
+
+  /**
+   * @brief Count of paint and shader lookups found in cache
+   */
+  static uint64_t GetHitCount();
+
+  /**
+   * @brief Count of paint and shader lookups missed
+   */
+  static uint64_t GetMissCount();
+
+  /**
+   * @brief Drop all interned paints and cached shaders
+   *
+   * Handles returned by Intern(), Shader and Paint objects still hold their
+   * own references.
+   */
+  static void Clear();
+
+ private:
+
+  struct Private;
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_PAINT_CACHE_HPP_
@@ -18,6 +18,7 @@
 #define SKLAND_GRAPHIC_PAINT_HPP_
 
 #include "../core/color.hpp"
+#include "../core/fast-pimpl.hpp"
 #include "font.hpp"
 
 #include <cstdint>
@@ -140,7 +141,7 @@ class Paint {
 
   struct Private;
 
-  std::unique_ptr<Private> p_;
+  core::FastPimpl<Private, 16 * sizeof(void *), alignof(void *)> p_;
 };
 
 bool operator==(const Paint &paint1, const Paint &paint2);
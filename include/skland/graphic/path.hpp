@@ -18,6 +18,7 @@
 #define SKLAND_GRAPHIC_PATH_HPP_
 
 #include "skland/core/rect.hpp"
+#include "skland/core/fast-pimpl.hpp"
 
 #include <memory>
 
@@ -139,7 +140,7 @@ class Path {
 
   struct Private;
 
-  std::unique_ptr<Private> p_;
+  core::FastPimpl<Private, 4 * sizeof(void *), alignof(void *)> p_;
 };
 
 bool operator==(const Path &path1, const Path &path2);
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_PICTURE_RECORDER_HPP_
+#define SKLAND_GRAPHIC_PICTURE_RECORDER_HPP_
+
+#include "picture.hpp"
+
+#include "skland/core/defines.hpp"
+
+namespace skland {
+namespace graphic {
+
+class Canvas;
+
+/**
+ * @ingroup graphic
+ * @brief Records drawing commands into a Picture
+ *
+ * Drawing on the canvas returned by BeginRecording() appends commands to a
+ * compact buffer instead of rasterizing, so the expensive part can be done
+ * later or in another thread by playing the picture back:
+ *
+ * @code
+ * PictureRecorder recorder;
+ * Canvas *canvas = recorder.BeginRecording(RectF::MakeFromXYWH(0.f, 0.f, 400.f, 300.f));
+ * canvas->DrawRect(rect, paint);
+ * Picture picture = recorder.FinishRecording();
+ * @endcode
+ */
+class PictureRecorder {
+
+ public:
+
+  using RectF = core::RectF;
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(PictureRecorder);
+
+  PictureRecorder();
+
+  ~PictureRecorder();
+
+  /**
+   * @brief Start recording
+   * @param bounds The bounds of the picture, commands outside may be culled
+   * @return A canvas which is valid until FinishRecording()
+   */
+  Canvas *BeginRecording(const RectF &bounds);
+
+  /**
+   * @brief Get the canvas being recorded, or nullptr if not recording
+   */
+  Canvas *GetRecordingCanvas() const;
+
+  /**
+   * @brief Stop recording and return the picture
+   */
+  Picture FinishRecording();
+
+ private:
+
+  struct Private;
+
+  std::unique_ptr<Private> p_;
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_PICTURE_RECORDER_HPP_
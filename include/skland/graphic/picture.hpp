@@ -0,0 +1,84 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_PICTURE_HPP_
+#define SKLAND_GRAPHIC_PICTURE_HPP_
+
+#include "skland/core/rect.hpp"
+
+#include <memory>
+
+namespace skland {
+namespace graphic {
+
+/**
+ * @ingroup graphic
+ * @brief A recorded list of drawing commands
+ *
+ * A picture is created by PictureRecorder and played back with
+ * Canvas::DrawPicture(). It's immutable and copying a picture only copies a
+ * reference, so it can be recorded in one thread and played back in another.
+ */
+class Picture {
+
+  friend class Canvas;
+  friend class PictureRecorder;
+
+ public:
+
+  using RectF = core::RectF;
+
+  /**
+   * @brief Create an empty picture
+   */
+  Picture();
+
+  Picture(const Picture &other);
+
+  Picture &operator=(const Picture &other);
+
+  ~Picture();
+
+  bool IsEmpty() const;
+
+  /**
+   * @brief Get the bounds given when the picture was recorded
+   */
+  RectF GetCullRect() const;
+
+  /**
+   * @brief Get the approximate number of drawing commands
+   */
+  int GetCommandCount() const;
+
+  /**
+   * @brief Get the approximate memory size of the commands in bytes
+   */
+  size_t GetMemorySize() const;
+
+ private:
+
+  struct Private;
+
+  std::unique_ptr<Private> p_;
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_PICTURE_HPP_
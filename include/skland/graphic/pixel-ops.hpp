@@ -0,0 +1,110 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_PIXEL_OPS_HPP_
+#define SKLAND_GRAPHIC_PIXEL_OPS_HPP_
+
+#include "../core/defines.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace skland {
+namespace graphic {
+
+/**
+ * @ingroup graphic
+ * @brief Kernels working on buffers of 32-bit pixels
+ *
+ * Pixels are in ARGB8888 format (0xAARRGGBB in a uint32_t) unless noted. The
+ * source and destination of a kernel may be the same buffer.
+ *
+ * The fastest implementation supported by the CPU (SSE2, AVX2 or NEON) is
+ * selected at runtime, all implementations give the same result as the
+ * scalar one bit by bit.
+ */
+class PixelOps {
+
+ public:
+
+  enum Implementation {
+    kImplementationScalar,
+    kImplementationSSE2,
+    kImplementationAVX2,
+    kImplementationNEON,
+
+    kImplementationCount
+  };
+
+  PixelOps() = delete;
+
+  /**
+   * @brief Multiply the color channels by alpha
+   */
+  static void Premultiply(const uint32_t *src, uint32_t *dst, size_t count);
+
+  /**
+   * @brief Divide the color channels by alpha, pixels with 0 alpha become 0
+   */
+  static void Unpremultiply(const uint32_t *src, uint32_t *dst, size_t count);
+
+  /**
+   * @brief Swap the red and blue channels, e.g. to convert between BGRA and RGBA byte order
+   */
+  static void SwapRB(const uint32_t *src, uint32_t *dst, size_t count);
+
+  /**
+   * @brief Fill a buffer with a pixel value
+   */
+  static void Fill(uint32_t *dst, uint32_t color, size_t count);
+
+  /**
+   * @brief Blend premultiplied source pixels over the destination
+   */
+  static void BlendSrcOver(const uint32_t *src, uint32_t *dst, size_t count);
+
+  /**
+   * @brief Get the implementation in use
+   */
+  static Implementation GetImplementation();
+
+  /**
+   * @brief Force an implementation, used in tests and benchmarks
+   * @return false if the implementation is not supported by this CPU
+   */
+  static bool SetImplementation(Implementation implementation);
+
+  static bool IsSupported(Implementation implementation);
+
+  static const char *GetImplementationName(Implementation implementation);
+
+ private:
+
+  struct Kernels;
+
+  static const Kernels *GetKernels(Implementation implementation);
+
+  static const Kernels *kKernels;
+
+  static Implementation kImplementation;
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_PIXEL_OPS_HPP_
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_RASTER_THREAD_HPP_
+#define SKLAND_GRAPHIC_RASTER_THREAD_HPP_
+
+#include "skland/core/defines.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace skland {
+namespace graphic {
+
+class Canvas;
+class Picture;
+
+/**
+ * @ingroup graphic
+ * @brief A thread playing back recorded pictures into canvases
+ *
+ * Record a frame with PictureRecorder and submit it here, the calling thread
+ * can go on with the next frame while this one is rasterized. Pictures are
+ * played back in the order submitted.
+ */
+class RasterThread {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(RasterThread);
+
+  RasterThread();
+
+  /**
+   * @brief Destructor
+   *
+   * Pictures already submitted are still played back before the thread quits.
+   */
+  ~RasterThread();
+
+  /**
+   * @brief Queue a picture to be played back into a canvas
+   * @param picture The picture to play back
+   * @param canvas The target canvas, it must not be used in other threads
+   *        until the picture is done
+   * @param callback Called in the raster thread when the picture is done
+   */
+  void Submit(const Picture &picture, Canvas *canvas, const std::function<void()> &callback = nullptr);
+
+  /**
+   * @brief Block until all submitted pictures are done
+   */
+  void Wait();
+
+  /**
+   * @brief Number of pictures queued or being played back
+   */
+  size_t GetPendingCount() const;
+
+ private:
+
+  struct Private;
+
+  std::unique_ptr<Private> p_;
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_RASTER_THREAD_HPP_
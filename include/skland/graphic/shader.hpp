@@ -17,6 +17,8 @@
 #ifndef SKLAND_GRAPHIC_SHADER_HPP_
 #define SKLAND_GRAPHIC_SHADER_HPP_
 
+#include "../core/fast-pimpl.hpp"
+
 #include <memory>
 
 namespace skland {
@@ -34,6 +36,9 @@ class Shader {
   friend class Paint;
   friend class GradientShader;
 
+  friend bool operator==(const Shader &shader1, const Shader &shader2);
+  friend bool operator!=(const Shader &shader1, const Shader &shader2);
+
  public:
 
   enum TileMode {
@@ -56,14 +61,24 @@ class Shader {
 
   struct Private;
 
-  explicit Shader(Private *p);
+  explicit Shader(const Private &p);
 
  private:
 
-  std::unique_ptr<Private> p_;
+  core::FastPimpl<Private, sizeof(void *), alignof(void *)> p_;
 
 };
 
+/**
+ * @brief Check if two shaders share the same SkShader
+ *
+ * Gradient shaders created with the same parameters are equal as they are
+ * interned in PaintCache.
+ */
+bool operator==(const Shader &shader1, const Shader &shader2);
+
+bool operator!=(const Shader &shader1, const Shader &shader2);
+
 } // namespace graphic
 } // namespace skland
 
@@ -27,6 +27,13 @@ namespace graphic {
 class Canvas;
 class Paint;
 
+/**
+ * @ingroup graphic
+ * @brief Draw a text in a box with line breaks
+ *
+ * The text is laid out with TextLayoutCache, a text box drawn again with the
+ * same text and paint reuses the layout instead of shaping the text.
+ */
 class TextBox {
 
  public:
@@ -78,6 +85,11 @@ class TextBox {
 
   float GetTextHeight() const;
 
+  /**
+   * @brief The width of the longest line
+   */
+  float GetTextWidth() const;
+
  private:
 
   struct Private;
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_TEXT_LAYOUT_HPP_
+#define SKLAND_GRAPHIC_TEXT_LAYOUT_HPP_
+
+#include "../core/defines.hpp"
+
+#include <memory>
+#include <string>
+#include <cstdint>
+
+namespace skland {
+namespace graphic {
+
+class Canvas;
+class Font;
+class Paint;
+class TextBox;
+
+/**
+ * @ingroup graphic
+ * @brief A prepared layout of a text with glyph IDs, positions and line breaks
+ *
+ * A TextLayout is immutable once created, it's usually shared through
+ * TextLayoutCache and drawn with Canvas::DrawTextLayout().
+ *
+ * Glyph positions are relative to the top-left of the layout, in pixels.
+ * Lines are broken at '\n' and, if a box width is given, wrapped to fit in
+ * the box.
+ */
+class TextLayout {
+
+  friend class Canvas;
+  friend class TextBox;
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(TextLayout);
+
+  TextLayout() = delete;
+
+  /**
+   * @brief Shape and break a UTF-8 text
+   * @param text The UTF-8 text
+   * @param byte_length Length of text in bytes
+   * @param font The font, its size is used as the text size
+   * @param box_width Maximal width of a line before the scale, 0 for one line layout
+   * @param scale The output scale applied to the text size and box width
+   */
+  TextLayout(const char *text, size_t byte_length, const Font &font, float box_width = 0.f, float scale = 1.f);
+
+  /**
+   * @brief Shape and break a UTF-8 text with the typeface and text size of a paint
+   * @param text The UTF-8 text
+   * @param byte_length Length of text in bytes
+   * @param paint The paint
+   * @param box_width Maximal width of a line, 0 for no wrapping
+   * @param spacing_mul Multiplier of the font height between lines
+   * @param spacing_add Extra space between lines
+   */
+  TextLayout(const char *text, size_t byte_length, const Paint &paint,
+             float box_width = 0.f, float spacing_mul = 1.f, float spacing_add = 0.f);
+
+  ~TextLayout();
+
+  int GetGlyphCount() const;
+
+  int CountLines() const;
+
+  /**
+   * @brief The width of the longest line in pixels
+   */
+  float GetWidth() const;
+
+  /**
+   * @brief The height of all lines in pixels
+   *
+   * This is the font height plus the line spacing of each line after the first.
+   */
+  float GetHeight() const;
+
+  /**
+   * @brief Estimated memory used by this object in bytes
+   */
+  size_t GetMemorySize() const;
+
+ private:
+
+  struct Private;
+
+  std::unique_ptr<Private> p_;
+
+};
+
+/**
+ * @ingroup graphic
+ * @brief A LRU cache of text layouts with a memory budget
+ *
+ * Layouts are keyed by the text, the typeface and size of the font, the box
+ * width and the scale. Least recently used layouts are evicted when the
+ * memory usage exceeds the budget, a layout still referenced elsewhere keeps
+ * alive until released.
+ *
+ * This cache is supposed to be used in the main thread only.
+ */
+class TextLayoutCache {
+
+ public:
+
+  TextLayoutCache() = delete;
+
+  /**
+   * @brief Find a cached layout or create a new one
+   *
+   * Parameters are the same as the constructor of TextLayout.
+   */
+  static std::shared_ptr<const TextLayout> Get(const std::string &text,
+                                               const Font &font,
+                                               float box_width = 0.f,
+                                               float scale = 1.f);
+
+  /**
+   * @brief Find a cached layout or create a new one with the text size of a paint
+   *
+   * Parameters are the same as the constructor of TextLayout.
+   */
+  static std::shared_ptr<const TextLayout> Get(const std::string &text,
+                                               const Paint &paint,
+                                               float box_width = 0.f,
+                                               float spacing_mul = 1.f,
+                                               float spacing_add = 0.f);
+
+  /**
+   * @brief Set the memory budget in bytes, default is 4MB
+   */
+  static void SetMemoryBudget(size_t budget);
+
+  static size_t GetMemoryBudget();
+
+  static size_t GetMemoryUsage();
+
+  static size_t GetCount();
+
+  static uint64_t GetHitCount();
+
+  static uint64_t GetMissCount();
+
+  static void Clear();
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_TEXT_LAYOUT_HPP_
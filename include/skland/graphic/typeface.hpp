@@ -19,6 +19,7 @@
 
 #include "../core/types.hpp"
 #include "../core/rect.hpp"
+#include "../core/fast-pimpl.hpp"
 
 #include "font-style.hpp"
 
@@ -109,7 +110,7 @@ class Typeface {
 
   struct Private;
 
-  std::unique_ptr<Private> p_;
+  core::FastPimpl<Private, sizeof(void *), alignof(void *)> p_;
 
 };
 
@@ -31,6 +31,7 @@ class KeyEvent;
 class Surface;
 class AbstractView;
 class Output;
+class ViewSlab;
 
 /**
  * @ingroup gui
@@ -58,6 +59,7 @@ SKLAND_EXPORT class AbstractEventHandler : public core::Trackable {
 
   friend class AbstractView;
   friend class AbstractShellView;
+  friend class ViewSlab;
 
  public:
 
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GUI_ABSTRACT_LIST_MODEL_HPP_
+#define SKLAND_GUI_ABSTRACT_LIST_MODEL_HPP_
+
+#include "skland/core/defines.hpp"
+#include "skland/core/sigcxx.hpp"
+
+namespace skland {
+namespace gui {
+
+class AbstractView;
+
+/**
+ * @ingroup gui
+ * @brief The base abstract class of data models used in ListView and GridView
+ *
+ * A list model provides the item count and creates/binds item views on
+ * demand. The list view only creates views for the visible items and reuses
+ * them when scrolling, so a model should never assume a view is bound to one
+ * index for its whole life.
+ *
+ * A model is not owned by the list view, it must outlive any view it was set
+ * to or be unset before destroyed.
+ */
+SKLAND_EXPORT class AbstractListModel : public core::Trackable {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(AbstractListModel);
+
+  AbstractListModel();
+
+  virtual ~AbstractListModel();
+
+  /**
+   * @brief Get the total count of items in this model
+   */
+  virtual int GetCount() const = 0;
+
+  /**
+   * @brief Get the view type of the item at index
+   *
+   * Views are only recycled between items of the same type. By default all
+   * items use type 0.
+   */
+  virtual int GetViewType(int index) const;
+
+  /**
+   * @brief Create a new item view of the given type
+   * @param type
+   * @return A new view created by new operator
+   */
+  virtual AbstractView *CreateView(int type) = 0;
+
+  /**
+   * @brief Bind the data at index to a created or recycled view
+   * @param view
+   * @param index
+   */
+  virtual void BindView(AbstractView *view, int index) = 0;
+
+  /**
+   * @brief Called when a view leaves the visible range and is put into the recycle pool
+   * @param view
+   * @param index
+   *
+   * By default this method does nothing.
+   */
+  virtual void UnbindView(AbstractView *view, int index);
+
+  /**
+   * @brief A signal emitted when the count or the content of items changed
+   */
+  core::SignalRef<> changed() { return changed_; }
+
+ protected:
+
+  /**
+   * @brief Emit the changed signal, call this in sub class when data changed
+   */
+  void NotifyChanged();
+
+ private:
+
+  core::Signal<> changed_;
+
+};
+
+} // namespace gui
+} // namespace skland
+
+#endif // SKLAND_GUI_ABSTRACT_LIST_MODEL_HPP_
@@ -30,6 +30,8 @@ namespace skland {
 namespace gui {
 
 class Context;
+class ViewGeometryStore;
+class ChromePathCache;
 
 /**
  * @ingroup gui
@@ -48,6 +50,7 @@ SKLAND_EXPORT class AbstractShellView : public AbstractEventHandler {
 
   friend class AbstractView;
   friend class Surface;
+  friend class Animation;
 
  public:
 
@@ -180,6 +183,14 @@ SKLAND_EXPORT class AbstractShellView : public AbstractEventHandler {
 
   AbstractShellView *GetParent() const;
 
+  /**
+   * @brief Get the bytes of memory used by this shell view
+   *
+   * Sum of the memory reported to core::MemoryStats with this shell view as
+   * the owner, e.g. the shared memory pools for its buffers.
+   */
+  size_t GetMemoryUsage() const;
+
   static const Margin kResizingMargin;
 
  protected:
@@ -271,6 +282,16 @@ SKLAND_EXPORT class AbstractShellView : public AbstractEventHandler {
 
   Surface *GetShellSurface() const;
 
+  /**
+   * @brief Get the flattened geometry store of the views attached to this shell view
+   */
+  ViewGeometryStore *GetViewGeometryStore() const;
+
+  /**
+   * @brief Get the cached paths and shadow of the window frame
+   */
+  ChromePathCache *GetChromePathCache() const;
+
   void DispatchMouseEnterEvent(AbstractView *view, MouseEvent *event);
 
   void DispatchMouseLeaveEvent();
@@ -34,6 +34,7 @@ namespace gui {
 class AbstractShellView;
 class AbstractLayout;
 class Context;
+class ViewSlab;
 
 /**
  * @ingroup gui
@@ -73,6 +74,8 @@ SKLAND_EXPORT class AbstractView : public AbstractEventHandler {
 
   friend class AbstractShellView;
   friend class AbstractLayout;
+  friend class ViewGeometryStore;
+  friend class ViewSlab;
 
  public:
 
@@ -386,6 +389,17 @@ SKLAND_EXPORT class AbstractView : public AbstractEventHandler {
 
   bool IsVisible() const;
 
+  /**
+   * @brief Declare if this view fills its whole geometry with opaque pixels
+   * @param opaque
+   *
+   * Opaque views are used to skip drawing views hidden under them and to
+   * calculate the opaque region of the surface. Default is false.
+   */
+  void SetOpaque(bool opaque);
+
+  bool IsOpaque() const;
+
   /**
    * @brief Add an anchor to target view for layout
    * @param target
@@ -630,6 +644,12 @@ SKLAND_EXPORT class AbstractView : public AbstractEventHandler {
    */
   void ClearChildren();
 
+  /**
+   * @brief Draw another view and its visible sub views, for containers which
+   * draw their children in OnDraw()
+   */
+  static void Draw(AbstractView *view, const Context &context);
+
   static bool SwapIndex(AbstractView *view1, AbstractView *view2);
 
   static bool InsertSiblingBefore(AbstractView *src, AbstractView *dst);
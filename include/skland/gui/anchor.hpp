@@ -19,6 +19,7 @@
 
 #include "skland/core/types.hpp"
 #include "skland/core/defines.hpp"
+#include "skland/core/slab-allocator.hpp"
 
 #include <utility>
 #include <memory>
@@ -32,8 +33,10 @@ class AnchorGroup;
 /**
  * @ingroup gui
  * @brief Used to align views in layout
+ *
+ * Anchors are allocated from the slab of ViewSlab if there's one.
  */
-class Anchor {
+class Anchor : public core::SlabObject<Anchor> {
 
   friend class AnchorGroup;
 
@@ -0,0 +1,311 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SKLAND_GUI_ANIMATION_HPP_
+#define SKLAND_GUI_ANIMATION_HPP_
+
+#include "../core/sigcxx.hpp"
+#include "../core/rect.hpp"
+#include "../core/color.hpp"
+
+#include <memory>
+
+namespace skland {
+namespace gui {
+
+class AbstractView;
+class Surface;
+
+/**
+ * @ingroup gui
+ * @brief Easing curves used to map the linear progress of an animation
+ */
+enum EasingCurve {
+  kEasingLinear,
+  kEasingInQuad,
+  kEasingOutQuad,
+  kEasingInOutQuad,
+  kEasingInCubic,
+  kEasingOutCubic,
+  kEasingInOutCubic
+};
+
+/**
+ * @ingroup gui
+ * @brief Linear interpolation between 2 float values
+ */
+inline float Interpolate(float from, float to, float progress) {
+  return from + (to - from) * progress;
+}
+
+/**
+ * @ingroup gui
+ * @brief Linear interpolation between 2 rectangles
+ */
+inline core::RectF Interpolate(const core::RectF &from, const core::RectF &to, float progress) {
+  return core::RectF(Interpolate(from.left, to.left, progress),
+                     Interpolate(from.top, to.top, progress),
+                     Interpolate(from.right, to.right, progress),
+                     Interpolate(from.bottom, to.bottom, progress));
+}
+
+/**
+ * @ingroup gui
+ * @brief Linear interpolation between 2 colors
+ */
+inline core::ColorF Interpolate(const core::ColorF &from, const core::ColorF &to, float progress) {
+  return core::ColorF(Interpolate(from.r, to.r, progress),
+                      Interpolate(from.g, to.g, progress),
+                      Interpolate(from.b, to.b, progress),
+                      Interpolate(from.a, to.a, progress));
+}
+
+/**
+ * @ingroup gui
+ * @brief The abstract class of animations driven by the frame clock
+ *
+ * All running animations are stepped together once per frame from the frame
+ * callback of the shell surface showing the target view, so any number of
+ * animations costs a single wake-up per frame. The frame request goes with the
+ * next commit of the window, a timer with the refresh rate of the output is
+ * used instead if the target view is not shown yet, or if the frame does not
+ * come within 2 refresh periods (nothing was redrawn, or the surface was hidden
+ * or destroyed).
+ *
+ * Subclasses implement OnStep() to apply the eased progress and return if the
+ * animated value changed, the target view is updated only in this case.
+ */
+SKLAND_EXPORT class Animation : public core::Trackable {
+
+  friend class Application;
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(Animation);
+
+  template<typename ... ParamTypes>
+  using SignalRef = typename core::SignalRef<ParamTypes...>;
+
+  template<typename ... ParamTypes>
+  using Signal = typename core::Signal<ParamTypes...>;
+
+  /**
+   * @brief Constructor
+   * @param view The target view to be updated, can be nullptr
+   */
+  explicit Animation(AbstractView *view = nullptr);
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~Animation();
+
+  /**
+   * @brief Start or restart this animation from the beginning
+   *
+   * The animation begins at the next frame.
+   */
+  void Start();
+
+  /**
+   * @brief Stop this animation at the current value
+   */
+  void Stop();
+
+  bool IsRunning() const;
+
+  /**
+   * @brief Set the duration of one loop
+   * @param duration Duration in milliseconds
+   */
+  void SetDuration(unsigned int duration);
+
+  unsigned int GetDuration() const;
+
+  void SetEasingCurve(EasingCurve curve);
+
+  EasingCurve GetEasingCurve() const;
+
+  /**
+   * @brief Set how many times this animation runs
+   * @param count Loop count, a negative value repeats forever
+   */
+  void SetLoopCount(int count);
+
+  int GetLoopCount() const;
+
+  /**
+   * @brief Set the target view to be updated when the animated value changes
+   * @param view
+   */
+  void SetTarget(AbstractView *view);
+
+  AbstractView *GetTarget() const;
+
+  /**
+   * @brief Get the eased progress of the last step, in [0, 1]
+   */
+  float GetProgress() const;
+
+  /**
+   * @brief A signal emitted when the animation reaches the end
+   */
+  SignalRef<> finished() { return finished_; }
+
+  /**
+   * @brief Map a linear progress in [0, 1] with an easing curve
+   */
+  static float Ease(EasingCurve curve, float progress);
+
+  /**
+   * @brief Step all running animations
+   * @param time Current time in nanoseconds
+   *
+   * This is called by the frame clock, you usually don't need to call it.
+   */
+  static void Tick(uint64_t time);
+
+  /**
+   * @brief Get the count of running animations
+   */
+  static int GetRunningCount();
+
+ protected:
+
+  /**
+   * @brief Apply the progress of this animation
+   * @param progress The eased progress
+   * @return true if the animated value changed
+   */
+  virtual bool OnStep(float progress) = 0;
+
+  /**
+   * @brief Schedule an update of the target view
+   */
+  void UpdateTarget();
+
+ private:
+
+  struct Private;
+  class FrameClock;
+
+  /**
+   * @brief Calculate the progress at the given time and call OnStep()
+   */
+  void Step(uint64_t time);
+
+  void OnViewDestroyed(AbstractView *view, __SLOT__);
+
+  static Surface *GetSurfaceOf(const AbstractView *view);
+
+  static int GetRefreshRateHint();
+
+  std::unique_ptr<Private> p_;
+
+  Signal<> finished_;
+
+};
+
+/**
+ * @ingroup gui
+ * @brief An animation interpolating a value between 2 ends
+ * @tparam T The value type, Interpolate() must be overloaded for it
+ */
+template<typename T>
+class ValueAnimation : public Animation {
+
+ public:
+
+  explicit ValueAnimation(AbstractView *view = nullptr)
+      : Animation(view) {}
+
+  virtual ~ValueAnimation() {}
+
+  void SetRange(const T &from, const T &to) {
+    from_ = from;
+    to_ = to;
+  }
+
+  const T &GetFrom() const { return from_; }
+
+  const T &GetTo() const { return to_; }
+
+  /**
+   * @brief Get the interpolated value of the last step
+   */
+  const T &GetValue() const { return value_; }
+
+  /**
+   * @brief A signal emitted in a step when the interpolated value changes
+   */
+  SignalRef<const T &> changed() { return changed_; }
+
+ protected:
+
+  virtual bool OnStep(float progress) override {
+    T value = Interpolate(from_, to_, progress);
+    if (value == value_) return false;
+
+    value_ = value;
+    changed_.Emit(value_);
+    OnValueChanged();
+    return true;
+  }
+
+  /**
+   * @brief Apply the new value, the default implementation updates the target view
+   */
+  virtual void OnValueChanged() {
+    UpdateTarget();
+  }
+
+ private:
+
+  T from_ = T();
+  T to_ = T();
+  T value_ = T();
+
+  Signal<const T &> changed_;
+
+};
+
+typedef ValueAnimation<float> OpacityAnimation;
+
+typedef ValueAnimation<core::ColorF> ColorAnimation;
+
+/**
+ * @ingroup gui
+ * @brief An animation moving and resizing the target view
+ */
+SKLAND_EXPORT class GeometryAnimation : public ValueAnimation<core::RectF> {
+
+ public:
+
+  explicit GeometryAnimation(AbstractView *view = nullptr)
+      : ValueAnimation<core::RectF>(view) {}
+
+  virtual ~GeometryAnimation() {}
+
+ protected:
+
+  virtual void OnValueChanged() override;
+
+};
+
+} // namespace gui
+} // namespace skland
+
+#endif // SKLAND_GUI_ANIMATION_HPP_
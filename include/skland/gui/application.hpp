@@ -21,6 +21,7 @@
 #include <thread>
 
 #include "skland/core/deque.hpp"
+#include "skland/core/signal-queue.hpp"
 #include "task.hpp"
 #include "display.hpp"
 
@@ -35,6 +36,8 @@ class AbstractEpollTask;
  */
 SKLAND_EXPORT class Application {
 
+  friend class Animation;
+
  public:
 
   SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(Application);
@@ -106,6 +109,14 @@ SKLAND_EXPORT class Application {
    */
   static core::Deque<Task> &GetTaskDeque();
 
+  /**
+   * @brief Get the queue delivering queued signals to the main loop
+   *
+   * This is also the current SignalQueue of the main thread, a
+   * Signal::ConnectQueued() in the main thread uses it by default.
+   */
+  static core::SignalQueue *GetSignalQueue();
+
  private:
 
   class EpollTask;
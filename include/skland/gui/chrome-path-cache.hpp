@@ -0,0 +1,184 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GUI_CHROME_PATH_CACHE_HPP_
+#define SKLAND_GUI_CHROME_PATH_CACHE_HPP_
+
+#include "../core/defines.hpp"
+#include "../core/color.hpp"
+#include "../core/rect.hpp"
+#include "../graphic/path.hpp"
+#include "../graphic/paint.hpp"
+
+namespace skland {
+
+namespace graphic {
+class Canvas;
+}
+
+namespace gui {
+
+/**
+ * @ingroup gui
+ * @brief Cached paths of the window chrome
+ *
+ * Each shape keeps the path built for the last key (size, scale, maximized),
+ * Get() returns the same immutable path without any allocation until the key
+ * changes. DrawInner() and DrawOutline() draw the cached paths with a paint
+ * kept in this object, DrawShadow() draws the theme shadow image with the
+ * rects kept for the last size and focus, so a steady-state repaint of the
+ * chrome does not allocate either.
+ *
+ * The glyphs of title bar buttons do not depend on the window and are built
+ * once for all windows.
+ */
+class ChromePathCache {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(ChromePathCache);
+
+  enum Shape {
+    /** The window background, a round rect or a rect if maximized */
+    kShapeWindowInner,
+    /** The outline of a normal window, inset by half a pixel */
+    kShapeWindowOutline,
+
+    kShapeCount
+  };
+
+  enum Glyph {
+    kGlyphClose,
+    kGlyphMaximize,
+    kGlyphMinimize,
+    kGlyphFullscreen,
+
+    kGlyphCount
+  };
+
+  /**
+   * @brief Corner radii of a window in logical pixels
+   *
+   * In the order of top-left, top-right, bottom-right, bottom-left.
+   */
+  static const float kWindowRadii[8];
+
+  ChromePathCache() = default;
+
+  ~ChromePathCache() = default;
+
+  /**
+   * @brief Get the path of a shape
+   * @param shape The shape
+   * @param width Width of the window in logical pixels
+   * @param height Height of the window in logical pixels
+   * @param scale The output scale
+   * @param maximized If the window is maximized or fullscreen
+   * @return A path in device pixels
+   */
+  const graphic::Path &Get(Shape shape, int width, int height, int scale, bool maximized);
+
+  /**
+   * @brief Fill the window background clipped by the inner path
+   * @param canvas The canvas of the window surface
+   * @param color The background color
+   */
+  void DrawInner(graphic::Canvas *canvas, const core::ColorF &color,
+                 int width, int height, int scale, bool maximized);
+
+  /**
+   * @brief Stroke the outline of a normal window
+   * @param canvas The canvas of the window surface
+   * @param color The outline color
+   */
+  void DrawOutline(graphic::Canvas *canvas, const core::ColorF &color,
+                   int width, int height, int scale);
+
+  /**
+   * @brief Draw the drop shadow around a normal window
+   * @param canvas The canvas of the window surface
+   * @param focused The shadow of a focused window is larger
+   */
+  void DrawShadow(graphic::Canvas *canvas, int width, int height, int scale, bool focused);
+
+  /**
+   * @brief Get the glyph of a title bar button
+   * @return A path centered at the origin in logical pixels
+   */
+  static const graphic::Path &GetGlyph(Glyph glyph);
+
+  /**
+   * @brief Count of paths built since created
+   */
+  int GetBuildCount() const { return build_count_; }
+
+ private:
+
+  struct Entry {
+
+    bool valid = false;
+
+    int width = 0;
+
+    int height = 0;
+
+    int scale = 0;
+
+    bool maximized = false;
+
+    graphic::Path path;
+
+  };
+
+  struct Shadow {
+
+    bool valid = false;
+
+    int width = 0;
+
+    int height = 0;
+
+    int radius = 0;
+
+    bool focused = false;
+
+    /** Rects of the 8 parts in the shadow image */
+    core::RectF src[8];
+
+    /** Rects of the 8 parts around the window in logical pixels */
+    core::RectF dst[8];
+
+  };
+
+  static void Build(Shape shape, Entry *entry);
+
+  static void BuildShadow(Shadow *shadow);
+
+  Entry entries_[kShapeCount];
+
+  Shadow shadow_;
+
+  int build_count_ = 0;
+
+  graphic::Paint paint_;
+
+};
+
+} // namespace gui
+} // namespace skland
+
+#endif // SKLAND_GUI_CHROME_PATH_CACHE_HPP_
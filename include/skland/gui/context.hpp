@@ -20,6 +20,8 @@
 #include "surface.hpp"
 #include "callback.hpp"
 
+#include "skland/core/arena.hpp"
+
 namespace skland {
 
 namespace graphic {
@@ -62,6 +64,14 @@ class Context {
 
   void set_canvas(Canvas *canvas) { canvas_ = canvas; }
 
+  /**
+   * @brief The arena for temporaries of the current frame
+   *
+   * Use it with core::ArenaAllocator for containers only needed while drawing,
+   * it's reset after the surface is committed.
+   */
+  core::Arena *arena() const { return surface_->GetFrameArena(); }
+
  private:
 
   Surface *surface_ = nullptr;
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GUI_FRAME_STATS_HPP_
+#define SKLAND_GUI_FRAME_STATS_HPP_
+
+#include <cstdint>
+
+namespace skland {
+namespace gui {
+
+/**
+ * @ingroup gui
+ * @brief Statistics of the rendering of a shell view
+ *
+ * The per-frame counters are reset at the beginning of each frame and hold the
+ * values of the last rendered frame.
+ */
+struct FrameStats {
+
+  /**
+   * @brief Total count of rendered frames
+   */
+  uint64_t frame_count = 0;
+
+  /**
+   * @brief Count of views drawn in the last frame
+   */
+  int drawn_views = 0;
+
+  /**
+   * @brief Count of views skipped in the last frame because they are hidden or out of the surface
+   */
+  int culled_offscreen_views = 0;
+
+  /**
+   * @brief Count of views skipped in the last frame because they are covered by opaque views
+   */
+  int culled_occluded_views = 0;
+
+  /**
+   * @brief Total count of culled views in all frames
+   */
+  uint64_t total_culled_views = 0;
+
+  /**
+   * @brief Reset the per-frame counters and count a new frame
+   */
+  void BeginFrame() {
+    frame_count++;
+    drawn_views = 0;
+    culled_offscreen_views = 0;
+    culled_occluded_views = 0;
+  }
+
+};
+
+} // namespace gui
+} // namespace skland
+
+#endif // SKLAND_GUI_FRAME_STATS_HPP_
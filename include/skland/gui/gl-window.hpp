@@ -77,6 +77,14 @@ class GLWindow : public AbstractShellView {
 
   void SwapBuffers();
 
+  /**
+   * @brief Get a canvas to draw on the GL surface with the Skia GL backend
+   * @return The canvas, or nullptr if the GL backend is not available
+   *
+   * @see GLESV2API::GetCanvas()
+   */
+  graphic::Canvas *GetCanvas();
+
  private:
 
   struct Private;
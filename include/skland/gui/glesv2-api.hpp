@@ -20,6 +20,11 @@
 #include "abstract-rendering-api.hpp"
 
 namespace skland {
+
+namespace graphic {
+class Canvas;
+}
+
 namespace gui {
 
 /**
@@ -42,6 +47,17 @@ class GLESV2API : public AbstractRenderingAPI {
 
   virtual void SwapBuffers() final;
 
+  /**
+   * @brief Get a canvas drawing on this surface with the Skia GL backend
+   *
+   * The EGL surface is made current. The canvas is kept until the viewport
+   * size changes, call Canvas::Flush() and SwapBuffers() after drawing.
+   *
+   * @return The canvas, or nullptr if the GL backend is not available, the
+   *         caller should draw with a raster canvas instead
+   */
+  graphic::Canvas *GetCanvas();
+
  protected:
 
   virtual void OnSetup(Surface *surface) final;
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GUI_GRID_VIEW_HPP_
+#define SKLAND_GUI_GRID_VIEW_HPP_
+
+#include "list-view.hpp"
+
+namespace skland {
+namespace gui {
+
+/**
+ * @ingroup gui
+ * @brief A virtualized view arranges items in fixed size cells
+ *
+ * The column count is calculated from the width of this view and the cell
+ * width, items are filled in rows.
+ */
+SKLAND_EXPORT class GridView : public ListView {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(GridView);
+
+  GridView();
+
+  GridView(int width, int height);
+
+  /**
+   * @brief Set the size of each cell
+   */
+  void SetCellSize(int width, int height);
+
+  int GetCellWidth() const { return cell_width_; }
+
+  int GetCellHeight() const { return GetItemHeight(); }
+
+ protected:
+
+  virtual ~GridView();
+
+  virtual int GetColumnCount() const final;
+
+  virtual RectF GetItemGeometry(int index) const final;
+
+  virtual int GetIndexAt(int x, int y) const final;
+
+ private:
+
+  int cell_width_;
+
+};
+
+} // namespace gui
+} // namespace skland
+
+#endif // SKLAND_GUI_GRID_VIEW_HPP_
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GUI_IMAGE_EXPORTER_HPP_
+#define SKLAND_GUI_IMAGE_EXPORTER_HPP_
+
+#include "../core/sigcxx.hpp"
+#include "../graphic/image-writer.hpp"
+
+#include <memory>
+#include <string>
+
+namespace skland {
+
+namespace graphic {
+class Bitmap;
+}
+
+namespace gui {
+
+/**
+ * @ingroup gui
+ * @brief Export a bitmap to an image file on a worker thread
+ *
+ * Start() takes a snapshot of the pixels on the calling thread and returns,
+ * the file is encoded on a worker thread and finished() is emitted in the main
+ * thread when it's done.
+ */
+class ImageExporter {
+
+ public:
+
+  using Format = graphic::ImageWriter::Format;
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(ImageExporter);
+
+  ImageExporter();
+
+  /**
+   * @brief Destructor
+   *
+   * Waits for the running export, finished() is not emitted.
+   */
+  ~ImageExporter();
+
+  /**
+   * @brief Start exporting a bitmap
+   * @param bitmap The bitmap to export, it can be changed once this method returns
+   * @param filename The image file to write
+   * @param format The file format, guessed from the file name by default
+   * @return false if an export is still running
+   */
+  bool Start(const graphic::Bitmap &bitmap,
+             const std::string &filename,
+             Format format = graphic::ImageWriter::kFormatAuto);
+
+  bool IsRunning() const;
+
+  /**
+   * @brief Set the JPEG compression quality in range [1, 100]
+   */
+  void SetQuality(int quality);
+
+  int GetQuality() const;
+
+  const std::string &GetFileName() const;
+
+  /**
+   * @brief A signal emitted in the main thread when an export finished
+   *
+   * The argument is true if the file was written.
+   */
+  core::SignalRef<bool> finished() { return finished_; }
+
+ private:
+
+  struct Private;
+  class EpollTask;
+
+  std::unique_ptr<Private> p_;
+
+  core::Signal<bool> finished_;
+
+};
+
+} // namespace gui
+} // namespace skland
+
+#endif // SKLAND_GUI_IMAGE_EXPORTER_HPP_
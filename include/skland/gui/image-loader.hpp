@@ -0,0 +1,93 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GUI_IMAGE_LOADER_HPP_
+#define SKLAND_GUI_IMAGE_LOADER_HPP_
+
+#include "../core/sigcxx.hpp"
+#include "../core/size.hpp"
+
+#include <memory>
+#include <string>
+
+namespace skland {
+
+namespace graphic {
+class Bitmap;
+}
+
+namespace gui {
+
+/**
+ * @ingroup gui
+ * @brief Load image files in worker threads and deliver them in the main thread
+ *
+ * This is a thin wrapper of graphic::Bitmap::LoadAsync(), loaded() is emitted
+ * in the main loop for each request, images found in graphic::ImageCache are
+ * delivered in the next loop iteration.
+ */
+class ImageLoader {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(ImageLoader);
+
+  ImageLoader();
+
+  /**
+   * @brief Destructor
+   *
+   * Requests not delivered yet are dropped, the worker threads don't wait for
+   * this object.
+   */
+  ~ImageLoader();
+
+  /**
+   * @brief Request an image
+   * @param path The image file
+   * @param target_size The size the image is displayed in, see graphic::Bitmap::Load()
+   */
+  void Load(const std::string &path, const core::SizeI &target_size = core::SizeI(0, 0));
+
+  /**
+   * @brief Number of requests not delivered yet
+   */
+  size_t GetPendingCount() const;
+
+  /**
+   * @brief A signal emitted in the main thread when an image is loaded
+   *
+   * The arguments are the requested path and the bitmap, which is empty if the
+   * file cannot be loaded.
+   */
+  core::SignalRef<const std::string &, const graphic::Bitmap &> loaded() { return loaded_; }
+
+ private:
+
+  struct Private;
+  class EpollTask;
+
+  std::unique_ptr<Private> p_;
+
+  core::Signal<const std::string &, const graphic::Bitmap &> loaded_;
+
+};
+
+} // namespace gui
+} // namespace skland
+
+#endif // SKLAND_GUI_IMAGE_LOADER_HPP_
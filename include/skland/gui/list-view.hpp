@@ -0,0 +1,190 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GUI_LIST_VIEW_HPP_
+#define SKLAND_GUI_LIST_VIEW_HPP_
+
+#include "abstract-view.hpp"
+
+namespace skland {
+namespace gui {
+
+class AbstractListModel;
+
+/**
+ * @ingroup gui
+ * @brief A scrollable view displays items provided by an AbstractListModel
+ *
+ * ListView is virtualized: it only creates item views for the visible items
+ * plus a small overscan, and item views scrolled out are put into a recycle
+ * pool and bound to new items later. The cost of scrolling depends on the
+ * visible item count, not the size of the model.
+ */
+SKLAND_EXPORT class ListView : public AbstractView {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(ListView);
+
+  ListView();
+
+  ListView(int width, int height);
+
+  /**
+   * @brief Set the model
+   * @param model A model object, the list view does not take the ownership
+   */
+  void SetModel(AbstractListModel *model);
+
+  AbstractListModel *GetModel() const;
+
+  /**
+   * @brief Set the height of each item
+   */
+  void SetItemHeight(int height);
+
+  int GetItemHeight() const;
+
+  /**
+   * @brief Set the count of extra items created beyond each edge of the visible area
+   */
+  void SetOverscan(int count);
+
+  int GetOverscan() const;
+
+  /**
+   * @brief Scroll the content to the given offset
+   * @param offset The vertical offset in pixels, will be clamped in range
+   */
+  void ScrollTo(int offset);
+
+  /**
+   * @brief Scroll the content by the given distance
+   */
+  void ScrollBy(int distance);
+
+  /**
+   * @brief Scroll to make the item at index visible at top
+   */
+  void ScrollToIndex(int index);
+
+  int GetScrollOffset() const;
+
+  /**
+   * @brief Get the maximal scroll offset of current model and geometry
+   */
+  int GetMaximalScrollOffset() const;
+
+  /**
+   * @brief Get the index of the first item which has a view
+   */
+  int GetFirstIndex() const;
+
+  /**
+   * @brief Get the count of items which have views
+   */
+  int GetViewCount() const;
+
+  /**
+   * @brief Get the count of views in the recycle pool
+   */
+  int GetRecycledCount() const;
+
+  /**
+   * @brief Get the item view bound to index
+   * @return The view or nullptr if this item is not realized
+   */
+  AbstractView *GetViewAt(int index) const;
+
+  SignalRef<int> scrolled() { return scrolled_; }
+
+ protected:
+
+  virtual ~ListView();
+
+  /**
+   * @brief Get the count of items in one row
+   *
+   * ListView always returns 1, GridView overrides this.
+   */
+  virtual int GetColumnCount() const;
+
+  /**
+   * @brief Calculate the geometry of the item at index (in window coordinate)
+   */
+  virtual RectF GetItemGeometry(int index) const;
+
+  /**
+   * @brief Get the index of the item at a point (in window coordinate)
+   * @return The index, or -1 if the point is not in a column
+   *
+   * The point must be in this view, the index may be out of the model.
+   */
+  virtual int GetIndexAt(int x, int y) const;
+
+  virtual void OnConfigureGeometry(const RectF &old_geometry,
+                                   const RectF &new_geometry) override;
+
+  virtual void OnSaveGeometry(const RectF &old_geometry,
+                              const RectF &new_geometry) override;
+
+  virtual void OnRequestUpdate(AbstractView *view) override;
+
+  virtual void OnMouseEnter(MouseEvent *event) override;
+
+  virtual void OnMouseLeave() override;
+
+  virtual void OnMouseMove(MouseEvent *event) override;
+
+  virtual void OnMouseDown(MouseEvent *event) override;
+
+  virtual void OnMouseUp(MouseEvent *event) override;
+
+  virtual void OnKeyDown(KeyEvent *event) override;
+
+  virtual void OnKeyUp(KeyEvent *event) override;
+
+  virtual void OnDraw(const Context &context) override;
+
+  virtual void OnDestroy() override;
+
+  virtual void DispatchUpdate() override;
+
+  virtual AbstractView *DispatchMouseEnterEvent(MouseEvent *event) override;
+
+  /**
+   * @brief Re-calculate the visible range, recycle and bind item views
+   * @param rebind Bind all visible views again, used when model changed
+   */
+  void Realize(bool rebind = false);
+
+ private:
+
+  struct Private;
+
+  void OnModelChanged(__SLOT__);
+
+  std::unique_ptr<Private> p_;
+
+  Signal<int> scrolled_;
+
+};
+
+} // namespace gui
+} // namespace skland
+
+#endif // SKLAND_GUI_LIST_VIEW_HPP_
@@ -52,6 +52,12 @@ class Output : public core::CompoundDeque::Element {
 
   int GetScale() const;
 
+  /**
+   * @brief Get the refresh rate of the current mode
+   * @return Vertical refresh rate in mHz, 0 if unknown
+   */
+  int GetRefreshRate() const;
+
   const std::string &GetMake() const;
 
   const std::string &GetModel() const;
@@ -23,6 +23,8 @@
 namespace skland {
 namespace gui {
 
+class AbstractShellView;
+
 /**
  * @brief Shared memory pool
  */
@@ -36,19 +38,22 @@ class SharedMemoryPool {
  public:
 
   SharedMemoryPool()
-      : wl_shm_pool_(nullptr), size_(0), data_(nullptr) {}
+      : wl_shm_pool_(nullptr), size_(0), data_(nullptr), owner_(nullptr) {}
 
   /**
    * @brief Destructor
    *
    * Destroy the pool, this does not unmap the memory though.
    */
-  ~SharedMemoryPool() {
-    if (wl_shm_pool_)
-      wl_shm_pool_destroy(wl_shm_pool_);
-  }
+  ~SharedMemoryPool();
 
-  void Setup(int32_t size);
+  /**
+   * @brief Create the pool
+   * @param size Size in bytes
+   * @param owner The shell view this pool is used for, the size is reported
+   *        to core::MemoryStats for it
+   */
+  void Setup(int32_t size, const AbstractShellView *owner = nullptr);
 
   void Destroy();
 
@@ -58,6 +63,8 @@ class SharedMemoryPool {
 
   void *data() const { return data_; };
 
+  const AbstractShellView *owner() const { return owner_; }
+
  private:
 
   static int CreateAnonymousFile(off_t size);
@@ -70,6 +77,8 @@ class SharedMemoryPool {
 
   void *data_;
 
+  const AbstractShellView *owner_;
+
 };
 
 } // namespace gui
@@ -28,6 +28,11 @@
 #include <memory>
 
 namespace skland {
+
+namespace core {
+class Arena;
+}
+
 namespace gui {
 
 class Buffer;
@@ -159,6 +164,14 @@ class Surface : public core::Trackable {
    */
   core::Deque<AbstractView::RedrawNode> &GetRedrawNodeDeque() const;
 
+  /**
+   * @brief Get the arena for temporaries used to render a frame
+   *
+   * The arena is reset after this surface is committed, memory allocated from
+   * it must not be kept across frames.
+   */
+  core::Arena *GetFrameArena() const;
+
   Surface *GetShellSurface();
 
   /**
@@ -28,6 +28,7 @@
 #include <string>
 
 class SkPixmap;
+class SkImage;
 
 namespace skland {
 namespace gui {
@@ -35,6 +36,8 @@ namespace gui {
 typedef void *(*ThemeCreateHandle)();
 typedef void(*ThemeDestroyHandle)(void *p);
 
+class ThemeBundle;
+
 /**
  * @ingroup gui
  * @brief The global theme manager
@@ -122,8 +125,33 @@ class Theme {
 
   };
 
+  /**
+   * @brief Load a theme
+   * @param name One of:
+   *   - a builtin theme: "light" (default) or "dark"
+   *   - a theme plugin (*.so) exporting ThemeCreate() and ThemeDestroy() as
+   *     ThemeCreateHandle and ThemeDestroyHandle
+   *   - a bundle file written by Compile(), which is mapped in memory and
+   *     provides the pre-rendered shadow image
+   *
+   * Falls back to the default theme if it cannot be loaded. The shadow
+   * geometry in a bundle applies to shell views created afterwards, so set
+   * the SKLAND_THEME environment variable to load a bundle at startup.
+   */
   static void Load(const char *name = nullptr);
 
+  /**
+   * @brief Compile a theme into a binary bundle
+   * @param source A builtin theme name, a theme plugin, or a text theme file
+   *        with "key = value" lines
+   * @param filename The bundle file to write
+   * @return false if the source cannot be loaded or the file cannot be written
+   *
+   * This is supposed to run offline, the text theme is never parsed when the
+   * application starts.
+   */
+  static bool Compile(const char *source, const char *filename);
+
   static inline int GetShadowRadius() {
     return kShadowRadius;
   }
@@ -144,6 +172,14 @@ class Theme {
     return kShadowPixmap;
   }
 
+  /**
+   * @brief The shadow pixmap wrapped in an image, kept so that drawing the
+   * shadow does not create a new one
+   */
+  static inline SkImage *GetShadowImage() {
+    return kShadowImage;
+  }
+
   static const int kShadowImageWidth = 250;
 
   static const int kShadowImageHeight = 250;
@@ -167,6 +203,13 @@ class Theme {
    */
   static void Initialize();
 
+  /**
+   * @brief Start resolving the fonts used in theme data in background
+   *
+   * This method is called only in Application before connecting to the display
+   */
+  static void Preload();
+
   /**
    * @brief Release the memory allocated for theme
    *
@@ -174,7 +217,23 @@ class Theme {
    */
   static void Release();
 
-  static void GenerateShadowImage();
+  /**
+   * @brief A loaded theme object and where it comes from, defined in source
+   */
+  struct Instance;
+
+  static bool CreateInstance(const char *name, Instance *instance);
+
+  static void DestroyInstance(Instance *instance);
+
+  /**
+   * @brief Use the shadow image in bundle, or generate it if bundle is nullptr
+   */
+  static void UseShadow(const ThemeBundle *bundle);
+
+  static void SetShadowGeometry(int radius, int offset_x, int offset_y);
+
+  static void GenerateShadowImage(uint32_t *pixels, int radius);
 
   static int kShadowRadius;
 
@@ -187,8 +246,12 @@ class Theme {
 
   static SkPixmap *kShadowPixmap;
 
+  static SkImage *kShadowImage;
+
   static Theme *kTheme;
 
+  static Instance kInstance;
+
   Data data_;
 
 };
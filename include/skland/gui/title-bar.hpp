@@ -22,7 +22,14 @@
 #include "skland/core/color.hpp"
 #include "skland/graphic/font.hpp"
 
+#include <memory>
+
 namespace skland {
+
+namespace graphic {
+class Paint;
+}
+
 namespace gui {
 
 /**
@@ -115,6 +122,13 @@ class TitleBar final : public AbstractView {
   graphic::Font font_;
 
   std::string title_;
+
+  /**
+   * @brief The interned paint of title, rebuilt when the scale changes
+   */
+  std::shared_ptr<const graphic::Paint> title_paint_;
+
+  int title_paint_scale_;
 };
 
 } // namespace gui
@@ -0,0 +1,265 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GUI_VIEW_GEOMETRY_STORE_HPP_
+#define SKLAND_GUI_VIEW_GEOMETRY_STORE_HPP_
+
+#include "skland/core/defines.hpp"
+#include "skland/core/rect.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace skland {
+namespace gui {
+
+class AbstractView;
+
+/**
+ * @ingroup gui
+ * @brief A flattened copy of geometry, visibility and dirty flags of view trees
+ *
+ * ViewGeometryStore keeps the views of one or more trees in pre-order (tree
+ * order) with their data in separate arrays (structure of arrays), so culling
+ * and hit testing become linear scans on contiguous memory instead of walking
+ * the pointers in every view.
+ *
+ * Each AbstractShellView owns a store with its attached views as roots. The
+ * store is rebuilt lazily after the tree structure changes, and geometry,
+ * visibility and dirty flags of a view are written in place when they change.
+ */
+SKLAND_EXPORT class ViewGeometryStore {
+
+ public:
+
+  using RectF = core::RectF;
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(ViewGeometryStore);
+
+  ViewGeometryStore();
+
+  ~ViewGeometryStore();
+
+  /**
+   * @brief Add the root of a view tree
+   */
+  void AddRoot(AbstractView *view);
+
+  /**
+   * @brief Remove the root of a view tree
+   */
+  void RemoveRoot(AbstractView *view);
+
+  /**
+   * @brief Mark the store as out of date after the tree structure changed
+   */
+  void Invalidate();
+
+  /**
+   * @brief Rebuild the arrays if the store is out of date
+   *
+   * This also rebuilds the list of occluders used in IsOccludedAt() if the
+   * opaque or visible flag of any view changed, so call it at the start of a
+   * frame.
+   */
+  void Sync();
+
+  bool IsValid() const { return !stale_; }
+
+  /**
+   * @brief Get the count of views in the store
+   */
+  int GetCount() const { return static_cast<int>(views_.size()); }
+
+  AbstractView *GetViewAt(int index) const { return views_[index]; }
+
+  RectF GetGeometryAt(int index) const {
+    return RectF(left_[index], top_[index], right_[index], bottom_[index]);
+  }
+
+  bool IsVisibleAt(int index) const { return 0 != visible_[index]; }
+
+  bool IsDirtyAt(int index) const { return 0 != dirty_[index]; }
+
+  bool IsOpaqueAt(int index) const { return 0 != opaque_[index]; }
+
+  /**
+   * @brief Get the index after the last descendant of the view at index
+   */
+  int GetSubtreeEndAt(int index) const { return subtree_end_[index]; }
+
+  /**
+   * @brief Get the index of the view in this store, or -1
+   */
+  int IndexOf(const AbstractView *view) const;
+
+  /**
+   * @brief Collect visible views intersecting the given rect in tree order
+   * @param rect The rect in window coordinate
+   * @param views A vector to store the result, it's cleared first
+   * @return Count of collected views
+   *
+   * Invisible views and their sub views are skipped.
+   */
+  int Cull(const RectF &rect, std::vector<AbstractView *> *views);
+
+  /**
+   * @brief Find the deepest visible view which contains the given position
+   *
+   * This follows the same rule as AbstractView::DispatchMouseEnterEvent(): the
+   * first child contains the position wins.
+   */
+  AbstractView *HitTest(float x, float y);
+
+  /**
+   * @brief Check if the view at index is completely covered by an opaque view
+   *
+   * A view is covered by its sub views and the views drawn above it. Same as
+   * hit testing, an earlier sibling is above the later ones.
+   *
+   * Only single opaque views are tested, a view covered by the union of
+   * several opaque views is not treated as occluded.
+   *
+   * Only the occluders collected in Sync() are checked, so the cost is linear
+   * in the count of visible opaque views rather than all views.
+   */
+  bool IsOccludedAt(int index);
+
+  /**
+   * @brief Get the count of visible opaque views which may occlude others
+   */
+  int GetOccluderCount() {
+    Sync();
+    return static_cast<int>(occluders_.size());
+  }
+
+  /**
+   * @brief Collect the rects of visible opaque views clipped by the given rect
+   * @return Count of rects
+   *
+   * The vector can use any allocator, e.g. core::ArenaAllocator with the frame
+   * arena of a surface to avoid heap allocations in each frame.
+   */
+  template<typename Allocator>
+  int CollectOpaque(const RectF &clip, std::vector<RectF, Allocator> *rects);
+
+  /**
+   * @brief Collect the dirty views in tree order
+   */
+  int CollectDirty(std::vector<AbstractView *> *views);
+
+  /**
+   * @brief Clear all dirty flags
+   */
+  void ClearDirty();
+
+  // Called in AbstractView:
+
+  void SetGeometryAt(int index, const RectF &geometry) {
+    left_[index] = geometry.left;
+    top_[index] = geometry.top;
+    right_[index] = geometry.right;
+    bottom_[index] = geometry.bottom;
+  }
+
+  void SetVisibleAt(int index, bool visible) {
+    visible_[index] = visible ? 1 : 0;
+    occluders_stale_ = true;
+  }
+
+  void SetDirtyAt(int index, bool dirty) { dirty_[index] = dirty ? 1 : 0; }
+
+  void SetOpaqueAt(int index, bool opaque);
+
+ private:
+
+  void Push(AbstractView *view);
+
+  void Release();
+
+  /**
+   * @brief Collect the indices of visible opaque views in tree order
+   */
+  void CollectOccluders();
+
+  /**
+   * @brief Calculate the intersection mask of all views in a tight loop
+   */
+  void CalculateMask(const RectF &rect);
+
+  std::vector<AbstractView *> roots_;
+
+  std::vector<AbstractView *> views_;
+
+  std::vector<int> subtree_end_;
+
+  std::vector<float> left_;
+  std::vector<float> top_;
+  std::vector<float> right_;
+  std::vector<float> bottom_;
+
+  std::vector<uint8_t> visible_;
+  std::vector<uint8_t> dirty_;
+  std::vector<uint8_t> opaque_;
+
+  int opaque_count_;
+
+  /**
+   * @brief Indices of visible opaque views in tree order
+   */
+  std::vector<int> occluders_;
+
+  bool occluders_stale_;
+
+  std::vector<uint8_t> mask_;
+
+  bool stale_;
+
+};
+
+template<typename Allocator>
+int ViewGeometryStore::CollectOpaque(const RectF &clip, std::vector<RectF, Allocator> *rects) {
+  Sync();
+
+  rects->clear();
+  if (0 == opaque_count_) return 0;
+
+  const int count = GetCount();
+  RectF rect;
+  int i = 0;
+
+  while (i < count) {
+    if (0 == visible_[i]) {
+      i = subtree_end_[i];
+      continue;
+    }
+
+    if (opaque_[i]) {
+      rect = RectF::GetIntersection(clip, GetGeometryAt(i));
+      if (!rect.IsEmpty()) rects->push_back(rect);
+    }
+
+    i++;
+  }
+
+  return static_cast<int>(rects->size());
+}
+
+} // namespace gui
+} // namespace skland
+
+#endif // SKLAND_GUI_VIEW_GEOMETRY_STORE_HPP_
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GUI_VIEW_SLAB_HPP_
+#define SKLAND_GUI_VIEW_SLAB_HPP_
+
+#include "skland/core/defines.hpp"
+#include "skland/core/slab-allocator.hpp"
+
+namespace skland {
+namespace gui {
+
+/**
+ * @ingroup gui
+ * @brief Slab allocators for the private data of views and anchors
+ *
+ * Views and anchors are allocated from the heap by default. While a ViewSlab
+ * object is alive, the private data of new views and event handlers and new
+ * anchors are allocated from its slabs instead, which reduces heap
+ * allocations when building and tearing down large view trees.
+ *
+ * Application creates one if the environment variable SKLAND_VIEW_SLAB is
+ * set, and destroys it after all windows. Objects still alive when a
+ * ViewSlab is destroyed keep their chunks until they are deleted.
+ */
+SKLAND_EXPORT class ViewSlab {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(ViewSlab);
+
+  /**
+   * @brief Constructor, makes new views and anchors use the slabs in this object
+   */
+  ViewSlab();
+
+  /**
+   * @brief Destructor, restores the allocators set before this object
+   */
+  ~ViewSlab();
+
+  /**
+   * @brief The slab of AbstractView::Private
+   */
+  const core::SlabAllocator &GetViewAllocator() const { return view_allocator_; }
+
+  /**
+   * @brief The slab of AbstractEventHandler::Private
+   */
+  const core::SlabAllocator &GetEventHandlerAllocator() const { return event_handler_allocator_; }
+
+  /**
+   * @brief The slab of Anchor
+   */
+  const core::SlabAllocator &GetAnchorAllocator() const { return anchor_allocator_; }
+
+ private:
+
+  core::SlabAllocator view_allocator_;
+  core::SlabAllocator event_handler_allocator_;
+  core::SlabAllocator anchor_allocator_;
+
+  core::SlabAllocator *previous_view_allocator_;
+  core::SlabAllocator *previous_event_handler_allocator_;
+  core::SlabAllocator *previous_anchor_allocator_;
+
+};
+
+} // namespace gui
+} // namespace skland
+
+#endif // SKLAND_GUI_VIEW_SLAB_HPP_
@@ -18,6 +18,7 @@
 #define SKLAND_GUI_WINDOW_HPP_
 
 #include "abstract-shell-view.hpp"
+#include "frame-stats.hpp"
 
 namespace skland {
 namespace gui {
@@ -26,6 +27,10 @@ namespace gui {
  * @ingroup gui
  * @brief A default window with a client-side decorations
  *
+ * The window is rasterized on the GPU through an EGL surface if the Skia GL
+ * backend is available, otherwise into shm buffers. Set SKLAND_DISABLE_GPU in
+ * the environment to always use shm buffers.
+ *
  * @example hello.cpp
  */
 SKLAND_EXPORT class Window : public AbstractShellView {
@@ -79,6 +84,11 @@ SKLAND_EXPORT class Window : public AbstractShellView {
 
   const Size &GetMaximalSize() const;
 
+  /**
+   * @brief Get the statistics of the last rendered frame
+   */
+  const FrameStats &GetFrameStats() const;
+
  protected:
 
   void OnShown() final;
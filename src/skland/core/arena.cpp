@@ -0,0 +1,118 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "skland/core/arena.hpp"
+#include "skland/core/memory-stats.hpp"
+
+namespace skland {
+namespace core {
+
+/**
+ * @brief The alignment of each chunk
+ */
+static const size_t kAlignment = alignof(std::max_align_t);
+
+static inline size_t Align(size_t size) {
+  return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+Arena::Arena(size_t chunk_size)
+    : chunk_size_(chunk_size > 0 ? chunk_size : 4096),
+      chunks_(nullptr),
+      current_(nullptr),
+      end_(nullptr),
+      finalizers_(nullptr),
+      capacity_(0),
+      filled_size_(0),
+      allocation_count_(0),
+      chunk_allocation_count_(0) {
+}
+
+Arena::~Arena() {
+  Reset();
+  ReleaseChunks();
+}
+
+void Arena::Reset() {
+  while (finalizers_) {
+    Finalizer *finalizer = finalizers_;
+    finalizers_ = finalizer->next;
+    finalizer->destroy(finalizer->object);
+  }
+
+  if (nullptr != chunks_ && nullptr != chunks_->next) {
+    // More than one chunk was used, replace them with a larger one
+    size_t capacity = capacity_;
+    ReleaseChunks();
+    AddChunk(capacity);
+  } else if (nullptr != chunks_) {
+    current_ = reinterpret_cast<char *>(chunks_) + Align(sizeof(Chunk));
+  }
+
+  filled_size_ = 0;
+  allocation_count_ = 0;
+}
+
+size_t Arena::GetUsedSize() const {
+  if (nullptr == chunks_) return 0;
+  return filled_size_ + (current_ - (reinterpret_cast<char *>(chunks_) + Align(sizeof(Chunk))));
+}
+
+void *Arena::AllocateSlow(size_t size, size_t alignment) {
+  if (nullptr != chunks_) filled_size_ += current_ - (reinterpret_cast<char *>(chunks_) + Align(sizeof(Chunk)));
+
+  size_t chunk_size = chunks_ ? chunks_->size * 2 : chunk_size_;
+  while (chunk_size < size + alignment) chunk_size *= 2;
+  AddChunk(chunk_size);
+
+  return Allocate(size, alignment);
+}
+
+void Arena::AddChunk(size_t size) {
+  size_t header = Align(sizeof(Chunk));
+  char *memory = static_cast<char *>(::operator new(header + size));
+
+  Chunk *chunk = reinterpret_cast<Chunk *>(memory);
+  chunk->next = chunks_;
+  chunk->size = size;
+  chunks_ = chunk;
+
+  current_ = memory + header;
+  end_ = current_ + size;
+  capacity_ += size;
+  chunk_allocation_count_++;
+
+  MemoryStats::Add(MemoryStats::kArena, size);
+}
+
+void Arena::ReleaseChunks() {
+  if (capacity_ > 0) MemoryStats::Remove(MemoryStats::kArena, capacity_);
+
+  Chunk *chunk = nullptr;
+  while (chunks_) {
+    chunk = chunks_;
+    chunks_ = chunks_->next;
+    ::operator delete(chunk);
+  }
+
+  current_ = nullptr;
+  end_ = nullptr;
+  capacity_ = 0;
+}
+
+} // namespace core
+} // namespace skland
@@ -0,0 +1,508 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "skland/core/batch.hpp"
+
+#include <limits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace skland {
+namespace core {
+
+namespace {
+
+// Scalar loops, used for the remainders of the SIMD loops or when SIMD is not available
+
+template<typename T>
+size_t IntersectScalar(const Rect<T> &rect, const Rect<T> *rects, size_t count, bool *results) {
+  size_t n = 0;
+  for (size_t i = 0; i < count; ++i) {
+    results[i] = rect.Intersect(rects[i]);
+    n += results[i];
+  }
+  return n;
+}
+
+template<typename T>
+size_t ContainScalar(const Rect<T> *rects, size_t count, T x, T y, bool *results) {
+  size_t n = 0;
+  for (size_t i = 0; i < count; ++i) {
+    results[i] = rects[i].Contain(x, y);
+    n += results[i];
+  }
+  return n;
+}
+
+template<typename T>
+size_t ContainScalar(const Rect<T> &rect, const Vector2<T> *points, size_t count, bool *results) {
+  size_t n = 0;
+  for (size_t i = 0; i < count; ++i) {
+    results[i] = rect.Contain(points[i].x, points[i].y);
+    n += results[i];
+  }
+  return n;
+}
+
+/**
+ * @brief Union of non-empty rects, starting from the bounds in result
+ *
+ * An empty accumulator is represented by left/top = max and right/bottom = lowest.
+ */
+template<typename T>
+void UnionScalar(const Rect<T> *rects, size_t count, Rect<T> *result) {
+  for (size_t i = 0; i < count; ++i) {
+    if (rects[i].IsEmpty()) continue;
+
+    result->left = std::min(result->left, rects[i].left);
+    result->top = std::min(result->top, rects[i].top);
+    result->right = std::max(result->right, rects[i].right);
+    result->bottom = std::max(result->bottom, rects[i].bottom);
+  }
+}
+
+template<typename T>
+Rect<T> MakeUnionAccumulator() {
+  return Rect<T>(std::numeric_limits<T>::max(), std::numeric_limits<T>::max(),
+                 std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest());
+}
+
+template<typename T>
+Rect<T> FinishUnion(const Rect<T> &accumulator) {
+  return accumulator.left == std::numeric_limits<T>::max() ? Rect<T>() : accumulator;
+}
+
+inline void WriteMask(int mask, bool *results, size_t *n) {
+  results[0] = (mask & 1) != 0;
+  results[1] = (mask & 2) != 0;
+  results[2] = (mask & 4) != 0;
+  results[3] = (mask & 8) != 0;
+  *n += results[0] + results[1] + results[2] + results[3];
+}
+
+#ifdef __SSE2__
+
+/**
+ * @brief Load 4 rects and transpose them to vectors of lefts, tops, rights and bottoms
+ */
+template<typename T>
+inline void LoadRects(const Rect<T> *rects, __m128 *l, __m128 *t, __m128 *r, __m128 *b) {
+  const float *p = reinterpret_cast<const float *>(rects);
+  __m128 r0 = _mm_loadu_ps(p);
+  __m128 r1 = _mm_loadu_ps(p + 4);
+  __m128 r2 = _mm_loadu_ps(p + 8);
+  __m128 r3 = _mm_loadu_ps(p + 12);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  *l = r0;
+  *t = r1;
+  *r = r2;
+  *b = r3;
+}
+
+/**
+ * @brief Load 4 points as a vector of x and a vector of y
+ */
+template<typename T>
+inline void LoadPoints(const Vector2<T> *points, __m128 *x, __m128 *y) {
+  const float *p = reinterpret_cast<const float *>(points);
+  __m128 p01 = _mm_loadu_ps(p);
+  __m128 p23 = _mm_loadu_ps(p + 4);
+  *x = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+  *y = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+inline __m128i AsInt(__m128 v) {
+  return _mm_castps_si128(v);
+}
+
+inline __m128i SelectInt(__m128i mask, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+inline __m128i MinInt(__m128i a, __m128i b) {
+  return SelectInt(_mm_cmplt_epi32(a, b), a, b);
+}
+
+inline __m128i MaxInt(__m128i a, __m128i b) {
+  return SelectInt(_mm_cmpgt_epi32(a, b), a, b);
+}
+
+#endif  // __SSE2__
+
+}  // namespace
+
+#ifdef __SSE2__
+
+template<>
+size_t Batch<float>::Intersect(const Rect<float> &rect, const Rect<float> *rects, size_t count, bool *results) {
+  if (rect.IsEmpty()) {
+    std::fill(results, results + count, false);
+    return 0;
+  }
+
+  const __m128 rl = _mm_set1_ps(rect.left);
+  const __m128 rt = _mm_set1_ps(rect.top);
+  const __m128 rr = _mm_set1_ps(rect.right);
+  const __m128 rb = _mm_set1_ps(rect.bottom);
+
+  size_t n = 0;
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 l, t, r, b;
+    LoadRects(rects + i, &l, &t, &r, &b);
+
+    // max(left) < min(right) and max(top) < min(bottom)
+    __m128 m = _mm_and_ps(_mm_cmplt_ps(l, r), _mm_cmplt_ps(t, b));
+    m = _mm_and_ps(m, _mm_and_ps(_mm_cmplt_ps(l, rr), _mm_cmplt_ps(rl, r)));
+    m = _mm_and_ps(m, _mm_and_ps(_mm_cmplt_ps(t, rb), _mm_cmplt_ps(rt, b)));
+
+    WriteMask(_mm_movemask_ps(m), results + i, &n);
+  }
+
+  return n + IntersectScalar(rect, rects + i, count - i, results + i);
+}
+
+template<>
+size_t Batch<float>::Contain(const Rect<float> *rects, size_t count, float x, float y, bool *results) {
+  const __m128 px = _mm_set1_ps(x);
+  const __m128 py = _mm_set1_ps(y);
+
+  size_t n = 0;
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 l, t, r, b;
+    LoadRects(rects + i, &l, &t, &r, &b);
+
+    __m128 m = _mm_and_ps(_mm_cmple_ps(l, px), _mm_cmplt_ps(px, r));
+    m = _mm_and_ps(m, _mm_and_ps(_mm_cmple_ps(t, py), _mm_cmplt_ps(py, b)));
+
+    WriteMask(_mm_movemask_ps(m), results + i, &n);
+  }
+
+  return n + ContainScalar(rects + i, count - i, x, y, results + i);
+}
+
+template<>
+size_t Batch<float>::Contain(const Rect<float> &rect, const Vector2<float> *points, size_t count, bool *results) {
+  const __m128 rl = _mm_set1_ps(rect.left);
+  const __m128 rt = _mm_set1_ps(rect.top);
+  const __m128 rr = _mm_set1_ps(rect.right);
+  const __m128 rb = _mm_set1_ps(rect.bottom);
+
+  size_t n = 0;
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 x, y;
+    LoadPoints(points + i, &x, &y);
+
+    __m128 m = _mm_and_ps(_mm_cmple_ps(rl, x), _mm_cmplt_ps(x, rr));
+    m = _mm_and_ps(m, _mm_and_ps(_mm_cmple_ps(rt, y), _mm_cmplt_ps(y, rb)));
+
+    WriteMask(_mm_movemask_ps(m), results + i, &n);
+  }
+
+  return n + ContainScalar(rect, points + i, count - i, results + i);
+}
+
+template<>
+Rect<float> Batch<float>::Union(const Rect<float> *rects, size_t count) {
+  const __m128 max = _mm_set1_ps(std::numeric_limits<float>::max());
+  const __m128 lowest = _mm_set1_ps(std::numeric_limits<float>::lowest());
+
+  __m128 ul = max, ut = max, ur = lowest, ub = lowest;
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 l, t, r, b;
+    LoadRects(rects + i, &l, &t, &r, &b);
+
+    // Replace empty rects with the identity of min/max
+    __m128 m = _mm_and_ps(_mm_cmplt_ps(l, r), _mm_cmplt_ps(t, b));
+    ul = _mm_min_ps(ul, _mm_or_ps(_mm_and_ps(m, l), _mm_andnot_ps(m, max)));
+    ut = _mm_min_ps(ut, _mm_or_ps(_mm_and_ps(m, t), _mm_andnot_ps(m, max)));
+    ur = _mm_max_ps(ur, _mm_or_ps(_mm_and_ps(m, r), _mm_andnot_ps(m, lowest)));
+    ub = _mm_max_ps(ub, _mm_or_ps(_mm_and_ps(m, b), _mm_andnot_ps(m, lowest)));
+  }
+
+  float l[4], t[4], r[4], b[4];
+  _mm_storeu_ps(l, ul);
+  _mm_storeu_ps(t, ut);
+  _mm_storeu_ps(r, ur);
+  _mm_storeu_ps(b, ub);
+
+  Rect<float> result = MakeUnionAccumulator<float>();
+  for (int j = 0; j < 4; ++j) {
+    result.left = std::min(result.left, l[j]);
+    result.top = std::min(result.top, t[j]);
+    result.right = std::max(result.right, r[j]);
+    result.bottom = std::max(result.bottom, b[j]);
+  }
+
+  UnionScalar(rects + i, count - i, &result);
+  return FinishUnion(result);
+}
+
+template<>
+void Batch<float>::Pack(const Color<float> *colors, size_t count, uint32_t *argb) {
+  const __m128 scale = _mm_set1_ps(255.f);
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const float *p = &colors[i].r;
+
+    // Truncate like the cast in Color::argb(), and reorder RGBA to BGRA (ARGB in little endian)
+    __m128i c0 = _mm_shuffle_epi32(_mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(p), scale)), _MM_SHUFFLE(3, 0, 1, 2));
+    __m128i c1 = _mm_shuffle_epi32(_mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(p + 4), scale)), _MM_SHUFFLE(3, 0, 1, 2));
+    __m128i c2 = _mm_shuffle_epi32(_mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(p + 8), scale)), _MM_SHUFFLE(3, 0, 1, 2));
+    __m128i c3 = _mm_shuffle_epi32(_mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(p + 12), scale)), _MM_SHUFFLE(3, 0, 1, 2));
+
+    __m128i packed = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(argb + i), packed);
+  }
+
+  for (; i < count; ++i) {
+    argb[i] = colors[i].argb();
+  }
+}
+
+template<>
+void Batch<float>::Unpack(const uint32_t *argb, size_t count, Color<float> *colors) {
+  const __m128 scale = _mm_set1_ps(255.f);
+  const __m128i zero = _mm_setzero_si128();
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(argb + i));
+    __m128i lo = _mm_unpacklo_epi8(v, zero);
+    __m128i hi = _mm_unpackhi_epi8(v, zero);
+
+    // BGRA bytes to RGBA floats, divided like in Color::operator=(uint32_t)
+    __m128i c[4] = {
+        _mm_unpacklo_epi16(lo, zero),
+        _mm_unpackhi_epi16(lo, zero),
+        _mm_unpacklo_epi16(hi, zero),
+        _mm_unpackhi_epi16(hi, zero)
+    };
+
+    float *p = &colors[i].r;
+    for (int j = 0; j < 4; ++j) {
+      __m128 f = _mm_cvtepi32_ps(_mm_shuffle_epi32(c[j], _MM_SHUFFLE(3, 0, 1, 2)));
+      _mm_storeu_ps(p + j * 4, _mm_div_ps(f, scale));
+    }
+  }
+
+  for (; i < count; ++i) {
+    colors[i] = argb[i];
+  }
+}
+
+template<>
+void Batch<float>::Lerp(const Color<float> *from, const Color<float> *to, float t, size_t count, Color<float> *result) {
+  const __m128 factor = _mm_set1_ps(t);
+
+  // Color<float> is 4 floats, one color per vector
+  for (size_t i = 0; i < count; ++i) {
+    __m128 f = _mm_loadu_ps(&from[i].r);
+    __m128 d = _mm_sub_ps(_mm_loadu_ps(&to[i].r), f);
+    _mm_storeu_ps(&result[i].r, _mm_add_ps(f, _mm_mul_ps(d, factor)));
+  }
+}
+
+template<>
+size_t Batch<int>::Intersect(const Rect<int> &rect, const Rect<int> *rects, size_t count, bool *results) {
+  if (rect.IsEmpty()) {
+    std::fill(results, results + count, false);
+    return 0;
+  }
+
+  const __m128i rl = _mm_set1_epi32(rect.left);
+  const __m128i rt = _mm_set1_epi32(rect.top);
+  const __m128i rr = _mm_set1_epi32(rect.right);
+  const __m128i rb = _mm_set1_epi32(rect.bottom);
+
+  size_t n = 0;
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 lf, tf, rf, bf;
+    LoadRects(rects + i, &lf, &tf, &rf, &bf);
+    __m128i l = AsInt(lf), t = AsInt(tf), r = AsInt(rf), b = AsInt(bf);
+
+    __m128i m = _mm_and_si128(_mm_cmplt_epi32(l, r), _mm_cmplt_epi32(t, b));
+    m = _mm_and_si128(m, _mm_and_si128(_mm_cmplt_epi32(l, rr), _mm_cmplt_epi32(rl, r)));
+    m = _mm_and_si128(m, _mm_and_si128(_mm_cmplt_epi32(t, rb), _mm_cmplt_epi32(rt, b)));
+
+    WriteMask(_mm_movemask_ps(_mm_castsi128_ps(m)), results + i, &n);
+  }
+
+  return n + IntersectScalar(rect, rects + i, count - i, results + i);
+}
+
+template<>
+size_t Batch<int>::Contain(const Rect<int> *rects, size_t count, int x, int y, bool *results) {
+  const __m128i px = _mm_set1_epi32(x);
+  const __m128i py = _mm_set1_epi32(y);
+
+  size_t n = 0;
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 lf, tf, rf, bf;
+    LoadRects(rects + i, &lf, &tf, &rf, &bf);
+    __m128i l = AsInt(lf), t = AsInt(tf), r = AsInt(rf), b = AsInt(bf);
+
+    // left <= x is !(left > x)
+    __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(l, px), _mm_cmpgt_epi32(t, py));
+    __m128i m = _mm_andnot_si128(outside, _mm_and_si128(_mm_cmplt_epi32(px, r), _mm_cmplt_epi32(py, b)));
+
+    WriteMask(_mm_movemask_ps(_mm_castsi128_ps(m)), results + i, &n);
+  }
+
+  return n + ContainScalar(rects + i, count - i, x, y, results + i);
+}
+
+template<>
+size_t Batch<int>::Contain(const Rect<int> &rect, const Vector2<int> *points, size_t count, bool *results) {
+  const __m128i rl = _mm_set1_epi32(rect.left);
+  const __m128i rt = _mm_set1_epi32(rect.top);
+  const __m128i rr = _mm_set1_epi32(rect.right);
+  const __m128i rb = _mm_set1_epi32(rect.bottom);
+
+  size_t n = 0;
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 xf, yf;
+    LoadPoints(points + i, &xf, &yf);
+    __m128i x = AsInt(xf), y = AsInt(yf);
+
+    __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(rl, x), _mm_cmpgt_epi32(rt, y));
+    __m128i m = _mm_andnot_si128(outside, _mm_and_si128(_mm_cmplt_epi32(x, rr), _mm_cmplt_epi32(y, rb)));
+
+    WriteMask(_mm_movemask_ps(_mm_castsi128_ps(m)), results + i, &n);
+  }
+
+  return n + ContainScalar(rect, points + i, count - i, results + i);
+}
+
+template<>
+Rect<int> Batch<int>::Union(const Rect<int> *rects, size_t count) {
+  const __m128i max = _mm_set1_epi32(std::numeric_limits<int>::max());
+  const __m128i lowest = _mm_set1_epi32(std::numeric_limits<int>::lowest());
+
+  __m128i ul = max, ut = max, ur = lowest, ub = lowest;
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 lf, tf, rf, bf;
+    LoadRects(rects + i, &lf, &tf, &rf, &bf);
+    __m128i l = AsInt(lf), t = AsInt(tf), r = AsInt(rf), b = AsInt(bf);
+
+    __m128i m = _mm_and_si128(_mm_cmplt_epi32(l, r), _mm_cmplt_epi32(t, b));
+    ul = MinInt(ul, SelectInt(m, l, max));
+    ut = MinInt(ut, SelectInt(m, t, max));
+    ur = MaxInt(ur, SelectInt(m, r, lowest));
+    ub = MaxInt(ub, SelectInt(m, b, lowest));
+  }
+
+  int l[4], t[4], r[4], b[4];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(l), ul);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(t), ut);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(r), ur);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(b), ub);
+
+  Rect<int> result = MakeUnionAccumulator<int>();
+  for (int j = 0; j < 4; ++j) {
+    result.left = std::min(result.left, l[j]);
+    result.top = std::min(result.top, t[j]);
+    result.right = std::max(result.right, r[j]);
+    result.bottom = std::max(result.bottom, b[j]);
+  }
+
+  UnionScalar(rects + i, count - i, &result);
+  return FinishUnion(result);
+}
+
+#else  // __SSE2__
+
+template<>
+size_t Batch<float>::Intersect(const Rect<float> &rect, const Rect<float> *rects, size_t count, bool *results) {
+  return IntersectScalar(rect, rects, count, results);
+}
+
+template<>
+size_t Batch<float>::Contain(const Rect<float> *rects, size_t count, float x, float y, bool *results) {
+  return ContainScalar(rects, count, x, y, results);
+}
+
+template<>
+size_t Batch<float>::Contain(const Rect<float> &rect, const Vector2<float> *points, size_t count, bool *results) {
+  return ContainScalar(rect, points, count, results);
+}
+
+template<>
+Rect<float> Batch<float>::Union(const Rect<float> *rects, size_t count) {
+  Rect<float> result = MakeUnionAccumulator<float>();
+  UnionScalar(rects, count, &result);
+  return FinishUnion(result);
+}
+
+template<>
+void Batch<float>::Pack(const Color<float> *colors, size_t count, uint32_t *argb) {
+  for (size_t i = 0; i < count; ++i) argb[i] = colors[i].argb();
+}
+
+template<>
+void Batch<float>::Unpack(const uint32_t *argb, size_t count, Color<float> *colors) {
+  for (size_t i = 0; i < count; ++i) colors[i] = argb[i];
+}
+
+template<>
+void Batch<float>::Lerp(const Color<float> *from, const Color<float> *to, float t, size_t count, Color<float> *result) {
+  for (size_t i = 0; i < count; ++i) {
+    result[i].r = from[i].r + (to[i].r - from[i].r) * t;
+    result[i].g = from[i].g + (to[i].g - from[i].g) * t;
+    result[i].b = from[i].b + (to[i].b - from[i].b) * t;
+    result[i].a = from[i].a + (to[i].a - from[i].a) * t;
+  }
+}
+
+template<>
+size_t Batch<int>::Intersect(const Rect<int> &rect, const Rect<int> *rects, size_t count, bool *results) {
+  return IntersectScalar(rect, rects, count, results);
+}
+
+template<>
+size_t Batch<int>::Contain(const Rect<int> *rects, size_t count, int x, int y, bool *results) {
+  return ContainScalar(rects, count, x, y, results);
+}
+
+template<>
+size_t Batch<int>::Contain(const Rect<int> &rect, const Vector2<int> *points, size_t count, bool *results) {
+  return ContainScalar(rect, points, count, results);
+}
+
+template<>
+Rect<int> Batch<int>::Union(const Rect<int> *rects, size_t count) {
+  Rect<int> result = MakeUnionAccumulator<int>();
+  UnionScalar(rects, count, &result);
+  return FinishUnion(result);
+}
+
+#endif  // __SSE2__
+
+} // namespace core
+} // namespace skland
@@ -24,7 +24,8 @@ namespace core {
 CompoundDeque::Element::Element()
     : previous_(nullptr),
       next_(nullptr),
-      deque_(nullptr) {
+      deque_(nullptr),
+      index_(-1) {
 }
 
 CompoundDeque::Element::~Element() {
@@ -61,6 +62,7 @@ void CompoundDeque::PushFront(Element *item) {
 
   item->deque_ = this;
   count_++;
+  index_.OnInserted(item);
 }
 
 void CompoundDeque::PushBack(Element *item) {
@@ -84,6 +86,7 @@ void CompoundDeque::PushBack(Element *item) {
 
   item->deque_ = this;
   count_++;
+  index_.OnInserted(item);
 }
 
 void CompoundDeque::Insert(Element *item, int index) {
@@ -102,11 +105,7 @@ void CompoundDeque::Insert(Element *item, int index) {
     first_ = item;
   } else {
     if (index >= 0) {
-      Element *p = first_;
-      while ((nullptr != p) && (index > 0)) {
-        p = p->next_;
-        index--;
-      }
+      Element *p = index < count_ ? index_.Get(index, count_, first_, last_) : nullptr;
       if (nullptr != p) {  // insert before p
         item->previous_ = p->previous_;
         item->next_ = p;
@@ -140,6 +139,7 @@ void CompoundDeque::Insert(Element *item, int index) {
 
   item->deque_ = this;
   count_++;
+  index_.OnInserted(item);
 }
 
 CompoundDeque::Element *CompoundDeque::Remove(Element *item) {
@@ -147,6 +147,8 @@ CompoundDeque::Element *CompoundDeque::Remove(Element *item) {
 
   _ASSERT(count_ > 0);
 
+  index_.OnRemoving(item);
+
   if (nullptr != item->previous_) {
     item->previous_->next_ = item->next_;
   } else {
@@ -187,30 +189,15 @@ void CompoundDeque::Clear() {
   count_ = 0;
   first_ = nullptr;
   last_ = nullptr;
+  index_.Clear();
 }
 
 CompoundDeque::Element *CompoundDeque::operator[](int index) const {
   if (index < 0) index = count_ + index;
 
-  Element *item = nullptr;
-  int mid = (count_ + 1) / 2;
+  if (index < 0 || index >= count_) return nullptr;
 
-  if (index >= 0 && index < mid) {
-    item = first_;
-    while (index > 0) {
-      item = item->next_;
-      index--;
-    }
-  } else if (index >= mid && index < count_) {
-    item = last_;
-    int max = count_ - 1;
-    while (index < max) {
-      item = item->previous_;
-      index++;
-    }
-  }
-
-  return item;
+  return index_.Get(index, count_, first_, last_);
 }
 
 } // namespace core
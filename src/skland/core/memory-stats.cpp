@@ -0,0 +1,352 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <skland/core/memory-stats.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace skland {
+namespace core {
+
+struct MemoryStats::Private {
+
+  struct Counter {
+
+    Counter()
+        : current(0), peak(0), budget(0), probe(nullptr) {}
+
+    std::atomic<size_t> current;
+    std::atomic<size_t> peak;
+    std::atomic<size_t> budget;
+    std::atomic<Probe> probe;
+
+  };
+
+  struct Owner {
+
+    std::string name;
+
+    Usage usage[kCategoryCount];
+
+  };
+
+  Private()
+      : dump_running(false), dump_interval_ms(0), dump_file(nullptr) {}
+
+  /**
+   * @brief Never destroyed, objects may still report memory at exit
+   */
+  static Private *Get() {
+    static Private *kPrivate = new Private;
+    return kPrivate;
+  }
+
+  static void UpdatePeak(std::atomic<size_t> *peak, size_t value) {
+    size_t old = peak->load(std::memory_order_relaxed);
+    while (value > old && !peak->compare_exchange_weak(old, value, std::memory_order_relaxed));
+  }
+
+  /**
+   * @brief Get the current bytes of a category and update the peak
+   */
+  size_t GetCurrent(Category category) {
+    Counter &counter = counters[category];
+    Probe probe = counter.probe.load(std::memory_order_acquire);
+    if (nullptr == probe) return counter.current.load(std::memory_order_relaxed);
+
+    size_t current = probe();
+    UpdatePeak(&counter.peak, current);
+    return current;
+  }
+
+  void RunPeriodicDump();
+
+  Counter counters[kCategoryCount];
+
+  std::mutex owner_mutex;
+
+  std::map<const void *, Owner> owners;
+
+  // Periodic dump:
+
+  std::mutex dump_mutex;
+
+  std::condition_variable dump_condition;
+
+  std::thread dump_thread;
+
+  bool dump_running;
+
+  int dump_interval_ms;
+
+  std::ofstream *dump_file;
+
+  static const char *kCategoryNames[kCategoryCount];
+
+};
+
+const char *MemoryStats::Private::kCategoryNames[kCategoryCount] = {
+    "shm-pool",
+    "shm-buffer",
+    "bitmap",
+    "image-cache",
+    "glyph-cache",
+    "theme",
+    "arena",
+    "other"
+};
+
+void MemoryStats::Private::RunPeriodicDump() {
+  std::unique_lock<std::mutex> lock(dump_mutex);
+  while (dump_running) {
+    dump_condition.wait_for(lock, std::chrono::milliseconds(dump_interval_ms));
+    if (!dump_running) break;
+
+    if (nullptr != dump_file) {
+      Dump(*dump_file);
+      dump_file->flush();
+    } else {
+      Dump(std::cerr);
+    }
+  }
+}
+
+void MemoryStats::Add(Category category, size_t bytes, const void *owner) {
+  Private *p = Private::Get();
+  Private::Counter &counter = p->counters[category];
+
+  size_t current = counter.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  Private::UpdatePeak(&counter.peak, current);
+
+  if (nullptr == owner) return;
+
+  std::lock_guard<std::mutex> lock(p->owner_mutex);
+  Usage &usage = p->owners[owner].usage[category];
+  usage.current += bytes;
+  if (usage.current > usage.peak) usage.peak = usage.current;
+}
+
+void MemoryStats::Remove(Category category, size_t bytes, const void *owner) {
+  Private *p = Private::Get();
+
+  size_t old = p->counters[category].current.fetch_sub(bytes, std::memory_order_relaxed);
+  _ASSERT(old >= bytes);
+  (void) old;
+
+  if (nullptr == owner) return;
+
+  std::lock_guard<std::mutex> lock(p->owner_mutex);
+  auto it = p->owners.find(owner);
+  if (it == p->owners.end()) return;  // Released
+
+  Usage &usage = it->second.usage[category];
+  _ASSERT(usage.current >= bytes);
+  usage.current -= bytes;
+}
+
+void MemoryStats::SetProbe(Category category, Probe probe) {
+  Private::Get()->counters[category].probe.store(probe, std::memory_order_release);
+}
+
+MemoryStats::Usage MemoryStats::GetUsage(Category category) {
+  Private *p = Private::Get();
+
+  Usage usage;
+  usage.current = p->GetCurrent(category);
+  usage.peak = p->counters[category].peak.load(std::memory_order_relaxed);
+  return usage;
+}
+
+size_t MemoryStats::GetTotalUsage() {
+  Private *p = Private::Get();
+
+  size_t total = 0;
+  for (int i = 0; i < kCategoryCount; i++) {
+    if (i == kBuffer) continue;
+    total += p->GetCurrent(static_cast<Category>(i));
+  }
+
+  return total;
+}
+
+MemoryStats::Usage MemoryStats::GetOwnerUsage(const void *owner, Category category) {
+  Private *p = Private::Get();
+  std::lock_guard<std::mutex> lock(p->owner_mutex);
+
+  auto it = p->owners.find(owner);
+  if (it == p->owners.end()) return Usage();
+
+  return it->second.usage[category];
+}
+
+size_t MemoryStats::GetOwnerTotalUsage(const void *owner) {
+  Private *p = Private::Get();
+  std::lock_guard<std::mutex> lock(p->owner_mutex);
+
+  auto it = p->owners.find(owner);
+  if (it == p->owners.end()) return 0;
+
+  size_t total = 0;
+  for (int i = 0; i < kCategoryCount; i++) {
+    if (i == kBuffer) continue;
+    total += it->second.usage[i].current;
+  }
+
+  return total;
+}
+
+void MemoryStats::SetOwnerName(const void *owner, const std::string &name) {
+  Private *p = Private::Get();
+  std::lock_guard<std::mutex> lock(p->owner_mutex);
+  p->owners[owner].name = name;
+}
+
+void MemoryStats::ReleaseOwner(const void *owner) {
+  Private *p = Private::Get();
+  std::lock_guard<std::mutex> lock(p->owner_mutex);
+  p->owners.erase(owner);
+}
+
+void MemoryStats::SetBudget(Category category, size_t bytes) {
+  Private::Get()->counters[category].budget.store(bytes, std::memory_order_relaxed);
+}
+
+size_t MemoryStats::GetBudget(Category category) {
+  return Private::Get()->counters[category].budget.load(std::memory_order_relaxed);
+}
+
+bool MemoryStats::IsOverBudget(Category category) {
+  Private *p = Private::Get();
+  size_t budget = p->counters[category].budget.load(std::memory_order_relaxed);
+  return budget > 0 && p->GetCurrent(category) > budget;
+}
+
+const char *MemoryStats::GetCategoryName(Category category) {
+  return Private::kCategoryNames[category];
+}
+
+void MemoryStats::Dump(std::ostream &out) {
+  Private *p = Private::Get();
+
+  out << "Memory usage (bytes):" << std::endl;
+  out << "  " << std::left << std::setw(14) << "category"
+      << std::right << std::setw(14) << "current"
+      << std::setw(14) << "peak"
+      << std::setw(14) << "budget" << std::endl;
+
+  for (int i = 0; i < kCategoryCount; i++) {
+    Category category = static_cast<Category>(i);
+    Usage usage = GetUsage(category);
+    size_t budget = GetBudget(category);
+
+    out << "  " << std::left << std::setw(14) << GetCategoryName(category)
+        << std::right << std::setw(14) << usage.current
+        << std::setw(14) << usage.peak
+        << std::setw(14) << budget;
+    if (budget > 0 && usage.current > budget) out << "  over budget";
+    out << std::endl;
+  }
+
+  out << "  " << std::left << std::setw(14) << "total"
+      << std::right << std::setw(14) << GetTotalUsage() << std::endl;
+
+  std::lock_guard<std::mutex> lock(p->owner_mutex);
+  for (const auto &pair : p->owners) {
+    const Private::Owner &owner = pair.second;
+
+    size_t total = 0;
+    for (int i = 0; i < kCategoryCount; i++) {
+      if (i != kBuffer) total += owner.usage[i].current;
+    }
+
+    out << "  owner " << pair.first;
+    if (!owner.name.empty()) out << " \"" << owner.name << "\"";
+    out << ": " << total << std::endl;
+
+    for (int i = 0; i < kCategoryCount; i++) {
+      const Usage &usage = owner.usage[i];
+      if (0 == usage.peak) continue;
+
+      out << "    " << std::left << std::setw(12) << Private::kCategoryNames[i]
+          << std::right << std::setw(14) << usage.current
+          << std::setw(14) << usage.peak << std::endl;
+    }
+  }
+}
+
+bool MemoryStats::StartPeriodicDump(int interval_ms, const std::string &filename) {
+  Private *p = Private::Get();
+  std::lock_guard<std::mutex> lock(p->dump_mutex);
+
+  if (p->dump_running) return false;
+
+  if (!filename.empty()) {
+    p->dump_file = new std::ofstream(filename, std::ios::app);
+    if (!p->dump_file->is_open()) {
+      delete p->dump_file;
+      p->dump_file = nullptr;
+      return false;
+    }
+  }
+
+  p->dump_interval_ms = interval_ms;
+  p->dump_running = true;
+  p->dump_thread = std::thread(&Private::RunPeriodicDump, p);
+  return true;
+}
+
+void MemoryStats::StopPeriodicDump() {
+  Private *p = Private::Get();
+
+  {
+    std::lock_guard<std::mutex> lock(p->dump_mutex);
+    if (!p->dump_running) return;
+    p->dump_running = false;
+  }
+
+  p->dump_condition.notify_one();
+  p->dump_thread.join();
+
+  delete p->dump_file;
+  p->dump_file = nullptr;
+}
+
+void MemoryStats::Reset() {
+  Private *p = Private::Get();
+
+  for (int i = 0; i < kCategoryCount; i++) {
+    Private::Counter &counter = p->counters[i];
+    counter.current.store(0, std::memory_order_relaxed);
+    counter.peak.store(0, std::memory_order_relaxed);
+    counter.budget.store(0, std::memory_order_relaxed);
+    counter.probe.store(nullptr, std::memory_order_relaxed);
+  }
+
+  std::lock_guard<std::mutex> lock(p->owner_mutex);
+  p->owners.clear();
+}
+
+} // namespace core
+} // namespace skland
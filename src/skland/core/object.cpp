@@ -26,7 +26,8 @@ Object::Object()
       first_child_(nullptr),
       last_child_(nullptr),
       parent_(nullptr),
-      children_count_(0) {
+      children_count_(0),
+      index_(-1) {
 }
 
 Object::~Object() {
@@ -47,25 +48,9 @@ Object::~Object() {
 Object *Object::GetChildAt(int index) const {
   if (index < 0) index = children_count_ + index;
 
-  Object *object = nullptr;
-  int mid = (children_count_ + 1) / 2;
+  if (index < 0 || index >= children_count_) return nullptr;
 
-  if (index >= 0 && index < mid) {
-    object = first_child_;
-    while (index > 0) {
-      object = object->next_;
-      index--;
-    }
-  } else if (index >= mid && index < children_count_) {
-    object = last_child_;
-    int max = children_count_ - 1;
-    while (index < max) {
-      object = object->previous_;
-      index++;
-    }
-  }
-
-  return object;
+  return children_index_.Get(index, children_count_, first_child_, last_child_);
 }
 
 void Object::PushFrontChild(Object *child) {
@@ -95,6 +80,7 @@ void Object::PushFrontChild(Object *child) {
   // child->previous_ = nullptr;
   child->parent_ = this;
   children_count_++;
+  children_index_.OnInserted(child);
 
   child->OnAddedToParent();
 }
@@ -121,11 +107,8 @@ void Object::InsertChild(Object *child, int index) {
     first_child_ = child;
   } else {
     if (index >= 0) {
-      Object *p = first_child_;
-      while (p && (index > 0)) {
-        p = p->next_;
-        index--;
-      }
+      Object *p = index < children_count_ ?
+                  children_index_.Get(index, children_count_, first_child_, last_child_) : nullptr;
       if (p) {  // insert before p
         child->previous_ = p->previous_;
         child->next_ = p;
@@ -161,6 +144,7 @@ void Object::InsertChild(Object *child, int index) {
 
   child->parent_ = this;
   children_count_++;
+  children_index_.OnInserted(child);
 
   child->OnAddedToParent();
 }
@@ -192,6 +176,7 @@ void Object::PushBackChild(Object *child) {
   // child->next_ = nullptr;
   child->parent_ = this;
   children_count_++;
+  children_index_.OnInserted(child);
 
   child->OnAddedToParent();
 }
@@ -201,6 +186,8 @@ Object *Object::RemoveChild(Object *child) {
 
   _ASSERT(children_count_ > 0);
 
+  children_index_.OnRemoving(child);
+
   if (child->previous_) {
     child->previous_->next_ = child->next_;
   } else {
@@ -243,6 +230,7 @@ void Object::ClearChildren() {
   children_count_ = 0;
   first_child_ = nullptr;
   last_child_ = nullptr;
+  children_index_.Clear();
 }
 
 void Object::OnAddedToParent() {
@@ -259,6 +247,9 @@ bool Object::SwapIndex(Object *object1, Object *object2) {
   if (object1->parent_ != object2->parent_) return false;
   if (object1->parent_ == nullptr) return false;
 
+  object1->parent_->children_index_.InvalidateFrom(object1);
+  object1->parent_->children_index_.InvalidateFrom(object2);
+
   Object *tmp1 = nullptr;
   Object *tmp2 = nullptr;
 
@@ -335,6 +326,9 @@ bool Object::InsertSiblingBefore(Object *src, Object *dst) {
         return true;
       }
 
+      src->parent_->children_index_.InvalidateFrom(src);
+      src->parent_->children_index_.InvalidateFrom(dst);
+
       if (dst->previous_) {
         dst->previous_->next_ = dst->next_;
       } else {
@@ -387,6 +381,7 @@ bool Object::InsertSiblingBefore(Object *src, Object *dst) {
 
   dst->parent_ = src->parent_;
   src->parent_->children_count_++;
+  src->parent_->children_index_.OnInserted(dst);
 
   return true;
 }
@@ -403,6 +398,9 @@ bool Object::InsertSiblingAfter(Object *src, Object *dst) {
         return true;
       }
 
+      src->parent_->children_index_.InvalidateFrom(src);
+      src->parent_->children_index_.InvalidateFrom(dst);
+
       if (dst->previous_) {
         dst->previous_->next_ = dst->next_;
       } else {
@@ -456,6 +454,7 @@ bool Object::InsertSiblingAfter(Object *src, Object *dst) {
 
   dst->parent_ = src->parent_;
   src->parent_->children_count_++;
+  src->parent_->children_index_.OnInserted(dst);
 
   return true;
 }
@@ -468,6 +467,8 @@ void Object::MoveToFirst(Object *object) {
       return;    // already at first
     }
 
+    object->parent_->children_index_.Invalidate();
+
     object->previous_->next_ = object->next_;
     if (object->next_) {
       object->next_->previous_ = object->previous_;
@@ -491,6 +492,8 @@ void Object::MoveToLast(Object *object) {
       return;    // already at last
     }
 
+    object->parent_->children_index_.OnRemoving(object);
+
     object->next_->previous_ = object->previous_;
 
     if (object->previous_) {
@@ -504,6 +507,7 @@ void Object::MoveToLast(Object *object) {
     object->previous_ = object->parent_->last_child_;
     object->parent_->last_child_->next_ = object;
     object->parent_->last_child_ = object;
+    object->parent_->children_index_.OnInserted(object);
   }
 }
 
@@ -512,6 +516,8 @@ void Object::MoveForward(Object *object) {
 
     if (object->next_) {
 
+      object->parent_->children_index_.InvalidateFrom(object);
+
       Object *tmp = object->next_;
 
       tmp->previous_ = object->previous_;
@@ -553,6 +559,8 @@ void Object::MoveBackward(Object *object) {
 
     if (object->previous_) {
 
+      object->parent_->children_index_.InvalidateFrom(object->previous_);
+
       Object *tmp = object->previous_;
 
       tmp->next_ = object->next_;
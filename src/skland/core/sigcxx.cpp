@@ -50,19 +50,7 @@ Binding::~Binding() {
 }
 
 Token::~Token() {
-  if (trackable) trackable->AuditDestroyingToken(this);
-
-  _ASSERT(nullptr == slot_mark_head.previous());
-  Slot::Mark *mark = nullptr;
-  while (nullptr != slot_mark_head.next()) {
-    mark = static_cast<Slot::Mark *>(slot_mark_head.next());
-    mark->slot()->token_ = next;
-    mark->slot()->skip_ = true;
-    mark->Unlink();
-  }
-
-  if (previous) previous->next = next;
-  if (next) next->previous = previous;
+  Unlink();
 
   if (binding) {
 #ifdef DEBUG
@@ -73,6 +61,18 @@ Token::~Token() {
   }
 }
 
+void Token::Unlink() {
+  if (trackable) {
+    trackable->AuditDestroyingToken(this);
+    trackable = nullptr;
+  }
+
+  if (previous) previous->next = next;
+  if (next) next->previous = previous;
+  previous = nullptr;
+  next = nullptr;
+}
+
 }  // namespace details
 
 Trackable::~Trackable() {
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "skland/core/signal-queue.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+namespace skland {
+namespace core {
+
+namespace {
+
+thread_local SignalQueue *current_queue = nullptr;
+
+}
+
+SignalQueue::SignalQueue()
+    : fd_(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)),
+      notified_(false) {
+  if (fd_ < 0) {
+    _DEBUG("%s\n", "Fail to create eventfd!");
+  }
+}
+
+SignalQueue::~SignalQueue() {
+  Call *call = nullptr;
+  while (nullptr != (call = queue_.Pop())) {
+    delete call;
+  }
+
+  if (fd_ >= 0) close(fd_);
+  if (current_queue == this) current_queue = nullptr;
+}
+
+void SignalQueue::Post(Call *call) {
+  queue_.Push(call);
+
+  // Only wake up the event loop when the queue was idle
+  if (!notified_.exchange(true, std::memory_order_acq_rel)) {
+    uint64_t value = 1;
+    if (write(fd_, &value, sizeof(uint64_t)) != sizeof(uint64_t)) {
+      _DEBUG("%s\n", "Fail to write event fd!");
+    }
+  }
+}
+
+int SignalQueue::Dispatch() {
+  uint64_t value = 0;
+  if (read(fd_, &value, sizeof(uint64_t)) != sizeof(uint64_t)) {
+    // Nothing to do, the queue may be dispatched without waiting the fd
+  }
+
+  // Calls posted after this point will write the eventfd again
+  notified_.exchange(false, std::memory_order_acq_rel);
+
+  int count = 0;
+  Call *call = nullptr;
+  while (nullptr != (call = queue_.Pop())) {
+    call->Run();
+    delete call;
+    count++;
+  }
+
+  return count;
+}
+
+SignalQueue *SignalQueue::GetCurrent() {
+  return current_queue;
+}
+
+void SignalQueue::SetCurrent(SignalQueue *queue) {
+  current_queue = queue;
+}
+
+} // namespace core
+} // namespace skland
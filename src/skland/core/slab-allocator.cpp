@@ -0,0 +1,152 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "skland/core/slab-allocator.hpp"
+
+namespace skland {
+namespace core {
+
+/**
+ * @brief The alignment of each block
+ */
+static const size_t kAlignment = alignof(std::max_align_t);
+
+static constexpr size_t Align(size_t size) {
+  return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+SlabAllocator::SlabAllocator(size_t block_size, size_t blocks_per_chunk)
+    : block_size_(Align(block_size < sizeof(Block) ? sizeof(Block) : block_size)),
+      blocks_per_chunk_(blocks_per_chunk > 0 ? blocks_per_chunk : 1),
+      free_list_(nullptr),
+      chunks_(nullptr),
+      allocation_count_(0),
+      deallocation_count_(0),
+      chunk_count_(0),
+      peak_in_use_count_(0) {
+}
+
+/**
+ * @brief The size of the chunk pointer before each block
+ */
+static const size_t kHeaderSize = Align(sizeof(void *));
+
+SlabAllocator::~SlabAllocator() {
+  if (GetInUseCount() > 0) {
+    _DEBUG("%zu blocks of %zu bytes are still in use, release them when freed\n",
+           GetInUseCount(), block_size_);
+  }
+
+  Chunk *chunk = nullptr;
+  while (chunks_) {
+    chunk = chunks_;
+    chunks_ = chunks_->next;
+
+    if (chunk->in_use_count > 0) {
+      chunk->owner = nullptr;
+      chunk->next = nullptr;
+    } else {
+      ::operator delete(chunk);
+    }
+  }
+}
+
+void *SlabAllocator::Allocate() {
+  if (nullptr == free_list_) AllocateChunk();
+
+  Block *block = free_list_;
+  free_list_ = block->next;
+
+  GetChunkOf(block)->in_use_count++;
+
+  allocation_count_++;
+  if (GetInUseCount() > peak_in_use_count_) peak_in_use_count_ = GetInUseCount();
+
+  return block;
+}
+
+void SlabAllocator::Deallocate(void *ptr) {
+  if (nullptr == ptr) return;
+
+  _ASSERT(GetInUseCount() > 0);
+  _ASSERT(GetChunkOf(ptr)->owner == this);
+
+  GetChunkOf(ptr)->in_use_count--;
+
+  Block *block = static_cast<Block *>(ptr);
+  block->next = free_list_;
+  free_list_ = block;
+
+  deallocation_count_++;
+}
+
+void *SlabAllocator::AllocateFromHeap(size_t size) {
+  char *memory = static_cast<char *>(::operator new(kHeaderSize + size));
+  void *ptr = memory + kHeaderSize;
+  GetChunkOf(ptr) = nullptr;
+  return ptr;
+}
+
+void SlabAllocator::Free(void *ptr) {
+  if (nullptr == ptr) return;
+
+  Chunk *chunk = GetChunkOf(ptr);
+
+  if (nullptr == chunk) {
+    ::operator delete(static_cast<char *>(ptr) - kHeaderSize);
+    return;
+  }
+
+  if (chunk->owner) {
+    chunk->owner->Deallocate(ptr);
+    return;
+  }
+
+  // The allocator was destroyed, release the chunk with its last block
+  _ASSERT(chunk->in_use_count > 0);
+  chunk->in_use_count--;
+  if (0 == chunk->in_use_count) ::operator delete(chunk);
+}
+
+SlabAllocator::Chunk *&SlabAllocator::GetChunkOf(void *ptr) {
+  return *reinterpret_cast<Chunk **>(static_cast<char *>(ptr) - kHeaderSize);
+}
+
+void SlabAllocator::AllocateChunk() {
+  size_t header = Align(sizeof(Chunk));
+  size_t slot_size = kHeaderSize + block_size_;
+  char *memory = static_cast<char *>(::operator new(header + slot_size * blocks_per_chunk_));
+
+  Chunk *chunk = reinterpret_cast<Chunk *>(memory);
+  chunk->next = chunks_;
+  chunk->owner = this;
+  chunk->in_use_count = 0;
+  chunks_ = chunk;
+  chunk_count_++;
+
+  // Push blocks in reverse order so that they are allocated in address order
+  Block *block = nullptr;
+  for (size_t i = blocks_per_chunk_; i > 0; i--) {
+    block = reinterpret_cast<Block *>(memory + header + slot_size * (i - 1) + kHeaderSize);
+    GetChunkOf(block) = chunk;
+    block->next = free_list_;
+    free_list_ = block;
+  }
+}
+
+} // namespace core
+} // namespace skland
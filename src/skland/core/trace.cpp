@@ -15,71 +15,410 @@
  */
 
 #include <skland/core/trace.hpp>
+#include <skland/core/spsc-ring.hpp>
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <stdarg.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 
 namespace skland {
+namespace core {
+
+/**
+ * @brief The per-thread ring of records
+ *
+ * A buffer is created when a thread records its first event, and retired
+ * when the thread exits. It's deleted by the consumer after all records in a
+ * retired buffer were written.
+ */
+struct Tracer::Buffer {
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(Buffer);
+  Buffer() = delete;
+
+  Buffer(size_t size, int tid)
+      : ring(size), thread_id(tid), dropped(0), retired(false) {}
+
+  ~Buffer() {}
+
+  SPSCRing<Record> ring;
+
+  int thread_id;
+
+  std::atomic<size_t> dropped;
+
+  std::atomic<bool> retired;
+
+};
+
+namespace {
+
+/**
+ * @brief Marks the buffer of a thread as retired when the thread exits
+ */
+struct BufferHolder {
+
+  BufferHolder()
+      : buffer(nullptr) {}
+
+  ~BufferHolder();
+
+  Tracer::Buffer *buffer;
+
+};
+
+/**
+ * @brief Global tracer state, guarded by mutex
+ *
+ * The mutex also makes sure there's only one consumer of the rings at a time,
+ * producers only lock it once per thread to register the buffer.
+ */
+struct State {
+
+  State()
+      : file(nullptr),
+        running(false),
+        first_event(true),
+        start_time(0),
+        buffer_size(16384),
+        dropped(0),
+        filename("trace.json") {}
+
+  std::mutex mutex;
+
+  std::condition_variable condition;
+
+  std::vector<Tracer::Buffer *> buffers;
 
-std::string Trace::kFileName = "trace.log";
+  std::thread thread;
 
-int Trace::kDepth = 0;
+  FILE *file;
 
-// arbitrarily support nesting 34 deep for no particular reason
-const char *Trace::kNestString = "| | | | | | | | | | | | | | | | | | | | | | | | | | | | | | | | | | ";
+  bool running;
 
-time_t Trace::kLastTime = 0;
+  bool first_event;
+
+  int64_t start_time;
+
+  size_t buffer_size;
+
+  /** Dropped records in deleted buffers */
+  size_t dropped;
+
+  std::string filename;
+
+};
+
+/**
+ * @brief Never destroyed, threads may still record events at exit
+ */
+State *GetState() {
+  static State *state = new State;
+  return state;
+}
+
+int GetThreadId() {
+#ifdef __linux__
+  return static_cast<int>(syscall(SYS_gettid));
+#else
+  static std::atomic<int> count(0);
+  return ++count;
+#endif
+}
+
+void WriteString(FILE *file, const char *str) {
+  fputc('"', file);
+  for (const char *p = str; *p; ++p) {
+    switch (*p) {
+      case '"': fputs("\\\"", file);
+        break;
+      case '\\': fputs("\\\\", file);
+        break;
+      case '\n': fputs("\\n", file);
+        break;
+      case '\t': fputs("\\t", file);
+        break;
+      default: {
+        if (static_cast<unsigned char>(*p) < 0x20) fprintf(file, "\\u%04x", *p);
+        else fputc(*p, file);
+        break;
+      }
+    }
+  }
+  fputc('"', file);
+}
+
+void WriteRecord(State *state, const Tracer::Record &record, int pid, int tid) {
+  FILE *file = state->file;
+
+  if (state->first_event) {
+    state->first_event = false;
+    fputs("\n", file);
+  } else {
+    fputs(",\n", file);
+  }
+
+  fputs("{\"name\":", file);
+  WriteString(file, record.name);
+  fprintf(file, ",\"cat\":\"skland\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d",
+          record.phase, (record.timestamp - state->start_time) / 1000.0, pid, tid);
+
+  switch (record.phase) {
+    case Tracer::kPhaseComplete: {
+      fprintf(file, ",\"dur\":%.3f", record.value / 1000.0);
+      break;
+    }
+    case Tracer::kPhaseInstant: {
+      fputs(",\"s\":\"t\"", file);
+      break;
+    }
+    case Tracer::kPhaseCounter: {
+      fprintf(file, ",\"args\":{\"value\":%lld}", static_cast<long long>(record.value));
+      break;
+    }
+    default: break;
+  }
+
+  if (record.message[0] != '\0') {
+    fputs(",\"args\":{\"message\":", file);
+    WriteString(file, record.message);
+    fputs("}", file);
+  }
+
+  fputs("}", file);
+}
+
+/**
+ * @brief Pop all records and write them to file, must be called with the
+ * mutex locked
+ */
+void Drain(State *state) {
+  int pid = static_cast<int>(getpid());
+  Tracer::Record record;
+
+  for (auto it = state->buffers.begin(); it != state->buffers.end();) {
+    Tracer::Buffer *buffer = *it;
+    bool retired = buffer->retired.load(std::memory_order_acquire);
+
+    while (buffer->ring.Pop(&record)) {
+      if (nullptr != state->file) WriteRecord(state, record, pid, buffer->thread_id);
+    }
+
+    if (retired) {
+      state->dropped += buffer->dropped.load(std::memory_order_relaxed);
+      delete buffer;
+      it = state->buffers.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (nullptr != state->file) fflush(state->file);
+}
 
-Trace::Trace(const char *func_name, const char *format, ...) {
-  char str[kBufferSize] = {0};
-  sprintf(str, "%s: %s", func_name, format);
+void Run(State *state) {
+  std::unique_lock<std::mutex> lock(state->mutex);
+  while (state->running) {
+    state->condition.wait_for(lock, std::chrono::milliseconds(100));
+    Drain(state);
+  }
+}
+
+BufferHolder::~BufferHolder() {
+  if (nullptr != buffer) buffer->retired.store(true, std::memory_order_release);
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::kEnabled(false);
+
+bool Tracer::Start(const std::string &filename, size_t buffer_size) {
+  State *state = GetState();
+  std::lock_guard<std::mutex> lock(state->mutex);
+
+  if (state->running) return false;
+
+  if (!filename.empty()) state->filename = filename;
+  state->file = fopen(state->filename.c_str(), "w");
+  if (nullptr == state->file) return false;
+
+  // Discard the records left from the last session
+  FILE *file = state->file;
+  state->file = nullptr;
+  Drain(state);
+  state->file = file;
+
+  state->dropped = 0;
+  for (Buffer *buffer : state->buffers) buffer->dropped.store(0, std::memory_order_relaxed);
+
+  fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", state->file);
+  state->first_event = true;
+  state->buffer_size = buffer_size;
+  state->start_time = GetTimestamp();
+  state->running = true;
+  state->thread = std::thread(Run, state);
+
+  kEnabled.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+void Tracer::Stop() {
+  State *state = GetState();
+
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (!state->running) return;
+    kEnabled.store(false, std::memory_order_relaxed);
+    state->running = false;
+  }
+
+  state->condition.notify_one();
+  state->thread.join();
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  Drain(state);
+  fputs("\n]}\n", state->file);
+  fclose(state->file);
+  state->file = nullptr;
+}
+
+void Tracer::Flush() {
+  State *state = GetState();
+  std::lock_guard<std::mutex> lock(state->mutex);
+  Drain(state);
+}
+
+void Tracer::Begin(const char *name, const char *message) {
+  Record record;
+  record.timestamp = GetTimestamp();
+  record.name = name;
+  record.value = 0;
+  record.phase = kPhaseBegin;
+  record.message[0] = '\0';
+  if (nullptr != message) {
+    strncpy(record.message, message, sizeof(record.message) - 1);
+    record.message[sizeof(record.message) - 1] = '\0';
+  }
+  Push(record);
+}
+
+void Tracer::End(const char *name) {
+  Record record;
+  record.timestamp = GetTimestamp();
+  record.name = name;
+  record.value = 0;
+  record.phase = kPhaseEnd;
+  record.message[0] = '\0';
+  Push(record);
+}
+
+void Tracer::Complete(const char *name, int64_t start, int64_t duration) {
+  Record record;
+  record.timestamp = start;
+  record.name = name;
+  record.value = duration;
+  record.phase = kPhaseComplete;
+  record.message[0] = '\0';
+  Push(record);
+}
+
+void Tracer::Instant(const char *name, const char *message) {
+  Record record;
+  record.timestamp = GetTimestamp();
+  record.name = name;
+  record.value = 0;
+  record.phase = kPhaseInstant;
+  record.message[0] = '\0';
+  if (nullptr != message) {
+    strncpy(record.message, message, sizeof(record.message) - 1);
+    record.message[sizeof(record.message) - 1] = '\0';
+  }
+  Push(record);
+}
+
+void Tracer::Counter(const char *name, int64_t value) {
+  Record record;
+  record.timestamp = GetTimestamp();
+  record.name = name;
+  record.value = value;
+  record.phase = kPhaseCounter;
+  record.message[0] = '\0';
+  Push(record);
+}
+
+size_t Tracer::GetDroppedCount() {
+  State *state = GetState();
+  std::lock_guard<std::mutex> lock(state->mutex);
+
+  size_t count = state->dropped;
+  for (Buffer *buffer : state->buffers) {
+    count += buffer->dropped.load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+void Tracer::Push(const Record &record) {
+  if (!IsEnabled()) return;
+
+  Buffer *buffer = GetThreadBuffer();
+  if (!buffer->ring.Push(record)) buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+Tracer::Buffer *Tracer::GetThreadBuffer() {
+  static thread_local BufferHolder holder;
+
+  if (nullptr == holder.buffer) {
+    State *state = GetState();
+    std::lock_guard<std::mutex> lock(state->mutex);
+    holder.buffer = new Buffer(state->buffer_size, GetThreadId());
+    state->buffers.push_back(holder.buffer);
+  }
+
+  return holder.buffer;
+}
+
+} // namespace core
+
+Trace::Trace(const char *func_name, const char *format, ...)
+    : func_name_(nullptr) {
+  if (!core::Tracer::IsEnabled()) return;
+
+  char message[sizeof(core::Tracer::Record::message)];
   va_list args;
   va_start(args, format);
-  SaveLine(kDepth, kDepth * 2, str, args);
+  vsnprintf(message, sizeof(message), format, args);
   va_end(args);
-  ++kDepth;
+
+  core::Tracer::Begin(func_name, message);
+  func_name_ = func_name;
 }
 
 void Trace::Log(const char *func_name, const char *format, ...) {
-  char str[kBufferSize] = {0};
-  sprintf(str, "%s: %s", func_name, format);
+  if (!core::Tracer::IsEnabled()) return;
+
+  char message[sizeof(core::Tracer::Record::message)];
   va_list args;
   va_start(args, format);
-  SaveLine(kDepth, kDepth * 2, str, args);
+  vsnprintf(message, sizeof(message), format, args);
   va_end(args);
+
+  core::Tracer::Instant(func_name, message);
 }
 
 void Trace::SetFileName(const std::string &filename) {
-  kFileName = filename;
+  core::State *state = core::GetState();
+  std::lock_guard<std::mutex> lock(state->mutex);
+  state->filename = filename;
 }
 
-int Trace::SaveLine(int depth, int align, const char *format, va_list args) {
-  // TODO: make sure method is thread save
-
-  FILE *fp = fopen(kFileName.c_str(), "a+");
-  if (fp == NULL) return 0;
-
-  time_t t;
-  time(&t);
-
-  // TODO: use std::locale
-  char time_stamp[32] = {0};
-  strftime(time_stamp, sizeof(time_stamp),
-           "%Y%m%d.%H%M%S", localtime(&t));
-
-  // only log the timestamp when the time changes
-  int len = fprintf(fp, "%s %*.*s> (%d) ",
-                    (kLastTime != t) ? time_stamp : "               ",
-                    align,
-                    align,
-                    kNestString,
-                    depth);
-  kLastTime = t;
-  len += vfprintf(fp, format, args);
-  len += fwrite("\n", 1, 1, fp);
-  fflush(fp);
-  fclose(fp);
-
-  return len;
 }
-
-}
\ No newline at end of file
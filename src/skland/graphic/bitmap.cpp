@@ -14,18 +14,44 @@
  * limitations under the License.
  */
 
-#include <OpenImageIO/imagebuf.h>
 #include "internal/bitmap_private.hpp"
 #include "internal/image-info_private.hpp"
+#include "internal/image-cache_private.hpp"
 
 #include "skland/core/memory.hpp"
+#include "skland/graphic/image-writer.hpp"
 
-#include "OpenImageIO/imageio.h"
-#include "OpenImageIO/imagebufalgo.h"
+#include <cstdlib>
+#include <new>
 
 namespace skland {
 namespace graphic {
 
+void Bitmap::Private::AllocatePixels(const SkImageInfo &info) {
+  size_t row_bytes = info.minRowBytes();
+  size_t bytes = info.computeByteSize(row_bytes);
+  if (SkImageInfo::ByteSizeOverflowed(bytes)) throw std::bad_alloc();
+
+  if (0 == bytes) {
+    sk_bitmap.setInfo(info, row_bytes);
+    return;
+  }
+
+  void *pixels = std::malloc(bytes);
+  if (nullptr == pixels) throw std::bad_alloc();
+
+  // ReleasePixels() is also called if the pixels cannot be installed
+  core::MemoryStats::Add(core::MemoryStats::kBitmap, bytes);
+  sk_bitmap.installPixels(info, pixels, row_bytes, ReleasePixels, reinterpret_cast<void *>(bytes));
+}
+
+void Bitmap::Private::ReleasePixels(void *pixels, void *context) {
+  core::MemoryStats::Remove(core::MemoryStats::kBitmap, reinterpret_cast<size_t>(context));
+  std::free(pixels);
+}
+
+// ------
+
 Bitmap::Bitmap() {
   p_ = core::MakeUnique<Private>(this);
 }
@@ -46,17 +72,18 @@ Bitmap::~Bitmap() {
 }
 
 void Bitmap::AllocatePixels(const ImageInfo &info) {
-  p_->sk_bitmap.allocPixels(SkImageInfo::Make(info.width(),
-                                              info.height(),
-                                              static_cast<SkColorType>(info.color_type()),
-                                              static_cast<SkAlphaType>(info.alpha_type())));
+  p_->AllocatePixels(SkImageInfo::Make(info.width(),
+                                       info.height(),
+                                       static_cast<SkColorType>(info.color_type()),
+                                       static_cast<SkAlphaType>(info.alpha_type())));
 }
 
 void Bitmap::AllocateN32Pixels(int width, int height, bool is_opaque) {
-  p_->sk_bitmap.allocN32Pixels(width, height, is_opaque);
+  p_->AllocatePixels(SkImageInfo::MakeN32(width, height, is_opaque ? kOpaque_SkAlphaType : kPremul_SkAlphaType));
 }
 
 bool Bitmap::InstallPixels(const ImageInfo &info, void *pixels, size_t row_bytes) {
+  // Installed pixels are owned by the caller
   return p_->sk_bitmap.installPixels(SkImageInfo::Make(info.width(),
                                                        info.height(),
                                                        static_cast<SkColorType >(info.color_type()),
@@ -65,49 +92,23 @@ bool Bitmap::InstallPixels(const ImageInfo &info, void *pixels, size_t row_bytes
                                      row_bytes);
 }
 
-void Bitmap::WriteToFile(const std::string &filename) const {
-  using OIIO::ImageOutput;
-  using OIIO::ImageSpec;
-  using OIIO::TypeDesc;
-  using OIIO::ImageBuf;
-  using namespace OIIO::ImageBufAlgo;
-
-  ImageOutput *out = ImageOutput::create(filename);
-  if (nullptr == out) return;
-
-  TypeDesc::BASETYPE base_type = TypeDesc::UNKNOWN;
-  switch (p_->sk_bitmap.bytesPerPixel()) {
-    // TODO: other color type
-    case 4: {
-      base_type = TypeDesc::UINT8;
-      break;
-    }
-    default:break;
-  }
-
-  if (TypeDesc::UNKNOWN == base_type) {
-    fprintf(stderr, "Unkown image type!\n");
-    return;
-  }
-
-  // TODO: determine the number of channel
-
-  ImageSpec spec(p_->sk_bitmap.width(), p_->sk_bitmap.height(), 4, base_type);
-
-  // Use ImageBuf to convert BGRA to RGBA
-  ImageBuf bgra(spec, p_->sk_bitmap.getPixels());
-  ImageBuf rgba;
-
-  std::vector<int> channel_order = {2, 1, 0, 3};
-  channels(rgba, bgra, 4, channel_order.data());
-
-  out->open(filename, spec);
-//  out->write_image(TypeDesc::UINT8, p_->sk_bitmap.getPixels());
+bool Bitmap::Load(const std::string &path, const core::SizeI &target_size) {
+  // Loaded pixels are counted in ImageCache
+  return ImageCache::Private::Load(path, target_size, &p_->sk_bitmap);
+}
 
-  rgba.write(out);
+void Bitmap::LoadAsync(const std::string &path,
+                       const core::SizeI &target_size,
+                       const std::function<void(const Bitmap &)> &callback) {
+  ImageCache::Private::LoadAsync(path, target_size, [callback](const SkBitmap &sk_bitmap) {
+    Bitmap bitmap;
+    bitmap.p_->sk_bitmap = sk_bitmap;
+    callback(bitmap);
+  });
+}
 
-  out->close();
-  ImageOutput::destroy(out);
+void Bitmap::WriteToFile(const std::string &filename) const {
+  ImageWriter::Write(*this, filename);
 }
 
 int Bitmap::GetWidth() const {
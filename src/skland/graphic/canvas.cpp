@@ -24,6 +24,9 @@
 #include "internal/matrix_private.hpp"
 #include "internal/surface_private.hpp"
 #include "internal/image-info_private.hpp"
+#include "internal/text-layout_private.hpp"
+#include "internal/picture_private.hpp"
+#include "internal/gpu-context_private.hpp"
 
 namespace skland {
 namespace graphic {
@@ -49,6 +52,42 @@ Canvas *Canvas::CreateRasterDirect(int width, int height, unsigned char *pixels,
   return new Canvas(bitmap);
 }
 
+Canvas *Canvas::CreateGPU(GPUContext *context, int width, int height) {
+  sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context->p_->gr_context.get(),
+                                                         SkBudgeted::kNo,
+                                                         SkImageInfo::MakeN32Premul(width, height));
+  if (!surface) return nullptr;
+
+  Canvas *canvas = new Canvas;
+  canvas->p_ = core::MakeUnique<Private>(surface);
+  return canvas;
+}
+
+Canvas *Canvas::CreateGPUFramebuffer(GPUContext *context,
+                                     int width,
+                                     int height,
+                                     unsigned int framebuffer,
+                                     int sample_count,
+                                     int stencil_bits) {
+  GrBackendRenderTargetDesc desc;
+  desc.fWidth = width;
+  desc.fHeight = height;
+  desc.fConfig = kRGBA_8888_GrPixelConfig;
+  desc.fOrigin = kBottomLeft_GrSurfaceOrigin;
+  desc.fSampleCnt = sample_count;
+  desc.fStencilBits = stencil_bits;
+  desc.fRenderTargetHandle = framebuffer;
+
+  sk_sp<SkSurface> surface = SkSurface::MakeFromBackendRenderTarget(context->p_->gr_context.get(),
+                                                                    desc,
+                                                                    nullptr);
+  if (!surface) return nullptr;
+
+  Canvas *canvas = new Canvas;
+  canvas->p_ = core::MakeUnique<Private>(surface);
+  return canvas;
+}
+
 Canvas::Canvas() {
   p_ = core::MakeUnique<Private>();
 }
@@ -74,18 +113,22 @@ Canvas::Canvas(const Bitmap &bitmap) {
   p_ = core::MakeUnique<Private>(bitmap.p_->sk_bitmap);
 }
 
+Canvas::Canvas(SkCanvas *sk_canvas) {
+  p_ = core::MakeUnique<Private>(sk_canvas);
+}
+
 Canvas::~Canvas() {
 
 }
 
 void Canvas::SetOrigin(float x, float y) {
-  p_->sk_canvas.translate(x - p_->origin.x, y - p_->origin.y);
+  p_->sk_canvas->translate(x - p_->origin.x, y - p_->origin.y);
   p_->origin.x = x;
   p_->origin.y = y;
 }
 
 Surface *Canvas::CreateSurface(const ImageInfo &info) {
-  sk_sp<SkSurface> native = p_->sk_canvas.makeSurface(SkImageInfo::Make(info.width(),
+  sk_sp<SkSurface> native = p_->sk_canvas->makeSurface(SkImageInfo::Make(info.width(),
                                                                          info.height(),
                                                                          static_cast<SkColorType >(info.color_type()),
                                                                          static_cast<SkAlphaType >(info.alpha_type())));
@@ -94,27 +137,27 @@ Surface *Canvas::CreateSurface(const ImageInfo &info) {
 }
 
 void Canvas::DrawLine(float x0, float y0, float x1, float y1, const Paint &paint) {
-  p_->sk_canvas.drawLine(x0, y0, x1, y1, paint.GetSkPaint());
+  p_->sk_canvas->drawLine(x0, y0, x1, y1, paint.GetSkPaint());
 }
 
 void Canvas::DrawRect(const RectF &rect, const Paint &paint) {
-  p_->sk_canvas.drawRect(*reinterpret_cast<const SkRect *>(&rect), paint.GetSkPaint());
+  p_->sk_canvas->drawRect(*reinterpret_cast<const SkRect *>(&rect), paint.GetSkPaint());
 }
 
 void Canvas::DrawRoundRect(const RectF &rect, float rx, float ry, const Paint &paint) {
-  p_->sk_canvas.drawRoundRect(*reinterpret_cast<const SkRect *>(&rect), rx, ry, paint.GetSkPaint());
+  p_->sk_canvas->drawRoundRect(*reinterpret_cast<const SkRect *>(&rect), rx, ry, paint.GetSkPaint());
 }
 
 void Canvas::DrawOval(const RectF &oval, const Paint &paint) {
-  p_->sk_canvas.drawOval(*reinterpret_cast<const SkRect *>(&oval), paint.GetSkPaint());
+  p_->sk_canvas->drawOval(*reinterpret_cast<const SkRect *>(&oval), paint.GetSkPaint());
 }
 
 void Canvas::DrawCircle(float x, float y, float radius, const Paint &paint) {
-  p_->sk_canvas.drawCircle(x, y, radius, paint.GetSkPaint());
+  p_->sk_canvas->drawCircle(x, y, radius, paint.GetSkPaint());
 }
 
 void Canvas::DrawArc(const RectF &oval, float start_angle, float sweep_angle, bool use_center, const Paint &paint) {
-  p_->sk_canvas.drawArc(*reinterpret_cast<const SkRect *>(&oval),
+  p_->sk_canvas->drawArc(*reinterpret_cast<const SkRect *>(&oval),
                          start_angle,
                          sweep_angle,
                          use_center,
@@ -122,115 +165,135 @@ void Canvas::DrawArc(const RectF &oval, float start_angle, float sweep_angle, bo
 }
 
 void Canvas::DrawPath(const Path &path, const Paint &paint) {
-  p_->sk_canvas.drawPath(path.GetSkPath(), paint.GetSkPaint());
+  p_->sk_canvas->drawPath(path.GetSkPath(), paint.GetSkPaint());
 }
 
 void Canvas::DrawText(const void *text, size_t byte_length, float x, float y, const Paint &paint) {
-  p_->sk_canvas.drawText(text, byte_length, x, y, paint.GetSkPaint());
+  p_->sk_canvas->drawText(text, byte_length, x, y, paint.GetSkPaint());
+}
+
+void Canvas::DrawTextLayout(const TextLayout &layout, float x, float y, const Paint &paint) {
+  layout.p_->Draw(p_->sk_canvas, x, y, paint.GetSkPaint());
 }
 
 void Canvas::DrawPaint(const Paint &paint) {
-  p_->sk_canvas.drawPaint(paint.GetSkPaint());
+  p_->sk_canvas->drawPaint(paint.GetSkPaint());
+}
+
+void Canvas::DrawPicture(const Picture &picture) {
+  if (!picture.p_->sk_picture) return;
+
+  p_->sk_canvas->drawPicture(picture.p_->sk_picture);
+}
+
+void Canvas::DrawCanvas(const Canvas &canvas, float x, float y) {
+  if (!canvas.p_->sk_surface) return;
+
+  canvas.p_->sk_surface->draw(p_->sk_canvas, x, y, nullptr);
 }
 
 void Canvas::Translate(float dx, float dy) {
-  p_->sk_canvas.translate(dx, dy);
+  p_->sk_canvas->translate(dx, dy);
 }
 
 void Canvas::Scale(float sx, float sy) {
-  p_->sk_canvas.scale(sx, sy);
+  p_->sk_canvas->scale(sx, sy);
 }
 
 void Canvas::Rotate(float degrees) {
-  p_->sk_canvas.rotate(degrees);
+  p_->sk_canvas->rotate(degrees);
 }
 
 void Canvas::Rotate(float degrees, float px, float py) {
-  p_->sk_canvas.rotate(degrees, px, py);
+  p_->sk_canvas->rotate(degrees, px, py);
 }
 
 void Canvas::Skew(float sx, float sy) {
-  p_->sk_canvas.skew(sx, sy);
+  p_->sk_canvas->skew(sx, sy);
 }
 
 void Canvas::Concat(const Matrix &matrix) {
-  p_->sk_canvas.concat(matrix.p_->sk_matrix);
+  p_->sk_canvas->concat(matrix.p_->sk_matrix);
 }
 
 void Canvas::SetMatrix(const Matrix &matrix) {
-  p_->sk_canvas.setMatrix(matrix.p_->sk_matrix);
+  p_->sk_canvas->setMatrix(matrix.p_->sk_matrix);
 }
 
 void Canvas::ResetMatrix() {
-  p_->sk_canvas.resetMatrix();
-  p_->sk_canvas.translate(p_->origin.x, p_->origin.y);
+  p_->sk_canvas->resetMatrix();
+  p_->sk_canvas->translate(p_->origin.x, p_->origin.y);
 }
 
 void Canvas::Clear(uint32_t argb) {
-  p_->sk_canvas.clear(argb);
+  p_->sk_canvas->clear(argb);
 }
 
 void Canvas::Clear(const ColorF &color) {
-  p_->sk_canvas.clear(color.argb());
+  p_->sk_canvas->clear(color.argb());
 }
 
 void Canvas::ClipRect(const RectF &rect, ClipOperation op, bool antialias) {
-  p_->sk_canvas.clipRect(reinterpret_cast<const SkRect &>(rect), static_cast<SkClipOp >(op), antialias);
+  p_->sk_canvas->clipRect(reinterpret_cast<const SkRect &>(rect), static_cast<SkClipOp >(op), antialias);
 }
 
 void Canvas::ClipRect(const RectF &rect, bool antialias) {
-  p_->sk_canvas.clipRect(reinterpret_cast<const SkRect &>(rect), antialias);
+  p_->sk_canvas->clipRect(reinterpret_cast<const SkRect &>(rect), antialias);
 }
 
 void Canvas::ClipPath(const Path &path, ClipOperation op, bool antialias) {
-  p_->sk_canvas.clipPath(path.GetSkPath(), static_cast<SkClipOp >(op), antialias);
+  p_->sk_canvas->clipPath(path.GetSkPath(), static_cast<SkClipOp >(op), antialias);
 }
 
 void Canvas::ClipPath(const Path &path, bool antilias) {
-  p_->sk_canvas.clipPath(path.GetSkPath(), antilias);
+  p_->sk_canvas->clipPath(path.GetSkPath(), antilias);
 }
 
 void Canvas::Save() {
-  p_->sk_canvas.save();
+  p_->sk_canvas->save();
 }
 
 void Canvas::SaveLayer(const RectF *bounds, const Paint *paint) {
-  p_->sk_canvas.saveLayer(reinterpret_cast<const SkRect *>(bounds),
+  p_->sk_canvas->saveLayer(reinterpret_cast<const SkRect *>(bounds),
                            nullptr == paint ? nullptr : &paint->GetSkPaint());
 }
 
 void Canvas::SaveLayer(const RectF *bounds, unsigned char alpha) {
-  p_->sk_canvas.saveLayerAlpha(reinterpret_cast<const SkRect *>(bounds), alpha);
+  p_->sk_canvas->saveLayerAlpha(reinterpret_cast<const SkRect *>(bounds), alpha);
 }
 
 void Canvas::Restore() {
   if (p_->lock_guard_deque.IsEmpty()) {
-    p_->sk_canvas.restore();
+    p_->sk_canvas->restore();
     return;
   }
 
-  if (p_->sk_canvas.getSaveCount() > p_->lock_guard_deque[-1]->depth) {
-    p_->sk_canvas.restore();
+  if (p_->sk_canvas->getSaveCount() > p_->lock_guard_deque[-1]->depth) {
+    p_->sk_canvas->restore();
   }
 }
 
 int Canvas::GetSaveCount() const {
-  return p_->sk_canvas.getSaveCount();
+  return p_->sk_canvas->getSaveCount();
 }
 
 void Canvas::RestoreToCount(int save_count) {
   if (p_->lock_guard_deque.IsEmpty()) {
-    p_->sk_canvas.restoreToCount(save_count);
+    p_->sk_canvas->restoreToCount(save_count);
     return;
   }
 
   if (save_count > p_->lock_guard_deque[-1]->depth) {
-    p_->sk_canvas.restoreToCount(save_count);
+    p_->sk_canvas->restoreToCount(save_count);
   }
 }
 
 void Canvas::Flush() {
-  p_->sk_canvas.flush();
+  p_->sk_canvas->flush();
+}
+
+bool Canvas::ReadPixels(Bitmap *bitmap, int src_x, int src_y) {
+  return p_->sk_canvas->readPixels(bitmap->p_->sk_bitmap, src_x, src_y);
 }
 
 const PointF &Canvas::GetOrigin() const {
@@ -238,7 +301,7 @@ const PointF &Canvas::GetOrigin() const {
 }
 
 SkCanvas *Canvas::GetSkCanvas() const {
-  return &p_->sk_canvas;
+  return p_->sk_canvas;
 }
 
 // ----------
@@ -250,7 +313,7 @@ Canvas::LockGuard::~LockGuard() {
       it.Remove();
       it = canvas_->p_->lock_guard_deque.rbegin();
     }
-    canvas_->p_->sk_canvas.restoreToCount(node_.depth);
+    canvas_->p_->sk_canvas->restoreToCount(node_.depth);
   }
 }
 
@@ -298,7 +361,7 @@ void Canvas::LockGuard::Unlock() {
     it.Remove();
     it = canvas_->p_->lock_guard_deque.rbegin();
   }
-  canvas_->p_->sk_canvas.restoreToCount(node_.depth);
+  canvas_->p_->sk_canvas->restoreToCount(node_.depth);
   node_.Unlink();
 }
 
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "internal/font-cache_private.hpp"
+
+#include "SkGraphics.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <utility>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+
+namespace skland {
+namespace graphic {
+
+namespace {
+
+typedef std::pair<std::string, uint32_t> TypefaceKey;
+
+struct FontKey {
+
+  bool operator<(const FontKey &other) const {
+    if (typeface_id != other.typeface_id) return typeface_id < other.typeface_id;
+    if (size != other.size) return size < other.size;
+    if (mask_type != other.mask_type) return mask_type < other.mask_type;
+    return flags < other.flags;
+  }
+
+  uint32_t typeface_id;
+
+  uint32_t size;
+
+  int mask_type;
+
+  uint32_t flags;
+
+};
+
+struct FontCacheData {
+
+  FontCacheData() = default;
+
+  ~FontCacheData() {
+    if (warm_up_thread.joinable()) warm_up_thread.join();
+  }
+
+  std::mutex mutex;
+
+  /**
+   * @brief Notified when a pending typeface is resolved
+   */
+  std::condition_variable resolved;
+
+  std::map<TypefaceKey, sk_sp<SkTypeface> > typefaces;
+
+  /**
+   * @brief Typefaces being resolved in another thread
+   */
+  std::set<TypefaceKey> pending;
+
+  std::map<FontKey, sk_sp<SkFont> > fonts;
+
+  std::vector<std::pair<std::string, FontStyle> > warm_up_list;
+
+  std::thread warm_up_thread;
+
+  uint64_t hit_count = 0;
+
+  uint64_t miss_count = 0;
+
+};
+
+FontCacheData &GetFontCacheData() {
+  static FontCacheData data;
+  return data;
+}
+
+uint32_t GetStyleValue(const FontStyle &font_style) {
+  uint32_t value = 0;
+  memcpy(&value, &font_style, sizeof(value));
+  return value;
+}
+
+}
+
+sk_sp<SkTypeface> FontCache::Private::GetTypeface(const char *family_name, const FontStyle &font_style) {
+  FontCacheData &data = GetFontCacheData();
+  TypefaceKey key(nullptr == family_name ? std::string() : std::string(family_name), GetStyleValue(font_style));
+
+  std::unique_lock<std::mutex> lock(data.mutex);
+  while (true) {
+    auto it = data.typefaces.find(key);
+    if (it != data.typefaces.end()) {
+      data.hit_count++;
+      return it->second;
+    }
+    if (data.pending.find(key) == data.pending.end()) break;
+    data.resolved.wait(lock);
+  }
+
+  data.miss_count++;
+  data.pending.insert(key);
+  lock.unlock();
+
+  // fontconfig matching is done without holding the lock
+  sk_sp<SkTypeface> typeface =
+      SkTypeface::MakeFromName(family_name, *reinterpret_cast<const SkFontStyle *>(&font_style));
+
+  lock.lock();
+  data.typefaces[key] = typeface;
+  data.pending.erase(key);
+  lock.unlock();
+  data.resolved.notify_all();
+
+  return typeface;
+}
+
+sk_sp<SkFont> FontCache::Private::GetFont(const sk_sp<SkTypeface> &typeface,
+                                          float size,
+                                          SkFont::MaskType mask_type,
+                                          uint32_t flags) {
+  FontCacheData &data = GetFontCacheData();
+
+  FontKey key;
+  key.typeface_id = typeface ? typeface->uniqueID() : 0;
+  memcpy(&key.size, &size, sizeof(key.size));
+  key.mask_type = mask_type;
+  key.flags = flags;
+
+  std::lock_guard<std::mutex> lock(data.mutex);
+  auto it = data.fonts.find(key);
+  if (it != data.fonts.end()) return it->second;
+
+  sk_sp<SkFont> font = SkFont::Make(typeface, size, mask_type, flags);
+  data.fonts[key] = font;
+  return font;
+}
+
+void FontCache::AddWarmUpFont(const char *family_name, FontStyle font_style) {
+  FontCacheData &data = GetFontCacheData();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  data.warm_up_list.push_back(std::make_pair(std::string(family_name), font_style));
+}
+
+void FontCache::WarmUp(bool async) {
+  FontCacheData &data = GetFontCacheData();
+  std::vector<std::pair<std::string, FontStyle> > list;
+
+  WaitForWarmUp();
+
+  {
+    std::lock_guard<std::mutex> lock(data.mutex);
+    list.swap(data.warm_up_list);
+  }
+
+  auto resolve = [](const std::vector<std::pair<std::string, FontStyle> > &list) {
+    for (size_t i = 0; i < list.size(); i++) {
+      Private::GetTypeface(list[i].first.c_str(), list[i].second);
+    }
+  };
+
+  if (async) {
+    data.warm_up_thread = std::thread(resolve, std::move(list));
+  } else {
+    resolve(list);
+  }
+}
+
+void FontCache::WaitForWarmUp() {
+  FontCacheData &data = GetFontCacheData();
+  if (data.warm_up_thread.joinable()) data.warm_up_thread.join();
+}
+
+size_t FontCache::GetTypefaceCount() {
+  FontCacheData &data = GetFontCacheData();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  return data.typefaces.size();
+}
+
+size_t FontCache::GetFontCount() {
+  FontCacheData &data = GetFontCacheData();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  return data.fonts.size();
+}
+
+uint64_t FontCache::GetHitCount() {
+  FontCacheData &data = GetFontCacheData();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  return data.hit_count;
+}
+
+uint64_t FontCache::GetMissCount() {
+  FontCacheData &data = GetFontCacheData();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  return data.miss_count;
+}
+
+size_t FontCache::GetGlyphCacheUsage() {
+  return SkGraphics::GetFontCacheUsed();
+}
+
+void FontCache::Clear() {
+  FontCacheData &data = GetFontCacheData();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  data.typefaces.clear();
+  data.fonts.clear();
+}
+
+} // namespace graphic
+} // namespace skland
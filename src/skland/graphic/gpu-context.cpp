@@ -0,0 +1,96 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "internal/gpu-context_private.hpp"
+
+#include "skland/core/memory.hpp"
+
+#include "gl/GrGLInterface.h"
+#include "gl/GrGLAssembleInterface.h"
+
+namespace skland {
+namespace graphic {
+
+namespace {
+
+struct GetGLProcData {
+
+  GPUContext::GetGLProc get_proc;
+
+  void *data;
+
+};
+
+GrGLFuncPtr GetGLFunction(void *data, const char name[]) {
+  const GetGLProcData *proc_data = static_cast<const GetGLProcData *>(data);
+  return reinterpret_cast<GrGLFuncPtr>(proc_data->get_proc(proc_data->data, name));
+}
+
+}
+
+GPUContext *GPUContext::CreateGL(GetGLProc get_proc, void *data) {
+  sk_sp<const GrGLInterface> interface;
+
+  if (nullptr == get_proc) {
+    interface.reset(GrGLCreateNativeInterface());
+  } else {
+    GetGLProcData proc_data = {get_proc, data};
+    interface.reset(GrGLAssembleInterface(&proc_data, GetGLFunction));
+  }
+
+  if (!interface) return nullptr;
+
+  sk_sp<GrContext> gr_context(GrContext::Create(kOpenGL_GrBackend, (GrBackendContext) interface.get()));
+  if (!gr_context) return nullptr;
+
+  GPUContext *context = new GPUContext;
+  context->p_->gr_context = gr_context;
+  return context;
+}
+
+GPUContext::GPUContext() {
+  p_ = core::MakeUnique<Private>();
+}
+
+GPUContext::~GPUContext() {
+
+}
+
+void GPUContext::Flush() {
+  p_->gr_context->flush();
+}
+
+void GPUContext::ResetState() {
+  p_->gr_context->resetContext();
+}
+
+void GPUContext::FreeResources() {
+  p_->gr_context->freeGpuResources();
+}
+
+void GPUContext::Abandon() {
+  p_->gr_context->abandonContext();
+}
+
+size_t GPUContext::GetResourceCacheUsage() const {
+  size_t bytes = 0;
+  p_->gr_context->getResourceCacheUsage(nullptr, &bytes);
+  return bytes;
+}
+
+} // namespace graphic
+} // namespace skland
@@ -18,14 +18,52 @@
 #include <skland/graphic/matrix.hpp>
 
 #include "internal/shader_private.hpp"
+#include "internal/paint-cache_private.hpp"
 
 #include "SkGradientShader.h"
 
+#include <string>
+
 namespace skland {
 namespace graphic {
 
 using core::PointF;
 
+namespace {
+
+/**
+ * @brief Write the parameters of a gradient into a reused key buffer
+ *
+ * The size of a color is included so gradients of uint32_t and ColorF
+ * colors never share a key.
+ */
+template<typename C>
+const std::string &MakeKey(char type,
+                           const float *geometry,
+                           size_t geometry_count,
+                           const C colors[],
+                           const float pos[],
+                           int count,
+                           Shader::TileMode mode,
+                           uint32_t flags) {
+  static thread_local std::string key;
+
+  key.clear();
+  key.push_back(type);
+  key.push_back((char) sizeof(C));
+  key.push_back((char) mode);
+  key.push_back(nullptr == pos ? 0 : 1);
+  key.append(reinterpret_cast<const char *>(&count), sizeof(count));
+  key.append(reinterpret_cast<const char *>(&flags), sizeof(flags));
+  key.append(reinterpret_cast<const char *>(geometry), sizeof(float) * geometry_count);
+  key.append(reinterpret_cast<const char *>(colors), sizeof(C) * count);
+  if (nullptr != pos) key.append(reinterpret_cast<const char *>(pos), sizeof(float) * count);
+
+  return key;
+}
+
+}
+
 Shader GradientShader::MakeLinear(const core::PointF *points,
                                   const uint32_t *colors,
                                   const float *pos,
@@ -33,6 +71,13 @@ Shader GradientShader::MakeLinear(const core::PointF *points,
                                   Shader::TileMode mode,
                                   uint32_t flags,
                                   const Matrix *local_matrix) {
+  const std::string *key = nullptr;
+  if (nullptr == local_matrix) {
+    key = &MakeKey('L', &points[0].x, 4, colors, pos, count, mode, flags);
+    sk_sp<SkShader> sk_shader = PaintCache::Private::FindShader(*key);
+    if (sk_shader) return Shader(Shader::Private(sk_shader));
+  }
+
   sk_sp<SkShader> sk_shader =
       SkGradientShader::MakeLinear(reinterpret_cast<const SkPoint *>(points),
                                    colors,
@@ -42,7 +87,8 @@ Shader GradientShader::MakeLinear(const core::PointF *points,
                                    flags,
                                    nullptr == local_matrix ? nullptr : local_matrix->GetSkMatrix());
 
-  return Shader(new Shader::Private(sk_shader));
+  if (nullptr != key && sk_shader) PaintCache::Private::AddShader(*key, sk_shader);
+  return Shader(Shader::Private(sk_shader));
 }
 
 Shader GradientShader::MakeLinear(const PointF points[],
@@ -52,6 +98,13 @@ Shader GradientShader::MakeLinear(const PointF points[],
                                   Shader::TileMode mode,
                                   uint32_t flags,
                                   const Matrix *local_matrix) {
+  const std::string *key = nullptr;
+  if (nullptr == local_matrix) {
+    key = &MakeKey('L', &points[0].x, 4, colors, pos, count, mode, flags);
+    sk_sp<SkShader> sk_shader = PaintCache::Private::FindShader(*key);
+    if (sk_shader) return Shader(Shader::Private(sk_shader));
+  }
+
   sk_sp<SkShader> sk_shader =
       SkGradientShader::MakeLinear(reinterpret_cast<const SkPoint *>(points),
                                    reinterpret_cast<const SkColor4f *>(colors),
@@ -62,7 +115,8 @@ Shader GradientShader::MakeLinear(const PointF points[],
                                    flags,
                                    nullptr == local_matrix ? nullptr : local_matrix->GetSkMatrix());
 
-  return Shader(new Shader::Private(sk_shader));
+  if (nullptr != key && sk_shader) PaintCache::Private::AddShader(*key, sk_shader);
+  return Shader(Shader::Private(sk_shader));
 }
 
 Shader GradientShader::MakeRadial(const PointF &center,
@@ -73,6 +127,14 @@ Shader GradientShader::MakeRadial(const PointF &center,
                                   Shader::TileMode mode,
                                   uint32_t flags,
                                   const Matrix *local_matrix) {
+  const std::string *key = nullptr;
+  if (nullptr == local_matrix) {
+    const float geometry[3] = {center.x, center.y, radius};
+    key = &MakeKey('R', geometry, 3, colors, pos, count, mode, flags);
+    sk_sp<SkShader> sk_shader = PaintCache::Private::FindShader(*key);
+    if (sk_shader) return Shader(Shader::Private(sk_shader));
+  }
+
   sk_sp<SkShader> sk_shader =
       SkGradientShader::MakeRadial(reinterpret_cast<const SkPoint &>(center),
                                    radius,
@@ -82,7 +144,9 @@ Shader GradientShader::MakeRadial(const PointF &center,
                                    (SkShader::TileMode) mode,
                                    flags,
                                    nullptr == local_matrix ? nullptr : local_matrix->GetSkMatrix());
-  return Shader(new Shader::Private(sk_shader));
+
+  if (nullptr != key && sk_shader) PaintCache::Private::AddShader(*key, sk_shader);
+  return Shader(Shader::Private(sk_shader));
 }
 
 Shader GradientShader::MakeRadial(const PointF &center,
@@ -93,6 +157,14 @@ Shader GradientShader::MakeRadial(const PointF &center,
                                   Shader::TileMode mode,
                                   uint32_t flags,
                                   const Matrix *local_matrix) {
+  const std::string *key = nullptr;
+  if (nullptr == local_matrix) {
+    const float geometry[3] = {center.x, center.y, radius};
+    key = &MakeKey('R', geometry, 3, colors, pos, count, mode, flags);
+    sk_sp<SkShader> sk_shader = PaintCache::Private::FindShader(*key);
+    if (sk_shader) return Shader(Shader::Private(sk_shader));
+  }
+
   sk_sp<SkShader> sk_shader =
       SkGradientShader::MakeRadial(reinterpret_cast<const SkPoint &>(center),
                                    radius,
@@ -104,7 +176,8 @@ Shader GradientShader::MakeRadial(const PointF &center,
                                    flags,
                                    nullptr == local_matrix ? nullptr : local_matrix->GetSkMatrix());
 
-  return Shader(new Shader::Private(sk_shader));
+  if (nullptr != key && sk_shader) PaintCache::Private::AddShader(*key, sk_shader);
+  return Shader(Shader::Private(sk_shader));
 }
 
 } // namespace graphic
@@ -0,0 +1,474 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "internal/image-cache_private.hpp"
+
+#include "skland/graphic/pixel-ops.hpp"
+
+#include "OpenImageIO/imageio.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace skland {
+namespace graphic {
+
+namespace {
+
+struct ImageKey {
+
+  std::string path;
+  int64_t mtime;
+  int width;
+  int height;
+
+  bool operator==(const ImageKey &other) const {
+    return mtime == other.mtime && width == other.width && height == other.height && path == other.path;
+  }
+
+};
+
+struct ImageKeyHash {
+
+  size_t operator()(const ImageKey &key) const {
+    size_t hash = std::hash<std::string>()(key.path);
+    hash = hash * 31 + std::hash<int64_t>()(key.mtime);
+    hash = hash * 31 + static_cast<size_t>(key.width);
+    hash = hash * 31 + static_cast<size_t>(key.height);
+    return hash;
+  }
+
+};
+
+struct ImageEntry {
+
+  ImageKey key;
+  SkBitmap bitmap;
+  size_t size;
+
+};
+
+bool DecodeImage(const std::string &path, const core::SizeI &target_size, SkBitmap *bitmap);
+
+/**
+ * @brief The cached images, the decode requests in flight and the worker threads
+ */
+struct ImageStore {
+
+  typedef std::list<ImageEntry> EntryList;
+  typedef std::function<void(const SkBitmap &)> Callback;
+  typedef std::vector<Callback> CallbackList;
+
+  ImageStore() = default;
+
+  ~ImageStore() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    work_cond.notify_all();
+    for (std::thread &worker: workers) worker.join();
+  }
+
+  /**
+   * @brief Find a cached image, the mutex must be locked
+   */
+  bool Find(const ImageKey &key, SkBitmap *bitmap) {
+    auto it = map.find(key);
+    if (it == map.end()) return false;
+
+    hit_count++;
+    entries.splice(entries.begin(), entries, it->second);
+    *bitmap = it->second->bitmap;
+    return true;
+  }
+
+  /**
+   * @brief Add an image to the cache, the mutex must be locked
+   */
+  void Insert(const ImageKey &key, const SkBitmap &bitmap) {
+    if (map.find(key) != map.end()) return;
+
+    ImageEntry entry;
+    entry.key = key;
+    entry.bitmap = bitmap;
+    entry.size = bitmap.rowBytes() * bitmap.height() + key.path.capacity();
+
+    usage += entry.size;
+    entries.push_front(std::move(entry));
+    map[key] = entries.begin();
+
+    Evict();
+  }
+
+  void Evict() {
+    while (usage > budget && !entries.empty()) {
+      usage -= entries.back().size;
+      map.erase(entries.back().key);
+      entries.pop_back();
+    }
+  }
+
+  /**
+   * @brief Start the worker threads on first use, the mutex must be locked
+   */
+  void StartWorkers() {
+    if (!workers.empty()) return;
+
+    // Leave one core to the main thread
+    unsigned int count = std::max(2u, std::min(std::thread::hardware_concurrency(), 4u)) - 1;
+    for (unsigned int i = 0; i < count; ++i) {
+      workers.push_back(std::thread(&ImageStore::Work, this));
+    }
+  }
+
+  void Work();
+
+  std::mutex mutex;
+
+  /** Notified when a request is queued */
+  std::condition_variable work_cond;
+
+  /** Notified when a request is done */
+  std::condition_variable done_cond;
+
+  EntryList entries;
+  std::unordered_map<ImageKey, EntryList::iterator, ImageKeyHash> map;
+
+  /** Callbacks waiting for each image being decoded */
+  std::unordered_map<ImageKey, CallbackList, ImageKeyHash> pending;
+
+  std::deque<ImageKey> queue;
+
+  std::vector<std::thread> workers;
+
+  bool stop = false;
+
+  size_t budget = 64 * 1024 * 1024;
+  size_t usage = 0;
+
+  uint64_t hit_count = 0;
+  uint64_t miss_count = 0;
+
+};
+
+void ImageStore::Work() {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while (true) {
+    work_cond.wait(lock, [this]() { return stop || !queue.empty(); });
+    if (stop) return;
+
+    ImageKey key = std::move(queue.front());
+    queue.pop_front();
+    lock.unlock();
+
+    SkBitmap bitmap;
+    if (!DecodeImage(key.path, core::SizeI(key.width, key.height), &bitmap))
+      bitmap.reset();
+
+    lock.lock();
+    if (!bitmap.isNull()) Insert(key, bitmap);
+
+    // Callbacks may be added while the others run, the key stays pending until
+    // all of them are called so WaitForIdle() covers them
+    while (true) {
+      CallbackList callbacks = std::move(pending[key]);
+      pending[key].clear();
+      if (callbacks.empty()) break;
+
+      lock.unlock();
+      for (const Callback &callback: callbacks) {
+        callback(bitmap);
+      }
+      lock.lock();
+    }
+
+    pending.erase(key);
+    done_cond.notify_all();
+  }
+}
+
+ImageStore &GetImageStore() {
+  static ImageStore store;
+  return store;
+}
+
+/**
+ * @brief Build the cache key, returns false if the file does not exist
+ */
+bool MakeKey(const std::string &path, const core::SizeI &target_size, ImageKey *key) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) return false;
+
+  key->path = path;
+  key->mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+  key->width = std::max(0, target_size.width);
+  key->height = std::max(0, target_size.height);
+  return true;
+}
+
+/**
+ * @brief Check if an image is still at least as large as the target size after halving
+ *
+ * The image is displayed scaled to fit in the target size, so it can be halved
+ * as long as either side is twice as large. A target width or height of 0 is
+ * unconstrained.
+ */
+bool CanHalve(int width, int height, const core::SizeI &target_size) {
+  if (width < 2 || height < 2) return false;
+
+  return (target_size.width > 0 && width >= target_size.width * 2) ||
+      (target_size.height > 0 && height >= target_size.height * 2);
+}
+
+/**
+ * @brief Scale 32-bit pixels down to half the size with a box filter
+ */
+void Halve(std::vector<uint32_t> &pixels, int *width, int *height) {
+  const int w = *width;
+  const int h = *height;
+  const int half_w = w / 2;
+  const int half_h = h / 2;
+
+  for (int y = 0; y < half_h; ++y) {
+    const uint32_t *row0 = pixels.data() + static_cast<size_t>(y * 2) * w;
+    const uint32_t *row1 = row0 + w;
+    uint32_t *dst = pixels.data() + static_cast<size_t>(y) * half_w;
+
+    for (int x = 0; x < half_w; ++x) {
+      const uint32_t p0 = row0[x * 2], p1 = row0[x * 2 + 1];
+      const uint32_t p2 = row1[x * 2], p3 = row1[x * 2 + 1];
+      uint32_t result = 0;
+      for (int shift = 0; shift < 32; shift += 8) {
+        uint32_t sum = ((p0 >> shift) & 0xFF) + ((p1 >> shift) & 0xFF) +
+            ((p2 >> shift) & 0xFF) + ((p3 >> shift) & 0xFF);
+        result |= ((sum + 2) >> 2) << shift;
+      }
+      dst[x] = result;
+    }
+  }
+
+  *width = half_w;
+  *height = half_h;
+  pixels.resize(static_cast<size_t>(half_w) * half_h);
+}
+
+/**
+ * @brief Decode an image file and scale it down close to the target size
+ */
+bool DecodeImage(const std::string &path, const core::SizeI &target_size, SkBitmap *bitmap) {
+  using OIIO::ImageInput;
+  using OIIO::ImageSpec;
+  using OIIO::TypeDesc;
+
+  ImageInput *in = ImageInput::open(path);
+  if (nullptr == in) return false;
+
+  // Use the smallest mipmap level stored in the file which is still large enough
+  ImageSpec spec = in->spec();
+  int level = 0;
+  ImageSpec level_spec;
+  while (CanHalve(spec.width, spec.height, target_size) && in->seek_subimage(0, level + 1, level_spec)) {
+    spec = level_spec;
+    level++;
+  }
+  in->seek_subimage(0, level, spec);
+
+  int width = spec.width;
+  int height = spec.height;
+  const int channels = spec.nchannels;
+
+  if (width <= 0 || height <= 0 || channels <= 0) {
+    in->close();
+    ImageInput::destroy(in);
+    return false;
+  }
+
+  std::vector<uint8_t> data(static_cast<size_t>(width) * height * channels);
+  bool ok = in->read_image(TypeDesc::UINT8, data.data());
+  in->close();
+  ImageInput::destroy(in);
+
+  if (!ok) return false;
+
+  // Expand to RGBA, gray images have 1 or 2 channels
+  const size_t count = static_cast<size_t>(width) * height;
+  const bool has_alpha = (2 == channels) || (channels >= 4);
+  std::vector<uint32_t> pixels(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    const uint8_t *src = data.data() + i * channels;
+    uint32_t r, g, b, a;
+    if (channels < 3) {
+      r = g = b = src[0];
+      a = (2 == channels) ? src[1] : 0xFF;
+    } else {
+      r = src[0];
+      g = src[1];
+      b = src[2];
+      a = has_alpha ? src[3] : 0xFF;
+    }
+    // Byte order R, G, B, A in memory
+    pixels[i] = (a << 24) | (b << 16) | (g << 8) | r;
+  }
+  std::vector<uint8_t>().swap(data);
+
+  // Scale in premultiplied space so transparent pixels do not bleed
+  if (has_alpha) PixelOps::Premultiply(pixels.data(), pixels.data(), count);
+
+  while (CanHalve(width, height, target_size)) {
+    Halve(pixels, &width, &height);
+  }
+
+  if (!bitmap->tryAllocN32Pixels(width, height, !has_alpha)) return false;
+
+  // N32 is BGRA in memory
+  for (int y = 0; y < height; ++y) {
+    PixelOps::SwapRB(pixels.data() + static_cast<size_t>(y) * width,
+                     reinterpret_cast<uint32_t *>(static_cast<char *>(bitmap->getPixels()) + y * bitmap->rowBytes()),
+                     static_cast<size_t>(width));
+  }
+
+  bitmap->setImmutable();
+  return true;
+}
+
+} // namespace
+
+bool ImageCache::Private::Load(const std::string &path, const core::SizeI &target_size, SkBitmap *bitmap) {
+  ImageStore &store = GetImageStore();
+
+  ImageKey key;
+  if (!MakeKey(path, target_size, &key)) return false;
+
+  {
+    std::unique_lock<std::mutex> lock(store.mutex);
+
+    // Wait for a worker decoding the same image
+    store.done_cond.wait(lock, [&]() { return store.pending.find(key) == store.pending.end(); });
+    if (store.Find(key, bitmap)) return true;
+    store.miss_count++;
+  }
+
+  if (!DecodeImage(path, target_size, bitmap)) return false;
+
+  std::lock_guard<std::mutex> lock(store.mutex);
+  store.Insert(key, *bitmap);
+  return true;
+}
+
+void ImageCache::Private::LoadAsync(const std::string &path,
+                                    const core::SizeI &target_size,
+                                    const Callback &callback) {
+  ImageStore &store = GetImageStore();
+
+  ImageKey key;
+  if (!MakeKey(path, target_size, &key)) {
+    callback(SkBitmap());
+    return;
+  }
+
+  SkBitmap bitmap;
+  {
+    std::lock_guard<std::mutex> lock(store.mutex);
+
+    if (!store.Find(key, &bitmap)) {
+      auto it = store.pending.find(key);
+      if (it == store.pending.end()) {
+        store.miss_count++;
+        store.pending[key].push_back(callback);
+        store.queue.push_back(key);
+        store.StartWorkers();
+        store.work_cond.notify_one();
+      } else {
+        it->second.push_back(callback);
+      }
+      return;
+    }
+  }
+
+  callback(bitmap);
+}
+
+void ImageCache::SetMemoryBudget(size_t budget) {
+  ImageStore &store = GetImageStore();
+  std::lock_guard<std::mutex> lock(store.mutex);
+  store.budget = budget;
+  store.Evict();
+}
+
+size_t ImageCache::GetMemoryBudget() {
+  ImageStore &store = GetImageStore();
+  std::lock_guard<std::mutex> lock(store.mutex);
+  return store.budget;
+}
+
+size_t ImageCache::GetMemoryUsage() {
+  ImageStore &store = GetImageStore();
+  std::lock_guard<std::mutex> lock(store.mutex);
+  return store.usage;
+}
+
+size_t ImageCache::GetCount() {
+  ImageStore &store = GetImageStore();
+  std::lock_guard<std::mutex> lock(store.mutex);
+  return store.entries.size();
+}
+
+uint64_t ImageCache::GetHitCount() {
+  ImageStore &store = GetImageStore();
+  std::lock_guard<std::mutex> lock(store.mutex);
+  return store.hit_count;
+}
+
+uint64_t ImageCache::GetMissCount() {
+  ImageStore &store = GetImageStore();
+  std::lock_guard<std::mutex> lock(store.mutex);
+  return store.miss_count;
+}
+
+size_t ImageCache::GetPendingCount() {
+  ImageStore &store = GetImageStore();
+  std::lock_guard<std::mutex> lock(store.mutex);
+  return store.pending.size();
+}
+
+void ImageCache::WaitForIdle() {
+  ImageStore &store = GetImageStore();
+  std::unique_lock<std::mutex> lock(store.mutex);
+  store.done_cond.wait(lock, [&]() { return store.pending.empty(); });
+}
+
+void ImageCache::Clear() {
+  ImageStore &store = GetImageStore();
+  std::lock_guard<std::mutex> lock(store.mutex);
+  store.map.clear();
+  store.entries.clear();
+  store.usage = 0;
+}
+
+} // namespace graphic
+} // namespace skland
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "skland/graphic/image-writer.hpp"
+#include "skland/graphic/pixel-ops.hpp"
+
+#include "internal/bitmap_private.hpp"
+
+#include "skland/core/memory.hpp"
+
+#include "OpenImageIO/imageio.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace skland {
+namespace graphic {
+
+/**
+ * @ingroup graphic_intern
+ * @brief The private structure used in ImageWriter
+ */
+struct ImageWriter::Private {
+
+  Private() = default;
+  Private(const Private &) = delete;
+  Private &operator=(const Private &) = delete;
+
+  ~Private() = default;
+
+  std::vector<uint32_t> pixels;
+
+  int width = 0;
+
+  int height = 0;
+
+  ColorType color_type = kColorTypeUnknown;
+
+  AlphaType alpha_type = kAlphaTypeUnknown;
+
+  int quality = 90;
+
+  /**
+   * @brief Encode 32-bit pixels to a file
+   */
+  static bool Encode(const void *pixels,
+                     size_t row_bytes,
+                     int width,
+                     int height,
+                     ColorType color_type,
+                     AlphaType alpha_type,
+                     const std::string &filename,
+                     Format format,
+                     int quality);
+
+  /**
+   * @brief Number of rows converted and written in one go
+   */
+  static const int kChunkRows = 32;
+
+};
+
+bool ImageWriter::Private::Encode(const void *pixels,
+                                  size_t row_bytes,
+                                  int width,
+                                  int height,
+                                  ColorType color_type,
+                                  AlphaType alpha_type,
+                                  const std::string &filename,
+                                  Format format,
+                                  int quality) {
+  using OIIO::ImageOutput;
+  using OIIO::ImageSpec;
+  using OIIO::TypeDesc;
+
+  // TODO: other color type
+  if (nullptr == pixels || width <= 0 || height <= 0 ||
+      (kColorTypeBGRA8888 != color_type && kColorTypeRGBA8888 != color_type)) {
+    fprintf(stderr, "Unkown image type!\n");
+    return false;
+  }
+
+  static const char *kFormatNames[] = {nullptr, "png", "jpeg", "openexr"};
+
+  ImageOutput *out = (kFormatAuto == format) ?
+                     ImageOutput::create(filename) : ImageOutput::create(kFormatNames[format]);
+  if (nullptr == out) return false;
+
+  const std::string format_name(out->format_name());
+
+  // JPEG has no alpha channel, the premultiplied colors are written as if
+  // composited over black
+  const int channels = (format_name == "jpeg") ? 3 : 4;
+  const bool unpremultiply = (4 == channels) && (kAlphaTypePremul == alpha_type);
+  const bool swap_rb = (kColorTypeBGRA8888 == color_type);
+
+  ImageSpec spec(width, height, channels, format_name == "openexr" ? TypeDesc::HALF : TypeDesc::UINT8);
+  spec.attribute("CompressionQuality", std::max(1, std::min(quality, 100)));
+
+  if (!out->open(filename, spec)) {
+    ImageOutput::destroy(out);
+    return false;
+  }
+
+  // Convert and write a few rows at a time so the temporary buffer stays small
+  const size_t stride = static_cast<size_t>(width);
+  std::vector<uint32_t> chunk(stride * kChunkRows);
+  std::vector<uint8_t> packed(3 == channels ? stride * 3 * kChunkRows : 0);
+
+  const char *src = static_cast<const char *>(pixels);
+  bool ok = true;
+
+  for (int y = 0; ok && y < height; y += kChunkRows) {
+    const int rows = std::min(kChunkRows, height - y);
+
+    for (int i = 0; i < rows; ++i) {
+      const uint32_t *row = reinterpret_cast<const uint32_t *>(src + (y + i) * row_bytes);
+      uint32_t *dst = chunk.data() + i * stride;
+
+      if (unpremultiply) {
+        PixelOps::Unpremultiply(row, dst, stride);
+        row = dst;
+      }
+
+      if (swap_rb)
+        PixelOps::SwapRB(row, dst, stride);
+      else if (row != dst)
+        memcpy(dst, row, stride * sizeof(uint32_t));
+    }
+
+    const void *data = chunk.data();
+    if (3 == channels) {
+      const uint8_t *rgba = reinterpret_cast<const uint8_t *>(chunk.data());
+      const size_t count = stride * rows;
+      for (size_t i = 0; i < count; ++i) {
+        packed[i * 3] = rgba[i * 4];
+        packed[i * 3 + 1] = rgba[i * 4 + 1];
+        packed[i * 3 + 2] = rgba[i * 4 + 2];
+      }
+      data = packed.data();
+    }
+
+    ok = out->write_scanlines(y, y + rows, 0, TypeDesc::UINT8, data);
+  }
+
+  ok = out->close() && ok;
+  ImageOutput::destroy(out);
+
+  return ok;
+}
+
+ImageWriter::ImageWriter(const Bitmap &bitmap) {
+  p_ = core::MakeUnique<Private>();
+
+  const SkBitmap &sk_bitmap = bitmap.p_->sk_bitmap;
+  if (4 != sk_bitmap.bytesPerPixel() || nullptr == sk_bitmap.getPixels()) return;
+
+  p_->width = sk_bitmap.width();
+  p_->height = sk_bitmap.height();
+  p_->color_type = static_cast<ColorType>(sk_bitmap.colorType());
+  p_->alpha_type = static_cast<AlphaType>(sk_bitmap.alphaType());
+
+  // The only work done on the caller's thread: copy the rows
+  const size_t row_size = static_cast<size_t>(p_->width) * sizeof(uint32_t);
+  const char *src = static_cast<const char *>(sk_bitmap.getPixels());
+
+  p_->pixels.resize(static_cast<size_t>(p_->width) * p_->height);
+  if (row_size == sk_bitmap.rowBytes()) {
+    memcpy(p_->pixels.data(), src, row_size * p_->height);
+  } else {
+    for (int y = 0; y < p_->height; ++y) {
+      memcpy(p_->pixels.data() + static_cast<size_t>(y) * p_->width, src + y * sk_bitmap.rowBytes(), row_size);
+    }
+  }
+}
+
+ImageWriter::~ImageWriter() {
+
+}
+
+bool ImageWriter::Write(const std::string &filename, Format format) const {
+  return Private::Encode(p_->pixels.data(),
+                         static_cast<size_t>(p_->width) * sizeof(uint32_t),
+                         p_->width,
+                         p_->height,
+                         p_->color_type,
+                         p_->alpha_type,
+                         filename,
+                         format,
+                         p_->quality);
+}
+
+void ImageWriter::SetQuality(int quality) {
+  p_->quality = std::max(1, std::min(quality, 100));
+}
+
+int ImageWriter::GetQuality() const {
+  return p_->quality;
+}
+
+int ImageWriter::GetWidth() const {
+  return p_->width;
+}
+
+int ImageWriter::GetHeight() const {
+  return p_->height;
+}
+
+bool ImageWriter::Write(const Bitmap &bitmap, const std::string &filename, Format format, int quality) {
+  const SkBitmap &sk_bitmap = bitmap.p_->sk_bitmap;
+  if (4 != sk_bitmap.bytesPerPixel()) {
+    fprintf(stderr, "Unkown image type!\n");
+    return false;
+  }
+
+  return Private::Encode(sk_bitmap.getPixels(),
+                         sk_bitmap.rowBytes(),
+                         sk_bitmap.width(),
+                         sk_bitmap.height(),
+                         static_cast<ColorType>(sk_bitmap.colorType()),
+                         static_cast<AlphaType>(sk_bitmap.alphaType()),
+                         filename,
+                         format,
+                         quality);
+}
+
+} // namespace graphic
+} // namespace skland
@@ -20,6 +20,7 @@
 #include "skland/graphic/bitmap.hpp"
 
 #include "skland/core/property.hpp"
+#include "skland/core/memory-stats.hpp"
 
 #include "SkBitmap.h"
 
@@ -35,7 +36,22 @@ struct Bitmap::Private : public core::Property<Bitmap> {
   explicit Private(Bitmap *owner)
       : core::Property<Bitmap>(owner) {}
 
-  ~Private() final = default;
+  ~Private() final {}
+
+  /**
+   * @brief Allocate pixels and report them in MemoryStats
+   *
+   * The pixels are owned by the pixel ref shared by all copies of this bitmap,
+   * the bytes are removed in ReleasePixels() when the last copy goes.
+   */
+  void AllocatePixels(const SkImageInfo &info);
+
+  /**
+   * @brief The release proc of pixels allocated in AllocatePixels()
+   * @param pixels The pixel memory
+   * @param context The size in bytes
+   */
+  static void ReleasePixels(void *pixels, void *context);
 
   SkBitmap sk_bitmap;
 
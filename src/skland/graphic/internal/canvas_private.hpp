@@ -24,6 +24,7 @@
 #include "skland/core/deque.hpp"
 
 #include "SkCanvas.h"
+#include "SkSurface.h"
 
 namespace skland {
 namespace graphic {
@@ -34,15 +35,32 @@ namespace graphic {
  */
 struct Canvas::Private {
 
-  Private() = default;
+  Private()
+      : own_canvas(new SkCanvas), sk_canvas(own_canvas.get()) {}
 
   explicit Private(const SkBitmap &bitmap)
-      : sk_canvas(bitmap) {
+      : own_canvas(new SkCanvas(bitmap)), sk_canvas(own_canvas.get()) {
   }
 
+  /**
+   * @brief Draw on a SkCanvas owned by others, e.g. a picture recorder
+   */
+  explicit Private(SkCanvas *canvas)
+      : sk_canvas(canvas) {}
+
+  /**
+   * @brief Draw on the canvas of a surface, e.g. a GPU render target
+   */
+  explicit Private(const sk_sp<SkSurface> &surface)
+      : sk_surface(surface), sk_canvas(surface->getCanvas()) {}
+
   ~Private() = default;
 
-  SkCanvas sk_canvas;
+  std::unique_ptr<SkCanvas> own_canvas;
+
+  sk_sp<SkSurface> sk_surface;
+
+  SkCanvas *sk_canvas = nullptr;
 
   core::PointF origin;
 
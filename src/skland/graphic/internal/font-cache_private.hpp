@@ -0,0 +1,55 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_INTERNAL_FONT_CACHE_PRIVATE_HPP_
+#define SKLAND_GRAPHIC_INTERNAL_FONT_CACHE_PRIVATE_HPP_
+
+#include <skland/graphic/font-cache.hpp>
+
+#include "SkFont.h"
+#include "SkTypeface.h"
+
+namespace skland {
+namespace graphic {
+
+/**
+ * @ingroup graphic_intern
+ * @brief Lookup functions used by Font and Typeface
+ */
+struct FontCache::Private {
+
+  Private() = delete;
+
+  /**
+   * @brief Find or resolve the typeface of a family name and style
+   */
+  static sk_sp<SkTypeface> GetTypeface(const char *family_name, const FontStyle &font_style);
+
+  /**
+   * @brief Find or create a font with the given typeface and attributes
+   */
+  static sk_sp<SkFont> GetFont(const sk_sp<SkTypeface> &typeface,
+                               float size,
+                               SkFont::MaskType mask_type,
+                               uint32_t flags);
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_INTERNAL_FONT_CACHE_PRIVATE_HPP_
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_INTERNAL_GPU_CONTEXT_PRIVATE_HPP_
+#define SKLAND_GRAPHIC_INTERNAL_GPU_CONTEXT_PRIVATE_HPP_
+
+#include <skland/graphic/gpu-context.hpp>
+
+#include "GrContext.h"
+
+namespace skland {
+namespace graphic {
+
+/**
+ * @ingroup graphic_intern
+ * @brief The private structure used in GPUContext
+ */
+struct GPUContext::Private {
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
+
+  Private() = default;
+
+  ~Private() = default;
+
+  sk_sp<GrContext> gr_context;
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_INTERNAL_GPU_CONTEXT_PRIVATE_HPP_
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_INTERNAL_IMAGE_CACHE_PRIVATE_HPP_
+#define SKLAND_GRAPHIC_INTERNAL_IMAGE_CACHE_PRIVATE_HPP_
+
+#include <skland/graphic/image-cache.hpp>
+
+#include "skland/core/size.hpp"
+
+#include "SkBitmap.h"
+
+#include <functional>
+#include <string>
+
+namespace skland {
+namespace graphic {
+
+/**
+ * @ingroup graphic_intern
+ * @brief Loading functions used by Bitmap
+ */
+struct ImageCache::Private {
+
+  typedef std::function<void(const SkBitmap &)> Callback;
+
+  Private() = delete;
+
+  /**
+   * @brief Find a cached image or decode it in the calling thread
+   */
+  static bool Load(const std::string &path, const core::SizeI &target_size, SkBitmap *bitmap);
+
+  /**
+   * @brief Find a cached image or queue it to be decoded in a worker thread
+   *
+   * The callback is called in the calling thread if the image is cached,
+   * otherwise in a worker thread. The bitmap is empty if the file cannot be
+   * loaded.
+   */
+  static void LoadAsync(const std::string &path, const core::SizeI &target_size, const Callback &callback);
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_INTERNAL_IMAGE_CACHE_PRIVATE_HPP_
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_INTERNAL_PAINT_CACHE_PRIVATE_HPP_
+#define SKLAND_GRAPHIC_INTERNAL_PAINT_CACHE_PRIVATE_HPP_
+
+#include <skland/graphic/paint-cache.hpp>
+
+#include "SkShader.h"
+
+#include <string>
+
+namespace skland {
+namespace graphic {
+
+/**
+ * @ingroup graphic_intern
+ * @brief Lookup functions used by GradientShader
+ */
+struct PaintCache::Private {
+
+  Private() = delete;
+
+  /**
+   * @brief Find a cached shader by the bytes of its parameters
+   * @return The shader, or an empty pointer if not found
+   */
+  static sk_sp<SkShader> FindShader(const std::string &key);
+
+  /**
+   * @brief Add a shader created with the parameters in key
+   */
+  static void AddShader(const std::string &key, const sk_sp<SkShader> &shader);
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_INTERNAL_PAINT_CACHE_PRIVATE_HPP_
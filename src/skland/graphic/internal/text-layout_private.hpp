@@ -0,0 +1,77 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GRAPHIC_INTERNAL_TEXT_LAYOUT_PRIVATE_HPP_
+#define SKLAND_GRAPHIC_INTERNAL_TEXT_LAYOUT_PRIVATE_HPP_
+
+#include <skland/graphic/text-layout.hpp>
+
+#include "SkTypeface.h"
+#include "SkPoint.h"
+
+class SkCanvas;
+class SkPaint;
+
+#include <vector>
+
+namespace skland {
+namespace graphic {
+
+/**
+ * @ingroup graphic_intern
+ * @brief Structure to store the glyph run of a TextLayout
+ */
+struct TextLayout::Private {
+
+  Private(const Private &) = delete;
+  Private &operator=(const Private &) = delete;
+
+  Private() = default;
+
+  ~Private() = default;
+
+  /**
+   * @brief Shape and break the text with sk_typeface and text_size
+   * @param max_width Maximal width of a line in pixels, 0 for no wrapping
+   */
+  void Layout(const char *text, size_t byte_length, float max_width, float spacing_mul, float spacing_add);
+
+  /**
+   * @brief Draw the glyph run with the color and style of the given paint
+   */
+  void Draw(SkCanvas *canvas, float x, float y, const SkPaint &paint) const;
+
+  sk_sp<SkTypeface> sk_typeface;
+
+  float text_size = 0.f;
+
+  std::vector<SkGlyphID> glyphs;
+
+  std::vector<SkPoint> positions;
+
+  int line_count = 0;
+
+  float width = 0.f;
+
+  float height = 0.f;
+
+};
+
+} // namespace graphic
+} // namespace skland
+
+#endif // SKLAND_GRAPHIC_INTERNAL_TEXT_LAYOUT_PRIVATE_HPP_
@@ -19,12 +19,12 @@
 namespace skland {
 namespace graphic {
 
-Matrix::Matrix() {
-  p_.reset(new Private);
+Matrix::Matrix()
+    : p_() {
 }
 
-Matrix::Matrix(const Matrix &other) {
-  p_.reset(new Private(*other.p_));
+Matrix::Matrix(const Matrix &other)
+    : p_(*other.p_) {
 }
 
 Matrix::~Matrix() {
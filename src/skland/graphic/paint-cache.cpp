@@ -0,0 +1,200 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <skland/graphic/paint.hpp>
+
+#include "internal/paint-cache_private.hpp"
+
+#include "SkPaint.h"
+
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace skland {
+namespace graphic {
+
+namespace {
+
+typedef std::pair<std::string, sk_sp<SkShader> > ShaderEntry;
+
+typedef std::pair<uint32_t, std::shared_ptr<const Paint> > PaintEntry;
+
+struct PaintCacheData {
+
+  std::mutex mutex;
+
+  /**
+   * @brief Interned paints, the most recently used at front
+   */
+  std::list<PaintEntry> paints;
+
+  std::unordered_multimap<uint32_t, std::list<PaintEntry>::iterator> paint_index;
+
+  /**
+   * @brief Cached shaders, the most recently used at front
+   */
+  std::list<ShaderEntry> shaders;
+
+  std::unordered_map<std::string, std::list<ShaderEntry>::iterator> shader_index;
+
+  size_t capacity = 256;
+
+  uint64_t hit_count = 0;
+
+  uint64_t miss_count = 0;
+
+};
+
+PaintCacheData &GetPaintCacheData() {
+  static PaintCacheData data;
+  return data;
+}
+
+void TrimShaders(PaintCacheData &data) {
+  while (data.shaders.size() > data.capacity) {
+    data.shader_index.erase(data.shaders.back().first);
+    data.shaders.pop_back();
+  }
+}
+
+void TrimPaints(PaintCacheData &data) {
+  while (data.paints.size() > data.capacity) {
+    auto last = std::prev(data.paints.end());
+    auto range = data.paint_index.equal_range(last->first);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == last) {
+        data.paint_index.erase(it);
+        break;
+      }
+    }
+    data.paints.pop_back();
+  }
+}
+
+}
+
+sk_sp<SkShader> PaintCache::Private::FindShader(const std::string &key) {
+  PaintCacheData &data = GetPaintCacheData();
+
+  std::lock_guard<std::mutex> lock(data.mutex);
+  auto it = data.shader_index.find(key);
+  if (it == data.shader_index.end()) {
+    data.miss_count++;
+    return nullptr;
+  }
+
+  data.hit_count++;
+  data.shaders.splice(data.shaders.begin(), data.shaders, it->second);
+  return it->second->second;
+}
+
+void PaintCache::Private::AddShader(const std::string &key, const sk_sp<SkShader> &shader) {
+  PaintCacheData &data = GetPaintCacheData();
+
+  std::lock_guard<std::mutex> lock(data.mutex);
+  if (0 == data.capacity) return;
+
+  auto it = data.shader_index.find(key);
+  if (it != data.shader_index.end()) {
+    // Added by another thread in the meantime
+    data.shaders.splice(data.shaders.begin(), data.shaders, it->second);
+    return;
+  }
+
+  data.shaders.push_front(ShaderEntry(key, shader));
+  data.shader_index[key] = data.shaders.begin();
+  TrimShaders(data);
+}
+
+std::shared_ptr<const Paint> PaintCache::Intern(const Paint &paint) {
+  PaintCacheData &data = GetPaintCacheData();
+  uint32_t hash = paint.GetHash();
+
+  std::lock_guard<std::mutex> lock(data.mutex);
+  auto range = data.paint_index.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second->second->GetSkPaint() == paint.GetSkPaint()) {
+      data.hit_count++;
+      data.paints.splice(data.paints.begin(), data.paints, it->second);
+      return it->second->second;
+    }
+  }
+
+  data.miss_count++;
+  std::shared_ptr<const Paint> interned = std::make_shared<Paint>(paint);
+  if (0 == data.capacity) return interned;
+
+  data.paints.push_front(PaintEntry(hash, interned));
+  data.paint_index.insert(std::make_pair(hash, data.paints.begin()));
+  TrimPaints(data);
+
+  return interned;
+}
+
+size_t PaintCache::GetPaintCount() {
+  PaintCacheData &data = GetPaintCacheData();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  return data.paints.size();
+}
+
+size_t PaintCache::GetShaderCount() {
+  PaintCacheData &data = GetPaintCacheData();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  return data.shaders.size();
+}
+
+void PaintCache::SetCapacity(size_t capacity) {
+  PaintCacheData &data = GetPaintCacheData();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  data.capacity = capacity;
+  TrimPaints(data);
+  TrimShaders(data);
+}
+
+size_t PaintCache::GetCapacity() {
+  PaintCacheData &data = GetPaintCacheData();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  return data.capacity;
+}
+
+uint64_t PaintCache::GetHitCount() {
+  PaintCacheData &data = GetPaintCacheData();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  return data.hit_count;
+}
+
+uint64_t PaintCache::GetMissCount() {
+  PaintCacheData &data = GetPaintCacheData();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  return data.miss_count;
+}
+
+void PaintCache::Clear() {
+  PaintCacheData &data = GetPaintCacheData();
+  std::lock_guard<std::mutex> lock(data.mutex);
+  data.paints.clear();
+  data.paint_index.clear();
+  data.shaders.clear();
+  data.shader_index.clear();
+}
+
+} // namespace graphic
+} // namespace skland
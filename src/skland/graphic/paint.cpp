@@ -42,12 +42,12 @@ struct Paint::Private {
 
 };
 
-Paint::Paint() {
-  p_.reset(new Private);
+Paint::Paint()
+    : p_() {
 }
 
-Paint::Paint(const Paint &orig) {
-  p_.reset(new Private(*orig.p_));
+Paint::Paint(const Paint &orig)
+    : p_(*orig.p_) {
 }
 
 Paint::~Paint() {
@@ -193,11 +193,11 @@ const SkPaint &Paint::GetSkPaint() const {
 }
 
 bool operator==(const Paint &paint1, const Paint &paint2) {
-  return paint1.p_ == paint2.p_;
+  return paint1.p_.get() == paint2.p_.get();
 }
 
 bool operator!=(const Paint &paint1, const Paint &paint2) {
-  return paint1.p_ != paint2.p_;
+  return paint1.p_.get() != paint2.p_.get();
 }
 
 } // namespace graphic
@@ -37,12 +37,12 @@ struct Path::Private {
 
 };
 
-Path::Path() {
-  p_.reset(new Private);
+Path::Path()
+    : p_() {
 }
 
-Path::Path(const Path &other) {
-  p_.reset(new Private(*other.p_));
+Path::Path(const Path &other)
+    : p_(*other.p_) {
 }
 
 Path::~Path() {
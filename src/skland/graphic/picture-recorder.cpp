@@ -0,0 +1,79 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "skland/graphic/picture-recorder.hpp"
+#include "skland/graphic/canvas.hpp"
+
+#include "skland/core/memory.hpp"
+
+#include "internal/picture_private.hpp"
+
+#include "SkPictureRecorder.h"
+
+namespace skland {
+namespace graphic {
+
+/**
+ * @ingroup graphic_intern
+ * @brief The private structure used in PictureRecorder
+ */
+struct PictureRecorder::Private {
+
+  Private() = default;
+  Private(const Private &) = delete;
+  Private &operator=(const Private &) = delete;
+
+  ~Private() = default;
+
+  SkPictureRecorder sk_recorder;
+
+  /** Wraps the recording SkCanvas owned by sk_recorder */
+  std::unique_ptr<Canvas> canvas;
+
+};
+
+PictureRecorder::PictureRecorder() {
+  p_ = core::MakeUnique<Private>();
+}
+
+PictureRecorder::~PictureRecorder() {
+
+}
+
+Canvas *PictureRecorder::BeginRecording(const RectF &bounds) {
+  p_->canvas.reset();
+
+  SkCanvas *sk_canvas = p_->sk_recorder.beginRecording(reinterpret_cast<const SkRect &>(bounds));
+  p_->canvas.reset(new Canvas(sk_canvas));
+  return p_->canvas.get();
+}
+
+Canvas *PictureRecorder::GetRecordingCanvas() const {
+  return p_->canvas.get();
+}
+
+Picture PictureRecorder::FinishRecording() {
+  Picture picture;
+  if (!p_->canvas) return picture;
+
+  p_->canvas.reset();
+  picture.p_->sk_picture = p_->sk_recorder.finishRecordingAsPicture();
+  return picture;
+}
+
+} // namespace graphic
+} // namespace skland
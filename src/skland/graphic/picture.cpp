@@ -0,0 +1,62 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "internal/picture_private.hpp"
+
+#include "skland/core/memory.hpp"
+
+namespace skland {
+namespace graphic {
+
+Picture::Picture() {
+  p_ = core::MakeUnique<Private>();
+}
+
+Picture::Picture(const Picture &other) {
+  p_ = core::MakeUnique<Private>(other.p_->sk_picture);
+}
+
+Picture &Picture::operator=(const Picture &other) {
+  p_->sk_picture = other.p_->sk_picture;
+  return *this;
+}
+
+Picture::~Picture() {
+
+}
+
+bool Picture::IsEmpty() const {
+  return !p_->sk_picture || 0 == p_->sk_picture->approximateOpCount();
+}
+
+core::RectF Picture::GetCullRect() const {
+  if (!p_->sk_picture) return RectF();
+
+  const SkRect &rect = p_->sk_picture->cullRect();
+  return RectF(rect.fLeft, rect.fTop, rect.fRight, rect.fBottom);
+}
+
+int Picture::GetCommandCount() const {
+  return p_->sk_picture ? p_->sk_picture->approximateOpCount() : 0;
+}
+
+size_t Picture::GetMemorySize() const {
+  return p_->sk_picture ? p_->sk_picture->approximateBytesUsed() : 0;
+}
+
+} // namespace graphic
+} // namespace skland
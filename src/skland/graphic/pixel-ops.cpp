@@ -0,0 +1,575 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "skland/graphic/pixel-ops.hpp"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SKLAND_PIXEL_OPS_X86
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define SKLAND_PIXEL_OPS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace skland {
+namespace graphic {
+
+struct PixelOps::Kernels {
+
+  void (*premultiply)(const uint32_t *src, uint32_t *dst, size_t count);
+
+  void (*unpremultiply)(const uint32_t *src, uint32_t *dst, size_t count);
+
+  void (*swap_rb)(const uint32_t *src, uint32_t *dst, size_t count);
+
+  void (*fill)(uint32_t *dst, uint32_t color, size_t count);
+
+  void (*blend_src_over)(const uint32_t *src, uint32_t *dst, size_t count);
+
+};
+
+namespace {
+
+// ------ Scalar reference ------
+
+/**
+ * @brief Exact round(x / 255) for x in [0, 255 * 255]
+ */
+inline uint32_t Div255(uint32_t x) {
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+inline uint32_t PremultiplyPixel(uint32_t pixel) {
+  uint32_t a = pixel >> 24;
+  uint32_t r = Div255(((pixel >> 16) & 0xFF) * a);
+  uint32_t g = Div255(((pixel >> 8) & 0xFF) * a);
+  uint32_t b = Div255((pixel & 0xFF) * a);
+  return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+inline uint32_t UnpremultiplyChannel(uint32_t c, float inv) {
+  // Same float operations as the SIMD versions to get identical results
+  float value = static_cast<float>(c) * inv + 0.5f;
+  return value >= 255.f ? 255 : static_cast<uint32_t>(value);
+}
+
+inline uint32_t UnpremultiplyPixel(uint32_t pixel) {
+  uint32_t a = pixel >> 24;
+  if (0 == a) return 0;
+
+  float inv = 255.f / static_cast<float>(a);
+  uint32_t r = UnpremultiplyChannel((pixel >> 16) & 0xFF, inv);
+  uint32_t g = UnpremultiplyChannel((pixel >> 8) & 0xFF, inv);
+  uint32_t b = UnpremultiplyChannel(pixel & 0xFF, inv);
+  return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+inline uint32_t SwapRBPixel(uint32_t pixel) {
+  return (pixel & 0xFF00FF00) | ((pixel >> 16) & 0xFF) | ((pixel & 0xFF) << 16);
+}
+
+inline uint32_t BlendSrcOverPixel(uint32_t src, uint32_t dst) {
+  uint32_t inv_a = 255 - (src >> 24);
+  uint32_t result = 0;
+  for (int shift = 0; shift < 32; shift += 8) {
+    uint32_t c = ((src >> shift) & 0xFF) + Div255(((dst >> shift) & 0xFF) * inv_a);
+    result |= std::min(c, 255u) << shift;
+  }
+  return result;
+}
+
+void PremultiplyScalar(const uint32_t *src, uint32_t *dst, size_t count) {
+  for (size_t i = 0; i < count; i++) dst[i] = PremultiplyPixel(src[i]);
+}
+
+void UnpremultiplyScalar(const uint32_t *src, uint32_t *dst, size_t count) {
+  for (size_t i = 0; i < count; i++) dst[i] = UnpremultiplyPixel(src[i]);
+}
+
+void SwapRBScalar(const uint32_t *src, uint32_t *dst, size_t count) {
+  for (size_t i = 0; i < count; i++) dst[i] = SwapRBPixel(src[i]);
+}
+
+void FillScalar(uint32_t *dst, uint32_t color, size_t count) {
+  for (size_t i = 0; i < count; i++) dst[i] = color;
+}
+
+void BlendSrcOverScalar(const uint32_t *src, uint32_t *dst, size_t count) {
+  for (size_t i = 0; i < count; i++) dst[i] = BlendSrcOverPixel(src[i], dst[i]);
+}
+
+#ifdef SKLAND_PIXEL_OPS_X86
+
+// ------ SSE2 ------
+
+/**
+ * @brief Div255() on 8 16-bit lanes
+ */
+inline __m128i Div255SSE2(__m128i x) {
+  x = _mm_add_epi16(x, _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+/**
+ * @brief Broadcast the alpha of 2 unpacked pixels to all 16-bit lanes
+ */
+inline __m128i AlphaSSE2(__m128i pixels) {
+  pixels = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+  return _mm_shufflehi_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+__attribute__((target("sse2")))
+void PremultiplySSE2(const uint32_t *src, uint32_t *dst, size_t count) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i alpha_mask = _mm_set1_epi32(0xFF000000);
+  size_t i = 0;
+
+  for (; i + 4 <= count; i += 4) {
+    __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+    __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+    lo = Div255SSE2(_mm_mullo_epi16(lo, AlphaSSE2(lo)));
+    hi = Div255SSE2(_mm_mullo_epi16(hi, AlphaSSE2(hi)));
+    __m128i result = _mm_packus_epi16(lo, hi);
+    result = _mm_or_si128(_mm_andnot_si128(alpha_mask, result), _mm_and_si128(alpha_mask, pixels));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), result);
+  }
+
+  PremultiplyScalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("sse2")))
+void UnpremultiplySSE2(const uint32_t *src, uint32_t *dst, size_t count) {
+  const __m128i mask = _mm_set1_epi32(0xFF);
+  const __m128 max = _mm_set1_ps(255.f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  size_t i = 0;
+
+  for (; i + 4 <= count; i += 4) {
+    __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i a = _mm_srli_epi32(pixels, 24);
+    __m128 inv = _mm_div_ps(max, _mm_cvtepi32_ps(a));
+    __m128i result = _mm_slli_epi32(a, 24);
+
+    for (int shift = 0; shift < 24; shift += 8) {
+      __m128i c = _mm_and_si128(_mm_srli_epi32(pixels, shift), mask);
+      __m128 value = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(c), inv), half);
+      c = _mm_cvttps_epi32(_mm_min_ps(value, max));
+      result = _mm_or_si128(result, _mm_sll_epi32(c, _mm_cvtsi32_si128(shift)));
+    }
+
+    // Pixels with 0 alpha
+    result = _mm_andnot_si128(_mm_cmpeq_epi32(a, _mm_setzero_si128()), result);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), result);
+  }
+
+  UnpremultiplyScalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("sse2")))
+void SwapRBSSE2(const uint32_t *src, uint32_t *dst, size_t count) {
+  const __m128i ag_mask = _mm_set1_epi32(0xFF00FF00);
+  const __m128i mask = _mm_set1_epi32(0xFF);
+  size_t i = 0;
+
+  for (; i + 4 <= count; i += 4) {
+    __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i result = _mm_and_si128(pixels, ag_mask);
+    result = _mm_or_si128(result, _mm_and_si128(_mm_srli_epi32(pixels, 16), mask));
+    result = _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(pixels, mask), 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), result);
+  }
+
+  SwapRBScalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("sse2")))
+void FillSSE2(uint32_t *dst, uint32_t color, size_t count) {
+  const __m128i value = _mm_set1_epi32(static_cast<int>(color));
+  size_t i = 0;
+
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), value);
+  }
+
+  FillScalar(dst + i, color, count - i);
+}
+
+__attribute__((target("sse2")))
+void BlendSrcOverSSE2(const uint32_t *src, uint32_t *dst, size_t count) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i full = _mm_set1_epi16(255);
+  size_t i = 0;
+
+  for (; i + 4 <= count; i += 4) {
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+    __m128i s_lo = _mm_unpacklo_epi8(s, zero);
+    __m128i s_hi = _mm_unpackhi_epi8(s, zero);
+    __m128i d_lo = _mm_unpacklo_epi8(d, zero);
+    __m128i d_hi = _mm_unpackhi_epi8(d, zero);
+    d_lo = Div255SSE2(_mm_mullo_epi16(d_lo, _mm_sub_epi16(full, AlphaSSE2(s_lo))));
+    d_hi = Div255SSE2(_mm_mullo_epi16(d_hi, _mm_sub_epi16(full, AlphaSSE2(s_hi))));
+    __m128i result = _mm_adds_epu8(s, _mm_packus_epi16(d_lo, d_hi));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), result);
+  }
+
+  BlendSrcOverScalar(src + i, dst + i, count - i);
+}
+
+// ------ AVX2 ------
+
+__attribute__((target("avx2")))
+inline __m256i Div255AVX2(__m256i x) {
+  x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+  return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+__attribute__((target("avx2")))
+inline __m256i AlphaAVX2(__m256i pixels) {
+  pixels = _mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+  return _mm256_shufflehi_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+__attribute__((target("avx2")))
+void PremultiplyAVX2(const uint32_t *src, uint32_t *dst, size_t count) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i alpha_mask = _mm256_set1_epi32(0xFF000000);
+  size_t i = 0;
+
+  for (; i + 8 <= count; i += 8) {
+    __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    __m256i lo = _mm256_unpacklo_epi8(pixels, zero);
+    __m256i hi = _mm256_unpackhi_epi8(pixels, zero);
+    lo = Div255AVX2(_mm256_mullo_epi16(lo, AlphaAVX2(lo)));
+    hi = Div255AVX2(_mm256_mullo_epi16(hi, AlphaAVX2(hi)));
+    __m256i result = _mm256_packus_epi16(lo, hi);
+    result = _mm256_blendv_epi8(result, pixels, alpha_mask);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), result);
+  }
+
+  PremultiplySSE2(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2")))
+void UnpremultiplyAVX2(const uint32_t *src, uint32_t *dst, size_t count) {
+  const __m256i mask = _mm256_set1_epi32(0xFF);
+  const __m256 max = _mm256_set1_ps(255.f);
+  const __m256 half = _mm256_set1_ps(0.5f);
+  size_t i = 0;
+
+  for (; i + 8 <= count; i += 8) {
+    __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    __m256i a = _mm256_srli_epi32(pixels, 24);
+    __m256 inv = _mm256_div_ps(max, _mm256_cvtepi32_ps(a));
+
+    __m256i r = _mm256_and_si256(_mm256_srli_epi32(pixels, 16), mask);
+    __m256i g = _mm256_and_si256(_mm256_srli_epi32(pixels, 8), mask);
+    __m256i b = _mm256_and_si256(pixels, mask);
+    r = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(r), inv), half), max));
+    g = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(g), inv), half), max));
+    b = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(b), inv), half), max));
+
+    __m256i result = _mm256_or_si256(_mm256_slli_epi32(a, 24), _mm256_slli_epi32(r, 16));
+    result = _mm256_or_si256(result, _mm256_or_si256(_mm256_slli_epi32(g, 8), b));
+
+    // Pixels with 0 alpha
+    result = _mm256_andnot_si256(_mm256_cmpeq_epi32(a, _mm256_setzero_si256()), result);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), result);
+  }
+
+  UnpremultiplySSE2(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2")))
+void SwapRBAVX2(const uint32_t *src, uint32_t *dst, size_t count) {
+  const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                           2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+  size_t i = 0;
+
+  for (; i + 8 <= count; i += 8) {
+    __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_shuffle_epi8(pixels, shuffle));
+  }
+
+  SwapRBSSE2(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2")))
+void FillAVX2(uint32_t *dst, uint32_t color, size_t count) {
+  const __m256i value = _mm256_set1_epi32(static_cast<int>(color));
+  size_t i = 0;
+
+  for (; i + 8 <= count; i += 8) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), value);
+  }
+
+  FillSSE2(dst + i, color, count - i);
+}
+
+__attribute__((target("avx2")))
+void BlendSrcOverAVX2(const uint32_t *src, uint32_t *dst, size_t count) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i full = _mm256_set1_epi16(255);
+  size_t i = 0;
+
+  for (; i + 8 <= count; i += 8) {
+    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+    __m256i s_lo = _mm256_unpacklo_epi8(s, zero);
+    __m256i s_hi = _mm256_unpackhi_epi8(s, zero);
+    __m256i d_lo = _mm256_unpacklo_epi8(d, zero);
+    __m256i d_hi = _mm256_unpackhi_epi8(d, zero);
+    d_lo = Div255AVX2(_mm256_mullo_epi16(d_lo, _mm256_sub_epi16(full, AlphaAVX2(s_lo))));
+    d_hi = Div255AVX2(_mm256_mullo_epi16(d_hi, _mm256_sub_epi16(full, AlphaAVX2(s_hi))));
+    __m256i result = _mm256_adds_epu8(s, _mm256_packus_epi16(d_lo, d_hi));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), result);
+  }
+
+  BlendSrcOverSSE2(src + i, dst + i, count - i);
+}
+
+#endif // SKLAND_PIXEL_OPS_X86
+
+#ifdef SKLAND_PIXEL_OPS_NEON
+
+// ------ NEON ------
+
+/**
+ * @brief Div255() on 8 16-bit lanes, narrowed to 8 bits
+ */
+inline uint8x8_t Div255NEON(uint16x8_t x) {
+  x = vaddq_u16(x, vdupq_n_u16(128));
+  return vshrn_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+}
+
+void PremultiplyNEON(const uint32_t *src, uint32_t *dst, size_t count) {
+  size_t i = 0;
+
+  for (; i + 8 <= count; i += 8) {
+    // val[0] to val[3] are B, G, R, A in little endian
+    uint8x8x4_t pixels = vld4_u8(reinterpret_cast<const uint8_t *>(src + i));
+    pixels.val[0] = Div255NEON(vmull_u8(pixels.val[0], pixels.val[3]));
+    pixels.val[1] = Div255NEON(vmull_u8(pixels.val[1], pixels.val[3]));
+    pixels.val[2] = Div255NEON(vmull_u8(pixels.val[2], pixels.val[3]));
+    vst4_u8(reinterpret_cast<uint8_t *>(dst + i), pixels);
+  }
+
+  PremultiplyScalar(src + i, dst + i, count - i);
+}
+
+void UnpremultiplyNEON(const uint32_t *src, uint32_t *dst, size_t count) {
+  const uint32x4_t mask = vdupq_n_u32(0xFF);
+  const float32x4_t max = vdupq_n_f32(255.f);
+  const float32x4_t half = vdupq_n_f32(0.5f);
+  size_t i = 0;
+
+  for (; i + 4 <= count; i += 4) {
+    uint32x4_t pixels = vld1q_u32(src + i);
+    uint32x4_t a = vshrq_n_u32(pixels, 24);
+    float32x4_t inv = vdivq_f32(max, vcvtq_f32_u32(a));
+
+    uint32x4_t r = vandq_u32(vshrq_n_u32(pixels, 16), mask);
+    uint32x4_t g = vandq_u32(vshrq_n_u32(pixels, 8), mask);
+    uint32x4_t b = vandq_u32(pixels, mask);
+    r = vcvtq_u32_f32(vminq_f32(vaddq_f32(vmulq_f32(vcvtq_f32_u32(r), inv), half), max));
+    g = vcvtq_u32_f32(vminq_f32(vaddq_f32(vmulq_f32(vcvtq_f32_u32(g), inv), half), max));
+    b = vcvtq_u32_f32(vminq_f32(vaddq_f32(vmulq_f32(vcvtq_f32_u32(b), inv), half), max));
+
+    uint32x4_t result = vorrq_u32(vshlq_n_u32(a, 24), vshlq_n_u32(r, 16));
+    result = vorrq_u32(result, vorrq_u32(vshlq_n_u32(g, 8), b));
+
+    // Pixels with 0 alpha
+    result = vbicq_u32(result, vceqq_u32(a, vdupq_n_u32(0)));
+    vst1q_u32(dst + i, result);
+  }
+
+  UnpremultiplyScalar(src + i, dst + i, count - i);
+}
+
+void SwapRBNEON(const uint32_t *src, uint32_t *dst, size_t count) {
+  size_t i = 0;
+
+  for (; i + 16 <= count; i += 16) {
+    uint8x16x4_t pixels = vld4q_u8(reinterpret_cast<const uint8_t *>(src + i));
+    uint8x16_t tmp = pixels.val[0];
+    pixels.val[0] = pixels.val[2];
+    pixels.val[2] = tmp;
+    vst4q_u8(reinterpret_cast<uint8_t *>(dst + i), pixels);
+  }
+
+  SwapRBScalar(src + i, dst + i, count - i);
+}
+
+void FillNEON(uint32_t *dst, uint32_t color, size_t count) {
+  const uint32x4_t value = vdupq_n_u32(color);
+  size_t i = 0;
+
+  for (; i + 4 <= count; i += 4) {
+    vst1q_u32(dst + i, value);
+  }
+
+  FillScalar(dst + i, color, count - i);
+}
+
+void BlendSrcOverNEON(const uint32_t *src, uint32_t *dst, size_t count) {
+  size_t i = 0;
+
+  for (; i + 8 <= count; i += 8) {
+    uint8x8x4_t s = vld4_u8(reinterpret_cast<const uint8_t *>(src + i));
+    uint8x8x4_t d = vld4_u8(reinterpret_cast<const uint8_t *>(dst + i));
+    uint8x8_t inv_a = vmvn_u8(s.val[3]);
+    for (int c = 0; c < 4; c++) {
+      d.val[c] = vqadd_u8(s.val[c], Div255NEON(vmull_u8(d.val[c], inv_a)));
+    }
+    vst4_u8(reinterpret_cast<uint8_t *>(dst + i), d);
+  }
+
+  BlendSrcOverScalar(src + i, dst + i, count - i);
+}
+
+#endif // SKLAND_PIXEL_OPS_NEON
+
+PixelOps::Implementation DetectImplementation() {
+#ifdef SKLAND_PIXEL_OPS_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return PixelOps::kImplementationAVX2;
+  if (__builtin_cpu_supports("sse2")) return PixelOps::kImplementationSSE2;
+#endif
+#ifdef SKLAND_PIXEL_OPS_NEON
+  return PixelOps::kImplementationNEON;
+#endif
+  return PixelOps::kImplementationScalar;
+}
+
+}
+
+const PixelOps::Kernels *PixelOps::kKernels = nullptr;
+
+PixelOps::Implementation PixelOps::kImplementation = PixelOps::kImplementationScalar;
+
+void PixelOps::Premultiply(const uint32_t *src, uint32_t *dst, size_t count) {
+  if (nullptr == kKernels) SetImplementation(DetectImplementation());
+  kKernels->premultiply(src, dst, count);
+}
+
+void PixelOps::Unpremultiply(const uint32_t *src, uint32_t *dst, size_t count) {
+  if (nullptr == kKernels) SetImplementation(DetectImplementation());
+  kKernels->unpremultiply(src, dst, count);
+}
+
+void PixelOps::SwapRB(const uint32_t *src, uint32_t *dst, size_t count) {
+  if (nullptr == kKernels) SetImplementation(DetectImplementation());
+  kKernels->swap_rb(src, dst, count);
+}
+
+void PixelOps::Fill(uint32_t *dst, uint32_t color, size_t count) {
+  if (nullptr == kKernels) SetImplementation(DetectImplementation());
+  kKernels->fill(dst, color, count);
+}
+
+void PixelOps::BlendSrcOver(const uint32_t *src, uint32_t *dst, size_t count) {
+  if (nullptr == kKernels) SetImplementation(DetectImplementation());
+  kKernels->blend_src_over(src, dst, count);
+}
+
+PixelOps::Implementation PixelOps::GetImplementation() {
+  if (nullptr == kKernels) SetImplementation(DetectImplementation());
+  return kImplementation;
+}
+
+bool PixelOps::SetImplementation(Implementation implementation) {
+  const Kernels *kernels = GetKernels(implementation);
+  if (nullptr == kernels) return false;
+
+  kKernels = kernels;
+  kImplementation = implementation;
+  return true;
+}
+
+bool PixelOps::IsSupported(Implementation implementation) {
+  return nullptr != GetKernels(implementation);
+}
+
+const char *PixelOps::GetImplementationName(Implementation implementation) {
+  switch (implementation) {
+    case kImplementationScalar: return "Scalar";
+    case kImplementationSSE2: return "SSE2";
+    case kImplementationAVX2: return "AVX2";
+    case kImplementationNEON: return "NEON";
+    default: return "Unknown";
+  }
+}
+
+const PixelOps::Kernels *PixelOps::GetKernels(Implementation implementation) {
+  switch (implementation) {
+    case kImplementationScalar: {
+      static const Kernels kernels = {
+          PremultiplyScalar,
+          UnpremultiplyScalar,
+          SwapRBScalar,
+          FillScalar,
+          BlendSrcOverScalar
+      };
+      return &kernels;
+    }
+#ifdef SKLAND_PIXEL_OPS_X86
+    case kImplementationSSE2: {
+      static const Kernels kernels = {
+          PremultiplySSE2,
+          UnpremultiplySSE2,
+          SwapRBSSE2,
+          FillSSE2,
+          BlendSrcOverSSE2
+      };
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("sse2") ? &kernels : nullptr;
+    }
+    case kImplementationAVX2: {
+      static const Kernels kernels = {
+          PremultiplyAVX2,
+          UnpremultiplyAVX2,
+          SwapRBAVX2,
+          FillAVX2,
+          BlendSrcOverAVX2
+      };
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") ? &kernels : nullptr;
+    }
+#endif
+#ifdef SKLAND_PIXEL_OPS_NEON
+    case kImplementationNEON: {
+      static const Kernels kernels = {
+          PremultiplyNEON,
+          UnpremultiplyNEON,
+          SwapRBNEON,
+          FillNEON,
+          BlendSrcOverNEON
+      };
+      return &kernels;
+    }
+#endif
+    default: {
+      return nullptr;
+    }
+  }
+}
+
+} // namespace graphic
+} // namespace skland
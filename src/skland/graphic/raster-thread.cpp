@@ -0,0 +1,135 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "skland/graphic/raster-thread.hpp"
+#include "skland/graphic/canvas.hpp"
+#include "skland/graphic/picture.hpp"
+
+#include "skland/core/memory.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace skland {
+namespace graphic {
+
+/**
+ * @ingroup graphic_intern
+ * @brief The private structure used in RasterThread
+ */
+struct RasterThread::Private {
+
+  struct Job {
+
+    Picture picture;
+    Canvas *canvas;
+    std::function<void()> callback;
+
+  };
+
+  Private() = default;
+  Private(const Private &) = delete;
+  Private &operator=(const Private &) = delete;
+
+  ~Private() = default;
+
+  void Run();
+
+  mutable std::mutex mutex;
+
+  /** Notified when a job is queued */
+  std::condition_variable job_cond;
+
+  /** Notified when a job is done */
+  std::condition_variable done_cond;
+
+  std::deque<Job> jobs;
+
+  /** Jobs queued or running */
+  size_t pending = 0;
+
+  bool stop = false;
+
+  std::thread thread;
+
+};
+
+void RasterThread::Private::Run() {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while (true) {
+    job_cond.wait(lock, [this]() { return stop || !jobs.empty(); });
+    if (jobs.empty()) return;
+
+    Job job = std::move(jobs.front());
+    jobs.pop_front();
+    lock.unlock();
+
+    job.canvas->DrawPicture(job.picture);
+    job.canvas->Flush();
+    if (job.callback) job.callback();
+
+    lock.lock();
+    pending--;
+    done_cond.notify_all();
+  }
+}
+
+RasterThread::RasterThread() {
+  p_ = core::MakeUnique<Private>();
+  p_->thread = std::thread(&Private::Run, p_.get());
+}
+
+RasterThread::~RasterThread() {
+  {
+    std::lock_guard<std::mutex> lock(p_->mutex);
+    p_->stop = true;
+  }
+  p_->job_cond.notify_all();
+  p_->thread.join();
+}
+
+void RasterThread::Submit(const Picture &picture, Canvas *canvas, const std::function<void()> &callback) {
+  if (nullptr == canvas) return;
+
+  Private::Job job;
+  job.picture = picture;
+  job.canvas = canvas;
+  job.callback = callback;
+
+  {
+    std::lock_guard<std::mutex> lock(p_->mutex);
+    p_->jobs.push_back(std::move(job));
+    p_->pending++;
+  }
+  p_->job_cond.notify_one();
+}
+
+void RasterThread::Wait() {
+  std::unique_lock<std::mutex> lock(p_->mutex);
+  p_->done_cond.wait(lock, [this]() { return 0 == p_->pending; });
+}
+
+size_t RasterThread::GetPendingCount() const {
+  std::lock_guard<std::mutex> lock(p_->mutex);
+  return p_->pending;
+}
+
+} // namespace graphic
+} // namespace skland
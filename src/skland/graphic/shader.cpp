@@ -17,22 +17,20 @@
 #include "internal/shader_private.hpp"
 
 #include "skland/core/defines.hpp"
-#include "skland/core/memory.hpp"
 
 namespace skland {
 namespace graphic {
 
-Shader::Shader() {
-  p_ = core::MakeUnique<Private>();
+Shader::Shader()
+    : p_() {
 }
 
-Shader::Shader(Private *p)
+Shader::Shader(const Private &p)
     : p_(p) {
-  _ASSERT(p_);
 }
 
-Shader::Shader(const Shader &other) {
-  p_ = core::MakeUnique<Private>(other.p_->sk_shader);
+Shader::Shader(const Shader &other)
+    : p_(*other.p_) {
 }
 
 Shader::~Shader() {
@@ -48,5 +46,13 @@ Shader::operator bool() const {
   return p_->sk_shader.get() != nullptr;
 }
 
+bool operator==(const Shader &shader1, const Shader &shader2) {
+  return shader1.p_->sk_shader == shader2.p_->sk_shader;
+}
+
+bool operator!=(const Shader &shader1, const Shader &shader2) {
+  return shader1.p_->sk_shader != shader2.p_->sk_shader;
+}
+
 } // namespace graphic
 } // namespace skland
@@ -18,24 +18,60 @@
 
 #include <skland/graphic/canvas.hpp>
 #include <skland/graphic/paint.hpp>
+#include <skland/graphic/text-layout.hpp>
 
-#include "SkTextBox.h"
+#include "internal/text-layout_private.hpp"
+
+#include "SkPaint.h"
+
+#include <string>
 
 namespace skland {
 namespace graphic {
 
 using core::RectF;
 
+/**
+ * @brief The private data of TextBox
+ *
+ * The text is shaped and broken into lines by TextLayoutCache when drawn, and
+ * the layout is kept until the text, paint, box width, mode or spacing
+ * changes, so a text box drawn repeatedly does not shape the text again.
+ */
 struct TextBox::Private {
 
   Private(const Private &) = delete;
   Private &operator=(const Private &) = delete;
 
-  Private() {}
+  Private()
+      : mode(kModeLineBreak),
+        spacing_align(kSpacingAlignStart),
+        spacing_mul(1.f),
+        spacing_add(0.f) {}
 
   ~Private() {}
 
-  SkTextBox sk_text_box;
+  const TextLayout &GetLayout() {
+    if (!layout)
+      layout = TextLayoutCache::Get(text, paint, kModeLineBreak == mode ? box.width() : 0.f, spacing_mul, spacing_add);
+    return *layout;
+  }
+
+  Mode mode;
+
+  SpacingAlign spacing_align;
+
+  RectF box;
+
+  float spacing_mul;
+
+  float spacing_add;
+
+  std::string text;
+
+  Paint paint;
+
+  std::shared_ptr<const TextLayout> layout;
 
 };
 
@@ -48,59 +84,92 @@ TextBox::~TextBox() {
 }
 
 TextBox::Mode TextBox::GetMode() const {
-  return static_cast<Mode>(p_->sk_text_box.getMode());
+  return p_->mode;
 }
 
 void TextBox::SetMode(Mode mode) {
-  p_->sk_text_box.setMode(static_cast<SkTextBox::Mode>(mode));
+  if (p_->mode == mode) return;
+
+  p_->mode = mode;
+  p_->layout.reset();
 }
 
 TextBox::SpacingAlign TextBox::GetSpacingAlign() const {
-  return static_cast<SpacingAlign >(p_->sk_text_box.getSpacingAlign());
+  return p_->spacing_align;
 }
 
 void TextBox::SetSpacingAlign(SpacingAlign align) {
-  p_->sk_text_box.setSpacingAlign(static_cast<SkTextBox::SpacingAlign >(align));
+  p_->spacing_align = align;
 }
 
 void TextBox::GetBox(RectF *rect) const {
-  p_->sk_text_box.getBox(reinterpret_cast<SkRect *>(rect));
+  *rect = p_->box;
 }
 
 void TextBox::SetBox(const RectF &rect) {
-  p_->sk_text_box.setBox(reinterpret_cast<const SkRect &>(rect));
+  if (kModeLineBreak == p_->mode && rect.width() != p_->box.width()) p_->layout.reset();
+  p_->box = rect;
 }
 
 void TextBox::SetBox(float left, float top, float right, float bottom) {
-  p_->sk_text_box.setBox(left, top, right, bottom);
+  SetBox(RectF(left, top, right, bottom));
 }
 
 void TextBox::GetSpacing(float *mul, float *add) const {
-  p_->sk_text_box.getSpacing(mul, add);
+  if (mul) *mul = p_->spacing_mul;
+  if (add) *add = p_->spacing_add;
 }
 
 void TextBox::SetSpacing(float mul, float add) {
-  p_->sk_text_box.setSpacing(mul, add);
+  if (p_->spacing_mul == mul && p_->spacing_add == add) return;
+
+  p_->spacing_mul = mul;
+  p_->spacing_add = add;
+  p_->layout.reset();
 }
 
 void TextBox::Draw(const Canvas &canvas, const char *text, size_t len, const Paint &paint) {
-  p_->sk_text_box.draw(canvas.GetSkCanvas(), text, len, paint.GetSkPaint());
+  SetText(text, len, paint);
+  Draw(canvas);
 }
 
 void TextBox::SetText(const char *text, size_t len, const Paint &paint) {
-  p_->sk_text_box.setText(text, len, paint.GetSkPaint());
+  p_->text.assign(text, len);
+  p_->paint = paint;
+  p_->layout.reset();
 }
 
 void TextBox::Draw(const Canvas &canvas) {
-  p_->sk_text_box.draw(canvas.GetSkCanvas());
+  const TextLayout &layout = p_->GetLayout();
+
+  float y = p_->box.top;
+  switch (p_->spacing_align) {
+    case kSpacingAlignCenter: {
+      y += (p_->box.height() - layout.GetHeight()) / 2.f;
+      break;
+    }
+    case kSpacingAlignEnd: {
+      y += p_->box.height() - layout.GetHeight();
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+
+  layout.p_->Draw(canvas.GetSkCanvas(), p_->box.left, y, p_->paint.GetSkPaint());
 }
 
 int TextBox::CountLines() const {
-  return p_->sk_text_box.countLines();
+  return p_->GetLayout().CountLines();
 }
 
 float TextBox::GetTextHeight() const {
-  return p_->sk_text_box.getTextHeight();
+  return p_->GetLayout().GetHeight();
+}
+
+float TextBox::GetTextWidth() const {
+  return p_->GetLayout().GetWidth();
 }
 
 } // namespace graphic
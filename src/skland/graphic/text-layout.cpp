@@ -0,0 +1,392 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "internal/text-layout_private.hpp"
+
+#include <skland/graphic/font.hpp>
+#include <skland/graphic/paint.hpp>
+
+#include "skland/core/memory.hpp"
+
+#include "SkCanvas.h"
+#include "SkPaint.h"
+
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+#include <cstring>
+
+namespace skland {
+namespace graphic {
+
+TextLayout::TextLayout(const char *text, size_t byte_length, const Font &font, float box_width, float scale) {
+  p_ = core::MakeUnique<Private>();
+  p_->sk_typeface = sk_ref_sp(font.GetSkTypeface());
+  p_->text_size = font.GetSize() * scale;
+  p_->Layout(text, byte_length, box_width * scale, 1.f, 0.f);
+}
+
+TextLayout::TextLayout(const char *text, size_t byte_length, const Paint &paint,
+                       float box_width, float spacing_mul, float spacing_add) {
+  p_ = core::MakeUnique<Private>();
+  p_->sk_typeface = sk_ref_sp(paint.GetSkPaint().getTypeface());
+  p_->text_size = paint.GetTextSize();
+  p_->Layout(text, byte_length, box_width, spacing_mul, spacing_add);
+}
+
+TextLayout::~TextLayout() {
+
+}
+
+int TextLayout::GetGlyphCount() const {
+  return static_cast<int>(p_->glyphs.size());
+}
+
+int TextLayout::CountLines() const {
+  return p_->line_count;
+}
+
+float TextLayout::GetWidth() const {
+  return p_->width;
+}
+
+float TextLayout::GetHeight() const {
+  return p_->height;
+}
+
+size_t TextLayout::GetMemorySize() const {
+  return sizeof(TextLayout) + sizeof(Private)
+      + p_->glyphs.capacity() * sizeof(SkGlyphID)
+      + p_->positions.capacity() * sizeof(SkPoint);
+}
+
+void TextLayout::Private::Layout(const char *text,
+                                 size_t byte_length,
+                                 float max_width,
+                                 float spacing_mul,
+                                 float spacing_add) {
+  SkPaint sk_paint;
+  sk_paint.setTypeface(sk_typeface);
+  sk_paint.setTextSize(text_size);
+  sk_paint.setTextEncoding(SkPaint::kUTF8_TextEncoding);
+
+  SkPaint::FontMetrics metrics;
+  const float font_height = sk_paint.getFontMetrics(&metrics);
+  const float line_spacing = font_height * spacing_mul + spacing_add;
+  const float ascent = -metrics.fAscent;
+  line_count = 1;
+  height = font_height;
+
+  int count = sk_paint.textToGlyphs(text, byte_length, nullptr);
+  if (count <= 0) return;
+
+  SkGlyphID space = 0;
+  sk_paint.textToGlyphs(" ", 1, &space);
+
+  glyphs.resize(static_cast<size_t>(count));
+  sk_paint.textToGlyphs(text, byte_length, glyphs.data());
+
+  // One glyph for each code point, mark the glyphs of '\n'
+  std::vector<bool> hard_breaks(static_cast<size_t>(count), false);
+  int index = 0;
+  for (size_t i = 0; i < byte_length && index < count; i++) {
+    if ((text[i] & 0xC0) == 0x80) continue;  // UTF-8 continuation byte
+    if (text[i] == '\n') hard_breaks[index] = true;
+    index++;
+  }
+
+  std::vector<SkScalar> widths(static_cast<size_t>(count));
+  sk_paint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+  sk_paint.getTextWidths(glyphs.data(), count * sizeof(SkGlyphID), widths.data());
+
+  // Greedy line breaking, wrap after the last space or break the word if
+  // there's no space. Glyphs of '\n' are dropped, so n counts the glyphs kept.
+  const bool line_break = max_width > 0.f;
+  int n = 0;
+  int line_start = 0;
+  int last_space = -1;
+  float x = 0.f;
+  float baseline = ascent;
+
+  positions.resize(static_cast<size_t>(count));
+  for (int i = 0; i < count; i++) {
+    if (hard_breaks[i]) {
+      width = std::max(width, x);
+
+      line_count++;
+      baseline += line_spacing;
+      line_start = n;
+      last_space = -1;
+      x = 0.f;
+      continue;
+    }
+
+    if (line_break && (x + widths[i] > max_width) && (n > line_start)) {
+      int next = last_space > line_start ? last_space + 1 : n;
+      float line_width = next == n ? x : positions[last_space].fX;
+      width = std::max(width, line_width);
+
+      line_count++;
+      baseline += line_spacing;
+      line_start = next;
+      last_space = -1;
+      x = 0.f;
+      for (int j = next; j < n; j++) {
+        positions[j].set(x, baseline);
+        x += widths[j];
+      }
+    }
+
+    glyphs[n] = glyphs[i];
+    widths[n] = widths[i];
+    positions[n].set(x, baseline);
+    x += widths[n];
+    if (glyphs[n] == space) last_space = n;
+    n++;
+  }
+
+  glyphs.resize(static_cast<size_t>(n));
+  positions.resize(static_cast<size_t>(n));
+
+  width = std::max(width, x);
+  height = font_height + line_spacing * (line_count - 1);
+}
+
+void TextLayout::Private::Draw(SkCanvas *canvas, float x, float y, const SkPaint &paint) const {
+  if (glyphs.empty()) return;
+
+  SkPaint sk_paint(paint);
+  sk_paint.setTypeface(sk_typeface);
+  sk_paint.setTextSize(text_size);
+  sk_paint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+  sk_paint.setTextAlign(SkPaint::kLeft_Align);
+
+  canvas->save();
+  canvas->translate(x, y);
+  canvas->drawPosText(glyphs.data(), glyphs.size() * sizeof(SkGlyphID), positions.data(), sk_paint);
+  canvas->restore();
+}
+
+// ------
+
+namespace {
+
+struct LayoutKey {
+
+  bool operator==(const LayoutKey &other) const {
+    return typeface_id == other.typeface_id &&
+        text_size == other.text_size &&
+        box_width == other.box_width &&
+        scale == other.scale &&
+        spacing_mul == other.spacing_mul &&
+        spacing_add == other.spacing_add &&
+        text == other.text;
+  }
+
+  std::string text;
+
+  uint32_t typeface_id;
+
+  float text_size;
+
+  float box_width;
+
+  float scale;
+
+  float spacing_mul;
+
+  float spacing_add;
+
+};
+
+struct LayoutKeyHash {
+
+  size_t operator()(const LayoutKey &key) const {
+    size_t hash = std::hash<std::string>()(key.text);
+    hash = Combine(hash, key.typeface_id);
+    hash = Combine(hash, Bits(key.text_size));
+    hash = Combine(hash, Bits(key.box_width));
+    hash = Combine(hash, Bits(key.scale));
+    hash = Combine(hash, Bits(key.spacing_mul));
+    hash = Combine(hash, Bits(key.spacing_add));
+    return hash;
+  }
+
+  static size_t Combine(size_t hash, uint32_t value) {
+    return hash ^ (value + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+  }
+
+  static uint32_t Bits(float value) {
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+};
+
+struct LayoutEntry {
+
+  LayoutKey key;
+
+  std::shared_ptr<const TextLayout> layout;
+
+  size_t size;
+
+};
+
+struct LayoutCache {
+
+  typedef std::list<LayoutEntry> EntryList;
+
+  void Evict() {
+    while (usage > budget && !entries.empty()) {
+      const LayoutEntry &entry = entries.back();
+      usage -= entry.size;
+      map.erase(entry.key);
+      entries.pop_back();
+    }
+  }
+
+  /**
+   * @brief Most recently used entries are at the front
+   */
+  EntryList entries;
+
+  std::unordered_map<LayoutKey, EntryList::iterator, LayoutKeyHash> map;
+
+  size_t budget = 4 * 1024 * 1024;
+
+  size_t usage = 0;
+
+  uint64_t hit_count = 0;
+
+  uint64_t miss_count = 0;
+
+};
+
+LayoutCache &GetLayoutCache() {
+  static LayoutCache cache;
+  return cache;
+}
+
+/**
+ * @brief Find the layout of the key, or create one with the factory and cache it
+ */
+template<typename Factory>
+std::shared_ptr<const TextLayout> Find(const LayoutKey &key, Factory factory) {
+  LayoutCache &cache = GetLayoutCache();
+
+  auto it = cache.map.find(key);
+  if (it != cache.map.end()) {
+    cache.hit_count++;
+    cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+    return it->second->layout;
+  }
+
+  cache.miss_count++;
+  std::shared_ptr<const TextLayout> layout = factory();
+
+  LayoutEntry entry;
+  entry.key = key;
+  entry.layout = layout;
+  entry.size = layout->GetMemorySize() + key.text.capacity();
+
+  cache.usage += entry.size;
+  cache.entries.push_front(std::move(entry));
+  cache.map[key] = cache.entries.begin();
+  cache.Evict();
+
+  return layout;
+}
+
+}
+
+std::shared_ptr<const TextLayout> TextLayoutCache::Get(const std::string &text,
+                                                       const Font &font,
+                                                       float box_width,
+                                                       float scale) {
+  LayoutKey key;
+  key.text = text;
+  key.typeface_id = font.GetSkTypeface()->uniqueID();
+  key.text_size = font.GetSize();
+  key.box_width = box_width;
+  key.scale = scale;
+  key.spacing_mul = 1.f;
+  key.spacing_add = 0.f;
+
+  return Find(key, [&]() {
+    return std::make_shared<TextLayout>(text.c_str(), text.length(), font, box_width, scale);
+  });
+}
+
+std::shared_ptr<const TextLayout> TextLayoutCache::Get(const std::string &text,
+                                                       const Paint &paint,
+                                                       float box_width,
+                                                       float spacing_mul,
+                                                       float spacing_add) {
+  SkTypeface *typeface = paint.GetSkPaint().getTypeface();
+
+  LayoutKey key;
+  key.text = text;
+  key.typeface_id = nullptr == typeface ? 0 : typeface->uniqueID();
+  key.text_size = paint.GetTextSize();
+  key.box_width = box_width;
+  key.scale = 1.f;
+  key.spacing_mul = spacing_mul;
+  key.spacing_add = spacing_add;
+
+  return Find(key, [&]() {
+    return std::make_shared<TextLayout>(text.c_str(), text.length(), paint, box_width, spacing_mul, spacing_add);
+  });
+}
+
+void TextLayoutCache::SetMemoryBudget(size_t budget) {
+  LayoutCache &cache = GetLayoutCache();
+  cache.budget = budget;
+  cache.Evict();
+}
+
+size_t TextLayoutCache::GetMemoryBudget() {
+  return GetLayoutCache().budget;
+}
+
+size_t TextLayoutCache::GetMemoryUsage() {
+  return GetLayoutCache().usage;
+}
+
+size_t TextLayoutCache::GetCount() {
+  return GetLayoutCache().entries.size();
+}
+
+uint64_t TextLayoutCache::GetHitCount() {
+  return GetLayoutCache().hit_count;
+}
+
+uint64_t TextLayoutCache::GetMissCount() {
+  return GetLayoutCache().miss_count;
+}
+
+void TextLayoutCache::Clear() {
+  LayoutCache &cache = GetLayoutCache();
+  cache.map.clear();
+  cache.entries.clear();
+  cache.usage = 0;
+}
+
+} // namespace graphic
+} // namespace skland
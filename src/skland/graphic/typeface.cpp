@@ -15,34 +15,35 @@
  */
 
 #include "internal/typeface_private.hpp"
+#include "internal/font-cache_private.hpp"
 
 namespace skland {
 namespace graphic {
 
 using core::RectF;
 
-Typeface::Typeface(Style style) {
-  p_.reset(new Private);
+Typeface::Typeface(Style style)
+    : p_() {
   p_->sk_typeface = SkTypeface::MakeDefault(static_cast<SkTypeface::Style>(style));
 }
 
-Typeface::Typeface(const char *family_name, FontStyle font_style) {
-  p_.reset(new Private);
-  p_->sk_typeface = SkTypeface::MakeFromName(family_name, *reinterpret_cast<SkFontStyle *>(&font_style));
+Typeface::Typeface(const char *family_name, FontStyle font_style)
+    : p_() {
+  p_->sk_typeface = FontCache::Private::GetTypeface(family_name, font_style);
 }
 
-Typeface::Typeface(const Typeface &other, Style style) {
-  p_.reset(new Private);
+Typeface::Typeface(const Typeface &other, Style style)
+    : p_() {
   p_->sk_typeface = SkTypeface::MakeFromTypeface(other.p_->sk_typeface.get(), (SkTypeface::Style) style);
 }
 
-Typeface::Typeface(SkTypeface *family, Style style) {
-  p_.reset(new Private);
+Typeface::Typeface(SkTypeface *family, Style style)
+    : p_() {
   p_->sk_typeface = SkTypeface::MakeFromTypeface(family, (SkTypeface::Style) style);
 }
 
-Typeface::Typeface(const char *path, int index) {
-  p_.reset(new Private);
+Typeface::Typeface(const char *path, int index)
+    : p_() {
   p_->sk_typeface = SkTypeface::MakeFromFile(path, index);
 }
 
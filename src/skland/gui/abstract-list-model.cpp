@@ -0,0 +1,45 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "skland/gui/abstract-list-model.hpp"
+
+namespace skland {
+namespace gui {
+
+AbstractListModel::AbstractListModel()
+    : core::Trackable() {
+
+}
+
+AbstractListModel::~AbstractListModel() {
+
+}
+
+int AbstractListModel::GetViewType(int /*index*/) const {
+  return 0;
+}
+
+void AbstractListModel::UnbindView(AbstractView */*view*/, int /*index*/) {
+  // override in sub class
+}
+
+void AbstractListModel::NotifyChanged() {
+  changed_.Emit();
+}
+
+} // namespace gui
+} // namespace skland
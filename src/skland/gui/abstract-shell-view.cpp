@@ -19,6 +19,7 @@
 
 #include "skland/core/defines.hpp"
 #include "skland/core/memory.hpp"
+#include "skland/core/memory-stats.hpp"
 
 #include "skland/numerical/bit.hpp"
 
@@ -30,9 +31,6 @@
 
 #include "skland/graphic/canvas.hpp"
 
-#include "SkCanvas.h"
-#include "SkImage.h"
-
 namespace skland {
 namespace gui {
 
@@ -60,6 +58,7 @@ AbstractShellView::AbstractShellView(int width,
   p_->parent = parent;
 
   if (nullptr != title) p_->title = title;
+  core::MemoryStats::SetOwnerName(this, p_->title);
 
   if (nullptr == p_->parent) {
     p_->shell_surface = Surface::Shell::Toplevel::Create(this, Theme::GetShadowMargin());
@@ -82,10 +81,12 @@ AbstractShellView::AbstractShellView(int width,
 
 AbstractShellView::~AbstractShellView() {
   delete p_->shell_surface;
+  core::MemoryStats::ReleaseOwner(this);
 }
 
 void AbstractShellView::SetTitle(const char *title) {
   p_->title = title;
+  core::MemoryStats::SetOwnerName(this, p_->title);
   if (nullptr == p_->parent) {
     Surface::Shell::Toplevel::Get(p_->shell_surface)->SetTitle(title);
   }
@@ -153,6 +154,10 @@ const std::string &AbstractShellView::GetTitle() const {
   return p_->title;
 }
 
+size_t AbstractShellView::GetMemoryUsage() const {
+  return core::MemoryStats::GetOwnerTotalUsage(this);
+}
+
 bool AbstractShellView::IsFullscreen() const {
   return 0 != (p_->flags & Private::kFlagMaskFullscreen);
 }
@@ -207,6 +212,7 @@ void AbstractShellView::AttachView(AbstractView *view) {
   }
 
   view->p_->shell_view = this;
+  p_->geometry_store.AddRoot(view);
 
   OnViewAttached(view);
   if (view->p_->shell_view == this)
@@ -218,6 +224,7 @@ void AbstractShellView::DetachView(AbstractView *view) {
 
   _ASSERT(nullptr == view->p_->parent);
   view->p_->shell_view = nullptr;
+  p_->geometry_store.RemoveRoot(view);
 
   OnViewDetached(view);
   if (view->p_->shell_view != this)
@@ -322,6 +329,14 @@ Surface *AbstractShellView::GetShellSurface() const {
   return p_->shell_surface;
 }
 
+ViewGeometryStore *AbstractShellView::GetViewGeometryStore() const {
+  return &p_->geometry_store;
+}
+
+ChromePathCache *AbstractShellView::GetChromePathCache() const {
+  return &p_->chrome_paths;
+}
+
 void AbstractShellView::DispatchUpdate(AbstractView *view) {
   view->Update();
   view->DispatchUpdate();
@@ -403,92 +418,11 @@ void AbstractShellView::DispatchMouseUpEvent(MouseEvent *event) {
 }
 
 void AbstractShellView::DropShadow(const Context &context) {
-  int scale = context.surface()->GetScale();
-  float rad = (Theme::GetShadowRadius() - 1.f); // The spread radius
-  float offset_x = Theme::GetShadowOffsetX();
-  float offset_y = Theme::GetShadowOffsetY();
-
-  int width = GetWidth();
-  int height = GetHeight();
-
-  if (!IsFocused()) {
-    rad = (int) rad / 3;
-    offset_x = (int) offset_x / 3;
-    offset_y = (int) offset_y / 3;
-  }
-
-  // shadow map
-  SkCanvas *c = context.canvas()->GetSkCanvas();
-  c->save();
-  c->scale(scale, scale);
-  sk_sp<SkImage> image = SkImage::MakeFromRaster(*Theme::GetShadowPixmap(), nullptr, nullptr);
-
-  // top-left
-  c->drawImageRect(image,
-                   SkRect::MakeLTRB(0, 0,
-                                    2 * Theme::GetShadowRadius(), 2 * Theme::GetShadowRadius()),
-                   SkRect::MakeXYWH(-rad + offset_x, -rad + offset_y,
-                                    2 * rad, 2 * rad),
-                   nullptr);
-
-  // top
-  c->drawImageRect(image,
-                   SkRect::MakeLTRB(2 * Theme::GetShadowRadius(), 0,
-                                    250 - 2 * Theme::GetShadowRadius(), 2 * Theme::GetShadowRadius()),
-                   SkRect::MakeXYWH(rad + offset_x, -rad + offset_y,
-                                    width - 2 * rad, 2 * rad),
-                   nullptr);
-
-  // top-right
-  c->drawImageRect(image,
-                   SkRect::MakeLTRB(250 - 2 * Theme::GetShadowRadius(), 0,
-                                    250, 2 * Theme::GetShadowRadius()),
-                   SkRect::MakeXYWH(width - rad + offset_x, -rad + offset_y,
-                                    2 * rad, 2 * rad),
-                   nullptr);
-
-  // left
-  c->drawImageRect(image,
-                   SkRect::MakeLTRB(0, 2 * Theme::GetShadowRadius(),
-                                    2 * Theme::GetShadowRadius(), 250 - 2 * Theme::GetShadowRadius()),
-                   SkRect::MakeXYWH(-rad + offset_x, rad + offset_y,
-                                    2 * rad, height - 2 * rad),
-                   nullptr);
-
-  // bottom-left
-  c->drawImageRect(image,
-                   SkRect::MakeLTRB(0, 250 - 2 * Theme::GetShadowRadius(),
-                                    2 * Theme::GetShadowRadius(), 250),
-                   SkRect::MakeXYWH(-rad + offset_x, height - rad + offset_y,
-                                    2 * rad, 2 * rad),
-                   nullptr);
-
-  // bottom
-  c->drawImageRect(image,
-                   SkRect::MakeLTRB(2 * Theme::GetShadowRadius(), 250 - 2 * Theme::GetShadowRadius(),
-                                    250 - 2 * Theme::GetShadowRadius(), 250),
-                   SkRect::MakeXYWH(rad + offset_x, height - rad + offset_y,
-                                    width - 2 * rad, 2 * rad),
-                   nullptr);
-
-  // bottom-right
-  c->drawImageRect(image,
-                   SkRect::MakeLTRB(250 - 2 * Theme::GetShadowRadius(), 250 - 2 * Theme::GetShadowRadius(),
-                                    250, 250),
-                   SkRect::MakeXYWH(width - rad + offset_x,
-                                    height - rad + offset_y,
-                                    2 * rad,
-                                    2 * rad),
-                   nullptr);
-
-  // right
-  c->drawImageRect(image,
-                   SkRect::MakeLTRB(250 - 2 * Theme::GetShadowRadius(), 2 * Theme::GetShadowRadius(),
-                                    250, 250 - 2 * Theme::GetShadowRadius()),
-                   SkRect::MakeXYWH(width - rad + offset_x, rad + offset_y,
-                                    2 * rad, height - 2 * rad),
-                   nullptr);
-  c->restore();
+  p_->chrome_paths.DrawShadow(context.canvas(),
+                              GetWidth(),
+                              GetHeight(),
+                              context.surface()->GetScale(),
+                              IsFocused());
 }
 
 // ---------
@@ -314,6 +314,20 @@ bool AbstractView::IsVisible() const {
   return p_->visible;
 }
 
+void AbstractView::SetOpaque(bool opaque) {
+  if (p_->opaque == opaque) return;
+
+  p_->opaque = opaque;
+  if (nullptr != p_->geometry_store)
+    p_->geometry_store->SetOpaqueAt(p_->geometry_index, opaque);
+
+  Update();
+}
+
+bool AbstractView::IsOpaque() const {
+  return p_->opaque;
+}
+
 void AbstractView::AddAnchorTo(AbstractView *target, Alignment align, int distance) {
   if (target == p_->parent || this == target->p_->parent) {
     switch (align) {
@@ -387,6 +401,9 @@ const AnchorGroup &AbstractView::GetAnchorGroup(Alignment align) const {
 }
 
 void AbstractView::Update(bool validate) {
+  if (nullptr != p_->geometry_store)
+    p_->geometry_store->SetDirtyAt(p_->geometry_index, validate);
+
   if (!validate) {
     p_->redraw_task.Unlink();
     return;
@@ -555,6 +572,9 @@ AbstractView *AbstractView::DispatchMouseEnterEvent(MouseEvent *event) {
 bool AbstractView::RequestSaveGeometry(const RectF &geometry) {
   p_->geometry = geometry;
 
+  if (nullptr != p_->geometry_store)
+    p_->geometry_store->SetGeometryAt(p_->geometry_index, geometry);
+
   if (p_->last_geometry == p_->geometry) {
     p_->geometry_task.Unlink();
     return false;
@@ -599,25 +619,9 @@ void AbstractView::UntrackMouseMotion() {
 AbstractView *AbstractView::GetChildAt(int index) const {
   if (index < 0) index = p_->children_count + index;
 
-  AbstractView *object = nullptr;
-  int mid = (p_->children_count + 1) / 2;
-
-  if (index >= 0 && index < mid) {
-    object = p_->first_child;
-    while (index > 0) {
-      object = object->p_->next;
-      index--;
-    }
-  } else if (index >= mid && index < p_->children_count) {
-    object = p_->last_child;
-    int max = p_->children_count - 1;
-    while (index < max) {
-      object = object->p_->previous;
-      index++;
-    }
-  }
+  if (index < 0 || index >= p_->children_count) return nullptr;
 
-  return object;
+  return p_->children_index.Get(index, p_->children_count, p_->first_child, p_->last_child);
 }
 
 void AbstractView::PushFrontChild(AbstractView *child) {
@@ -652,6 +656,9 @@ void AbstractView::PushFrontChild(AbstractView *child) {
   // child->data_->previous_ = nullptr;
   child->p_->parent = this;
   p_->children_count++;
+  p_->children_index.OnInserted(child);
+
+  p_->InvalidateGeometryStore();
 
   OnChildAdded(child);
   if (child->p_->parent == this)
@@ -685,11 +692,9 @@ void AbstractView::InsertChild(AbstractView *child, int index) {
     p_->first_child = child;
   } else {
     if (index >= 0) {
-      AbstractView *p = p_->first_child;
-      while (p && (index > 0)) {
-        p = p->p_->next;
-        index--;
-      }
+      AbstractView *p = index < p_->children_count ?
+                        p_->children_index.Get(index, p_->children_count, p_->first_child, p_->last_child) :
+                        nullptr;
       if (p) {  // insert before p
         child->p_->previous = p->p_->previous;
         child->p_->next = p;
@@ -725,6 +730,9 @@ void AbstractView::InsertChild(AbstractView *child, int index) {
 
   child->p_->parent = this;
   p_->children_count++;
+  p_->children_index.OnInserted(child);
+
+  p_->InvalidateGeometryStore();
 
   OnChildAdded(child);
   if (child->p_->parent == this)
@@ -763,6 +771,9 @@ void AbstractView::PushBackChild(AbstractView *child) {
   // child->data_->next_ = nullptr;
   child->p_->parent = this;
   p_->children_count++;
+  p_->children_index.OnInserted(child);
+
+  p_->InvalidateGeometryStore();
 
   OnChildAdded(child);
   if (child->p_->parent == this)
@@ -774,6 +785,8 @@ AbstractView *AbstractView::RemoveChild(AbstractView *child) {
 
   _ASSERT(p_->children_count > 0);
 
+  p_->children_index.OnRemoving(child);
+
   if (child->p_->previous) {
     child->p_->previous->p_->next = child->p_->next;
   } else {
@@ -795,6 +808,8 @@ AbstractView *AbstractView::RemoveChild(AbstractView *child) {
   child->p_->next = nullptr;
   child->p_->parent = nullptr;
 
+  p_->InvalidateGeometryStore();
+
   OnChildRemoved(child);
   if (child->p_->parent != this)
     child->OnRemovedFromParent(this);
@@ -818,6 +833,16 @@ void AbstractView::ClearChildren() {
   p_->children_count = 0;
   p_->first_child = nullptr;
   p_->last_child = nullptr;
+  p_->children_index.Clear();
+}
+
+void AbstractView::Draw(AbstractView *view, const Context &context) {
+  view->OnDraw(context);
+
+  // Sub views are drawn in the same order as DispatchUpdate() queues them
+  for (AbstractView *sub = view->p_->last_child; sub; sub = sub->p_->previous) {
+    if (sub->IsVisible()) Draw(sub, context);
+  }
 }
 
 bool AbstractView::SwapIndex(AbstractView *view1, AbstractView *view2) {
@@ -826,6 +851,10 @@ bool AbstractView::SwapIndex(AbstractView *view1, AbstractView *view2) {
   if (view1->p_->parent != view2->p_->parent) return false;
   if (view1->p_->parent == nullptr) return false;
 
+  view1->p_->InvalidateGeometryStore();
+  view1->p_->parent->p_->children_index.InvalidateFrom(view1);
+  view1->p_->parent->p_->children_index.InvalidateFrom(view2);
+
   AbstractView *tmp1 = nullptr;
   AbstractView *tmp2 = nullptr;
 
@@ -894,6 +923,9 @@ bool AbstractView::InsertSiblingBefore(AbstractView *src, AbstractView *dst) {
   if (src == nullptr || dst == nullptr) return false;
   if (src == dst) return false;
 
+  src->p_->InvalidateGeometryStore();
+  dst->p_->InvalidateGeometryStore();
+
   if (dst->p_->parent != nullptr) {
 
     if (dst->p_->parent == src->p_->parent) {
@@ -902,6 +934,9 @@ bool AbstractView::InsertSiblingBefore(AbstractView *src, AbstractView *dst) {
         return true;
       }
 
+      src->p_->parent->p_->children_index.InvalidateFrom(src);
+      src->p_->parent->p_->children_index.InvalidateFrom(dst);
+
       if (dst->p_->previous) {
         dst->p_->previous->p_->next = dst->p_->next;
       } else {
@@ -954,6 +989,7 @@ bool AbstractView::InsertSiblingBefore(AbstractView *src, AbstractView *dst) {
 
   dst->p_->parent = src->p_->parent;
   src->p_->parent->p_->children_count++;
+  src->p_->parent->p_->children_index.OnInserted(dst);
 
   return true;
 }
@@ -962,6 +998,9 @@ bool AbstractView::InsertSiblingAfter(AbstractView *src, AbstractView *dst) {
   if (src == nullptr || dst == nullptr) return false;
   if (src == dst) return false;
 
+  src->p_->InvalidateGeometryStore();
+  dst->p_->InvalidateGeometryStore();
+
   if (dst->p_->parent != nullptr) {
 
     if (dst->p_->previous == src->p_->parent) {
@@ -970,6 +1009,9 @@ bool AbstractView::InsertSiblingAfter(AbstractView *src, AbstractView *dst) {
         return true;
       }
 
+      src->p_->parent->p_->children_index.InvalidateFrom(src);
+      src->p_->parent->p_->children_index.InvalidateFrom(dst);
+
       if (dst->p_->previous) {
         dst->p_->previous->p_->next = dst->p_->next;
       } else {
@@ -1023,6 +1065,7 @@ bool AbstractView::InsertSiblingAfter(AbstractView *src, AbstractView *dst) {
 
   dst->p_->parent = src->p_->parent;
   src->p_->parent->p_->children_count++;
+  src->p_->parent->p_->children_index.OnInserted(dst);
 
   return true;
 }
@@ -1030,11 +1073,15 @@ bool AbstractView::InsertSiblingAfter(AbstractView *src, AbstractView *dst) {
 void AbstractView::MoveToFirst(AbstractView *view) {
   if (view->p_->parent) {
 
+    view->p_->InvalidateGeometryStore();
+
     if (view->p_->parent->p_->first_child == view) {
       _ASSERT(view->p_->previous == 0);
       return;    // already at first
     }
 
+    view->p_->parent->p_->children_index.Invalidate();
+
     view->p_->previous->p_->next = view->p_->next;
     if (view->p_->next) {
       view->p_->next->p_->previous = view->p_->previous;
@@ -1053,11 +1100,15 @@ void AbstractView::MoveToFirst(AbstractView *view) {
 void AbstractView::MoveToLast(AbstractView *view) {
   if (view->p_->parent) {
 
+    view->p_->InvalidateGeometryStore();
+
     if (view->p_->parent->p_->last_child == view) {
       _ASSERT(view->p_->next == 0);
       return;    // already at last
     }
 
+    view->p_->parent->p_->children_index.OnRemoving(view);
+
     view->p_->next->p_->previous = view->p_->previous;
 
     if (view->p_->previous) {
@@ -1071,14 +1122,19 @@ void AbstractView::MoveToLast(AbstractView *view) {
     view->p_->previous = view->p_->parent->p_->last_child;
     view->p_->parent->p_->last_child->p_->next = view;
     view->p_->parent->p_->last_child = view;
+    view->p_->parent->p_->children_index.OnInserted(view);
   }
 }
 
 void AbstractView::MoveForward(AbstractView *view) {
   if (view->p_->parent) {
 
+    view->p_->InvalidateGeometryStore();
+
     if (view->p_->next) {
 
+      view->p_->parent->p_->children_index.InvalidateFrom(view);
+
       AbstractView *tmp = view->p_->next;
 
       tmp->p_->previous = view->p_->previous;
@@ -1118,8 +1174,12 @@ void AbstractView::MoveForward(AbstractView *view) {
 void AbstractView::MoveBackward(AbstractView *view) {
   if (view->p_->parent) {
 
+    view->p_->InvalidateGeometryStore();
+
     if (view->p_->previous) {
 
+      view->p_->parent->p_->children_index.InvalidateFrom(view->p_->previous);
+
       AbstractView *tmp = view->p_->previous;
 
       tmp->p_->next = view->p_->next;
@@ -57,9 +57,8 @@ std::pair<Anchor *, Anchor *> Anchor::MakePair(int distance,
   Anchor *anchor2 = new Anchor(view2);
   anchor1->contrary_ = anchor2;
   anchor2->contrary_ = anchor1;
-  anchor1->distance_.reset(new int);
+  anchor1->distance_ = std::make_shared<int>(distance);
   anchor2->distance_ = anchor1->distance_;
-  *anchor1->distance_ = distance;
 
   return std::make_pair(anchor1, anchor2);
 }
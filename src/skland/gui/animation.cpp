@@ -0,0 +1,346 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "skland/gui/animation.hpp"
+
+#include "skland/gui/abstract-shell-view.hpp"
+#include "skland/gui/application.hpp"
+#include "skland/gui/display.hpp"
+#include "skland/gui/output.hpp"
+
+#include "skland/core/memory.hpp"
+
+#include "internal/animation_frame-clock.hpp"
+
+namespace skland {
+namespace gui {
+
+/**
+ * @brief The private structure linked in the running deque of the frame clock
+ */
+struct Animation::Private : public core::BiNode {
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
+
+  explicit Private(Animation *owner)
+      : owner(owner) {}
+
+  virtual ~Private() {}
+
+  Animation *owner = nullptr;
+
+  AbstractView *view = nullptr;
+
+  unsigned int duration = 250;
+
+  EasingCurve curve = kEasingOutCubic;
+
+  int loop_count = 1;
+
+  bool started = false;
+
+  uint64_t start_time = 0;
+
+  float progress = 0.f;
+
+};
+
+core::Deque<Animation::Private> Animation::FrameClock::kRunning;
+
+core::Deque<Animation::Private> Animation::FrameClock::kStepped;
+
+Animation::FrameClock *Animation::FrameClock::kInstance = nullptr;
+
+Animation::FrameClock::FrameClock() {
+  _ASSERT(nullptr == kInstance);
+  kInstance = this;
+  frame_callback_.done().Set(this, &FrameClock::OnFrame);
+}
+
+Animation::FrameClock::~FrameClock() {
+  kInstance = nullptr;
+}
+
+void Animation::FrameClock::Add(Private *p) {
+  kRunning.PushBack(p);
+}
+
+void Animation::FrameClock::Schedule() {
+  if (kRunning.IsEmpty()) {
+    frame_pending_ = false;
+    if (timer_) timer_->Stop();
+    return;
+  }
+
+  if (frame_pending_) return;
+
+  Surface *surface = nullptr;
+  for (auto it = kRunning.begin(); it != kRunning.end(); ++it) {
+    surface = GetSurfaceOf(it.element()->view);
+    if (nullptr != surface) break;
+  }
+
+  int refresh_rate = GetRefreshRateHint();
+
+  if (nullptr != surface) {
+    // The frame request takes effect in the next commit of the surface, which
+    // is made when the window redraws the views updated in the last tick
+    frame_callback_.Setup(*surface);
+    frame_pending_ = true;
+
+    // The frame never comes if nothing is committed, or if the surface is
+    // hidden or destroyed, the timer keeps the animations running then
+    if (refresh_rate > 0) StartTimer(refresh_rate, 2);
+    return;
+  }
+
+  if (refresh_rate <= 0) return;
+  StartTimer(refresh_rate, 1);
+}
+
+void Animation::FrameClock::Tick(uint64_t time) {
+  core::Deque<Private>::Iterator it = kRunning.begin();
+  Private *p = nullptr;
+
+  // Move each animation to another deque before stepping it, so signal handlers
+  // can safely start, stop or destroy any animation
+  while (it != kRunning.end()) {
+    p = it.element();
+    kStepped.PushBack(p);
+    p->owner->Step(time);
+    it = kRunning.begin();
+  }
+
+  it = kStepped.begin();
+  while (it != kStepped.end()) {
+    kRunning.PushBack(it.element());
+    it = kStepped.begin();
+  }
+}
+
+int Animation::FrameClock::GetRunningCount() {
+  return static_cast<int>(kRunning.GetSize() + kStepped.GetSize());
+}
+
+void Animation::FrameClock::OnFrame(uint32_t /* serial */) {
+  frame_pending_ = false;
+  Tick(Timer::GetClockTime());
+  Schedule();
+}
+
+void Animation::FrameClock::OnTimeout(core::SLOT) {
+  // The requested frame is late, drop it and request a new one in Schedule()
+  frame_pending_ = false;
+  Tick(Timer::GetClockTime());
+  Schedule();
+}
+
+void Animation::FrameClock::StartTimer(int refresh_rate, int frames) {
+  if (!timer_) {
+    timer_.reset(new Timer);
+    timer_->timeout().Connect(this, &FrameClock::OnTimeout);
+  }
+
+  // Refresh rate is in mHz and the timer interval is in microseconds
+  timer_->Stop();
+  timer_->SetInterval(static_cast<unsigned int>(1000000000LL * frames / refresh_rate));
+  timer_->Start();
+}
+
+// ------
+
+Animation::Animation(AbstractView *view) {
+  p_ = core::MakeUnique<Private>(this);
+  SetTarget(view);
+}
+
+Animation::~Animation() {
+  Stop();
+}
+
+void Animation::Start() {
+  p_->started = false;
+  p_->progress = 0.f;
+
+  FrameClock::Add(p_.get());
+
+  // Without an application the animations are only stepped by Tick()
+  if (nullptr != FrameClock::kInstance) FrameClock::kInstance->Schedule();
+}
+
+void Animation::Stop() {
+  if (p_->IsLinked()) p_->Unlink();
+}
+
+bool Animation::IsRunning() const {
+  return p_->IsLinked();
+}
+
+void Animation::SetDuration(unsigned int duration) {
+  p_->duration = duration;
+}
+
+unsigned int Animation::GetDuration() const {
+  return p_->duration;
+}
+
+void Animation::SetEasingCurve(EasingCurve curve) {
+  p_->curve = curve;
+}
+
+EasingCurve Animation::GetEasingCurve() const {
+  return p_->curve;
+}
+
+void Animation::SetLoopCount(int count) {
+  p_->loop_count = count;
+}
+
+int Animation::GetLoopCount() const {
+  return p_->loop_count;
+}
+
+void Animation::SetTarget(AbstractView *view) {
+  if (p_->view == view) return;
+
+  if (nullptr != p_->view) p_->view->destroyed().DisconnectAll(this, &Animation::OnViewDestroyed);
+
+  p_->view = view;
+  if (nullptr != p_->view) p_->view->destroyed().Connect(this, &Animation::OnViewDestroyed);
+}
+
+AbstractView *Animation::GetTarget() const {
+  return p_->view;
+}
+
+float Animation::GetProgress() const {
+  return p_->progress;
+}
+
+float Animation::Ease(EasingCurve curve, float progress) {
+  float t = progress;
+
+  switch (curve) {
+    case kEasingInQuad: {
+      return t * t;
+    }
+    case kEasingOutQuad: {
+      return t * (2.f - t);
+    }
+    case kEasingInOutQuad: {
+      return t < 0.5f ? 2.f * t * t : -1.f + (4.f - 2.f * t) * t;
+    }
+    case kEasingInCubic: {
+      return t * t * t;
+    }
+    case kEasingOutCubic: {
+      t -= 1.f;
+      return t * t * t + 1.f;
+    }
+    case kEasingInOutCubic: {
+      if (t < 0.5f) return 4.f * t * t * t;
+      t = 2.f * t - 2.f;
+      return 0.5f * t * t * t + 1.f;
+    }
+    default: {
+      return t;
+    }
+  }
+}
+
+void Animation::Tick(uint64_t time) {
+  FrameClock::Tick(time);
+}
+
+int Animation::GetRunningCount() {
+  return FrameClock::GetRunningCount();
+}
+
+void Animation::UpdateTarget() {
+  if (nullptr != p_->view) p_->view->Update();
+}
+
+void Animation::Step(uint64_t time) {
+  if (!p_->started) {
+    p_->started = true;
+    p_->start_time = time;
+  }
+
+  uint64_t elapsed = time > p_->start_time ? time - p_->start_time : 0;
+  uint64_t duration = static_cast<uint64_t>(p_->duration) * 1000000;
+  bool finish = false;
+  float linear = 1.f;
+
+  if (0 == duration) {
+    finish = true;
+  } else {
+    uint64_t loop = elapsed / duration;
+    if (p_->loop_count >= 0 && loop >= static_cast<uint64_t>(p_->loop_count)) {
+      finish = true;
+    } else {
+      linear = static_cast<float>(elapsed % duration) / static_cast<float>(duration);
+    }
+  }
+
+  p_->progress = Ease(p_->curve, linear);
+  OnStep(p_->progress);
+
+  if (finish) {
+    Stop();
+    finished_.Emit();
+  }
+}
+
+void Animation::OnViewDestroyed(AbstractView * /* view */, core::SLOT) {
+  Stop();
+  p_->view = nullptr;
+}
+
+Surface *Animation::GetSurfaceOf(const AbstractView *view) {
+  if (nullptr == view) return nullptr;
+
+  AbstractShellView *shell_view = view->GetShellView();
+  if (nullptr == shell_view) return nullptr;
+
+  return shell_view->GetShellSurface();
+}
+
+int Animation::GetRefreshRateHint() {
+  // The display and outputs are only available with an application instance
+  if (nullptr == Application::kInstance) return 0;
+
+  int refresh_rate = 0;
+  const core::CompoundDeque &outputs = Display::GetOutputs();
+  if (outputs.count() > 0) {
+    refresh_rate = static_cast<const Output *>(outputs[0])->GetRefreshRate();
+  }
+
+  return refresh_rate > 0 ? refresh_rate : 60000;
+}
+
+// ------
+
+void GeometryAnimation::OnValueChanged() {
+  AbstractView *view = GetTarget();
+  if (nullptr == view) return;
+
+  const core::RectF &value = GetValue();
+  view->MoveTo(static_cast<int>(value.left), static_cast<int>(value.top));
+  view->Resize(static_cast<int>(value.width()), static_cast<int>(value.height()));
+}
+
+} // namespace gui
+} // namespace skland
@@ -21,15 +21,23 @@
 #include <signal.h>
 #include <sys/epoll.h>
 
+#include <cstdlib>
 #include <iostream>
 
 #include "skland/core/defines.hpp"
+#include "skland/core/trace.hpp"
+#include "skland/core/memory-stats.hpp"
+
+#include "skland/graphic/font-cache.hpp"
+#include "skland/graphic/image-cache.hpp"
 
 #include <skland/gui/theme.hpp>
 
 #include <skland/gui/abstract-view.hpp>
 #include <skland/gui/surface.hpp>
+#include <skland/gui/view-slab.hpp>
 
+#include "internal/animation_frame-clock.hpp"
 #include "internal/display_private.hpp"
 
 using std::cerr;
@@ -61,12 +69,34 @@ class Application::EpollTask : public AbstractEpollTask {
  */
 struct Application::Private {
 
+  /**
+   * @brief Dispatch the queued signals when the signal queue fd is readable
+   */
+  class SignalQueueTask : public AbstractEpollTask {
+
+   public:
+
+    SignalQueueTask(core::SignalQueue *queue)
+        : AbstractEpollTask(), queue_(queue) {}
+
+    virtual ~SignalQueueTask() {}
+
+    virtual void Run(uint32_t events) override {
+      queue_->Dispatch();
+    }
+
+   private:
+
+    core::SignalQueue *queue_;
+
+  };
+
   Private() = delete;
   Private(const Private &) = delete;
   Private &operator=(const Private &) = delete;
 
   Private(Application *app)
-      : running(true), epoll_fd(-1), epoll_task(app), argc(0), argv(nullptr) {}
+      : running(true), epoll_fd(-1), epoll_task(app), signal_queue_task(&signal_queue), argc(0), argv(nullptr) {}
 
   ~Private() {}
 
@@ -75,6 +105,13 @@ struct Application::Private {
 
   EpollTask epoll_task;
 
+  /**
+   * @brief Signals emitted in other threads by queued connections
+   */
+  core::SignalQueue signal_queue;
+
+  SignalQueueTask signal_queue_task;
+
   int argc;
   char **argv;
 
@@ -82,6 +119,16 @@ struct Application::Private {
 
   core::Deque<Task> task_deque;
 
+  /**
+   * @brief Slabs for views and anchors, created only if SKLAND_VIEW_SLAB is set
+   */
+  std::unique_ptr<ViewSlab> view_slab;
+
+  /**
+   * @brief The frame clock of animations, destroyed before the display
+   */
+  std::unique_ptr<Animation::FrameClock> frame_clock;
+
   /**
 * @brief Create an epoll file descriptor
 * @return a nonnegative file descriptor or -1
@@ -196,11 +243,29 @@ Application::Application(int argc, char *argv[]) {
 
   kInstance = this;
 
+  if (nullptr != getenv("SKLAND_VIEW_SLAB"))
+    p_->view_slab.reset(new ViewSlab);
+
+#ifdef TRACE
+  // Trace the whole run, the JSON file is written in the destructor. Use
+  // SKLAND_TRACE_FILE to change the file name.
+  const char *trace_file = getenv("SKLAND_TRACE_FILE");
+  if (!core::Tracer::Start(nullptr == trace_file ? std::string() : std::string(trace_file)))
+    cerr << "Cannot start tracing" << endl;
+#endif
+
   // Set log handler to a lambda function
   wl_log_set_handler_client([](const char *format, va_list args) {
     vfprintf(stderr, format, args);
   });
 
+  // Caches which track their own usage are queried on demand
+  core::MemoryStats::SetProbe(core::MemoryStats::kGlyphCache, graphic::FontCache::GetGlyphCacheUsage);
+  core::MemoryStats::SetProbe(core::MemoryStats::kImageCache, graphic::ImageCache::GetMemoryUsage);
+
+  // Resolve theme fonts while connecting to the display
+  Theme::Preload();
+
   Display::kDisplay = new Display;
 
   try {
@@ -215,9 +280,20 @@ Application::Application(int argc, char *argv[]) {
 
   p_->epoll_fd = Private::CreateEpollFd();
   WatchFd(Display::kDisplay->p_->fd, EPOLLIN | EPOLLERR | EPOLLHUP, &p_->epoll_task);
+
+  p_->frame_clock.reset(new Animation::FrameClock);
+
+  // Queued signal connections made in the main thread are delivered here
+  core::SignalQueue::SetCurrent(&p_->signal_queue);
+  if (p_->signal_queue.GetFd() >= 0)
+    WatchFd(p_->signal_queue.GetFd(), EPOLLIN, &p_->signal_queue_task);
 }
 
 Application::~Application() {
+  // The frame callback and timer of animations need the display
+  p_->frame_clock.reset();
+
+  core::SignalQueue::SetCurrent(nullptr);
   close(p_->epoll_fd);
   Display::kDisplay->Disconnect();
 
@@ -225,6 +301,13 @@ Application::~Application() {
   delete Display::kDisplay;
   Display::kDisplay = nullptr;
 
+  // Views still alive release their blocks when destroyed
+  p_->view_slab.reset();
+
+#ifdef TRACE
+  core::Tracer::Stop();
+#endif
+
   kInstance = nullptr;
 }
 
@@ -248,6 +331,7 @@ int Application::Run() {
     /*
      * Run idle tasks (process geometries)
      */
+    SKLAND_TRACE_BEGIN("Idle tasks");
     defferred_task_it = kInstance->p_->task_deque.begin();
     while (defferred_task_it != kInstance->p_->task_deque.end()) {
       task = defferred_task_it.element();
@@ -255,10 +339,12 @@ int Application::Run() {
       task->Run();
       defferred_task_it = kInstance->p_->task_deque.begin();
     }
+    SKLAND_TRACE_END("Idle tasks");
 
     /*
      * Draw contents on every surface requested
      */
+    SKLAND_TRACE_BEGIN("Render surfaces");
     draw_task_it = Surface::kRenderTaskDeque.begin();
     while (draw_task_it != Surface::kRenderTaskDeque.end()) {
       task = draw_task_it.element();
@@ -266,10 +352,12 @@ int Application::Run() {
       task->Run();
       draw_task_it = Surface::kRenderTaskDeque.begin();
     }
+    SKLAND_TRACE_END("Render surfaces");
 
     /*
      * Commit every surface requested
      */
+    SKLAND_TRACE_BEGIN("Commit surfaces");
     commit_task_it = Surface::kCommitTaskDeque.begin();
     while (commit_task_it != Surface::kCommitTaskDeque.end()) {
       task = commit_task_it.element();
@@ -277,6 +365,7 @@ int Application::Run() {
       task->Run();
       commit_task_it = Surface::kCommitTaskDeque.begin();
     }
+    SKLAND_TRACE_END("Commit surfaces");
 
     wl_display_dispatch_pending(Display::kDisplay->p_->wl_display);
 
@@ -295,10 +384,12 @@ int Application::Run() {
 
     AbstractEpollTask *epoll_task = nullptr;
     count = epoll_wait(kInstance->p_->epoll_fd, ep, Private::kMaxEpollEvents, -1);
+    SKLAND_TRACE_BEGIN("Dispatch events");
     for (int i = 0; i < count; i++) {
       epoll_task = static_cast<AbstractEpollTask *>(ep[i].data.ptr);
       if (epoll_task) epoll_task->Run(ep[i].events);
     }
+    SKLAND_TRACE_END("Dispatch events");
   }
 
   return 0;
@@ -337,5 +428,9 @@ core::Deque<Task> &Application::GetTaskDeque() {
   return kInstance->p_->task_deque;
 }
 
+core::SignalQueue *Application::GetSignalQueue() {
+  return &kInstance->p_->signal_queue;
+}
+
 } // namespace gui
 } // namespace skland
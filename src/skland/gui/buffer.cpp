@@ -17,6 +17,7 @@
 #include "internal/buffer_private.hpp"
 
 #include "skland/core/memory.hpp"
+#include "skland/core/memory-stats.hpp"
 #include "skland/gui/shared-memory-pool.hpp"
 
 namespace skland {
@@ -59,10 +60,16 @@ void Buffer::Setup(const SharedMemoryPool &pool,
   p_->format = format;
   p_->offset = offset;
   p_->data = (char *) pool.data() + offset;
+  p_->owner = pool.owner();
+
+  core::MemoryStats::Add(core::MemoryStats::kBuffer, (size_t) size, p_->owner);
 }
 
 void Buffer::Destroy() {
   if (nullptr != p_->wl_buffer) {
+    core::MemoryStats::Remove(core::MemoryStats::kBuffer, (size_t) (p_->stride * p_->size.height), p_->owner);
+    p_->owner = nullptr;
+
     p_->data = nullptr;
     p_->offset = 0;
     p_->format = 0;
@@ -0,0 +1,272 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "skland/gui/chrome-path-cache.hpp"
+
+#include "skland/gui/theme.hpp"
+
+#include "skland/graphic/canvas.hpp"
+
+#include "SkCanvas.h"
+#include "SkImage.h"
+
+#include <cmath>
+
+namespace skland {
+namespace gui {
+
+using core::RectF;
+using graphic::Canvas;
+using graphic::ClipOperation;
+using graphic::Paint;
+using graphic::Path;
+
+const float ChromePathCache::kWindowRadii[8] = {
+    7.f, 7.f, // top-left
+    7.f, 7.f, // top-right
+    4.f, 4.f, // bottom-right
+    4.f, 4.f  // bottom-left
+};
+
+const Path &ChromePathCache::Get(Shape shape, int width, int height, int scale, bool maximized) {
+  _ASSERT(shape >= 0 && shape < kShapeCount);
+
+  Entry *entry = &entries_[shape];
+  if (entry->valid &&
+      entry->width == width &&
+      entry->height == height &&
+      entry->scale == scale &&
+      entry->maximized == maximized) {
+    return entry->path;
+  }
+
+  entry->valid = true;
+  entry->width = width;
+  entry->height = height;
+  entry->scale = scale;
+  entry->maximized = maximized;
+  Build(shape, entry);
+  build_count_++;
+
+  return entry->path;
+}
+
+void ChromePathCache::DrawInner(Canvas *canvas, const core::ColorF &color,
+                                int width, int height, int scale, bool maximized) {
+  const Path &path = Get(kShapeWindowInner, width, height, scale, maximized);
+
+  paint_.Reset();
+  paint_.SetAntiAlias(true);
+  paint_.SetColor(color);
+
+  Canvas::LockGuard guard(canvas, path, ClipOperation::kClipIntersect, true);
+  canvas->DrawPath(path, paint_);
+}
+
+void ChromePathCache::DrawOutline(Canvas *canvas, const core::ColorF &color,
+                                  int width, int height, int scale) {
+  const Path &path = Get(kShapeWindowOutline, width, height, scale, false);
+
+  paint_.Reset();
+  paint_.SetAntiAlias(true);
+  paint_.SetColor(color);
+  paint_.SetStyle(Paint::Style::kStyleStroke);
+  paint_.SetStrokeWidth(.2f);
+
+  // FIXME: this function draws a white circle at bottom corners.
+  canvas->DrawPath(path, paint_);
+}
+
+void ChromePathCache::DrawShadow(Canvas *canvas, int width, int height, int scale, bool focused) {
+  SkImage *image = Theme::GetShadowImage();
+  if (nullptr == image) return;
+
+  Shadow *shadow = &shadow_;
+  if (!(shadow->valid &&
+      shadow->width == width &&
+      shadow->height == height &&
+      shadow->radius == Theme::GetShadowRadius() &&
+      shadow->focused == focused)) {
+    shadow->valid = true;
+    shadow->width = width;
+    shadow->height = height;
+    shadow->radius = Theme::GetShadowRadius();
+    shadow->focused = focused;
+    BuildShadow(shadow);
+  }
+
+  SkCanvas *c = canvas->GetSkCanvas();
+  c->save();
+  c->scale(scale, scale);
+  for (int i = 0; i < 8; i++) {
+    const RectF &src = shadow->src[i];
+    const RectF &dst = shadow->dst[i];
+    c->drawImageRect(image,
+                     SkRect::MakeLTRB(src.l, src.t, src.r, src.b),
+                     SkRect::MakeLTRB(dst.l, dst.t, dst.r, dst.b),
+                     nullptr);
+  }
+  c->restore();
+}
+
+/**
+ * @brief Add the triangle of the fullscreen glyph rotated around the origin
+ */
+static void AddArrow(Path *path, float degrees) {
+  const float points[3][2] = {{-5.f, 0.f}, {-1.5f, -3.5f}, {-1.5f, 3.5f}};
+  const float radians = degrees * static_cast<float>(M_PI) / 180.f;
+  const float cos = std::cos(radians);
+  const float sin = std::sin(radians);
+
+  for (int i = 0; i < 3; i++) {
+    float x = points[i][0] * cos - points[i][1] * sin;
+    float y = points[i][0] * sin + points[i][1] * cos;
+    if (0 == i) path->MoveTo(x, y);
+    else path->LineTo(x, y);
+  }
+  path->Close();
+}
+
+const Path &ChromePathCache::GetGlyph(Glyph glyph) {
+  _ASSERT(glyph >= 0 && glyph < kGlyphCount);
+
+  static Path glyphs[kGlyphCount];
+
+  Path &path = glyphs[glyph];
+  if (!path.IsEmpty()) return path;
+
+  switch (glyph) {
+    case kGlyphClose: {
+      path.MoveTo(-3.f, -3.f);
+      path.LineTo(3.f, 3.f);
+      path.MoveTo(3.f, -3.f);
+      path.LineTo(-3.f, 3.f);
+      break;
+    }
+    case kGlyphMaximize: {
+      path.MoveTo(-4.f, 0.f);
+      path.LineTo(4.f, 0.f);
+      path.MoveTo(0.f, -4.f);
+      path.LineTo(0.f, 4.f);
+      break;
+    }
+    case kGlyphMinimize: {
+      path.MoveTo(-4.f, 0.f);
+      path.LineTo(4.f, 0.f);
+      break;
+    }
+    case kGlyphFullscreen: {
+      AddArrow(&path, -45.f);
+      AddArrow(&path, 135.f);
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+
+  return path;
+}
+
+void ChromePathCache::BuildShadow(Shadow *shadow) {
+  const float radius = shadow->radius;
+  float rad = radius - 1.f; // The spread radius
+  float offset_x = Theme::GetShadowOffsetX();
+  float offset_y = Theme::GetShadowOffsetY();
+
+  if (!shadow->focused) {
+    rad = (int) rad / 3;
+    offset_x = (int) offset_x / 3;
+    offset_y = (int) offset_y / 3;
+  }
+
+  const float w = Theme::kShadowImageWidth;
+  const float h = Theme::kShadowImageHeight;
+  const float corner = 2 * radius;
+  const float width = shadow->width;
+  const float height = shadow->height;
+
+  // top-left
+  shadow->src[0] = RectF::MakeFromLTRB(0.f, 0.f, corner, corner);
+  shadow->dst[0] = RectF::MakeFromXYWH(-rad + offset_x, -rad + offset_y, 2 * rad, 2 * rad);
+
+  // top
+  shadow->src[1] = RectF::MakeFromLTRB(corner, 0.f, w - corner, corner);
+  shadow->dst[1] = RectF::MakeFromXYWH(rad + offset_x, -rad + offset_y, width - 2 * rad, 2 * rad);
+
+  // top-right
+  shadow->src[2] = RectF::MakeFromLTRB(w - corner, 0.f, w, corner);
+  shadow->dst[2] = RectF::MakeFromXYWH(width - rad + offset_x, -rad + offset_y, 2 * rad, 2 * rad);
+
+  // left
+  shadow->src[3] = RectF::MakeFromLTRB(0.f, corner, corner, h - corner);
+  shadow->dst[3] = RectF::MakeFromXYWH(-rad + offset_x, rad + offset_y, 2 * rad, height - 2 * rad);
+
+  // bottom-left
+  shadow->src[4] = RectF::MakeFromLTRB(0.f, h - corner, corner, h);
+  shadow->dst[4] = RectF::MakeFromXYWH(-rad + offset_x, height - rad + offset_y, 2 * rad, 2 * rad);
+
+  // bottom
+  shadow->src[5] = RectF::MakeFromLTRB(corner, h - corner, w - corner, h);
+  shadow->dst[5] = RectF::MakeFromXYWH(rad + offset_x, height - rad + offset_y, width - 2 * rad, 2 * rad);
+
+  // bottom-right
+  shadow->src[6] = RectF::MakeFromLTRB(w - corner, h - corner, w, h);
+  shadow->dst[6] = RectF::MakeFromXYWH(width - rad + offset_x, height - rad + offset_y, 2 * rad, 2 * rad);
+
+  // right
+  shadow->src[7] = RectF::MakeFromLTRB(w - corner, corner, w, h - corner);
+  shadow->dst[7] = RectF::MakeFromXYWH(width - rad + offset_x, rad + offset_y, 2 * rad, height - 2 * rad);
+}
+
+void ChromePathCache::Build(Shape shape, Entry *entry) {
+  float pixel_width = entry->width * entry->scale;
+  float pixel_height = entry->height * entry->scale;
+  float radii[8];
+  for (int i = 0; i < 8; i++) {
+    radii[i] = kWindowRadii[i] * entry->scale;
+  }
+
+  entry->path.Reset();
+
+  switch (shape) {
+    case kShapeWindowInner: {
+      RectF geometry = RectF::MakeFromXYWH(0.f, 0.f, pixel_width, pixel_height);
+      if (entry->maximized) {
+        entry->path.AddRect(geometry);
+      } else {
+        entry->path.AddRoundRect(geometry, radii);
+      }
+      break;
+    }
+    case kShapeWindowOutline: {
+      RectF geometry = RectF::MakeFromXYWH(0.5f, 0.5f, pixel_width - 1.f, pixel_height - 1.f);
+      if (entry->maximized) {
+        entry->path.AddRect(geometry);
+      } else {
+        entry->path.AddRoundRect(geometry, radii);
+      }
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+}
+
+} // namespace gui
+} // namespace skland
@@ -74,7 +74,7 @@ void Dialog::OnShown() {
   int height = GetHeight() + margin.tb();
   int32_t pool_size = width * 4 * height;
 
-  p_->pool.Setup(pool_size);
+  p_->pool.Setup(pool_size, this);
   p_->frame_buffer.Setup(p_->pool, width, height,
                          width * 4, WL_SHM_FORMAT_ARGB8888);
   shell_surface->Attach(&p_->frame_buffer);
@@ -107,7 +107,7 @@ void Dialog::OnSaveSize(const Size &old_size, const Size &new_size) {
   height += margin.tb();
 
   int pool_size = width * 4 * height;
-  p_->pool.Setup(pool_size);
+  p_->pool.Setup(pool_size, this);
 
   p_->frame_buffer.Setup(p_->pool, width, height, width * 4, WL_SHM_FORMAT_ARGB8888);
   shell_surface->Attach(&p_->frame_buffer);
@@ -70,7 +70,7 @@ struct GLWindow::Private : public core::Property<GLWindow> {
 
   Buffer frame_buffer;
 
-  AbstractRenderingAPI *rendering_api = nullptr;
+  GLESV2API *rendering_api = nullptr;
 
   Surface *gl_surface = nullptr;
 
@@ -205,7 +205,7 @@ void GLWindow::OnShown() {
   int height = GetHeight() + margin.tb();  // buffer height with vertical margins
   int32_t pool_size = width * 4 * height;
 
-  p_->pool.Setup(pool_size);
+  p_->pool.Setup(pool_size, this);
   p_->frame_buffer.Setup(p_->pool, width, height,
                          width * 4, WL_SHM_FORMAT_ARGB8888);
   shell_surface->Attach(&p_->frame_buffer);
@@ -263,7 +263,7 @@ void GLWindow::OnSaveSize(const Size &old_size, const Size &new_size) {
   height += margin.tb();
 
   int pool_size = width * 4 * height;
-  p_->pool.Setup(pool_size);
+  p_->pool.Setup(pool_size, this);
 
   p_->frame_buffer.Setup(p_->pool, width, height, width * 4, WL_SHM_FORMAT_ARGB8888);
   shell_surface->Attach(&p_->frame_buffer);
@@ -393,11 +393,18 @@ void GLWindow::OnResize(int /*width*/, int /*height*/) {
 }
 
 void GLWindow::OnRender() {
-  p_->rendering_api->MakeCurrent();
-
-  glClearColor(0.f, 0.f, 0.f, 1.f);
-  glClear(GL_COLOR_BUFFER_BIT);
-  glFlush();
+  // Draw with the Skia GL backend if it's available, GetCanvas() makes the
+  // EGL surface current
+  Canvas *canvas = p_->rendering_api->GetCanvas();
+  if (nullptr != canvas) {
+    canvas->Clear(0xFF000000);
+    canvas->Flush();
+  } else {
+    p_->rendering_api->MakeCurrent();
+    glClearColor(0.f, 0.f, 0.f, 1.f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glFlush();
+  }
 
   p_->rendering_api->SwapBuffers();
 }
@@ -411,5 +418,9 @@ void GLWindow::SwapBuffers() {
   p_->rendering_api->SwapBuffers();
 }
 
+Canvas *GLWindow::GetCanvas() {
+  return p_->rendering_api->GetCanvas();
+}
+
 } // namespace gui
 } // namespace skland
@@ -19,6 +19,8 @@
 #include "skland/core/defines.hpp"
 #include "skland/core/memory.hpp"
 
+#include "skland/graphic/canvas.hpp"
+
 #include "internal/abstract-rendering-api_proxy.hpp"
 #include "internal/display_proxy.hpp"
 
@@ -41,6 +43,12 @@ struct GLESV2API::Private {
 
   struct wl_egl_window *wl_egl_window = nullptr;
 
+  int width = 400;
+
+  int height = 300;
+
+  std::unique_ptr<graphic::Canvas> canvas;
+
 };
 
 GLESV2API::GLESV2API() {
@@ -53,6 +61,12 @@ GLESV2API::~GLESV2API() {
 
 void GLESV2API::SetViewportSize(int width, int height) {
   wl_egl_window_resize(p_->wl_egl_window, width, height, 0, 0);
+
+  if (p_->width != width || p_->height != height) {
+    p_->width = width;
+    p_->height = height;
+    p_->canvas.reset();
+  }
 }
 
 void GLESV2API::MakeCurrent() {
@@ -66,10 +80,29 @@ void GLESV2API::SwapBuffers() {
   eglSwapBuffers(Display::Proxy::egl_display(), p_->egl_surface);
 }
 
+graphic::Canvas *GLESV2API::GetCanvas() {
+  if (nullptr == p_->egl_surface) return nullptr;
+
+  MakeCurrent();
+
+  if (!p_->canvas) {
+    graphic::GPUContext *context = Display::Proxy::gpu_context();
+    if (nullptr == context) return nullptr;
+
+    EGLint samples = 0, stencil_bits = 0;
+    eglGetConfigAttrib(Display::Proxy::egl_display(), Display::Proxy::egl_config(), EGL_SAMPLES, &samples);
+    eglGetConfigAttrib(Display::Proxy::egl_display(), Display::Proxy::egl_config(), EGL_STENCIL_SIZE, &stencil_bits);
+
+    p_->canvas.reset(graphic::Canvas::CreateGPUFramebuffer(context, p_->width, p_->height, 0, samples, stencil_bits));
+  }
+
+  return p_->canvas.get();
+}
+
 void GLESV2API::OnSetup(Surface *surface) {
   Destroy();
 
-  p_->wl_egl_window = wl_egl_window_create(Proxy::GetWaylandSurface(surface), 400, 300);
+  p_->wl_egl_window = wl_egl_window_create(Proxy::GetWaylandSurface(surface), p_->width, p_->height);
   p_->egl_surface = eglCreatePlatformWindowSurface(Display::Proxy::egl_display(),
                                                    Display::Proxy::egl_config(),
                                                    p_->wl_egl_window,
@@ -81,6 +114,8 @@ void GLESV2API::OnRelease(Surface *surface) {
 }
 
 void GLESV2API::Destroy() {
+  p_->canvas.reset();
+
   if (nullptr != p_->egl_surface) {
     _ASSERT(nullptr != p_->wl_egl_window);
     eglDestroySurface(Display::Proxy::egl_display(), p_->egl_surface);
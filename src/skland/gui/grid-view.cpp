@@ -0,0 +1,80 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "skland/gui/grid-view.hpp"
+
+namespace skland {
+namespace gui {
+
+using core::RectF;
+
+GridView::GridView()
+    : GridView(400, 300) {
+}
+
+GridView::GridView(int width, int height)
+    : ListView(width, height),
+      cell_width_(96) {
+  SetItemHeight(96);
+}
+
+GridView::~GridView() {
+
+}
+
+void GridView::SetCellSize(int width, int height) {
+  if (width < 1 || height < 1) return;
+  if (width == cell_width_ && height == GetItemHeight()) return;
+
+  cell_width_ = width;
+
+  if (height != GetItemHeight()) {
+    SetItemHeight(height);
+    return;
+  }
+
+  Realize();
+  Update();
+}
+
+int GridView::GetColumnCount() const {
+  int columns = GetWidth() / cell_width_;
+  return columns > 0 ? columns : 1;
+}
+
+RectF GridView::GetItemGeometry(int index) const {
+  int columns = GetColumnCount();
+  int row = index / columns;
+  int column = index % columns;
+
+  return RectF::MakeFromXYWH(GetX() + column * cell_width_,
+                             GetY() + row * GetItemHeight() - GetScrollOffset(),
+                             cell_width_,
+                             GetItemHeight());
+}
+
+int GridView::GetIndexAt(int x, int y) const {
+  int row = (y - GetY() + GetScrollOffset()) / GetItemHeight();
+  int columns = GetColumnCount();
+  int column = (x - GetX()) / cell_width_;
+  if (column < 0 || column >= columns) return -1;
+
+  return row * columns + column;
+}
+
+} // namespace gui
+} // namespace skland
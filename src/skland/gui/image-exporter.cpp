@@ -0,0 +1,168 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <skland/gui/image-exporter.hpp>
+
+#include <skland/gui/abstract-epoll-task.hpp>
+#include <skland/gui/application.hpp>
+
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <thread>
+
+#include "skland/core/defines.hpp"
+
+namespace skland {
+namespace gui {
+
+class ImageExporter::EpollTask : public AbstractEpollTask {
+
+ public:
+
+  EpollTask(ImageExporter *exporter)
+      : AbstractEpollTask(), exporter_(exporter) {}
+
+  virtual ~EpollTask() {}
+
+  virtual void Run(uint32_t events) override;
+
+ private:
+
+  ImageExporter *exporter_;
+
+};
+
+/**
+ * @ingroup gui_intern
+ * @brief The private structure used in ImageExporter
+ */
+struct ImageExporter::Private {
+
+  Private() = delete;
+  Private(const Private &) = delete;
+  Private &operator=(const Private &) = delete;
+
+  Private(ImageExporter *exporter)
+      : fd(-1), is_running(false), success(false), quality(90), epoll_task(exporter) {}
+
+  ~Private() {}
+
+  /**
+   * @brief Wait for the worker thread and stop watching the event fd
+   */
+  void Join();
+
+  /** An eventfd the worker thread writes to when the file is done */
+  int fd;
+
+  bool is_running;
+
+  /** Written by the worker thread before it signals the event fd */
+  bool success;
+
+  int quality;
+
+  std::string filename;
+
+  std::unique_ptr<graphic::ImageWriter> writer;
+
+  std::thread worker;
+
+  EpollTask epoll_task;
+
+};
+
+void ImageExporter::Private::Join() {
+  if (worker.joinable()) worker.join();
+
+  Application::UnwatchFd(fd);
+  writer.reset();
+  is_running = false;
+}
+
+void ImageExporter::EpollTask::Run(uint32_t events) {
+  uint64_t value;
+  ssize_t s;
+
+  s = read(exporter_->p_->fd, &value, sizeof(uint64_t));
+  if (s != sizeof(uint64_t)) {
+    _DEBUG("%s\n", "Fail to read event fd!\n");
+    return;
+  }
+
+  exporter_->p_->Join();
+  exporter_->finished_.Emit(exporter_->p_->success);
+}
+
+ImageExporter::ImageExporter() {
+  p_.reset(new Private(this));
+
+  p_->fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (p_->fd < 0) {
+    fprintf(stderr, "Error! Fail to create eventfd!\n");
+  }
+}
+
+ImageExporter::~ImageExporter() {
+  if (p_->is_running) p_->Join();
+  if (p_->fd >= 0) close(p_->fd);
+}
+
+bool ImageExporter::Start(const graphic::Bitmap &bitmap, const std::string &filename, Format format) {
+  if (p_->is_running || p_->fd < 0) return false;
+
+  p_->writer.reset(new graphic::ImageWriter(bitmap));
+  p_->writer->SetQuality(p_->quality);
+  p_->filename = filename;
+  p_->success = false;
+  p_->is_running = true;
+
+  Application::WatchFd(p_->fd, EPOLLIN, &p_->epoll_task);
+
+  Private *p = p_.get();
+  p_->worker = std::thread([p, format]() {
+    p->success = p->writer->Write(p->filename, format);
+
+    uint64_t value = 1;
+    if (write(p->fd, &value, sizeof(uint64_t)) != sizeof(uint64_t)) {
+      _DEBUG("%s\n", "Fail to write event fd!\n");
+    }
+  });
+
+  return true;
+}
+
+bool ImageExporter::IsRunning() const {
+  return p_->is_running;
+}
+
+void ImageExporter::SetQuality(int quality) {
+  p_->quality = quality;
+}
+
+int ImageExporter::GetQuality() const {
+  return p_->quality;
+}
+
+const std::string &ImageExporter::GetFileName() const {
+  return p_->filename;
+}
+
+} // namespace gui
+} // namespace skland
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <skland/gui/image-loader.hpp>
+
+#include <skland/gui/abstract-epoll-task.hpp>
+#include <skland/gui/application.hpp>
+
+#include <skland/graphic/bitmap.hpp>
+
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <deque>
+#include <mutex>
+#include <utility>
+
+#include "skland/core/defines.hpp"
+
+namespace skland {
+namespace gui {
+
+class ImageLoader::EpollTask : public AbstractEpollTask {
+
+ public:
+
+  EpollTask(ImageLoader *loader)
+      : AbstractEpollTask(), loader_(loader) {}
+
+  virtual ~EpollTask() {}
+
+  virtual void Run(uint32_t events) override;
+
+ private:
+
+  ImageLoader *loader_;
+
+};
+
+/**
+ * @ingroup gui_intern
+ * @brief The private structure used in ImageLoader
+ */
+struct ImageLoader::Private {
+
+  /**
+   * @brief Loaded images waiting to be delivered
+   *
+   * Shared with the callbacks running in worker threads, so it lives until the
+   * last request finished even if the loader is destroyed.
+   */
+  struct Queue {
+
+    Queue()
+        : fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {}
+
+    ~Queue() {
+      if (fd >= 0) close(fd);
+    }
+
+    void Push(const std::string &path, const graphic::Bitmap &bitmap) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        results.push_back(std::make_pair(path, bitmap));
+      }
+
+      uint64_t value = 1;
+      if (write(fd, &value, sizeof(uint64_t)) != sizeof(uint64_t)) {
+        _DEBUG("%s\n", "Fail to write event fd!\n");
+      }
+    }
+
+    int fd;
+
+    std::mutex mutex;
+
+    std::deque<std::pair<std::string, graphic::Bitmap>> results;
+
+  };
+
+  Private() = delete;
+  Private(const Private &) = delete;
+  Private &operator=(const Private &) = delete;
+
+  Private(ImageLoader *loader)
+      : queue(std::make_shared<Queue>()), pending_count(0), is_watching(false), epoll_task(loader) {}
+
+  ~Private() {}
+
+  std::shared_ptr<Queue> queue;
+
+  size_t pending_count;
+
+  bool is_watching;
+
+  EpollTask epoll_task;
+
+};
+
+void ImageLoader::EpollTask::Run(uint32_t events) {
+  Private *p = loader_->p_.get();
+  uint64_t value;
+
+  if (read(p->queue->fd, &value, sizeof(uint64_t)) != sizeof(uint64_t)) {
+    _DEBUG("%s\n", "Fail to read event fd!\n");
+    return;
+  }
+
+  std::deque<std::pair<std::string, graphic::Bitmap>> results;
+  {
+    std::lock_guard<std::mutex> lock(p->queue->mutex);
+    results.swap(p->queue->results);
+  }
+
+  p->pending_count -= results.size();
+  if (0 == p->pending_count) {
+    Application::UnwatchFd(p->queue->fd);
+    p->is_watching = false;
+  }
+
+  for (auto &result: results) {
+    loader_->loaded_.Emit(result.first, result.second);
+  }
+}
+
+ImageLoader::ImageLoader() {
+  p_.reset(new Private(this));
+
+  if (p_->queue->fd < 0) {
+    fprintf(stderr, "Error! Fail to create eventfd!\n");
+  }
+}
+
+ImageLoader::~ImageLoader() {
+  if (p_->is_watching) Application::UnwatchFd(p_->queue->fd);
+}
+
+void ImageLoader::Load(const std::string &path, const core::SizeI &target_size) {
+  if (p_->queue->fd < 0) return;
+
+  if (!p_->is_watching) {
+    Application::WatchFd(p_->queue->fd, EPOLLIN, &p_->epoll_task);
+    p_->is_watching = true;
+  }
+  p_->pending_count++;
+
+  std::shared_ptr<Private::Queue> queue = p_->queue;
+  graphic::Bitmap::LoadAsync(path, target_size, [queue, path](const graphic::Bitmap &bitmap) {
+    queue->Push(path, bitmap);
+  });
+}
+
+size_t ImageLoader::GetPendingCount() const {
+  return p_->pending_count;
+}
+
+} // namespace gui
+} // namespace skland
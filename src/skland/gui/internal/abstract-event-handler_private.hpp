@@ -20,6 +20,7 @@
 #include "skland/gui/abstract-event-handler.hpp"
 
 #include "skland/core/property.hpp"
+#include "skland/core/slab-allocator.hpp"
 
 namespace skland {
 namespace gui {
@@ -28,7 +29,8 @@ namespace gui {
  * @ingroup gui_intern
  * @brief The structure for the private data in AbstractEventHandler
  */
-struct AbstractEventHandler::Private : public core::Property<AbstractEventHandler> {
+struct AbstractEventHandler::Private : public core::Property<AbstractEventHandler>,
+                                      public core::SlabObject<AbstractEventHandler::Private> {
 
   SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
 
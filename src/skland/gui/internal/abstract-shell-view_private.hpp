@@ -20,6 +20,9 @@
 #include "skland/gui/abstract-shell-view.hpp"
 
 #include "skland/core/property.hpp"
+#include "skland/gui/view-geometry-store.hpp"
+#include "skland/gui/chrome-path-cache.hpp"
+
 #include "xdg-shell-unstable-v6-client-protocol.h"
 
 namespace skland {
@@ -108,6 +111,16 @@ struct AbstractShellView::Private : public core::Property<AbstractShellView> {
    */
   bool is_damaged;
 
+  /**
+   * @brief Flattened geometry of all attached view trees
+   */
+  ViewGeometryStore geometry_store;
+
+  /**
+   * @brief Paths and shadow of the window frame reused until the size, scale or state changes
+   */
+  ChromePathCache chrome_paths;
+
   void OnXdgSurfaceConfigure(uint32_t serial);
 
   void OnXdgToplevelConfigure(int width, int height, int states);
@@ -19,9 +19,12 @@
 
 #include "skland/gui/abstract-view.hpp"
 
+#include "skland/core/list-index.hpp"
 #include "skland/core/padding.hpp"
+#include "skland/core/slab-allocator.hpp"
 #include "skland/gui/anchor.hpp"
 #include "skland/gui/anchor-group.hpp"
+#include "skland/gui/view-geometry-store.hpp"
 
 namespace skland {
 namespace gui {
@@ -29,8 +32,11 @@ namespace gui {
 /**
  * @ingroup gui_intern
  * @brief A structure for private data in AbstractView
+ *
+ * Allocated from the slab of ViewSlab if there's one to reduce heap
+ * allocations when building and tearing down large view trees.
  */
-SKLAND_NO_EXPORT struct AbstractView::Private {
+SKLAND_NO_EXPORT struct AbstractView::Private : public core::SlabObject<AbstractView::Private> {
 
   SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
   Private() = delete;
@@ -42,8 +48,10 @@ SKLAND_NO_EXPORT struct AbstractView::Private {
         last_child(nullptr),
         parent(nullptr),
         children_count(0),
+        index(-1),
         shell_view(nullptr),
         visible(true),
+        opaque(false),
         minimal_size(0, 0),
         preferred_size(100, 100),
         maximal_size(65536, 65536),
@@ -55,7 +63,9 @@ SKLAND_NO_EXPORT struct AbstractView::Private {
         top_anchor_group(view, kAlignTop),
         right_anchor_group(view, kAlignRight),
         bottom_anchor_group(view, kAlignBottom),
-        layout(nullptr) {}
+        layout(nullptr),
+        geometry_store(nullptr),
+        geometry_index(-1) {}
 
   ~Private() = default;
 
@@ -68,10 +78,31 @@ SKLAND_NO_EXPORT struct AbstractView::Private {
   AbstractView *parent;
   int children_count;
 
+  /**
+   * @brief Access the sibling links and index hint for children_index
+   */
+  struct ChildIndexTraits {
+    static AbstractView *Next(AbstractView *view) { return view->p_->next; }
+    static AbstractView *Previous(AbstractView *view) { return view->p_->previous; }
+    static int &Index(AbstractView *view) { return view->p_->index; }
+  };
+
+  /**
+   * @brief The position hint used by children_index in parent
+   */
+  int index;
+
+  /**
+   * @brief Lazily built index table of children
+   */
+  core::ListIndex<AbstractView, ChildIndexTraits> children_index;
+
   AbstractShellView *shell_view;
 
   bool visible;
 
+  bool opaque;
+
   Size minimal_size;
 
   Size preferred_size;
@@ -99,6 +130,23 @@ SKLAND_NO_EXPORT struct AbstractView::Private {
 
   AbstractLayout *layout;
 
+  /**
+   * @brief The flattened store this view is in, set by ViewGeometryStore
+   */
+  ViewGeometryStore *geometry_store;
+
+  /**
+   * @brief The index in geometry_store
+   */
+  int geometry_index;
+
+  /**
+   * @brief Mark the geometry store out of date when the tree structure changes
+   */
+  void InvalidateGeometryStore() {
+    if (nullptr != geometry_store) geometry_store->Invalidate();
+  }
+
 };
 
 } // namespace gui
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SKLAND_GUI_INTERNAL_ANIMATION_FRAME_CLOCK_HPP_
+#define SKLAND_GUI_INTERNAL_ANIMATION_FRAME_CLOCK_HPP_
+
+#include "skland/gui/animation.hpp"
+#include "skland/gui/callback.hpp"
+#include "skland/gui/timer.hpp"
+
+#include "skland/core/deque.hpp"
+
+namespace skland {
+namespace gui {
+
+/**
+ * @ingroup gui_intern
+ * @brief The frame clock stepping all running animations
+ *
+ * The clock is created and destroyed with Application, as the frame callback
+ * and the timer must not outlive the display connection. The running deques
+ * need no display, animations can still be stepped with Animation::Tick()
+ * without an application.
+ */
+SKLAND_NO_EXPORT class Animation::FrameClock : public core::Trackable {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(FrameClock);
+
+  FrameClock();
+
+  virtual ~FrameClock();
+
+  /**
+   * @brief Request the next frame if there's running animation
+   */
+  void Schedule();
+
+  static void Add(Private *p);
+
+  static void Tick(uint64_t time);
+
+  static int GetRunningCount();
+
+  /**
+   * @brief The clock of the application instance, nullptr without an application
+   */
+  static FrameClock *kInstance;
+
+ private:
+
+  void OnFrame(uint32_t serial);
+
+  void OnTimeout(__SLOT__);
+
+  /**
+   * @brief Start the timer or restart it if it's armed
+   * @param refresh_rate Refresh rate in mHz
+   * @param frames Interval in frames
+   */
+  void StartTimer(int refresh_rate, int frames);
+
+  Callback frame_callback_;
+
+  /**
+   * @brief A frame callback was requested, the timer only watches it
+   */
+  bool frame_pending_ = false;
+
+  std::unique_ptr<Timer> timer_;
+
+  static core::Deque<Private> kRunning;
+
+  /**
+   * @brief Animations already stepped in the current tick
+   */
+  static core::Deque<Private> kStepped;
+
+};
+
+} // namespace gui
+} // namespace skland
+
+#endif // SKLAND_GUI_INTERNAL_ANIMATION_FRAME_CLOCK_HPP_
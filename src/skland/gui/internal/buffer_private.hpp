@@ -49,6 +49,11 @@ struct Buffer::Private {
 
   void *data = nullptr;
 
+  /**
+   * @brief The owner of the pool, used in memory accounting
+   */
+  const void *owner = nullptr;
+
   static void OnRelease(void *data, struct wl_buffer *buffer);
 
   static const struct wl_buffer_listener kListener;
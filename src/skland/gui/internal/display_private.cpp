@@ -136,7 +136,28 @@ void Display::Private::InitializeEGLDisplay() {
   }
 }
 
+graphic::GPUContext *Display::Private::GetGPUContext() {
+  if (!gpu_context && !gpu_context_failed && egl_context) {
+    gpu_context.reset(graphic::GPUContext::CreateGL([](void *, const char *name) {
+      return reinterpret_cast<graphic::GPUContext::GLProc>(eglGetProcAddress(name));
+    }));
+    if (!gpu_context) {
+      fprintf(stderr, "Skia GL backend is not available, use raster instead\n");
+      gpu_context_failed = true;
+    }
+  }
+
+  return gpu_context.get();
+}
+
 void Display::Private::ReleaseEGLDisplay() {
+  if (gpu_context) {
+    // The EGL context may not be current here
+    gpu_context->Abandon();
+    gpu_context.reset();
+  }
+  gpu_context_failed = false;
+
   if (egl_display) {
     eglMakeCurrent(egl_display, (::EGLSurface) 0, (::EGLSurface) 0, (::EGLContext) 0);
     eglTerminate(egl_display);
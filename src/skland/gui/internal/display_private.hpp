@@ -22,6 +22,8 @@
 #include "skland/gui/task.hpp"
 #include "skland/gui/abstract-epoll-task.hpp"
 
+#include "skland/graphic/gpu-context.hpp"
+
 #include "xdg-shell-unstable-v6-client-protocol.h"
 
 #include <EGL/egl.h>
@@ -65,6 +67,15 @@ struct Display::Private {
 
   void ReleaseEGLDisplay();
 
+  /**
+   * @brief Get the GPU context shared by all GL surfaces, created on first use
+   *
+   * Must be called with the EGL context current.
+   *
+   * @return The GPU context, or nullptr if the Skia GL backend is not available
+   */
+  graphic::GPUContext *GetGPUContext();
+
   void CreateVKInstance();
 
   void ReleaseVKInstance();
@@ -88,6 +99,9 @@ struct Display::Private {
   EGLint egl_version_major;  /**< The major version */
   EGLint egl_version_minor;  /**< The minor version */
 
+  std::unique_ptr<graphic::GPUContext> gpu_context;
+  bool gpu_context_failed = false;
+
   vk::Instance vk_instance;
 
   struct xkb_context *xkb_context;
@@ -122,6 +122,14 @@ SKLAND_NO_EXPORT struct Display::Proxy {
     return Display::kDisplay->p_->egl_context;
   }
 
+  /**
+   * @brief Get the GPU context shared by GL surfaces
+   * @return The GPU context, or nullptr if not available
+   */
+  static graphic::GPUContext *gpu_context() {
+    return Display::kDisplay->p_->GetGPUContext();
+  }
+
   /**
    * @brief Get the native C++ Vulkan instance
    * @return
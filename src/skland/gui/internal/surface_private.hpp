@@ -20,6 +20,8 @@
 #include "skland/gui/surface.hpp"
 #include "skland/gui/abstract-rendering-api.hpp"
 
+#include "skland/core/arena.hpp"
+
 namespace skland {
 namespace gui {
 
@@ -104,6 +106,11 @@ struct Surface::Private {
 
   core::Deque<AbstractView::RedrawNode> redraw_node_deque;
 
+  /**
+   * @brief Per-frame allocator, reset after commit
+   */
+  core::Arena frame_arena;
+
   static void OnEnter(void *data, struct wl_surface *wl_surface,
                       struct wl_output *wl_output);
 
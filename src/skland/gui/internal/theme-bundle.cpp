@@ -0,0 +1,436 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "theme-bundle.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace skland {
+namespace gui {
+
+using std::cerr;
+using std::endl;
+
+static const char kMagic[8] = {'S', 'K', 'T', 'H', 'E', 'M', 'E', '\0'};
+
+static const uint32_t kByteOrderMark = 0x01020304;
+
+/**
+ * @brief The shadow pixels are aligned for SIMD loads
+ */
+static const size_t kShadowAlignment = 16;
+
+struct ThemeBundle::Header {
+
+  char magic[8];
+
+  uint32_t byte_order;
+
+  uint32_t version;
+
+  uint32_t file_size;
+
+  int32_t shadow_radius;
+  int32_t shadow_offset_x;
+  int32_t shadow_offset_y;
+  int32_t shadow_width;
+  int32_t shadow_height;
+  uint32_t shadow_pixels_offset;
+
+  String name;
+
+  Attribute attributes[kSchemaCount][kStyleCount][kAttributeCount];
+
+  Font fonts[kFontCount];
+
+};
+
+const char *ThemeBundle::kSchemaNames[kSchemaCount] = {"window", "title_bar", "button"};
+const char *ThemeBundle::kStyleNames[kStyleCount] = {"active", "inactive", "highlight"};
+const char *ThemeBundle::kAttributeNames[kAttributeCount] = {"foreground", "background", "outline"};
+const char *ThemeBundle::kFontNames[kFontCount] = {"title_bar_font", "default_font"};
+
+namespace {
+
+/**
+ * @brief Append data to a buffer at the given alignment
+ * @return Offset of the data in buffer
+ */
+uint32_t Append(std::vector<char> *buffer, const void *data, size_t size, size_t alignment = 4) {
+  size_t offset = (buffer->size() + alignment - 1) & ~(alignment - 1);
+  buffer->resize(offset + size);
+  if (size > 0) memcpy(buffer->data() + offset, data, size);
+  return static_cast<uint32_t>(offset);
+}
+
+std::string Trim(const std::string &str) {
+  size_t begin = str.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos) return std::string();
+  size_t end = str.find_last_not_of(" \t\r\n");
+  return str.substr(begin, end - begin + 1);
+}
+
+bool ParseInt(const std::string &str, int *value) {
+  char *end = nullptr;
+  long result = strtol(str.c_str(), &end, 0);
+  if (end == str.c_str() || *end != '\0') return false;
+  *value = static_cast<int>(result);
+  return true;
+}
+
+bool ParseColor(const std::string &str, uint32_t *argb) {
+  char *end = nullptr;
+  unsigned long result = strtoul(str.c_str(), &end, 16);
+  if (end == str.c_str() || *end != '\0' || result > 0xFFFFFFFFul) return false;
+  *argb = static_cast<uint32_t>(result);
+  return true;
+}
+
+bool ParseFloat(const std::string &str, float *value) {
+  char *end = nullptr;
+  float result = strtof(str.c_str(), &end);
+  if (end == str.c_str() || *end != '\0') return false;
+  *value = result;
+  return true;
+}
+
+} // namespace
+
+ThemeBundle::ThemeBundle()
+    : data_(nullptr), size_(0) {
+}
+
+ThemeBundle::~ThemeBundle() {
+  Close();
+}
+
+bool ThemeBundle::Open(const char *filename) {
+  Close();
+
+  int fd = open(filename, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (fstat(fd, &st) < 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+    close(fd);
+    return false;
+  }
+
+  void *data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) return false;
+
+  data_ = static_cast<const char *>(data);
+  size_ = static_cast<size_t>(st.st_size);
+
+  if (!Validate()) {
+    cerr << "Error! Invalid theme bundle: " << filename << endl;
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+void ThemeBundle::Close() {
+  if (nullptr == data_) return;
+
+  munmap(const_cast<char *>(data_), size_);
+  data_ = nullptr;
+  size_ = 0;
+}
+
+void ThemeBundle::Apply(Theme::Data *data) const {
+  _ASSERT(data_);
+  const Header *h = header();
+
+  data->name.assign(data_ + h->name.offset, h->name.length);
+
+  for (int i = 0; i < kSchemaCount; i++) {
+    for (int j = 0; j < kStyleCount; j++) {
+      for (int k = 0; k < kAttributeCount; k++) {
+        const Attribute &record = h->attributes[i][j][k];
+        Theme::Schema::Style::Attribute *attribute = GetAttribute(data, i, j, k);
+
+        const float *colors = reinterpret_cast<const float *>(data_ + record.colors_offset);
+        attribute->colors.resize(record.color_count);
+        for (uint32_t n = 0; n < record.color_count; n++, colors += 4) {
+          attribute->colors[n] = core::ColorF(colors[0], colors[1], colors[2], colors[3]);
+        }
+
+        const float *positions = reinterpret_cast<const float *>(data_ + record.positions_offset);
+        attribute->color_positions.assign(positions, positions + record.position_count);
+      }
+    }
+  }
+
+  for (int i = 0; i < kFontCount; i++) {
+    const Font &record = h->fonts[i];
+    std::string family(data_ + record.family.offset, record.family.length);
+    *GetFont(data, i) = graphic::Font(family.c_str(),
+                                      graphic::FontStyle(record.weight,
+                                                         record.width,
+                                                         static_cast<graphic::FontStyle::Slant>(record.slant)),
+                                      record.size);
+  }
+}
+
+const uint32_t *ThemeBundle::GetShadowPixels() const {
+  return reinterpret_cast<const uint32_t *>(data_ + header()->shadow_pixels_offset);
+}
+
+int ThemeBundle::GetShadowRadius() const {
+  return header()->shadow_radius;
+}
+
+int ThemeBundle::GetShadowOffsetX() const {
+  return header()->shadow_offset_x;
+}
+
+int ThemeBundle::GetShadowOffsetY() const {
+  return header()->shadow_offset_y;
+}
+
+bool ThemeBundle::Write(const char *filename, const Content &content) {
+  if (content.shadow_pixels.size() != size_t(Theme::kShadowImageWidth * Theme::kShadowImageHeight))
+    return false;
+
+  std::vector<char> buffer(sizeof(Header), 0);
+  Header header;
+  memset(&header, 0, sizeof(Header));
+
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.byte_order = kByteOrderMark;
+  header.version = kVersion;
+  header.shadow_radius = content.shadow_radius;
+  header.shadow_offset_x = content.shadow_offset_x;
+  header.shadow_offset_y = content.shadow_offset_y;
+  header.shadow_width = Theme::kShadowImageWidth;
+  header.shadow_height = Theme::kShadowImageHeight;
+
+  header.name.offset = Append(&buffer, content.data.name.data(), content.data.name.size(), 1);
+  header.name.length = static_cast<uint32_t>(content.data.name.size());
+
+  for (int i = 0; i < kSchemaCount; i++) {
+    for (int j = 0; j < kStyleCount; j++) {
+      for (int k = 0; k < kAttributeCount; k++) {
+        const Theme::Schema::Style::Attribute *attribute = GetAttribute(&content.data, i, j, k);
+        Attribute &record = header.attributes[i][j][k];
+
+        std::vector<float> colors;
+        colors.reserve(attribute->colors.size() * 4);
+        for (const core::ColorF &color : attribute->colors) {
+          colors.push_back(color.r);
+          colors.push_back(color.g);
+          colors.push_back(color.b);
+          colors.push_back(color.a);
+        }
+
+        record.color_count = static_cast<uint32_t>(attribute->colors.size());
+        record.colors_offset = Append(&buffer, colors.data(), colors.size() * sizeof(float));
+        record.position_count = static_cast<uint32_t>(attribute->color_positions.size());
+        record.positions_offset = Append(&buffer,
+                                         attribute->color_positions.data(),
+                                         attribute->color_positions.size() * sizeof(float));
+      }
+    }
+  }
+
+  for (int i = 0; i < kFontCount; i++) {
+    const FontDescriptor &descriptor = content.fonts[i];
+    Font &record = header.fonts[i];
+    record.family.offset = Append(&buffer, descriptor.family.data(), descriptor.family.size(), 1);
+    record.family.length = static_cast<uint32_t>(descriptor.family.size());
+    record.weight = descriptor.weight;
+    record.width = descriptor.width;
+    record.slant = descriptor.slant;
+    record.size = descriptor.size;
+  }
+
+  header.shadow_pixels_offset = Append(&buffer,
+                                       content.shadow_pixels.data(),
+                                       content.shadow_pixels.size() * sizeof(uint32_t),
+                                       kShadowAlignment);
+
+  header.file_size = static_cast<uint32_t>(buffer.size());
+  memcpy(buffer.data(), &header, sizeof(Header));
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) return false;
+
+  file.write(buffer.data(), buffer.size());
+  return file.good();
+}
+
+bool ThemeBundle::ReadSource(const char *filename, std::vector<SourceEntry> *entries) {
+  std::ifstream file(filename);
+  if (!file.is_open()) return false;
+
+  std::string line;
+  int line_number = 0;
+  while (std::getline(file, line)) {
+    line_number++;
+    line = Trim(line);
+    if (line.empty() || line[0] == '#') continue;
+
+    size_t pos = line.find('=');
+    if (pos == std::string::npos) {
+      cerr << "Error! " << filename << ":" << line_number << ": expect \"key = value\"" << endl;
+      return false;
+    }
+
+    entries->push_back(SourceEntry(Trim(line.substr(0, pos)), Trim(line.substr(pos + 1))));
+  }
+
+  return true;
+}
+
+bool ThemeBundle::ApplySourceEntry(const SourceEntry &entry, Content *content) {
+  const std::string &key = entry.first;
+  const std::string &value = entry.second;
+
+  if (key == "base") return true;
+
+  if (key == "name") {
+    content->data.name = value;
+    return true;
+  }
+
+  if (key == "shadow.radius") return ParseInt(value, &content->shadow_radius) && content->shadow_radius > 0;
+  if (key == "shadow.offset_x") return ParseInt(value, &content->shadow_offset_x);
+  if (key == "shadow.offset_y") return ParseInt(value, &content->shadow_offset_y);
+
+  for (int i = 0; i < kFontCount; i++) {
+    if (key != kFontNames[i]) continue;
+
+    // family, weight, size
+    std::vector<std::string> fields;
+    std::istringstream stream(value);
+    std::string field;
+    while (std::getline(stream, field, ',')) fields.push_back(Trim(field));
+    if (fields.size() != 3 || fields[0].empty()) return false;
+
+    FontDescriptor &descriptor = content->fonts[i];
+    descriptor.family = fields[0];
+    return ParseInt(fields[1], &descriptor.weight) && ParseFloat(fields[2], &descriptor.size);
+  }
+
+  for (int i = 0; i < kSchemaCount; i++) {
+    for (int j = 0; j < kStyleCount; j++) {
+      for (int k = 0; k < kAttributeCount; k++) {
+        if (key != std::string(kSchemaNames[i]) + "." + kStyleNames[j] + "." + kAttributeNames[k]) continue;
+
+        Theme::Schema::Style::Attribute *attribute = GetAttribute(&content->data, i, j, k);
+        attribute->colors.clear();
+        attribute->color_positions.clear();
+
+        std::istringstream stream(value);
+        std::string token;
+        while (stream >> token) {
+          size_t at = token.find('@');
+          uint32_t argb = 0;
+          if (!ParseColor(token.substr(0, at), &argb)) return false;
+          attribute->colors.push_back(core::ColorF(argb));
+
+          if (at != std::string::npos) {
+            float position = 0.f;
+            if (!ParseFloat(token.substr(at + 1), &position)) return false;
+            attribute->color_positions.push_back(position);
+          }
+        }
+
+        // Positions are either omitted or given for all colors
+        return !attribute->colors.empty() &&
+            (attribute->color_positions.empty() || attribute->color_positions.size() == attribute->colors.size());
+      }
+    }
+  }
+
+  return false;
+}
+
+const Theme::Schema::Style::Attribute *ThemeBundle::GetAttribute(const Theme::Data *data,
+                                                                 int schema,
+                                                                 int style,
+                                                                 int attribute) {
+  const Theme::Schema *schemas[kSchemaCount] = {&data->window, &data->title_bar, &data->button};
+  const Theme::Schema::Style *styles[kStyleCount] = {&schemas[schema]->active,
+                                                     &schemas[schema]->inactive,
+                                                     &schemas[schema]->highlight};
+  const Theme::Schema::Style::Attribute *attributes[kAttributeCount] = {&styles[style]->foreground,
+                                                                        &styles[style]->background,
+                                                                        &styles[style]->outline};
+  return attributes[attribute];
+}
+
+Theme::Schema::Style::Attribute *ThemeBundle::GetAttribute(Theme::Data *data, int schema, int style, int attribute) {
+  const Theme::Data *const_data = data;
+  return const_cast<Theme::Schema::Style::Attribute *>(GetAttribute(const_data, schema, style, attribute));
+}
+
+graphic::Font *ThemeBundle::GetFont(Theme::Data *data, int index) {
+  return 0 == index ? &data->title_bar_font : &data->default_font;
+}
+
+bool ThemeBundle::Validate() const {
+  const Header *h = header();
+
+  if (0 != memcmp(h->magic, kMagic, sizeof(kMagic))) return false;
+  if (h->byte_order != kByteOrderMark || h->version != kVersion) return false;
+  if (h->file_size != size_) return false;
+
+  if (h->shadow_radius <= 0 ||
+      h->shadow_width != Theme::kShadowImageWidth ||
+      h->shadow_height != Theme::kShadowImageHeight)
+    return false;
+
+  if (0 != (h->shadow_pixels_offset % kShadowAlignment) ||
+      !IsInRange(h->shadow_pixels_offset, size_t(h->shadow_width) * h->shadow_height * sizeof(uint32_t)))
+    return false;
+
+  if (!IsInRange(h->name.offset, h->name.length)) return false;
+
+  for (int i = 0; i < kSchemaCount; i++) {
+    for (int j = 0; j < kStyleCount; j++) {
+      for (int k = 0; k < kAttributeCount; k++) {
+        const Attribute &record = h->attributes[i][j][k];
+        if (0 != (record.colors_offset % 4) || 0 != (record.positions_offset % 4)) return false;
+        if (record.color_count > size_ || record.position_count > size_) return false;
+        if (!IsInRange(record.colors_offset, size_t(record.color_count) * 4 * sizeof(float))) return false;
+        if (!IsInRange(record.positions_offset, size_t(record.position_count) * sizeof(float))) return false;
+      }
+    }
+  }
+
+  for (int i = 0; i < kFontCount; i++) {
+    if (!IsInRange(h->fonts[i].family.offset, h->fonts[i].family.length)) return false;
+  }
+
+  return true;
+}
+
+} // namespace gui
+} // namespace skland
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SKLAND_GUI_INTERNAL_THEME_BUNDLE_HPP_
+#define SKLAND_GUI_INTERNAL_THEME_BUNDLE_HPP_
+
+#include "skland/gui/theme.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace skland {
+namespace gui {
+
+/**
+ * @ingroup gui_intern
+ * @brief A compiled theme file mapped in memory
+ *
+ * A bundle is a flat binary file written by Theme::Compile(): a fixed size
+ * header with tables of offsets, followed by the colors, strings and the
+ * pre-rendered shadow pixels. It's loaded with mmap and validated once, the
+ * shadow pixels are used in place and the colors are copied into Theme::Data
+ * without any parsing.
+ *
+ * Bundles are written in the native byte order and are not portable between
+ * architectures.
+ */
+class ThemeBundle {
+
+ public:
+
+  SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(ThemeBundle);
+
+  static const uint32_t kVersion = 1;
+
+  static const int kSchemaCount = 3;  // window, title_bar, button
+  static const int kStyleCount = 3;  // active, inactive, highlight
+  static const int kAttributeCount = 3;  // foreground, background, outline
+  static const int kFontCount = 2;  // title_bar_font, default_font
+
+  struct FontDescriptor {
+
+    FontDescriptor()
+        : weight(graphic::FontStyle::kWeightNormal),
+          width(graphic::FontStyle::kWidthNormal),
+          slant(graphic::FontStyle::kSlantUpright),
+          size(12.f) {}
+
+    std::string family;
+    int weight;
+    int width;
+    int slant;
+    float size;
+
+  };
+
+  /**
+   * @brief The content of a bundle to be written
+   */
+  struct Content {
+
+    Content()
+        : shadow_radius(0), shadow_offset_x(0), shadow_offset_y(0) {}
+
+    Theme::Data data;
+
+    /** Fonts are written as descriptors, the Font objects in data are ignored */
+    FontDescriptor fonts[kFontCount];
+
+    int shadow_radius;
+    int shadow_offset_x;
+    int shadow_offset_y;
+
+    /** kShadowImageWidth x kShadowImageHeight pixels in N32 premultiplied */
+    std::vector<uint32_t> shadow_pixels;
+
+  };
+
+  typedef std::pair<std::string, std::string> SourceEntry;
+
+  ThemeBundle();
+
+  ~ThemeBundle();
+
+  /**
+   * @brief Map and validate a bundle file
+   * @return false if the file cannot be mapped or is not a valid bundle
+   */
+  bool Open(const char *filename);
+
+  void Close();
+
+  /**
+   * @brief Copy the colors, name and fonts into theme data
+   */
+  void Apply(Theme::Data *data) const;
+
+  const uint32_t *GetShadowPixels() const;
+
+  int GetShadowRadius() const;
+
+  int GetShadowOffsetX() const;
+
+  int GetShadowOffsetY() const;
+
+  size_t GetSize() const { return size_; }
+
+  static bool Write(const char *filename, const Content &content);
+
+  /**
+   * @brief Read the "key = value" lines of a text theme
+   *
+   * Empty lines and lines start with '#' are ignored.
+   */
+  static bool ReadSource(const char *filename, std::vector<SourceEntry> *entries);
+
+  /**
+   * @brief Apply a line of text theme on content
+   *
+   * Supported keys:
+   *   - base: the theme to start with, handled in Theme::Compile()
+   *   - name
+   *   - <schema>.<style>.<attribute>: a list of colors in hex AARRGGBB, each
+   *     optionally followed by @position for gradients, e.g.
+   *     "title_bar.active.background = 0xFFDDDDDD@0 0xFFCCCCCC@1"
+   *   - title_bar_font, default_font: "family, weight, size"
+   *   - shadow.radius, shadow.offset_x, shadow.offset_y
+   */
+  static bool ApplySourceEntry(const SourceEntry &entry, Content *content);
+
+ private:
+
+  struct Header;
+
+  struct String {
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  struct Attribute {
+    uint32_t color_count;
+    uint32_t position_count;
+    uint32_t colors_offset;
+    uint32_t positions_offset;
+  };
+
+  struct Font {
+    String family;
+    int32_t weight;
+    int32_t width;
+    int32_t slant;
+    float size;
+  };
+
+  static const Theme::Schema::Style::Attribute *GetAttribute(const Theme::Data *data,
+                                                             int schema,
+                                                             int style,
+                                                             int attribute);
+
+  static Theme::Schema::Style::Attribute *GetAttribute(Theme::Data *data, int schema, int style, int attribute);
+
+  static graphic::Font *GetFont(Theme::Data *data, int index);
+
+  const Header *header() const { return reinterpret_cast<const Header *>(data_); }
+
+  bool Validate() const;
+
+  bool IsInRange(uint32_t offset, size_t length) const {
+    return offset <= size_ && length <= size_ - offset;
+  }
+
+  const char *data_;
+
+  size_t size_;
+
+  static const char *kSchemaNames[kSchemaCount];
+  static const char *kStyleNames[kStyleCount];
+  static const char *kAttributeNames[kAttributeCount];
+  static const char *kFontNames[kFontCount];
+
+};
+
+} // namespace gui
+} // namespace skland
+
+#endif // SKLAND_GUI_INTERNAL_THEME_BUNDLE_HPP_
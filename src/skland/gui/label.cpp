@@ -21,7 +21,7 @@
 #include "skland/graphic/font.hpp"
 #include "skland/graphic/canvas.hpp"
 #include "skland/graphic/paint.hpp"
-#include "skland/graphic/text-box.hpp"
+#include "skland/graphic/text-layout.hpp"
 
 #include "skland/gui/context.hpp"
 #include "skland/gui/key-event.hpp"
@@ -45,7 +45,8 @@ struct Label::Private {
       : text(text),
         foreground(0.2f, 0.2f, 0.2f),
         background(0.f, 0.f, 0.f, 0.f),
-        font(Theme::GetData().default_font) {}
+        font(Theme::GetData().default_font),
+        layout_scale(0) {}
 
   ~Private() {}
 
@@ -54,6 +55,12 @@ struct Label::Private {
   core::ColorF background;
   Font font;
 
+  /**
+   * @brief The shaped text, reset when the text, font or scale changes
+   */
+  std::shared_ptr<const graphic::TextLayout> layout;
+  int layout_scale;
+
 };
 
 Label::Label(const std::string &text)
@@ -79,12 +86,15 @@ void Label::SetForeground(const ColorF &color) {
 void Label::SetBackground(const ColorF &color) {
   if (p_->background != color) {
     p_->background = color;
+    // A label with a solid background covers everything under it
+    SetOpaque(color.alpha >= 1.f);
     Update();
   }
 }
 
 void Label::SetFont(const graphic::Font &font) {
   p_->font = font;
+  p_->layout.reset();
   Update();
 }
 
@@ -127,7 +137,7 @@ void Label::OnKeyUp(KeyEvent *event) {
 void Label::OnDraw(const Context &context) {
   using graphic::Canvas;
   using graphic::Paint;
-  using graphic::TextBox;
+  using graphic::TextLayoutCache;
 
   int scale = context.surface()->GetScale();
   const RectF rect = GetGeometry() * scale;
@@ -137,23 +147,20 @@ void Label::OnDraw(const Context &context) {
   paint.SetColor(p_->background);
   context.canvas()->DrawRect(rect, paint);
 
+  if (!p_->layout || p_->layout_scale != scale) {
+    p_->layout = TextLayoutCache::Get(p_->text, p_->font, 0.f, scale);
+    p_->layout_scale = scale;
+  }
+
   paint.SetColor(p_->foreground);
   paint.SetAntiAlias(true);
   paint.SetStyle(Paint::kStyleFill);
-  paint.SetFont(p_->font);
-  paint.SetTextSize(p_->font.GetSize() * scale);
-
-  float text_width = paint.MeasureText(p_->text.c_str(), p_->text.length());
 
-  TextBox text_box;
   // Put the text at the center
-  text_box.SetBox(rect.l + (rect.width() - text_width) / 2.f,
-                  rect.t + 1.f, // move down a little for better look
-                  rect.r - (rect.width() - text_width) / 2.f,
-                  rect.b);
-  text_box.SetSpacingAlign(TextBox::kSpacingAlignCenter);
-  text_box.SetText(p_->text.c_str(), p_->text.length(), paint);
-  text_box.Draw(*context.canvas());
+  context.canvas()->DrawTextLayout(*p_->layout,
+                                   rect.l + (rect.width() - p_->layout->GetWidth()) / 2.f,
+                                   rect.t + 1.f + (rect.height() - p_->layout->GetHeight()) / 2.f,
+                                   paint);
 }
 
 } // namespace gui
@@ -0,0 +1,430 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "skland/gui/list-view.hpp"
+
+#include "skland/core/memory.hpp"
+#include "skland/core/defines.hpp"
+
+#include "skland/numerical/clamp.hpp"
+
+#include "skland/graphic/canvas.hpp"
+
+#include "skland/gui/abstract-list-model.hpp"
+#include "skland/gui/context.hpp"
+#include "skland/gui/mouse-event.hpp"
+#include "skland/gui/key-event.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace skland {
+namespace gui {
+
+using core::RectF;
+using core::PointI;
+using numerical::Clamp;
+
+/**
+ * @brief The private structure used in ListView
+ */
+struct ListView::Private {
+
+  Private(const Private &) = delete;
+  Private &operator=(const Private &) = delete;
+
+  /**
+   * @brief A realized item view with the type used for recycling
+   */
+  struct Item {
+    AbstractView *view;
+    int type;
+  };
+
+  Private()
+      : model(nullptr),
+        item_height(24),
+        overscan(2),
+        scroll_offset(0),
+        first_index(0) {}
+
+  ~Private() {}
+
+  AbstractListModel *model;
+
+  int item_height;
+
+  int overscan;
+
+  int scroll_offset;
+
+  /**
+   * @brief The model index of the first item in items
+   */
+  int first_index;
+
+  /**
+   * @brief Realized item views in index order, starts from first_index
+   */
+  std::deque<Item> items;
+
+  /**
+   * @brief Recycled views grouped by view type
+   */
+  std::map<int, std::vector<AbstractView *>> pool;
+
+};
+
+ListView::ListView()
+    : ListView(400, 300) {
+}
+
+ListView::ListView(int width, int height)
+    : AbstractView(width, height) {
+  p_ = core::MakeUnique<Private>();
+}
+
+ListView::~ListView() {
+  _ASSERT(p_->items.empty());
+  _ASSERT(p_->pool.empty());
+}
+
+void ListView::SetModel(AbstractListModel *model) {
+  if (p_->model == model) return;
+
+  if (nullptr != p_->model) {
+    p_->model->changed().DisconnectAll(this, &ListView::OnModelChanged);
+  }
+
+  // Views in the pool were created by the old model
+  while (!p_->items.empty()) {
+    AbstractView *view = RemoveChild(p_->items.back().view);
+    p_->items.pop_back();
+    view->Destroy();
+  }
+  for (auto &pair : p_->pool) {
+    for (AbstractView *view : pair.second) view->Destroy();
+  }
+  p_->pool.clear();
+
+  p_->model = model;
+  p_->scroll_offset = 0;
+  p_->first_index = 0;
+
+  if (nullptr != p_->model) {
+    p_->model->changed().Connect(this, &ListView::OnModelChanged);
+  }
+
+  Realize();
+  Update();
+}
+
+AbstractListModel *ListView::GetModel() const {
+  return p_->model;
+}
+
+void ListView::SetItemHeight(int height) {
+  if (height < 1 || height == p_->item_height) return;
+
+  p_->item_height = height;
+  Realize();
+  Update();
+}
+
+int ListView::GetItemHeight() const {
+  return p_->item_height;
+}
+
+void ListView::SetOverscan(int count) {
+  if (count < 0 || count == p_->overscan) return;
+
+  p_->overscan = count;
+  Realize();
+}
+
+int ListView::GetOverscan() const {
+  return p_->overscan;
+}
+
+void ListView::ScrollTo(int offset) {
+  offset = Clamp(offset, 0, GetMaximalScrollOffset());
+  if (offset == p_->scroll_offset) return;
+
+  p_->scroll_offset = offset;
+  Realize();
+
+  Update();
+  DispatchUpdate();
+
+  scrolled_.Emit(offset);
+}
+
+void ListView::ScrollBy(int distance) {
+  ScrollTo(p_->scroll_offset + distance);
+}
+
+void ListView::ScrollToIndex(int index) {
+  ScrollTo(index / GetColumnCount() * p_->item_height);
+}
+
+int ListView::GetScrollOffset() const {
+  return p_->scroll_offset;
+}
+
+int ListView::GetMaximalScrollOffset() const {
+  if (nullptr == p_->model) return 0;
+
+  int columns = GetColumnCount();
+  int rows = (p_->model->GetCount() + columns - 1) / columns;
+  int max = rows * p_->item_height - GetHeight();
+  return max > 0 ? max : 0;
+}
+
+int ListView::GetFirstIndex() const {
+  return p_->first_index;
+}
+
+int ListView::GetViewCount() const {
+  return static_cast<int>(p_->items.size());
+}
+
+int ListView::GetRecycledCount() const {
+  int count = 0;
+  for (auto &pair : p_->pool) count += static_cast<int>(pair.second.size());
+  return count;
+}
+
+AbstractView *ListView::GetViewAt(int index) const {
+  index -= p_->first_index;
+  if (index < 0 || index >= static_cast<int>(p_->items.size())) return nullptr;
+
+  return p_->items[index].view;
+}
+
+int ListView::GetColumnCount() const {
+  return 1;
+}
+
+RectF ListView::GetItemGeometry(int index) const {
+  int columns = GetColumnCount();
+  float width = GetWidth() / static_cast<float>(columns);
+  int row = index / columns;
+  int column = index % columns;
+
+  return RectF::MakeFromXYWH(GetX() + column * width,
+                             GetY() + row * p_->item_height - p_->scroll_offset,
+                             width,
+                             p_->item_height);
+}
+
+int ListView::GetIndexAt(int x, int y) const {
+  int row = (y - GetY() + p_->scroll_offset) / p_->item_height;
+  int columns = GetColumnCount();
+  int column = static_cast<int>((x - GetX()) * columns / GetWidth());
+  if (column < 0 || column >= columns) return -1;
+
+  return row * columns + column;
+}
+
+void ListView::OnConfigureGeometry(const RectF &old_geometry, const RectF &new_geometry) {
+  if (!RequestSaveGeometry(new_geometry)) return;
+
+  Realize();
+}
+
+void ListView::OnSaveGeometry(const RectF &old_geometry, const RectF &new_geometry) {
+  Update();
+}
+
+void ListView::OnRequestUpdate(AbstractView *view) {
+  if (view != this) {
+    // Find the item view which is or contains the view
+    AbstractView *item = view;
+    while (nullptr != item && item->GetParent() != this) item = item->GetParent();
+
+    if (nullptr != item) {
+      // Do not redraw the item views in overscan area
+      if (!GetGeometry().Intersect(item->GetGeometry())) return;
+
+      // Item views and their sub views are drawn in OnDraw() of this list
+      Update();
+      return;
+    }
+  }
+
+  AbstractView::OnRequestUpdate(view);
+}
+
+void ListView::OnMouseEnter(MouseEvent *event) {
+  event->Ignore();
+}
+
+void ListView::OnMouseLeave() {
+
+}
+
+void ListView::OnMouseMove(MouseEvent *event) {
+  event->Ignore();
+}
+
+void ListView::OnMouseDown(MouseEvent *event) {
+  event->Ignore();
+}
+
+void ListView::OnMouseUp(MouseEvent *event) {
+  event->Ignore();
+}
+
+void ListView::OnKeyDown(KeyEvent *event) {
+  event->Ignore();
+}
+
+void ListView::OnKeyUp(KeyEvent *event) {
+  event->Ignore();
+}
+
+void ListView::OnDraw(const Context &context) {
+  // The background is drawn by the shell view. Item views are drawn in the clip
+  // of this list, the ones partly scrolled out must not draw beyond the edges.
+  int scale = nullptr == context.surface() ? 1 : context.surface()->GetScale();
+  graphic::Canvas::LockGuard guard(context.canvas(), GetGeometry() * scale);
+
+  const RectF &geometry = GetGeometry();
+  for (const Private::Item &item : p_->items) {
+    if (item.view->IsVisible() && geometry.Intersect(item.view->GetGeometry())) {
+      Draw(item.view, context);
+    }
+  }
+}
+
+void ListView::OnDestroy() {
+  // Realized views are children and destroyed in ClearChildren()
+  p_->items.clear();
+
+  for (auto &pair : p_->pool) {
+    for (AbstractView *view : pair.second) view->Destroy();
+  }
+  p_->pool.clear();
+}
+
+void ListView::DispatchUpdate() {
+  // Visible item views are drawn with this list
+  Update();
+}
+
+AbstractView *ListView::DispatchMouseEnterEvent(MouseEvent *event) {
+  PointI cursor_xy(event->GetWindowXY());
+  if (!Contain(cursor_xy.x, cursor_xy.y) || p_->items.empty()) return nullptr;
+
+  // Items are laid out in order, so the index can be calculated directly
+  int index = GetIndexAt(cursor_xy.x, cursor_xy.y);
+  AbstractView *view = index < 0 ? nullptr : GetViewAt(index);
+
+  if (nullptr != view && view->Contain(cursor_xy.x, cursor_xy.y)) return view;
+  return nullptr;
+}
+
+void ListView::Realize(bool rebind) {
+  AbstractListModel *model = p_->model;
+
+  // The scroll range changes with model count, geometry and item size
+  p_->scroll_offset = Clamp(p_->scroll_offset, 0, GetMaximalScrollOffset());
+
+  int first = 0;
+  int last = 0;
+
+  if (nullptr != model) {
+    int count = model->GetCount();
+    int columns = GetColumnCount();
+    int rows = (count + columns - 1) / columns;
+    int first_row = p_->scroll_offset / p_->item_height - p_->overscan;
+    int last_row = (p_->scroll_offset + GetHeight() + p_->item_height - 1) / p_->item_height + p_->overscan;
+
+    first = Clamp(first_row, 0, rows) * columns;
+    last = std::min(Clamp(last_row, 0, rows) * columns, count);
+  }
+
+  // Put views out of the new range into the pool:
+  auto recycle = [this, model](const Private::Item &item, int index) {
+    RemoveChild(item.view);
+    item.view->Update(false);
+    model->UnbindView(item.view, index);
+    p_->pool[item.type].push_back(item.view);
+  };
+
+  while (!p_->items.empty() && (p_->first_index < first || rebind)) {
+    recycle(p_->items.front(), p_->first_index);
+    p_->items.pop_front();
+    p_->first_index++;
+  }
+
+  while (!p_->items.empty() && (p_->first_index + static_cast<int>(p_->items.size())) > last) {
+    recycle(p_->items.back(), p_->first_index + static_cast<int>(p_->items.size()) - 1);
+    p_->items.pop_back();
+  }
+
+  if (p_->items.empty()) p_->first_index = first;
+
+  // Acquire views for new items from the pool or the model:
+  auto acquire = [this, model](int index, bool front) -> Private::Item {
+    Private::Item item;
+    item.type = model->GetViewType(index);
+
+    std::vector<AbstractView *> &views = p_->pool[item.type];
+    if (views.empty()) {
+      item.view = model->CreateView(item.type);
+    } else {
+      item.view = views.back();
+      views.pop_back();
+    }
+
+    // Keep the children in index order
+    if (front) PushFrontChild(item.view);
+    else PushBackChild(item.view);
+    model->BindView(item.view, index);
+    return item;
+  };
+
+  while (p_->first_index > first) {
+    p_->first_index--;
+    p_->items.push_front(acquire(p_->first_index, true));
+  }
+
+  while ((p_->first_index + static_cast<int>(p_->items.size())) < last) {
+    p_->items.push_back(acquire(p_->first_index + static_cast<int>(p_->items.size()), false));
+  }
+
+  // Move the realized views:
+  int index = p_->first_index;
+  for (const Private::Item &item : p_->items) {
+    RectF geometry = GetItemGeometry(index);
+    item.view->MoveTo(static_cast<int>(geometry.x()), static_cast<int>(geometry.y()));
+    item.view->Resize(static_cast<int>(geometry.width()), static_cast<int>(geometry.height()));
+    index++;
+  }
+}
+
+void ListView::OnModelChanged(core::SLOT /*slot*/) {
+  Realize(true);
+  Update();
+  DispatchUpdate();
+}
+
+} // namespace gui
+} // namespace skland
@@ -55,6 +55,10 @@ int Output::GetScale() const {
   return p_->scale;
 }
 
+int Output::GetRefreshRate() const {
+  return p_->current_refresh_rate;
+}
+
 const std::string &Output::GetMake() const {
   return p_->make_;
 }
@@ -99,16 +99,17 @@ void PushButton::OnDraw(const Context &context) {
   paint.SetFont(font);
   paint.SetTextSize(font.GetSize());
 
-  float text_width = paint.MeasureText(text.c_str(), text.length());
-
   TextBox text_box;
+  text_box.SetMode(TextBox::kModeOneLine);
+  text_box.SetText(text.c_str(), text.length(), paint);  // The layout is shared in TextLayoutCache
+
+  float text_width = text_box.GetTextWidth();
   // Put the text at the center
   text_box.SetBox(geometry.l + (geometry.width() - text_width) / 2.f,
                   geometry.t + 1.f, // move down a little for better look
                   geometry.r - (geometry.width() - text_width) / 2.f,
                   geometry.b);
   text_box.SetSpacingAlign(TextBox::kSpacingAlignCenter);
-  text_box.SetText(text.c_str(), text.length(), paint);
   text_box.Draw(*canvas);
 }
 
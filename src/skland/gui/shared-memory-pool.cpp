@@ -17,6 +17,7 @@
 #include <skland/gui/shared-memory-pool.hpp>
 
 #include "skland/core/defines.hpp"
+#include "skland/core/memory-stats.hpp"
 
 #include <sys/mman.h>
 
@@ -37,7 +38,14 @@
 namespace skland {
 namespace gui {
 
-void SharedMemoryPool::Setup(int32_t size) {
+SharedMemoryPool::~SharedMemoryPool() {
+  if (wl_shm_pool_) {
+    wl_shm_pool_destroy(wl_shm_pool_);
+    core::MemoryStats::Remove(core::MemoryStats::kSharedMemoryPool, (size_t) size_, owner_);
+  }
+}
+
+void SharedMemoryPool::Setup(int32_t size, const AbstractShellView *owner) {
   Destroy();
 
   int fd = CreateAnonymousFile(size);
@@ -54,7 +62,10 @@ void SharedMemoryPool::Setup(int32_t size) {
   wl_shm_pool_ = wl_shm_create_pool(Display::Proxy::wl_shm(), fd, size);
 
   size_ = size;
+  owner_ = owner;
   close(fd);
+
+  core::MemoryStats::Add(core::MemoryStats::kSharedMemoryPool, (size_t) size_, owner_);
 }
 
 void SharedMemoryPool::Destroy() {
@@ -64,6 +75,9 @@ void SharedMemoryPool::Destroy() {
     if (munmap(data_, (size_t) size_))
       _DEBUG("%s\n", "Failed to unmap the memory\n");
 
+    core::MemoryStats::Remove(core::MemoryStats::kSharedMemoryPool, (size_t) size_, owner_);
+    owner_ = nullptr;
+
     data_ = nullptr;
     size_ = 0;
 
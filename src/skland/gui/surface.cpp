@@ -432,6 +432,7 @@ void Surface::RenderTask::Run() const {
 
 void Surface::CommitTask::Run() const {
   wl_surface_commit(surface_->p_->wl_surface);
+  surface_->p_->frame_arena.Reset();
 }
 
 // ------
@@ -480,7 +481,9 @@ void Surface::Attach(Buffer *buffer, int32_t x, int32_t y) {
 
 void Surface::Commit() {
   if (nullptr != p_->rendering_api) {
-    // GL surface does not use commit
+    // GL surface does not use commit, the frame is already swapped
+    p_->frame_arena.Reset();
+
     if (p_->commit_mode == kSynchronized) {
       Surface *main_surface = GetShellSurface();
       if (main_surface != this)
@@ -560,6 +563,10 @@ core::Deque<AbstractView::RedrawNode> &Surface::GetRedrawNodeDeque() const {
   return p_->redraw_node_deque;
 }
 
+core::Arena *Surface::GetFrameArena() const {
+  return &p_->frame_arena;
+}
+
 Surface *Surface::GetShellSurface() {
   Surface *shell_surface = this;
   Surface *parent = p_->parent;
@@ -17,40 +17,135 @@
 #include <skland/gui/theme.hpp>
 #include <iostream>
 #include <skland/core/defines.hpp>
+#include <skland/core/memory-stats.hpp>
+#include <skland/core/dynamic-library.hpp>
 #include <skland/graphic/gradient-shader.hpp>
+#include <skland/graphic/font-cache.hpp>
 
 #include "SkBlurMaskFilter.h"
 #include "SkPath.h"
 #include "SkCanvas.h"
 #include "SkPixmap.h"
+#include "SkImage.h"
+#include "SkTypeface.h"
 
 #include "internal/theme-light.hpp"
 #include "internal/theme-dark.hpp"
+#include "internal/theme-bundle.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/stat.h>
 
 namespace skland {
 namespace gui {
 
 using core::PointF;
 using graphic::FontStyle;
+using graphic::FontCache;
 using graphic::Shader;
 
-int Theme::kShadowRadius = 33;
-int Theme::kShadowOffsetX = 0;
-int Theme::kShadowOffsetY = 11;
+using std::cerr;
+using std::endl;
+
+static const char *kFontFamily = "Noto Sans CJK SC";
+
+static const int kDefaultShadowRadius = 33;
+static const int kDefaultShadowOffsetX = 0;
+static const int kDefaultShadowOffsetY = 11;
+
+/**
+ * @brief A loaded theme and where it comes from
+ */
+struct Theme::Instance {
+
+  Instance()
+      : theme(nullptr), destroy(nullptr), plugin(nullptr), bundle(nullptr) {}
+
+  Theme *theme;
+
+  ThemeDestroyHandle destroy;
+
+  /** The theme plugin, nullptr for builtin themes and bundles */
+  core::DynamicLibrary *plugin;
+
+  /** The mapped bundle, nullptr for builtin themes and plugins */
+  ThemeBundle *bundle;
+
+};
+
+/**
+ * @brief A theme created from a compiled bundle
+ */
+class ThemeFromBundle : public Theme {
+
+ public:
+
+  explicit ThemeFromBundle(const ThemeBundle &bundle)
+      : Theme() {
+    bundle.Apply(&data());
+  }
+
+  ~ThemeFromBundle() {}
+
+};
+
+namespace {
+
+bool IsRegularFile(const char *path) {
+  struct stat st;
+  return 0 == stat(path, &st) && S_ISREG(st.st_mode);
+}
+
+bool IsPlugin(const char *path) {
+  size_t length = strlen(path);
+  return length > 3 && 0 == strcmp(path + length - 3, ".so");
+}
+
+void DestroyThemeFromBundle(void *p) {
+  delete static_cast<ThemeFromBundle *>(p);
+}
+
+void GetFontDescriptor(const graphic::Font &font, ThemeBundle::FontDescriptor *descriptor) {
+  descriptor->family = kFontFamily;
+  descriptor->size = font.GetSize();
+
+  SkTypeface *typeface = font.GetSkTypeface();
+  if (nullptr == typeface) return;
+
+  SkString family_name;
+  typeface->getFamilyName(&family_name);
+  if (family_name.size() > 0) descriptor->family = family_name.c_str();
+
+  SkFontStyle font_style = typeface->fontStyle();
+  descriptor->weight = font_style.weight();
+  descriptor->width = font_style.width();
+  descriptor->slant = font_style.slant();
+}
+
+} // namespace
+
+Theme::Instance Theme::kInstance;
+
+int Theme::kShadowRadius = kDefaultShadowRadius;
+int Theme::kShadowOffsetX = kDefaultShadowOffsetX;
+int Theme::kShadowOffsetY = kDefaultShadowOffsetY;
 core::Margin Theme::kShadowMargin = core::Margin(kShadowRadius - kShadowOffsetX,
                                                  kShadowRadius - kShadowOffsetY,
                                                  kShadowRadius + kShadowOffsetX,
                                                  kShadowRadius + kShadowOffsetY);
 std::vector<uint32_t> Theme::kShadowPixels;
 SkPixmap *Theme::kShadowPixmap = nullptr;
+SkImage *Theme::kShadowImage = nullptr;
 
 Theme *Theme::kTheme = nullptr;
 
 Theme::Data::Data()
-    : title_bar_font("Noto Sans CJK SC",
+    : title_bar_font(kFontFamily,
                      FontStyle(FontStyle::kWeightBold),
                      12.f),
-      default_font("Noto Sans CJK SC",
+      default_font(kFontFamily,
                    FontStyle(),
                    12.f) {
 
@@ -64,30 +159,36 @@ Shader Theme::Helper::GradientShader::MakeLinear(const PointF *points, const Att
                                                      Shader::TileMode::kTileModeClamp);
 }
 
+void Theme::Preload() {
+  FontCache::AddWarmUpFont(kFontFamily, FontStyle(FontStyle::kWeightBold));
+  FontCache::AddWarmUpFont(kFontFamily, FontStyle());
+  FontCache::WarmUp();
+}
+
 void Theme::Initialize() {
   if (kTheme) return;
 
-  kShadowPixels.resize(kShadowImageWidth * kShadowImageHeight, 0);
-  GenerateShadowImage();
-
-  SkImageInfo image_info = SkImageInfo::MakeN32Premul(kShadowImageWidth, kShadowImageHeight);
-  delete kShadowPixmap;
-  kShadowPixmap = new SkPixmap(image_info,
-                               kShadowPixels.data(),
-                               kShadowImageWidth * 4);
-
-  Load();
+  // A compiled bundle given in SKLAND_THEME also provides the shadow image
+  Load(getenv("SKLAND_THEME"));
   _ASSERT(kTheme);
 }
 
 void Theme::Release() {
   if (nullptr == kTheme) return;
 
-  delete kTheme;
+  DestroyInstance(&kInstance);
   kTheme = nullptr;
 
+  SkSafeUnref(kShadowImage);
+  kShadowImage = nullptr;
+
   delete kShadowPixmap;
   kShadowPixmap = nullptr;
+
+  if (!kShadowPixels.empty()) {
+    core::MemoryStats::Remove(core::MemoryStats::kTheme, kShadowPixels.size() * sizeof(uint32_t));
+    std::vector<uint32_t>().swap(kShadowPixels);
+  }
 }
 
 Theme::Theme() {
@@ -99,52 +200,176 @@ Theme::~Theme() {
 }
 
 void Theme::Load(const char *name) {
-  if (kTheme) delete kTheme;
-  kTheme = nullptr;
-
   if (nullptr == name) name = "Light";
 
-  ThemeCreateHandle handle = nullptr;
-  // TODO: load from file
+  Instance instance;
+  if (!CreateInstance(name, &instance)) {
+    cerr << "Error! Cannot load theme: " << name << ", use the default one" << endl;
+    CreateInstance("Light", &instance);
+  }
+  _ASSERT(instance.theme);
+
+  // Switch the shadow image before the old bundle is unmapped
+  UseShadow(instance.bundle);
+
+  DestroyInstance(&kInstance);
+  kInstance = instance;
+  kTheme = instance.theme;
+}
+
+bool Theme::Compile(const char *source, const char *filename) {
+  std::string base(source);
+  std::vector<ThemeBundle::SourceEntry> entries;
+
+  if (IsRegularFile(source) && !IsPlugin(source)) {
+    if (!ThemeBundle::ReadSource(source, &entries)) return false;
+
+    base = "Light";
+    for (const ThemeBundle::SourceEntry &entry : entries) {
+      if (entry.first == "base") base = entry.second;
+    }
+  }
+
+  Instance instance;
+  if (!CreateInstance(base.c_str(), &instance)) return false;
+
+  ThemeBundle::Content content;
+  content.data = instance.theme->data_;
+  if (content.data.name.empty()) content.data.name = base;
+  GetFontDescriptor(content.data.title_bar_font, &content.fonts[0]);
+  GetFontDescriptor(content.data.default_font, &content.fonts[1]);
+  content.shadow_radius = kDefaultShadowRadius;
+  content.shadow_offset_x = kDefaultShadowOffsetX;
+  content.shadow_offset_y = kDefaultShadowOffsetY;
+
+  DestroyInstance(&instance);
+
+  for (const ThemeBundle::SourceEntry &entry : entries) {
+    if (!ThemeBundle::ApplySourceEntry(entry, &content)) {
+      cerr << "Error! Invalid theme entry: " << entry.first << " = " << entry.second << endl;
+      return false;
+    }
+  }
+
+  content.shadow_pixels.resize(kShadowImageWidth * kShadowImageHeight, 0);
+  GenerateShadowImage(content.shadow_pixels.data(), content.shadow_radius);
+
+  return ThemeBundle::Write(filename, content);
+}
+
+void Theme::UseShadow(const ThemeBundle *bundle) {
+  const uint32_t *pixels = nullptr;
+
+  if (nullptr != bundle) {
+    if (!kShadowPixels.empty()) {
+      core::MemoryStats::Remove(core::MemoryStats::kTheme, kShadowPixels.size() * sizeof(uint32_t));
+      std::vector<uint32_t>().swap(kShadowPixels);
+    }
+
+    SetShadowGeometry(bundle->GetShadowRadius(), bundle->GetShadowOffsetX(), bundle->GetShadowOffsetY());
+    pixels = bundle->GetShadowPixels();
+  } else {
+    if (nullptr != kShadowPixmap && !kShadowPixels.empty()) return;
+
+    SetShadowGeometry(kDefaultShadowRadius, kDefaultShadowOffsetX, kDefaultShadowOffsetY);
+    kShadowPixels.resize(kShadowImageWidth * kShadowImageHeight, 0);
+    core::MemoryStats::Add(core::MemoryStats::kTheme, kShadowPixels.size() * sizeof(uint32_t));
+    GenerateShadowImage(kShadowPixels.data(), kShadowRadius);
+    pixels = kShadowPixels.data();
+  }
+
+  SkImageInfo image_info = SkImageInfo::MakeN32Premul(kShadowImageWidth, kShadowImageHeight);
+  delete kShadowPixmap;
+  kShadowPixmap = new SkPixmap(image_info, pixels, kShadowImageWidth * 4);
+
+  // The image does not copy the pixels
+  SkSafeUnref(kShadowImage);
+  kShadowImage = SkImage::MakeFromRaster(*kShadowPixmap, nullptr, nullptr).release();
+}
+
+void Theme::SetShadowGeometry(int radius, int offset_x, int offset_y) {
+  kShadowRadius = radius;
+  kShadowOffsetX = offset_x;
+  kShadowOffsetY = offset_y;
+  kShadowMargin = Margin(radius - offset_x, radius - offset_y, radius + offset_x, radius + offset_y);
+}
 
-  // Otherwise, use the builtin theme
+bool Theme::CreateInstance(const char *name, Instance *instance) {
   std::string upper_name(name);
   std::transform(upper_name.begin(), upper_name.end(), upper_name.begin(), ::toupper);
 
   if (upper_name == "LIGHT") {
-    handle = ThemeLightCreate;
-    kTheme = static_cast<Theme *>(handle());
-    kTheme->data_.name = name;
+    instance->theme = static_cast<Theme *>(ThemeLightCreate());
+    instance->theme->data_.name = name;
+    instance->destroy = ThemeLightDestroy;
   } else if (upper_name == "DARK") {
-    handle = ThemeDarkCreate;
-    kTheme = static_cast<Theme *>(handle());
+    instance->theme = static_cast<Theme *>(ThemeDarkCreate());
+    instance->destroy = ThemeDarkDestroy;
+  } else if (IsRegularFile(name) && IsPlugin(name)) {
+    instance->plugin = new core::DynamicLibrary;
+    instance->plugin->Open(name, RTLD_NOW | RTLD_LOCAL);
+    if (instance->plugin->IsValid()) {
+      ThemeCreateHandle create = reinterpret_cast<ThemeCreateHandle>(instance->plugin->GetSymbol("ThemeCreate"));
+      instance->destroy = reinterpret_cast<ThemeDestroyHandle>(instance->plugin->GetSymbol("ThemeDestroy"));
+      if (nullptr != create && nullptr != instance->destroy)
+        instance->theme = static_cast<Theme *>(create());
+    }
+  } else if (IsRegularFile(name)) {
+    instance->bundle = new ThemeBundle;
+    if (instance->bundle->Open(name)) {
+      core::MemoryStats::Add(core::MemoryStats::kTheme, instance->bundle->GetSize());
+      instance->theme = new ThemeFromBundle(*instance->bundle);
+      instance->destroy = DestroyThemeFromBundle;
+    }
+  }
+
+  if (nullptr == instance->theme) {
+    DestroyInstance(instance);
+    return false;
   }
+
+  return true;
+}
+
+void Theme::DestroyInstance(Instance *instance) {
+  if (nullptr != instance->theme) instance->destroy(instance->theme);
+  instance->theme = nullptr;
+  instance->destroy = nullptr;
+
+  // The plugin is closed after the theme it created is destroyed
+  delete instance->plugin;
+  instance->plugin = nullptr;
+
+  if (nullptr != instance->bundle && instance->bundle->GetSize() > 0)
+    core::MemoryStats::Remove(core::MemoryStats::kTheme, instance->bundle->GetSize());
+  delete instance->bundle;
+  instance->bundle = nullptr;
 }
 
-void Theme::GenerateShadowImage() {
+void Theme::GenerateShadowImage(uint32_t *pixels, int radius) {
   std::unique_ptr<SkCanvas> canvas =
       SkCanvas::MakeRasterDirectN32(kShadowImageWidth,
                                     kShadowImageHeight,
-                                    kShadowPixels.data(),
+                                    pixels,
                                     kShadowImageWidth * 4);
   SkPaint paint;
   paint.setAntiAlias(true);
   paint.setARGB(135, 0, 0, 0);
   paint.setMaskFilter(SkBlurMaskFilter::Make(
-      kNormal_SkBlurStyle, kShadowRadius / 2.f - 0.5f, 0x2));  // Use high-quality blur
+      kNormal_SkBlurStyle, radius / 2.f - 0.5f, 0x2));  // Use high-quality blur
 
   float radii[] = {
-      kShadowRadius / 1.f, kShadowRadius / 1.f, // top-left
-      kShadowRadius / 1.f, kShadowRadius / 1.f, // top-right
-      kShadowRadius / 2.f, kShadowRadius / 2.f, // bottom-right
-      kShadowRadius / 2.f, kShadowRadius / 2.f,  // bottom-left
+      radius / 1.f, radius / 1.f, // top-left
+      radius / 1.f, radius / 1.f, // top-right
+      radius / 2.f, radius / 2.f, // bottom-right
+      radius / 2.f, radius / 2.f,  // bottom-left
   };
 
   SkPath path;
-  path.addRoundRect(SkRect::MakeLTRB(kShadowRadius,
-                                     kShadowRadius,
-                                     kShadowImageWidth - kShadowRadius,
-                                     kShadowImageWidth - kShadowRadius),
+  path.addRoundRect(SkRect::MakeLTRB(radius,
+                                     radius,
+                                     kShadowImageWidth - radius,
+                                     kShadowImageWidth - radius),
                     radii, SkPath::kCW_Direction);
   canvas->drawPath(path, paint);
 }
@@ -19,17 +19,15 @@
 #include <skland/gui/mouse-event.hpp>
 #include <skland/gui/key-event.hpp>
 #include <skland/gui/context.hpp>
+#include <skland/gui/chrome-path-cache.hpp>
 
 #include <skland/graphic/canvas.hpp>
 #include <skland/graphic/paint.hpp>
+#include <skland/graphic/paint-cache.hpp>
 #include <skland/graphic/path.hpp>
+#include <skland/graphic/text-layout.hpp>
 #include <skland/gui/theme.hpp>
 
-#include "SkCanvas.h"
-//#include "SkTypeface.h"
-//#include "SkPaint.h"
-#include "SkTextBox.h"
-
 namespace skland {
 namespace gui {
 
@@ -37,6 +35,24 @@ using core::RectF;
 using graphic::Canvas;
 using graphic::Paint;
 using graphic::Path;
+using graphic::PaintCache;
+using graphic::TextLayout;
+using graphic::TextLayoutCache;
+
+/**
+ * @brief Get an anti-aliased paint interned in PaintCache, so the buttons of
+ * all title bars share one
+ */
+static std::shared_ptr<const Paint> InternPaint(const core::ColorF &color,
+                                                Paint::Style style,
+                                                float stroke_width = 0.f) {
+  Paint paint;
+  paint.SetAntiAlias(true);
+  paint.SetStyle(style);
+  paint.SetColor(color);
+  paint.SetStrokeWidth(stroke_width);
+  return PaintCache::Intern(paint);
+}
 
 class TitleBar::Button : public AbstractButton {
  public:
@@ -49,6 +65,17 @@ class TitleBar::Button : public AbstractButton {
 
   void OnDraw(const Context &context) override;
 
+  /**
+   * @brief Draw the circle when hovered or pressed
+   */
+  void DrawBackground(Canvas *canvas, const RectF &rect) const;
+
+  std::shared_ptr<const Paint> pressed_paint_;
+
+  std::shared_ptr<const Paint> hovered_paint_;
+
+  std::shared_ptr<const Paint> glyph_paint_;
+
  private:
 
   static const int kButtonSize = 14;
@@ -56,17 +83,29 @@ class TitleBar::Button : public AbstractButton {
 
 TitleBar::Button::Button()
     : AbstractButton(kButtonSize, kButtonSize) {
+  const Theme::Data &data = Theme::GetData();
+
+  pressed_paint_ = InternPaint(data.title_bar.highlight.foreground.colors[0], Paint::Style::kStyleFill);
+  hovered_paint_ = InternPaint(data.title_bar.active.foreground.colors[0], Paint::Style::kStyleStroke, 1.f);
+  glyph_paint_ = InternPaint(data.title_bar.active.foreground.colors[0], Paint::Style::kStyleStroke, 1.5f);
 }
 
 void TitleBar::Button::OnDraw(const Context &context) {
   // override in sub class
 }
 
+void TitleBar::Button::DrawBackground(Canvas *canvas, const RectF &rect) const {
+  if (!IsHovered()) return;
+
+  if (IsPressed()) canvas->DrawCircle(rect.center_x(), rect.center_y(), 7.f, *pressed_paint_);
+  canvas->DrawCircle(rect.center_x(), rect.center_y(), 6.5f, *hovered_paint_);
+}
+
 class TitleBar::CloseButton : public TitleBar::Button {
 
  public:
 
-  CloseButton() = default;
+  CloseButton();
 
   ~CloseButton() final = default;
 
@@ -74,8 +113,23 @@ class TitleBar::CloseButton : public TitleBar::Button {
 
   void OnDraw(const Context &context) final;
 
+ private:
+
+  std::shared_ptr<const Paint> background_paint_;
+
 };
 
+TitleBar::CloseButton::CloseButton()
+    : Button() {
+  core::ColorF background = 0xFFDD6666;
+  background_paint_ = InternPaint(background, Paint::Style::kStyleFill);
+  hovered_paint_ = InternPaint(background + 35, Paint::Style::kStyleFill);
+  pressed_paint_ = InternPaint(background - 45, Paint::Style::kStyleFill);
+
+//  glyph_paint_ = InternPaint(Theme::GetData().title_bar.active.foreground.color, ...);
+  glyph_paint_ = InternPaint(0xFFDDDDDD, Paint::Style::kStyleStroke, 1.5f);
+}
+
 void TitleBar::CloseButton::OnDraw(const Context &context) {
   Canvas *canvas = context.canvas();
   int scale = context.surface()->GetScale();
@@ -85,31 +139,14 @@ void TitleBar::CloseButton::OnDraw(const Context &context) {
 
   canvas->Scale(scale, scale);
 
-  Paint paint;
-  paint.SetAntiAlias(true);
-  core::ColorF background = 0xFFDD6666;
-
+  const Paint *background = background_paint_.get();
   if (IsHovered()) {
-    if (IsPressed()) {
-      background -= 45;
-    } else {
-      background += 35;
-    }
+    background = IsPressed() ? pressed_paint_.get() : hovered_paint_.get();
   }
+  canvas->DrawCircle(rect.center_x(), rect.center_y(), 7.f, *background);
 
-  paint.SetStyle(Paint::Style::kStyleFill);
-  paint.SetColor(background);
-  canvas->DrawCircle(rect.center_x(), rect.center_y(), 7.f, paint);
-
-//  paint.SetColor(Theme::GetData().title_bar.active.foreground.color);
-  paint.SetColor(0xFFDDDDDD);
-  paint.SetStrokeWidth(1.5f);
-  canvas->DrawLine(rect.center_x() - 3.f, rect.center_y() - 3.f,
-                   rect.center_x() + 3.f, rect.center_y() + 3.f,
-                   paint);
-  canvas->DrawLine(rect.center_x() + 3.f, rect.center_y() - 3.f,
-                   rect.center_x() - 3.f, rect.center_y() + 3.f,
-                   paint);
+  canvas->Translate(rect.center_x(), rect.center_y());
+  canvas->DrawPath(ChromePathCache::GetGlyph(ChromePathCache::kGlyphClose), *glyph_paint_);
 }
 
 class TitleBar::MaximizeButton : public TitleBar::Button {
@@ -135,32 +172,10 @@ void TitleBar::MaximizeButton::OnDraw(const Context &context) {
 
   canvas->Scale(scale, scale);
 
-  Paint paint;
-  paint.SetAntiAlias(true);
+  DrawBackground(canvas, rect);
 
-  if (IsHovered()) {
-    if (IsPressed()) {
-      paint.SetColor(Theme::GetData().title_bar.highlight.foreground.colors[0]);
-      paint.SetStyle(Paint::Style::kStyleFill);
-      canvas->DrawCircle(rect.center_x(), rect.center_y(), 7.f, paint);
-      paint.Reset();
-      paint.SetAntiAlias(true);
-    }
-
-    paint.SetStyle(Paint::Style::kStyleStroke);
-    paint.SetColor(Theme::GetData().title_bar.active.foreground.colors[0]);
-    paint.SetStrokeWidth(1.f);
-    canvas->DrawCircle(rect.center_x(), rect.center_y(), 6.5f, paint);
-  }
-
-  paint.SetColor(Theme::GetData().title_bar.active.foreground.colors[0]);
-  paint.SetStrokeWidth(1.5f);
-  canvas->DrawLine(rect.center_x() - 4.f, rect.center_y(),
-                   rect.center_x() + 4.f, rect.center_y(),
-                   paint);
-  canvas->DrawLine(rect.center_x(), rect.center_y() - 4.f,
-                   rect.center_x(), rect.center_y() + 4.f,
-                   paint);
+  canvas->Translate(rect.center_x(), rect.center_y());
+  canvas->DrawPath(ChromePathCache::GetGlyph(ChromePathCache::kGlyphMaximize), *glyph_paint_);
 }
 
 class TitleBar::MinimizeButton : public TitleBar::Button {
@@ -186,44 +201,34 @@ void TitleBar::MinimizeButton::OnDraw(const Context &context) {
 
   canvas->Scale(scale, scale);
 
-  Paint paint;
-  paint.SetAntiAlias(true);
+  DrawBackground(canvas, rect);
 
-  if (IsHovered()) {
-    if (IsPressed()) {
-      paint.SetColor(Theme::GetData().title_bar.highlight.foreground.colors[0]);
-      paint.SetStyle(Paint::Style::kStyleFill);
-      canvas->DrawCircle(rect.center_x(), rect.center_y(), 7.f, paint);
-      paint.Reset();
-      paint.SetAntiAlias(true);
-    }
-
-    paint.SetStyle(Paint::Style::kStyleStroke);
-    paint.SetColor(Theme::GetData().title_bar.active.foreground.colors[0]);
-    paint.SetStrokeWidth(1.f);
-    canvas->DrawCircle(rect.center_x(), rect.center_y(), 6.5f, paint);
-  }
-
-  paint.SetColor(Theme::GetData().title_bar.active.foreground.colors[0]);
-  paint.SetStrokeWidth(1.5f);
-  canvas->DrawLine(rect.center_x() - 4.f, rect.center_y(),
-                   rect.center_x() + 4.f, rect.center_y(),
-                   paint);
+  canvas->Translate(rect.center_x(), rect.center_y());
+  canvas->DrawPath(ChromePathCache::GetGlyph(ChromePathCache::kGlyphMinimize), *glyph_paint_);
 }
 
 class TitleBar::FullscreenButton : public TitleBar::Button {
 
  public:
 
-  FullscreenButton() = default;
+  FullscreenButton();
 
   ~FullscreenButton() final = default;
 
  protected:
 
   void OnDraw(const Context &context) final;
+
 };
 
+TitleBar::FullscreenButton::FullscreenButton()
+    : Button() {
+  const core::ColorF &foreground = Theme::GetData().title_bar.active.foreground.colors[0];
+
+  pressed_paint_ = InternPaint(foreground, Paint::Style::kStyleFill);
+  glyph_paint_ = InternPaint(foreground, Paint::Style::kStyleFill);
+}
+
 void TitleBar::FullscreenButton::OnDraw(const Context &context) {
   Canvas *canvas = context.canvas();
   int scale = context.surface()->GetScale();
@@ -233,38 +238,10 @@ void TitleBar::FullscreenButton::OnDraw(const Context &context) {
 
   canvas->Scale(scale, scale);
 
-  Paint paint;
-  paint.SetAntiAlias(true);
-
-  if (IsHovered()) {
-    if (IsPressed()) {
-      paint.SetColor(Theme::GetData().title_bar.active.foreground.colors[0]);
-      paint.SetStyle(Paint::Style::kStyleFill);
-      canvas->DrawCircle(rect.center_x(), rect.center_y(), 7.f, paint);
-      paint.Reset();
-      paint.SetAntiAlias(true);
-    }
-
-    paint.SetStyle(Paint::Style::kStyleStroke);
-    paint.SetColor(Theme::GetData().title_bar.active.foreground.colors[0]);
-    paint.SetStrokeWidth(1.f);
-    canvas->DrawCircle(rect.center_x(), rect.center_y(), 6.5f, paint);
-  }
-
-  paint.SetColor(Theme::GetData().title_bar.active.foreground.colors[0]);
-  paint.SetStyle(Paint::Style::kStyleFill);
-
-  Path path;
-  path.MoveTo(-5.f, 0.f);
-  path.RelativeLineTo(3.5f, -3.5f);
-  path.RelativeLineTo(0.f, 7.f);
-  path.Close();
+  DrawBackground(canvas, rect);
 
   canvas->Translate(rect.center_x(), rect.center_y());
-  canvas->Rotate(-45.f);
-  canvas->DrawPath(path, paint);
-  canvas->Rotate(180.f);
-  canvas->DrawPath(path, paint);
+  canvas->DrawPath(ChromePathCache::GetGlyph(ChromePathCache::kGlyphFullscreen), *glyph_paint_);
 }
 
 TitleBar::TitleBar()
@@ -273,7 +250,8 @@ TitleBar::TitleBar()
       maximize_button_(nullptr),
       minimize_button_(nullptr),
       fullscreen_button_(nullptr),
-      font_(Theme::GetData().title_bar_font) {
+      font_(Theme::GetData().title_bar_font),
+      title_paint_scale_(0) {
   close_button_ = new CloseButton;
   maximize_button_ = new MaximizeButton;
   minimize_button_ = new MinimizeButton;
@@ -355,29 +333,33 @@ void TitleBar::OnKeyUp(KeyEvent *event) {
 
 void TitleBar::OnDraw(const Context &context) {
   int scale = context.surface()->GetScale();
-  Paint paint;
-  paint.SetAntiAlias(true);
-  paint.SetStyle(Paint::kStyleFill);
-  paint.SetFont(font_);
-  paint.SetTextSize(font_.GetSize() * scale);
+
+  if (!title_paint_ || title_paint_scale_ != scale) {
+    Paint paint;
+    paint.SetAntiAlias(true);
+    paint.SetStyle(Paint::kStyleFill);
+    paint.SetFont(font_);
+    paint.SetTextSize(font_.GetSize() * scale);
+    paint.SetColor(Theme::GetData().title_bar.active.foreground.colors[0]);
+
+    title_paint_ = PaintCache::Intern(paint);
+    title_paint_scale_ = scale;
+  }
+  const Paint &paint = *title_paint_;
 
 //  paint.SetColor(0xFF7F1F1F);
 //  context.canvas()->DrawRect(GetGeometry(), paint);
 
-  paint.SetColor(Theme::GetData().title_bar.active.foreground.colors[0]);
-
-  float text_width = paint.MeasureText(title_.c_str(), title_.length());
+  // Shaped once and shared in TextLayoutCache until the title or scale changes
+  std::shared_ptr<const TextLayout> layout = TextLayoutCache::Get(title_, paint);
 
-  SkTextBox text_box;
   const RectF rect = GetGeometry() * scale;
   // Put the foreground at the center
-  text_box.setBox(rect.l + (rect.width() - text_width) / 2.f,
-                  rect.t + 1.f, // move down a little for better look
-                  rect.r - (rect.width() - text_width) / 2.f,
-                  rect.b);
-  text_box.setSpacingAlign(SkTextBox::kCenter_SpacingAlign);
-  text_box.setText(title_.c_str(), title_.length(), paint.GetSkPaint());
-  text_box.draw(context.canvas()->GetSkCanvas());
+  context.canvas()->DrawTextLayout(*layout,
+                                   rect.l + (rect.width() - layout->GetWidth()) / 2.f,
+                                   rect.t + 1.f + // move down a little for better look
+                                       (rect.height() - layout->GetHeight()) / 2.f,
+                                   paint);
 }
 
 } // namespace gui
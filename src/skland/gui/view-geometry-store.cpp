@@ -0,0 +1,255 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "skland/gui/view-geometry-store.hpp"
+
+#include "internal/abstract-view_private.hpp"
+
+#include <algorithm>
+
+namespace skland {
+namespace gui {
+
+using core::RectF;
+
+ViewGeometryStore::ViewGeometryStore()
+    : opaque_count_(0),
+      occluders_stale_(false),
+      stale_(false) {
+}
+
+ViewGeometryStore::~ViewGeometryStore() {
+  Release();
+}
+
+void ViewGeometryStore::AddRoot(AbstractView *view) {
+  if (std::find(roots_.begin(), roots_.end(), view) != roots_.end()) return;
+
+  roots_.push_back(view);
+  Invalidate();
+}
+
+void ViewGeometryStore::RemoveRoot(AbstractView *view) {
+  auto it = std::find(roots_.begin(), roots_.end(), view);
+  if (it == roots_.end()) return;
+
+  roots_.erase(it);
+  Invalidate();
+}
+
+void ViewGeometryStore::Invalidate() {
+  if (stale_) return;
+
+  Release();
+  stale_ = true;
+}
+
+void ViewGeometryStore::Sync() {
+  if (stale_) {
+    for (AbstractView *root : roots_) {
+      Push(root);
+    }
+    mask_.resize(views_.size());
+
+    stale_ = false;
+    occluders_stale_ = true;
+  }
+
+  if (occluders_stale_) CollectOccluders();
+}
+
+int ViewGeometryStore::IndexOf(const AbstractView *view) const {
+  if (view->p_->geometry_store != this) return -1;
+  return view->p_->geometry_index;
+}
+
+int ViewGeometryStore::Cull(const RectF &rect, std::vector<AbstractView *> *views) {
+  Sync();
+  CalculateMask(rect);
+
+  views->clear();
+
+  const int count = GetCount();
+  int i = 0;
+  while (i < count) {
+    if (0 == visible_[i]) {
+      i = subtree_end_[i];
+      continue;
+    }
+    if (mask_[i]) views->push_back(views_[i]);
+    i++;
+  }
+
+  return static_cast<int>(views->size());
+}
+
+AbstractView *ViewGeometryStore::HitTest(float x, float y) {
+  Sync();
+
+  AbstractView *hit = nullptr;
+  int end = GetCount();
+  int i = 0;
+
+  while (i < end) {
+    if (visible_[i] && x >= left_[i] && x < right_[i] && y >= top_[i] && y < bottom_[i]) {
+      // Only search in the sub views of this one
+      hit = views_[i];
+      end = subtree_end_[i];
+      i++;
+    } else {
+      i = subtree_end_[i];
+    }
+  }
+
+  return hit;
+}
+
+bool ViewGeometryStore::IsOccludedAt(int index) {
+  Sync();
+  if (occluders_.empty()) return false;
+
+  const float l = left_[index];
+  const float t = top_[index];
+  const float r = right_[index];
+  const float b = bottom_[index];
+
+  if (l >= r || t >= b) return false;
+
+  // Views above this one are before the end of its subtree in tree order
+  const int end = subtree_end_[index];
+
+  for (int i : occluders_) {
+    if (i >= end) break;
+
+    // Skip this view and its ancestors
+    if (i <= index && subtree_end_[i] > index) continue;
+
+    if (left_[i] <= l && top_[i] <= t && right_[i] >= r && bottom_[i] >= b)
+      return true;
+  }
+
+  return false;
+}
+
+int ViewGeometryStore::CollectDirty(std::vector<AbstractView *> *views) {
+  Sync();
+
+  views->clear();
+
+  const int count = GetCount();
+  for (int i = 0; i < count; i++) {
+    if (dirty_[i] & visible_[i]) views->push_back(views_[i]);
+  }
+
+  return static_cast<int>(views->size());
+}
+
+void ViewGeometryStore::ClearDirty() {
+  std::fill(dirty_.begin(), dirty_.end(), 0);
+}
+
+void ViewGeometryStore::SetOpaqueAt(int index, bool opaque) {
+  if ((0 != opaque_[index]) == opaque) return;
+
+  opaque_[index] = opaque ? 1 : 0;
+  opaque_count_ += opaque ? 1 : -1;
+  occluders_stale_ = true;
+}
+
+void ViewGeometryStore::Push(AbstractView *view) {
+  const int index = GetCount();
+  const AbstractView::Private *p = view->p_.get();
+
+  views_.push_back(view);
+  subtree_end_.push_back(index + 1);
+  left_.push_back(p->geometry.left);
+  top_.push_back(p->geometry.top);
+  right_.push_back(p->geometry.right);
+  bottom_.push_back(p->geometry.bottom);
+  visible_.push_back(p->visible ? 1 : 0);
+  dirty_.push_back(p->redraw_task.IsLinked() ? 1 : 0);
+  opaque_.push_back(p->opaque ? 1 : 0);
+  if (p->opaque) opaque_count_++;
+
+  view->p_->geometry_store = this;
+  view->p_->geometry_index = index;
+
+  for (AbstractView *sub = p->first_child; sub; sub = sub->p_->next) {
+    Push(sub);
+  }
+
+  subtree_end_[index] = GetCount();
+}
+
+void ViewGeometryStore::Release() {
+  for (AbstractView *view : views_) {
+    view->p_->geometry_store = nullptr;
+    view->p_->geometry_index = -1;
+  }
+
+  views_.clear();
+  subtree_end_.clear();
+  left_.clear();
+  top_.clear();
+  right_.clear();
+  bottom_.clear();
+  visible_.clear();
+  dirty_.clear();
+  opaque_.clear();
+  mask_.clear();
+  occluders_.clear();
+
+  opaque_count_ = 0;
+  occluders_stale_ = false;
+}
+
+void ViewGeometryStore::CollectOccluders() {
+  occluders_.clear();
+  occluders_stale_ = false;
+
+  if (0 == opaque_count_) return;
+
+  const int count = GetCount();
+  int i = 0;
+  while (i < count) {
+    if (0 == visible_[i]) {
+      i = subtree_end_[i];
+      continue;
+    }
+    if (opaque_[i]) occluders_.push_back(i);
+    i++;
+  }
+}
+
+void ViewGeometryStore::CalculateMask(const RectF &rect) {
+  const int count = GetCount();
+  const float *l = left_.data();
+  const float *t = top_.data();
+  const float *r = right_.data();
+  const float *b = bottom_.data();
+  uint8_t *mask = mask_.data();
+
+  // Branchless so that the compiler can vectorize this loop
+  for (int i = 0; i < count; i++) {
+    mask[i] = static_cast<uint8_t>((l[i] < rect.right) & (r[i] > rect.left) &
+        (t[i] < rect.bottom) & (b[i] > rect.top) &
+        (l[i] < r[i]) & (t[i] < b[i]));
+  }
+}
+
+} // namespace gui
+} // namespace skland
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "skland/gui/view-slab.hpp"
+
+#include "skland/gui/anchor.hpp"
+
+#include "internal/abstract-view_private.hpp"
+#include "internal/abstract-event-handler_private.hpp"
+
+namespace skland {
+namespace gui {
+
+ViewSlab::ViewSlab()
+    : view_allocator_(sizeof(AbstractView::Private)),
+      event_handler_allocator_(sizeof(AbstractEventHandler::Private)),
+      anchor_allocator_(sizeof(Anchor)),
+      previous_view_allocator_(AbstractView::Private::GetSlabAllocator()),
+      previous_event_handler_allocator_(AbstractEventHandler::Private::GetSlabAllocator()),
+      previous_anchor_allocator_(Anchor::GetSlabAllocator()) {
+  AbstractView::Private::SetSlabAllocator(&view_allocator_);
+  AbstractEventHandler::Private::SetSlabAllocator(&event_handler_allocator_);
+  Anchor::SetSlabAllocator(&anchor_allocator_);
+}
+
+ViewSlab::~ViewSlab() {
+  AbstractView::Private::SetSlabAllocator(previous_view_allocator_);
+  AbstractEventHandler::Private::SetSlabAllocator(previous_event_handler_allocator_);
+  Anchor::SetSlabAllocator(previous_anchor_allocator_);
+}
+
+} // namespace gui
+} // namespace skland
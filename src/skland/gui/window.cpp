@@ -19,6 +19,8 @@
 #include "skland/core/defines.hpp"
 #include "skland/core/memory.hpp"
 #include "skland/core/property.hpp"
+#include "skland/core/arena.hpp"
+#include "skland/core/batch.hpp"
 
 #include "skland/gui/application.hpp"
 #include "skland/gui/mouse-event.hpp"
@@ -29,6 +31,9 @@
 #include "skland/gui/buffer.hpp"
 #include "skland/gui/region.hpp"
 #include "skland/gui/output.hpp"
+#include "skland/gui/view-geometry-store.hpp"
+#include "skland/gui/chrome-path-cache.hpp"
+#include "skland/gui/glesv2-api.hpp"
 
 #include "skland/gui/theme.hpp"
 
@@ -36,6 +41,14 @@
 #include "skland/graphic/paint.hpp"
 #include "skland/graphic/path.hpp"
 #include "skland/graphic/gradient-shader.hpp"
+#include "skland/graphic/picture-recorder.hpp"
+#include "skland/graphic/raster-thread.hpp"
+
+#include "internal/display_proxy.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
 
 namespace skland {
 namespace gui {
@@ -57,7 +70,7 @@ using graphic::ClipOperation;
  * @ingroup gui_intern
  * @brief The private structure for Window
  */
-struct Window::Private : public core::Property<Window> {
+struct Window::Private : public core::Property<Window>, public core::Trackable {
 
   SKLAND_DECLARE_NONCOPYABLE_AND_NONMOVALE(Private);
 
@@ -65,9 +78,15 @@ struct Window::Private : public core::Property<Window> {
       : core::Property<Window>(owner),
         minimal_size(160, 120),
         preferred_size(640, 480),
-        maximal_size(65536, 65536) {}
+        maximal_size(65536, 65536),
+        use_gpu(nullptr == getenv("SKLAND_DISABLE_GPU")) {
+    // Emitted in the raster thread, the surface is committed in the main thread
+    rasterized.ConnectQueued(this, &Private::OnRasterized);
+  }
 
-  ~Private() final = default;
+  ~Private() final {
+    ReleaseGPU();
+  }
 
   SharedMemoryPool pool;
 
@@ -92,6 +111,85 @@ struct Window::Private : public core::Property<Window> {
 
   bool inhibit_update = true;
 
+  FrameStats frame_stats;
+
+  /**
+   * @brief The opaque rects set to the surface in last frame
+   */
+  std::vector<RectF> opaque_rects;
+
+  /**
+   * @brief Records the views drawn in a frame, the picture is played back into
+   * the buffer by raster_thread
+   */
+  graphic::PictureRecorder recorder;
+
+  /**
+   * @brief The canvas on the buffer, only used in raster_thread
+   */
+  std::unique_ptr<Canvas> buffer_canvas;
+
+  /**
+   * @brief The damaged rects of each frame submitted and not committed yet
+   */
+  std::deque<std::vector<RectI> > pending_damage;
+
+  /**
+   * @brief Frames dropped in WaitRasterThread() whose rasterized signals are
+   * still queued
+   */
+  size_t dropped_frames = 0;
+
+  /**
+   * @brief The maximal count of damaged rects sent for one frame
+   *
+   * More rects are merged into their bounds, as each one is a request to the
+   * compositor.
+   */
+  static const size_t kMaxDamageRects = 16;
+
+  core::Signal<> rasterized;
+
+  /**
+   * @brief Draws on an EGL surface of the shell surface, nullptr if the
+   * window is rendered into the shm buffer
+   */
+  std::unique_ptr<GLESV2API> gl_api;
+
+  /**
+   * @brief The GPU render target which keeps the window content between frames
+   */
+  std::unique_ptr<Canvas> gpu_canvas;
+
+  /**
+   * @brief Try the GPU before the shm buffer, disabled by SKLAND_DISABLE_GPU
+   */
+  bool use_gpu;
+
+  /**
+   * @brief Declared last so it's joined before the members it uses are destroyed
+   */
+  graphic::RasterThread raster_thread;
+
+  const Path &GetChromePath(ChromePathCache::Shape shape, int scale) {
+    return owner()->GetChromePathCache()->Get(shape,
+                                              owner()->GetWidth(),
+                                              owner()->GetHeight(),
+                                              scale,
+                                              owner()->IsMaximized() || owner()->IsFullscreen());
+  }
+
+  /**
+   * @brief Check if a view in redraw deque can be skipped and update the frame stats
+   * @return true if the view does not need to be drawn
+   */
+  bool CullView(AbstractView *view, ViewGeometryStore *store, const RectF &window_geometry);
+
+  /**
+   * @brief Set the opaque region of the surface from opaque views if changed
+   */
+  void UpdateOpaqueRegion(Surface *surface, ViewGeometryStore *store);
+
   void DrawInner(const Context &context);
 
   void DrawOutline(const Context &context);
@@ -102,92 +200,66 @@ struct Window::Private : public core::Property<Window> {
 
   void SetContentViewGeometry();
 
-  static std::vector<float> kOutlineRadii;
-
-};
+  /**
+   * @brief Wait for the pending frames before the buffer is reset
+   */
+  void WaitRasterThread();
+
+  /**
+   * @brief Set up the buffer of the shell surface in the given size in pixels
+   *
+   * The window is rasterized on the GPU if the Skia GL backend is available,
+   * otherwise falls back to the shm buffer.
+   */
+  void SetupBuffer(Surface *surface, int width, int height);
+
+  /**
+   * @brief Set up the EGL surface and the GPU render target
+   * @return false if the GL backend is not available
+   */
+  bool SetupGPU(Surface *surface, int width, int height);
+
+  void ReleaseGPU();
+
+  /**
+   * @brief Play back a frame on the GPU and swap buffers
+   */
+  void RenderOnGPU(const graphic::Picture &picture);
+
+  /**
+   * @brief Damage and commit the oldest frame rasterized
+   */
+  void OnRasterized(__SLOT__);
 
-std::vector<float> Window::Private::kOutlineRadii = {
-    7.f, 7.f, // top-left
-    7.f, 7.f, // top-right
-    4.f, 4.f, // bottom-right
-    4.f, 4.f  // bottom-left
 };
 
 void Window::Private::DrawInner(const Context &context) {
-  int scale = context.surface()->GetScale();
-  int pixel_width = owner()->GetWidth() * scale;
-  int pixel_height = owner()->GetHeight() * scale;
-  RectF geometry = RectF::MakeFromXYWH(0.f, 0.f, pixel_width, pixel_height);
-  std::vector<float> radii = {
-      kOutlineRadii[0] * scale, kOutlineRadii[1] * scale, // top-left
-      kOutlineRadii[2] * scale, kOutlineRadii[3] * scale, // top-right
-      kOutlineRadii[4] * scale, kOutlineRadii[5] * scale, // bottom-right
-      kOutlineRadii[6] * scale, kOutlineRadii[7] * scale  // bottom-left
-  };
-  Path path;
-  if (owner()->IsMaximized() || owner()->IsFullscreen()) {
-    path.AddRect(geometry);
-  } else {
-    path.AddRoundRect(geometry, radii.data());
-  }
-
   const Theme::Schema &window_schema = Theme::GetData().window;
 
-  // Fill color:
-  Paint paint;
-  paint.SetAntiAlias(true);
-  paint.SetColor(window_schema.active.background.colors[0]);
-
-  Canvas::LockGuard guard(context.canvas(), path, ClipOperation::kClipIntersect, true);
-  context.canvas()->DrawPath(path, paint);
+  owner()->GetChromePathCache()->DrawInner(context.canvas(),
+                                           window_schema.active.background.colors[0],
+                                           owner()->GetWidth(),
+                                           owner()->GetHeight(),
+                                           context.surface()->GetScale(),
+                                           owner()->IsMaximized() || owner()->IsFullscreen());
 }
 
 void Window::Private::DrawOutline(const Context &context) {
   if (owner()->IsMaximized() || owner()->IsFullscreen()) return;
 
-  int scale = context.surface()->GetScale();
-  int pixel_width = owner()->GetWidth() * scale;
-  int pixel_height = owner()->GetHeight() * scale;
-  RectF geometry = RectF::MakeFromXYWH(0.5f, 0.5f, pixel_width - 1.f, pixel_height - 1.f);
-  std::vector<float> radii = {
-      kOutlineRadii[0] * scale, kOutlineRadii[1] * scale, // top-left
-      kOutlineRadii[2] * scale, kOutlineRadii[3] * scale, // top-right
-      kOutlineRadii[4] * scale, kOutlineRadii[5] * scale, // bottom-right
-      kOutlineRadii[6] * scale, kOutlineRadii[7] * scale  // bottom-left
-  };
-  Path path;
-  if (owner()->IsMaximized() || owner()->IsFullscreen()) {
-    path.AddRect(geometry);
-  } else {
-    path.AddRoundRect(geometry, radii.data());
-  }
-
   const Theme::Schema &window_schema = Theme::GetData().window;
-  Paint paint;
-  paint.SetAntiAlias(true);
-  paint.SetColor(window_schema.inactive.outline.colors[0]);
-  paint.SetStyle(Paint::Style::kStyleStroke);
-  paint.SetStrokeWidth(.2f);
 
-  // FIXME: this function draws a white circle at bottom corners.
-  context.canvas()->DrawPath(path, paint);
+  owner()->GetChromePathCache()->DrawOutline(context.canvas(),
+                                             window_schema.inactive.outline.colors[0],
+                                             owner()->GetWidth(),
+                                             owner()->GetHeight(),
+                                             context.surface()->GetScale());
 }
 
 void Window::Private::DrawShadow(const Context &context) {
   if (owner()->IsMaximized() || owner()->IsFullscreen()) return;
 
-  int scale = context.surface()->GetScale();
-  int pixel_width = owner()->GetWidth() * scale;
-  int pixel_height = owner()->GetHeight() * scale;
-  RectF geometry = RectF::MakeFromXYWH(0.f, 0.f, pixel_width, pixel_height);
-  std::vector<float> radii = {
-      kOutlineRadii[0] * scale, kOutlineRadii[1] * scale, // top-left
-      kOutlineRadii[2] * scale, kOutlineRadii[3] * scale, // top-right
-      kOutlineRadii[4] * scale, kOutlineRadii[5] * scale, // bottom-right
-      kOutlineRadii[6] * scale, kOutlineRadii[7] * scale  // bottom-left
-  };
-  Path path;
-  path.AddRoundRect(geometry, radii.data());
+  const Path &path = GetChromePath(ChromePathCache::kShapeWindowInner, context.surface()->GetScale());
 
   Canvas::LockGuard guard(context.canvas(), path, ClipOperation::kClipDifference, true);
   context.canvas()->Clear();
@@ -208,12 +280,160 @@ void Window::Private::RecursiveDraw(AbstractView *view, const Context &context)
   Draw(view, context);
 }
 
+bool Window::Private::CullView(AbstractView *view, ViewGeometryStore *store, const RectF &window_geometry) {
+  int index = store->IndexOf(view);
+  if (index < 0) return false;
+
+  store->SetDirtyAt(index, false);
+
+  if ((!store->IsVisibleAt(index)) || (!window_geometry.Intersect(store->GetGeometryAt(index)))) {
+    frame_stats.culled_offscreen_views++;
+    frame_stats.total_culled_views++;
+    return true;
+  }
+
+  if (store->IsOccludedAt(index)) {
+    frame_stats.culled_occluded_views++;
+    frame_stats.total_culled_views++;
+    return true;
+  }
+
+  return false;
+}
+
+void Window::Private::UpdateOpaqueRegion(Surface *surface, ViewGeometryStore *store) {
+  // Collected in the frame arena, only copied when the region changes
+  core::ArenaVector<RectF> rects((core::ArenaAllocator<RectF>(surface->GetFrameArena())));
+
+  const RectF window_geometry = RectF::MakeFromXYWH(0.f, 0.f, owner()->GetWidth(), owner()->GetHeight());
+  store->CollectOpaque(window_geometry, &rects);
+  if (rects.size() == opaque_rects.size() && std::equal(rects.begin(), rects.end(), opaque_rects.begin()))
+    return;
+
+  opaque_rects.assign(rects.begin(), rects.end());
+
+  const Margin &margin = surface->GetMargin();
+  Region region;
+  for (const RectF &rect : opaque_rects) {
+    region.Add(static_cast<int>(rect.l) + margin.l,
+               static_cast<int>(rect.t) + margin.t,
+               static_cast<int>(rect.width()),
+               static_cast<int>(rect.height()));
+  }
+
+  if (!(owner()->IsMaximized() || owner()->IsFullscreen())) {
+    // The rounded corners are transparent
+    int w = owner()->GetWidth();
+    int h = owner()->GetHeight();
+    int top = static_cast<int>(ChromePathCache::kWindowRadii[0]);
+    int bottom = static_cast<int>(ChromePathCache::kWindowRadii[4]);
+    region.Subtract(margin.l, margin.t, top, top);
+    region.Subtract(margin.l + w - top, margin.t, top, top);
+    region.Subtract(margin.l + w - bottom, margin.t + h - bottom, bottom, bottom);
+    region.Subtract(margin.l, margin.t + h - bottom, bottom, bottom);
+  }
+
+  surface->SetOpaqueRegion(region);
+}
+
 void Window::Private::SetContentViewGeometry() {
   const RectI geometry = owner()->GetContentGeometry();
   content_view->MoveTo(geometry.x(), geometry.y());
   content_view->Resize(geometry.width(), geometry.height());
 }
 
+void Window::Private::WaitRasterThread() {
+  raster_thread.Wait();
+  buffer_canvas.reset();
+
+  // The old buffer is not committed, the window is redrawn in the new one. The
+  // queued signals of these frames come before any new frame's and are ignored.
+  dropped_frames += pending_damage.size();
+  pending_damage.clear();
+}
+
+void Window::Private::SetupBuffer(Surface *surface, int width, int height) {
+  WaitRasterThread();
+
+  if (use_gpu) {
+    if (SetupGPU(surface, width, height)) return;
+
+    // Do not try again, use the shm buffer from now on
+    use_gpu = false;
+  }
+
+  pool.Setup(width * 4 * height, owner());
+  buffer.Setup(pool, width, height, width * 4, WL_SHM_FORMAT_ARGB8888);
+  surface->Attach(&buffer);
+}
+
+bool Window::Private::SetupGPU(Surface *surface, int width, int height) {
+  if (!gl_api) {
+    gl_api.reset(new GLESV2API);
+    surface->SetRenderingAPI(gl_api.get());
+  }
+
+  gl_api->SetViewportSize(width, height);
+
+  // GetCanvas() makes the EGL surface current and creates the GPU context
+  if (nullptr == gl_api->GetCanvas()) {
+    ReleaseGPU();
+    return false;
+  }
+
+  gpu_canvas.reset(Canvas::CreateGPU(Display::Proxy::gpu_context(), width, height));
+  if (!gpu_canvas) {
+    ReleaseGPU();
+    return false;
+  }
+
+  return true;
+}
+
+void Window::Private::ReleaseGPU() {
+  if (!gl_api) return;
+
+  // The render target is released in the GL context
+  gl_api->MakeCurrent();
+  gpu_canvas.reset();
+
+  // Emits destroyed() and the surface is detached from the EGL surface
+  gl_api.reset();
+}
+
+void Window::Private::RenderOnGPU(const graphic::Picture &picture) {
+  Canvas *framebuffer = gl_api->GetCanvas();
+  if (nullptr == framebuffer) return;
+
+  // Only the views drawn in this frame are in the picture, the render target
+  // keeps the others
+  gpu_canvas->DrawPicture(picture);
+  gpu_canvas->Flush();
+
+  framebuffer->Clear();
+  framebuffer->DrawCanvas(*gpu_canvas, 0.f, 0.f);
+  framebuffer->Flush();
+
+  gl_api->SwapBuffers();
+}
+
+void Window::Private::OnRasterized(core::SLOT) {
+  if (dropped_frames > 0) {
+    --dropped_frames;
+    return;
+  }
+
+  if (pending_damage.empty()) return;
+
+  Surface *surface = owner()->GetShellSurface();
+  for (const RectI &rect : pending_damage.front()) {
+    surface->Damage(rect.x(), rect.y(), rect.width(), rect.height());
+  }
+  pending_damage.pop_front();
+
+  surface->Commit();
+}
+
 // --------------
 
 Window::Window(const char *title)
@@ -284,6 +504,10 @@ const core::SizeI &Window::GetMaximalSize() const {
   return p_->maximal_size;
 }
 
+const FrameStats &Window::GetFrameStats() const {
+  return p_->frame_stats;
+}
+
 void Window::OnShown() {
   Surface *shell_surface = GetShellSurface();
   const Margin &margin = shell_surface->GetMargin();
@@ -305,11 +529,7 @@ void Window::OnShown() {
   width += margin.lr() * scale;
   height += margin.tb() * scale;
 
-  p_->pool.Setup(width * 4 * height);
-
-  p_->buffer.Setup(p_->pool, width, height,
-                   width * 4, WL_SHM_FORMAT_ARGB8888);
-  shell_surface->Attach(&p_->buffer);
+  p_->SetupBuffer(shell_surface, width, height);
   shell_surface->Update();
 
   p_->redraw_all = true;
@@ -384,10 +604,7 @@ void Window::OnSaveSize(const Size &old_size, const Size &new_size) {
   width += margin.lr() * scale;
   height += margin.tb() * scale;
 
-  p_->pool.Setup(width * 4 * height);
-
-  p_->buffer.Setup(p_->pool, width, height, width * 4, WL_SHM_FORMAT_ARGB8888);
-  shell_surface->Attach(&p_->buffer);
+  p_->SetupBuffer(shell_surface, width, height);
   shell_surface->Update();
 
   p_->redraw_all = true;
@@ -409,13 +626,16 @@ void Window::OnRenderSurface(Surface *surface) {
   const Margin &margin = surface->GetMargin();
 
   int scale = surface->GetScale();
-  int pixel_width = GetWidth() * scale;
-  int pixel_height = GetHeight() * scale;
-  RectF geometry = RectF::MakeFromXYWH(0.f, 0.f, pixel_width, pixel_height);
+  int buffer_width = (GetWidth() + margin.lr()) * scale;
+  int buffer_height = (GetHeight() + margin.tb()) * scale;
 
-  Canvas canvas((unsigned char *) p_->buffer.GetData(),
-                p_->buffer.GetSize().width,
-                p_->buffer.GetSize().height);
+  if ((!p_->gl_api) && (!p_->buffer_canvas)) {
+    p_->buffer_canvas.reset(new Canvas((unsigned char *) p_->buffer.GetData(), buffer_width, buffer_height));
+  }
+
+  // Views are drawn into a picture here, and rasterized into the buffer in the
+  // raster thread while the main thread goes on with events and the next frame
+  Canvas &canvas = *p_->recorder.BeginRecording(RectF::MakeFromXYWH(0.f, 0.f, buffer_width, buffer_height));
   canvas.SetOrigin(margin.left, margin.top);
   if (p_->clear) {
     canvas.Clear();
@@ -423,19 +643,17 @@ void Window::OnRenderSurface(Surface *surface) {
   }
   Context context(surface, &canvas);
 
-  std::vector<float> radii = {
-      Private::kOutlineRadii[0] * scale, Private::kOutlineRadii[1] * scale, // top-left
-      Private::kOutlineRadii[2] * scale, Private::kOutlineRadii[3] * scale, // top-right
-      Private::kOutlineRadii[4] * scale, Private::kOutlineRadii[5] * scale, // bottom-right
-      Private::kOutlineRadii[6] * scale, Private::kOutlineRadii[7] * scale  // bottom-left
-  };
+  p_->pending_damage.push_back(std::vector<RectI>());
+  std::vector<RectI> &damage = p_->pending_damage.back();
 
-  Path path;
-  if (!(IsMaximized() || IsFullscreen())) {
-    path.AddRoundRect(geometry, radii.data());
-  } else {
-    path.AddRect(geometry);
-  }
+  const Path &path = p_->GetChromePath(ChromePathCache::kShapeWindowInner, scale);
+
+  // Rebuild the store and the occluders once for this frame
+  ViewGeometryStore *store = GetViewGeometryStore();
+  store->Sync();
+  const RectF window_geometry = RectF::MakeFromXYWH(0.f, 0.f, GetWidth(), GetHeight());
+
+  p_->frame_stats.BeginFrame();
 
   if (p_->redraw_all) {
     p_->redraw_all = false;
@@ -453,14 +671,17 @@ void Window::OnRenderSurface(Surface *surface) {
     while (it != deque.end()) {
       view = it.element()->view();
       it.Remove();
-      Draw(view, context);
+      if (!p_->CullView(view, store, window_geometry)) {
+        Draw(view, context);
+        p_->frame_stats.drawn_views++;
+      }
       it = deque.begin();
     }
 
-    canvas.Flush();
+    store->ClearDirty();
+    p_->UpdateOpaqueRegion(surface, store);
 
-    surface->Damage(0, 0, GetWidth() + margin.lr(), GetHeight() + margin.tb());
-    surface->Commit();
+    damage.push_back(RectI::MakeFromXYWH(0, 0, GetWidth() + margin.lr(), GetHeight() + margin.tb()));
   } else {
     core::Deque<AbstractView::RedrawNode> &deque = surface->GetRedrawNodeDeque();
     core::Deque<AbstractView::RedrawNode>::Iterator it = deque.begin();
@@ -471,18 +692,43 @@ void Window::OnRenderSurface(Surface *surface) {
     while (it != deque.end()) {
       view = it.element()->view();
       it.Remove();
+
+      // Skip the views which are hidden, out of this window or covered by opaque views
+      if (p_->CullView(view, store, window_geometry)) {
+        it = deque.begin();
+        continue;
+      }
+
       p_->RecursiveDraw(view, context);
-      surface->Damage(view->GetX() + margin.l,
-                      view->GetY() + margin.t,
-                      view->GetWidth(),
-                      view->GetHeight());
+      p_->frame_stats.drawn_views++;
+      damage.push_back(RectI::MakeFromXYWH(view->GetX() + margin.l,
+                                           view->GetY() + margin.t,
+                                           view->GetWidth(),
+                                           view->GetHeight()));
       it = deque.begin();
     }
 
-    canvas.Flush();
+    if (damage.size() > Private::kMaxDamageRects) {
+      RectI bounds = core::BatchI::Union(damage.data(), damage.size());
+      damage.assign(1, bounds);
+    }
+
+    p_->UpdateOpaqueRegion(surface, store);
+  }
 
+  if (p_->gl_api) {
+    // The whole EGL surface is swapped, the damage is not needed
+    p_->pending_damage.pop_back();
+    p_->RenderOnGPU(p_->recorder.FinishRecording());
     surface->Commit();
+    return;
   }
+
+  // The surface is committed in OnRasterized() when the picture is played back
+  core::Signal<> *rasterized = &p_->rasterized;
+  p_->raster_thread.Submit(p_->recorder.FinishRecording(),
+                           p_->buffer_canvas.get(),
+                           [rasterized]() { rasterized->Emit(); });
 }
 
 void Window::OnMouseEnter(MouseEvent *event) {
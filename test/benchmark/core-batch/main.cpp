@@ -0,0 +1,207 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ * @brief Compare core::Batch with the scalar loops it replaces
+ */
+
+#include <skland/core/rect.hpp>
+#include <skland/core/color.hpp>
+#include <skland/core/vector.hpp>
+#include <skland/core/batch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace skland;
+using namespace skland::core;
+
+typedef std::chrono::steady_clock Clock;
+
+static const size_t kCount = 4096;
+static const int kLoops = 2000;
+
+static long long Microseconds(const Clock::duration &duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+static void Print(const char *name, size_t count, const Clock::duration &scalar, const Clock::duration &batch) {
+  std::cout << name << " " << count << " elements, scalar: "
+            << Microseconds(scalar) << " us, batch: "
+            << Microseconds(batch) << " us" << std::endl;
+}
+
+/**
+ * @brief Random rects with small coordinates so many of them intersect, some are empty
+ */
+static std::vector<RectF> MakeRandomRects(size_t count) {
+  std::vector<RectF> rects(count);
+  srand(1);
+  for (size_t i = 0; i < count; ++i) {
+    float x = float(rand() % 200 - 50);
+    float y = float(rand() % 200 - 50);
+    rects[i] = RectF::MakeFromXYWH(x, y, float(rand() % 60 - 5), float(rand() % 60 - 5));
+  }
+  return rects;
+}
+
+static bool BenchmarkRects() {
+  std::vector<RectF> rects = MakeRandomRects(kCount);
+  std::vector<char> results(kCount);
+  RectF rect(20.f, 20.f, 80.f, 70.f);
+  size_t scalar_count = 0, batch_count = 0;
+
+  Clock::time_point start = Clock::now();
+  for (int j = 0; j < kLoops; ++j) {
+    for (size_t i = 0; i < kCount; ++i) {
+      results[i] = rect.Intersect(rects[i]);
+      scalar_count += results[i];
+    }
+  }
+  Clock::duration scalar = Clock::now() - start;
+
+  start = Clock::now();
+  for (int j = 0; j < kLoops; ++j) {
+    batch_count += BatchF::Intersect(rect, rects.data(), kCount, reinterpret_cast<bool *>(results.data()));
+  }
+  Clock::duration batch = Clock::now() - start;
+
+  Print("Intersect", kCount * kLoops, scalar, batch);
+
+  RectF scalar_bounds;
+  start = Clock::now();
+  for (int j = 0; j < kLoops; ++j) {
+    scalar_bounds = RectF(1e9f, 1e9f, -1e9f, -1e9f);
+    for (size_t i = 0; i < kCount; ++i) {
+      if (rects[i].IsEmpty()) continue;
+      scalar_bounds.left = std::min(scalar_bounds.left, rects[i].left);
+      scalar_bounds.top = std::min(scalar_bounds.top, rects[i].top);
+      scalar_bounds.right = std::max(scalar_bounds.right, rects[i].right);
+      scalar_bounds.bottom = std::max(scalar_bounds.bottom, rects[i].bottom);
+    }
+  }
+  scalar = Clock::now() - start;
+
+  RectF batch_bounds;
+  start = Clock::now();
+  for (int j = 0; j < kLoops; ++j) {
+    batch_bounds = BatchF::Union(rects.data(), kCount);
+  }
+  batch = Clock::now() - start;
+
+  Print("Union", kCount * kLoops, scalar, batch);
+
+  return scalar_count == batch_count && scalar_bounds == batch_bounds;
+}
+
+static bool BenchmarkPoints() {
+  std::vector<Vector2<float> > points(kCount);
+  std::vector<char> results(kCount);
+  RectF rect(10.f, 20.f, 60.f, 90.f);
+  size_t scalar_count = 0, batch_count = 0;
+
+  for (size_t i = 0; i < kCount; ++i) {
+    points[i] = Vector2<float>((float) (i * 7 % 100), (float) (i * 13 % 100));
+  }
+
+  Clock::time_point start = Clock::now();
+  for (int j = 0; j < kLoops; ++j) {
+    for (size_t i = 0; i < kCount; ++i) {
+      results[i] = rect.Contain(points[i].x, points[i].y);
+      scalar_count += results[i];
+    }
+  }
+  Clock::duration scalar = Clock::now() - start;
+
+  start = Clock::now();
+  for (int j = 0; j < kLoops; ++j) {
+    batch_count += BatchF::Contain(rect, points.data(), kCount, reinterpret_cast<bool *>(results.data()));
+  }
+  Clock::duration batch = Clock::now() - start;
+
+  Print("Contain", kCount * kLoops, scalar, batch);
+
+  return scalar_count == batch_count;
+}
+
+static bool BenchmarkColors() {
+  std::vector<ColorF> colors(kCount);
+  std::vector<uint32_t> argb(kCount);
+  double checksum = 0.0;
+
+  for (size_t i = 0; i < kCount; ++i) {
+    colors[i] = ColorF((i % 256) / 255.f, 0.5f, 0.25f, 1.f);
+  }
+
+  Clock::time_point start = Clock::now();
+  for (int j = 0; j < kLoops; ++j) {
+    colors[j % kCount].g = (j % 256) / 255.f;  // keep the loop from being optimized out
+    for (size_t i = 0; i < kCount; ++i) {
+      argb[i] = colors[i].argb();
+    }
+    checksum += argb[j % kCount];
+  }
+  Clock::duration scalar = Clock::now() - start;
+
+  start = Clock::now();
+  for (int j = 0; j < kLoops; ++j) {
+    colors[j % kCount].g = (j % 256) / 255.f;
+    BatchF::Pack(colors.data(), kCount, argb.data());
+    checksum -= argb[j % kCount];
+  }
+  Clock::duration batch = Clock::now() - start;
+
+  Print("Pack", kCount * kLoops, scalar, batch);
+
+  start = Clock::now();
+  for (int j = 0; j < kLoops; ++j) {
+    argb[j % kCount] ^= 0x100;
+    for (size_t i = 0; i < kCount; ++i) {
+      colors[i] = argb[i];
+    }
+    checksum += colors[j % kCount].g;
+  }
+  scalar = Clock::now() - start;
+
+  start = Clock::now();
+  for (int j = 0; j < kLoops; ++j) {
+    argb[j % kCount] ^= 0x100;
+    BatchF::Unpack(argb.data(), kCount, colors.data());
+    checksum -= colors[j % kCount].g;
+  }
+  batch = Clock::now() - start;
+
+  Print("Unpack", kCount * kLoops, scalar, batch);
+
+  return checksum == 0.0;
+}
+
+int main(int argc, char *argv[]) {
+  bool ok = BenchmarkRects();
+  ok = BenchmarkPoints() && ok;
+  ok = BenchmarkColors() && ok;
+
+  if (!ok) {
+    std::cerr << "Error! Batch results differ from the scalar ones" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
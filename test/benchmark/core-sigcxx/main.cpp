@@ -0,0 +1,106 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ * @brief Compare the cost of emitting signals with calling delegates directly
+ */
+
+#include <skland/core/sigcxx.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace skland;
+using namespace skland::core;
+
+typedef std::chrono::steady_clock Clock;
+
+class Counter : public Trackable {
+
+ public:
+
+  Counter() = default;
+
+  ~Counter() final = default;
+
+  void OnCount(int value, SLOT slot) {
+    count_++;
+    sum_ += value;
+  }
+
+  int count() const { return count_; }
+
+  long sum() const { return sum_; }
+
+ private:
+
+  int count_ = 0;
+
+  long sum_ = 0;
+
+};
+
+int main(int argc, char *argv[]) {
+  const int loops = 1000000;
+  const int connection_counts[] = {0, 1, 8, 64};
+
+  for (int connections : connection_counts) {
+    Signal<int> signal;
+    std::vector<Counter> counters(connections > 0 ? connections : 1);
+    std::vector<Delegate<void(int, SLOT)> > delegates;
+
+    for (int i = 0; i < connections; ++i) {
+      signal.Connect(&counters[i], &Counter::OnCount);
+      delegates.push_back(Delegate<void(int, SLOT)>::FromMethod(&counters[i], &Counter::OnCount));
+    }
+
+    int calls = connections > 0 ? loops / connections : loops;
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < calls; ++i) {
+      for (size_t j = 0; j < delegates.size(); ++j) {
+        delegates[j](i, nullptr);
+      }
+    }
+    Clock::duration direct = Clock::now() - start;
+
+    start = Clock::now();
+    for (int i = 0; i < calls; ++i) {
+      signal.Emit(i);
+    }
+    Clock::duration emit = Clock::now() - start;
+
+    // Keep the calls from being optimized out
+    long expected = 0;
+    for (int i = 0; i < calls; ++i) expected += i;
+    for (int i = 0; i < connections; ++i) {
+      if (counters[i].count() != calls * 2 || counters[i].sum() != expected * 2) {
+        std::cerr << "Error! Wrong count of calls" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::cout << connections << " connections, " << calls << " emits, delegates: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(direct).count() << " us, signal: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(emit).count() << " us"
+              << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
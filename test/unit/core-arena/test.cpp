@@ -0,0 +1,199 @@
+/*
+ * Copyright 2017 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/core/arena.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace skland;
+using namespace skland::core;
+
+static size_t kAllocationCount = 0;
+
+void *operator new(size_t size) {
+  kAllocationCount++;
+  void *p = malloc(size);
+  if (nullptr == p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  free(p);
+}
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+TEST_F(Test, allocate_1) {
+  Arena arena(256);
+
+  ASSERT_TRUE(arena.GetCapacity() == 0);
+
+  char *p1 = static_cast<char *>(arena.Allocate(1, 1));
+  void *p2 = arena.Allocate(8, 8);
+  void *p3 = arena.Allocate(3, 16);
+
+  ASSERT_TRUE(arena.GetAllocationCount() == 3);
+  ASSERT_TRUE(arena.GetChunkAllocationCount() == 1);
+  ASSERT_TRUE(reinterpret_cast<uintptr_t>(p2) % 8 == 0);
+  ASSERT_TRUE(reinterpret_cast<uintptr_t>(p3) % 16 == 0);
+  ASSERT_TRUE(p1 + 8 == p2);
+
+  arena.Reset();
+  ASSERT_TRUE(arena.GetAllocationCount() == 0);
+  ASSERT_TRUE(arena.GetUsedSize() == 0);
+  ASSERT_TRUE(arena.Allocate(1, 1) == p1);
+}
+
+TEST_F(Test, grow_1) {
+  Arena arena(64);
+
+  for (int i = 0; i < 100; i++) arena.Allocate(16);
+  ASSERT_TRUE(arena.GetChunkAllocationCount() > 1);
+  ASSERT_TRUE(arena.GetUsedSize() >= 1600);
+
+  // A large allocation gets its own chunk
+  void *p = arena.Allocate(10000);
+  ASSERT_TRUE(p != nullptr);
+
+  size_t capacity = arena.GetCapacity();
+  arena.Reset();
+  ASSERT_TRUE(arena.GetCapacity() == capacity);
+
+  // All fit in one chunk after reset
+  size_t chunks = arena.GetChunkAllocationCount();
+  for (int i = 0; i < 100; i++) arena.Allocate(16);
+  arena.Allocate(10000);
+  ASSERT_TRUE(arena.GetChunkAllocationCount() == chunks);
+}
+
+static int kDestroyOrder = 0;
+
+struct Tracked {
+
+  explicit Tracked(int *order)
+      : order_(order) {}
+
+  ~Tracked() { *order_ = ++kDestroyOrder; }
+
+  int *order_;
+
+};
+
+TEST_F(Test, new_1) {
+  int order1 = 0, order2 = 0;
+
+  Arena arena;
+  arena.New<Tracked>(&order1);
+  arena.New<Tracked>(&order2);
+  int *value = arena.New<int>(5);
+  ASSERT_TRUE(*value == 5);
+
+  arena.Reset();
+  ASSERT_TRUE(order2 == 1);
+  ASSERT_TRUE(order1 == 2);
+
+  std::string *str = arena.New<std::string>("a string longer than the small buffer");
+  ASSERT_TRUE(str->size() > 16);
+  // The destructor runs in ~Arena() and ASan reports if not
+}
+
+TEST_F(Test, vector_1) {
+  Arena arena;
+
+  ArenaVector<float> radii(8, 1.f, ArenaAllocator<float>(&arena));
+  for (int i = 0; i < 1000; i++) radii.push_back(static_cast<float>(i));
+
+  ASSERT_TRUE(radii.size() == 1008);
+  ASSERT_TRUE(radii[8] == 0.f);
+  ASSERT_TRUE(radii[1007] == 999.f);
+
+  ArenaVector<float> copy(radii);
+  ASSERT_TRUE(copy.get_allocator() == radii.get_allocator());
+  ASSERT_TRUE(copy == radii);
+}
+
+struct RectF {
+  float l, t, r, b;
+};
+
+/*
+ * The temporaries of a frame: some radii and a list of rects
+ */
+template<typename FloatVector, typename RectVector>
+static float DrawFrame(FloatVector &radii, RectVector &rects, int n) {
+  for (int i = 0; i < 8; i++) radii.push_back(static_cast<float>(i));
+  for (int i = 0; i < n; i++) {
+    RectF rect = {0.f, 0.f, static_cast<float>(i), static_cast<float>(i)};
+    rects.push_back(rect);
+  }
+  return radii[n % 8] + rects.back().r;
+}
+
+/*
+ * Frame time and heap allocations with the arena on and off
+ */
+TEST_F(Test, benchmark_1) {
+  typedef std::chrono::steady_clock Clock;
+  const int frames = 100000;
+  float sum = 0.f;
+
+  size_t count0 = kAllocationCount;
+  Clock::time_point t0 = Clock::now();
+  for (int i = 0; i < frames; i++) {
+    std::vector<float> radii;
+    std::vector<RectF> rects;
+    sum += DrawFrame(radii, rects, 50);
+  }
+  Clock::time_point t1 = Clock::now();
+  size_t count1 = kAllocationCount;
+
+  Arena arena;
+  for (int i = 0; i < frames; i++) {
+    ArenaVector<float> radii{ArenaAllocator<float>(&arena)};
+    ArenaVector<RectF> rects{ArenaAllocator<RectF>(&arena)};
+    sum += DrawFrame(radii, rects, 50);
+    arena.Reset();
+  }
+  Clock::time_point t2 = Clock::now();
+  size_t count2 = kAllocationCount;
+
+  std::cout << "arena off: "
+            << std::chrono::duration<double, std::nano>(t1 - t0).count() / frames << " ns/frame, "
+            << static_cast<double>(count1 - count0) / frames << " heap allocations/frame" << std::endl;
+  std::cout << "arena on: "
+            << std::chrono::duration<double, std::nano>(t2 - t1).count() / frames << " ns/frame, "
+            << static_cast<double>(count2 - count1) / frames << " heap allocations/frame" << std::endl;
+
+  ASSERT_TRUE(count2 - count1 <= 2);
+  ASSERT_TRUE(sum > 0.f);
+}
@@ -5,6 +5,10 @@
 #include "test.hpp"
 
 #include <skland/core/color.hpp>
+#include <skland/core/batch.hpp>
+
+#include <cstdlib>
+#include <vector>
 
 #include "SkColor.h"
 
@@ -95,4 +99,62 @@ TEST_F(Test, cast_1) {
       (sk_color->fG == 1.f) &&
       (sk_color->fB == 1.f) &&
       (sk_color->fA == 1.f));
-}
\ No newline at end of file
+}
+TEST_F(Test, batch_pack_1) {
+  std::vector<ColorF> colors(1031);
+  std::vector<uint32_t> result(colors.size());
+
+  srand(1);
+  for (size_t i = 0; i < colors.size(); ++i) {
+    // Exact steps of 1/255 and arbitrary values
+    if (i % 2)
+      colors[i] = ColorF(rand() % 256 / 255.f, rand() % 256 / 255.f, rand() % 256 / 255.f, rand() % 256 / 255.f);
+    else
+      colors[i] = ColorF(rand() / (float) RAND_MAX, rand() / (float) RAND_MAX,
+                         rand() / (float) RAND_MAX, rand() / (float) RAND_MAX);
+  }
+
+  BatchF::Pack(colors.data(), colors.size(), result.data());
+  for (size_t i = 0; i < colors.size(); ++i) {
+    ASSERT_TRUE(result[i] == colors[i].argb());
+  }
+}
+
+TEST_F(Test, batch_unpack_1) {
+  std::vector<uint32_t> argb(256 * 4 + 3);
+  std::vector<ColorF> result(argb.size());
+
+  // Every value of every channel
+  for (uint32_t i = 0; i < argb.size(); ++i) {
+    argb[i] = (i & 0xFF) << ((i >> 8) * 8 % 32) | 0x12345678 >> (i % 7);
+  }
+
+  BatchF::Unpack(argb.data(), argb.size(), result.data());
+  for (size_t i = 0; i < argb.size(); ++i) {
+    ColorF expect;
+    expect = argb[i];
+    ASSERT_TRUE(result[i] == expect);
+    ASSERT_TRUE(result[i].argb() == argb[i]);
+  }
+}
+
+TEST_F(Test, batch_lerp_1) {
+  std::vector<ColorF> from(67), to(67), result(67), expect(67);
+
+  srand(2);
+  for (size_t i = 0; i < from.size(); ++i) {
+    from[i] = ColorF(rand() / (float) RAND_MAX, rand() / (float) RAND_MAX, rand() / (float) RAND_MAX);
+    to[i] = ColorF(rand() / (float) RAND_MAX, rand() / (float) RAND_MAX, rand() / (float) RAND_MAX, 0.5f);
+  }
+
+  for (float t = 0.f; t <= 1.f; t += 0.125f) {
+    BatchF::Lerp(from.data(), to.data(), t, from.size(), result.data());
+    for (size_t i = 0; i < from.size(); ++i) {
+      expect[i].r = from[i].r + (to[i].r - from[i].r) * t;
+      expect[i].g = from[i].g + (to[i].g - from[i].g) * t;
+      expect[i].b = from[i].b + (to[i].b - from[i].b) * t;
+      expect[i].a = from[i].a + (to[i].a - from[i].a) * t;
+      ASSERT_TRUE(result[i] == expect[i]);
+    }
+  }
+}
@@ -6,6 +6,11 @@
 
 #include <skland/core/compound-deque.hpp>
 
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
 using namespace skland;
 using namespace skland::core;
 
@@ -161,3 +166,92 @@ TEST_F(Test, insert_3) {
   ASSERT_TRUE(item1->_next() == item4);
   ASSERT_TRUE(item4->_next() == nullptr);
 }
+
+/*
+ * Compare index access with a std::vector after random insert/remove
+ */
+TEST_F(Test, index_1) {
+  TestDeque deque;
+  std::vector<Item *> expect;
+
+  srand(1);
+  for (int i = 0; i < 2000; i++) {
+    int op = rand() % 4;
+    if (op == 0 || expect.empty()) {
+      auto item = new Item(i);
+      int index = static_cast<int>(rand() % (expect.size() + 1));
+      deque.Insert(item, index);
+      expect.insert(expect.begin() + index, item);
+    } else if (op == 1) {
+      auto item = new Item(i);
+      deque.PushBack(item);
+      expect.push_back(item);
+    } else if (op == 2) {
+      int index = static_cast<int>(rand() % expect.size());
+      delete expect[index];
+      expect.erase(expect.begin() + index);
+    }
+
+    ASSERT_TRUE(deque.count() == static_cast<int>(expect.size()));
+    int count = static_cast<int>(expect.size());
+    for (int j = 0; j < count; j += 7) {
+      ASSERT_TRUE(deque[j] == expect[j]);
+    }
+    if (count > 0) {
+      ASSERT_TRUE(deque[-1] == expect.back());
+    }
+  }
+
+  ASSERT_TRUE(deque[deque.count()] == nullptr);
+  ASSERT_TRUE(deque[-deque.count() - 1] == nullptr);
+
+  deque.Clear();
+  ASSERT_TRUE(deque.count() == 0);
+  ASSERT_TRUE(deque[0] == nullptr);
+}
+
+/*
+ * Index access on a deque of 10, 1k and 100k elements, compared with walking
+ * the list for each index
+ */
+TEST_F(Test, benchmark_1) {
+  typedef std::chrono::steady_clock Clock;
+
+  const int sizes[] = {10, 1000, 100000};
+
+  for (int size : sizes) {
+    TestDeque deque;
+    for (int i = 0; i < size; i++) deque.PushBack(new Item(i));
+
+    const int rounds = size > 1000 ? 2 : 100000 / size;
+    long sum1 = 0, sum2 = 0;
+
+    Clock::time_point t0 = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (int i = 0; i < size; i++) {
+        sum1 += static_cast<Item *>(deque[i])->id();
+      }
+    }
+    Clock::time_point t1 = Clock::now();
+
+    for (int r = 0; r < rounds; r++) {
+      for (int i = 0; i < size && i < 10000; i++) {
+        CompoundDeque::Iterator it = deque.begin();
+        for (int j = 0; j < i; j++) ++it;
+        sum2 += it.cast<Item>()->id();
+      }
+    }
+    Clock::time_point t2 = Clock::now();
+
+    int walked = size < 10000 ? size : 10000;
+    double indexed = std::chrono::duration<double, std::nano>(t1 - t0).count() / (rounds * size);
+    double linked = std::chrono::duration<double, std::nano>(t2 - t1).count() / (rounds * walked);
+
+    std::cout << "size " << size
+              << ": indexed " << indexed << " ns/access"
+              << ", linked walk " << linked << " ns/access"
+              << std::endl;
+
+    ASSERT_TRUE(sum1 >= sum2);
+  }
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright 2017 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <skland/core/fast-pimpl.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+
+using namespace skland;
+using namespace skland::core;
+
+static size_t kAllocationCount = 0;
+
+void *operator new(size_t size) {
+  kAllocationCount++;
+  void *p = malloc(size);
+  if (nullptr == p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  free(p);
+}
+
+static int kLiveCount = 0;
+
+/**
+ * @brief A value type with in-place private data
+ */
+class FastValue {
+
+ public:
+
+  FastValue();
+
+  explicit FastValue(int value);
+
+  FastValue(const FastValue &other);
+
+  ~FastValue();
+
+  FastValue &operator=(const FastValue &other);
+
+  int GetValue() const;
+
+  void SetValue(int value);
+
+  const void *GetPrivateAddress() const;
+
+ private:
+
+  struct Private;
+
+  FastPimpl<Private, 16, 8> p_;
+
+};
+
+/**
+ * @brief The same value type with heap allocated private data
+ */
+class UniqueValue {
+
+ public:
+
+  UniqueValue();
+
+  ~UniqueValue();
+
+  int GetValue() const;
+
+ private:
+
+  struct Private;
+
+  std::unique_ptr<Private> p_;
+
+};
+
+struct FastValue::Private {
+
+  Private()
+      : value(0), scale(1.0) { kLiveCount++; }
+
+  explicit Private(int v)
+      : value(v), scale(1.0) { kLiveCount++; }
+
+  Private(const Private &other)
+      : value(other.value), scale(other.scale) { kLiveCount++; }
+
+  ~Private() { kLiveCount--; }
+
+  Private &operator=(const Private &other) = default;
+
+  int value;
+
+  double scale;
+
+};
+
+FastValue::FastValue()
+    : p_() {
+}
+
+FastValue::FastValue(int value)
+    : p_(value) {
+}
+
+FastValue::FastValue(const FastValue &other)
+    : p_(*other.p_) {
+}
+
+FastValue::~FastValue() {
+}
+
+FastValue &FastValue::operator=(const FastValue &other) {
+  *p_ = *other.p_;
+  return *this;
+}
+
+int FastValue::GetValue() const {
+  return p_->value;
+}
+
+void FastValue::SetValue(int value) {
+  p_->value = value;
+}
+
+const void *FastValue::GetPrivateAddress() const {
+  return p_.get();
+}
+
+struct UniqueValue::Private {
+
+  Private()
+      : value(0), scale(1.0) {}
+
+  int value;
+
+  double scale;
+
+};
+
+UniqueValue::UniqueValue()
+    : p_(new Private) {
+}
+
+UniqueValue::~UniqueValue() {
+}
+
+int UniqueValue::GetValue() const {
+  return p_->value;
+}
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+TEST_F(Test, construct_1) {
+  {
+    FastValue value1;
+    FastValue value2(2);
+    FastValue value3(value2);
+
+    ASSERT_TRUE(kLiveCount == 3);
+    ASSERT_TRUE(value1.GetValue() == 0);
+    ASSERT_TRUE(value2.GetValue() == 2);
+    ASSERT_TRUE(value3.GetValue() == 2);
+
+    value1 = value3;
+    value3.SetValue(3);
+    ASSERT_TRUE(value1.GetValue() == 2);
+    ASSERT_TRUE(value3.GetValue() == 3);
+  }
+
+  ASSERT_TRUE(kLiveCount == 0);
+}
+
+TEST_F(Test, layout_1) {
+  FastValue value;
+
+  ASSERT_TRUE(sizeof(FastValue) == 16);
+  ASSERT_TRUE(value.GetPrivateAddress() == static_cast<const void *>(&value));
+  ASSERT_TRUE(reinterpret_cast<uintptr_t>(value.GetPrivateAddress()) % 8 == 0);
+}
+
+TEST_F(Test, allocation_1) {
+  size_t count = kAllocationCount;
+  for (int i = 0; i < 100; i++) {
+    FastValue value(i);
+    FastValue copy(value);
+    ASSERT_TRUE(copy.GetValue() == i);
+  }
+  ASSERT_TRUE(kAllocationCount == count);
+
+  for (int i = 0; i < 100; i++) {
+    UniqueValue value;
+    ASSERT_TRUE(value.GetValue() == 0);
+  }
+  ASSERT_TRUE(kAllocationCount == count + 100);
+}
+
+/*
+ * Construct and destroy a value on stack, compared with std::unique_ptr pimpl
+ */
+TEST_F(Test, benchmark_1) {
+  typedef std::chrono::steady_clock Clock;
+  const int count = 1000000;
+  long sum = 0;
+
+  Clock::time_point t0 = Clock::now();
+  for (int i = 0; i < count; i++) {
+    FastValue value(i);
+    sum += value.GetValue();
+  }
+  Clock::time_point t1 = Clock::now();
+  for (int i = 0; i < count; i++) {
+    UniqueValue value;
+    sum += value.GetValue();
+  }
+  Clock::time_point t2 = Clock::now();
+
+  std::cout << "FastPimpl: "
+            << std::chrono::duration<double, std::nano>(t1 - t0).count() / count << " ns"
+            << ", std::unique_ptr: "
+            << std::chrono::duration<double, std::nano>(t2 - t1).count() / count << " ns"
+            << std::endl;
+
+  ASSERT_TRUE(sum > 0);
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/core/memory-stats.hpp>
+#include <skland/core/arena.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace skland;
+using namespace skland::core;
+
+static size_t kProbeValue = 0;
+
+static size_t GetProbeValue() {
+  return kProbeValue;
+}
+
+Test::Test()
+    : testing::Test() {
+  MemoryStats::Reset();
+}
+
+Test::~Test() {
+  MemoryStats::Reset();
+}
+
+TEST_F(Test, add_remove_1) {
+  MemoryStats::Add(MemoryStats::kBitmap, 1000);
+  MemoryStats::Add(MemoryStats::kBitmap, 500);
+  MemoryStats::Remove(MemoryStats::kBitmap, 1000);
+
+  MemoryStats::Usage usage = MemoryStats::GetUsage(MemoryStats::kBitmap);
+  ASSERT_TRUE(usage.current == 500);
+  ASSERT_TRUE(usage.peak == 1500);
+}
+
+TEST_F(Test, total_1) {
+  MemoryStats::Add(MemoryStats::kSharedMemoryPool, 4096);
+  MemoryStats::Add(MemoryStats::kBuffer, 4096);
+  MemoryStats::Add(MemoryStats::kTheme, 100);
+
+  // Buffers are a part of pools
+  ASSERT_TRUE(MemoryStats::GetTotalUsage() == 4196);
+}
+
+TEST_F(Test, owner_1) {
+  int window1 = 0, window2 = 0;
+
+  MemoryStats::SetOwnerName(&window1, "Window 1");
+  MemoryStats::Add(MemoryStats::kSharedMemoryPool, 4096, &window1);
+  MemoryStats::Add(MemoryStats::kBuffer, 4096, &window1);
+  MemoryStats::Add(MemoryStats::kSharedMemoryPool, 8192, &window2);
+  MemoryStats::Remove(MemoryStats::kSharedMemoryPool, 4096, &window1);
+  MemoryStats::Add(MemoryStats::kSharedMemoryPool, 2048, &window1);
+
+  MemoryStats::Usage usage = MemoryStats::GetOwnerUsage(&window1, MemoryStats::kSharedMemoryPool);
+  ASSERT_TRUE(usage.current == 2048);
+  ASSERT_TRUE(usage.peak == 4096);
+  ASSERT_TRUE(MemoryStats::GetOwnerTotalUsage(&window1) == 2048);
+  ASSERT_TRUE(MemoryStats::GetOwnerTotalUsage(&window2) == 8192);
+  ASSERT_TRUE(MemoryStats::GetUsage(MemoryStats::kSharedMemoryPool).current == 10240);
+
+  std::ostringstream out;
+  MemoryStats::Dump(out);
+  ASSERT_TRUE(out.str().find("\"Window 1\": 2048") != std::string::npos);
+
+  // Released owner keeps the bytes in category
+  MemoryStats::ReleaseOwner(&window2);
+  ASSERT_TRUE(MemoryStats::GetOwnerTotalUsage(&window2) == 0);
+  ASSERT_TRUE(MemoryStats::GetUsage(MemoryStats::kSharedMemoryPool).current == 10240);
+  MemoryStats::Remove(MemoryStats::kSharedMemoryPool, 8192, &window2);
+  ASSERT_TRUE(MemoryStats::GetUsage(MemoryStats::kSharedMemoryPool).current == 2048);
+}
+
+TEST_F(Test, probe_1) {
+  MemoryStats::SetProbe(MemoryStats::kGlyphCache, GetProbeValue);
+
+  kProbeValue = 3000;
+  ASSERT_TRUE(MemoryStats::GetUsage(MemoryStats::kGlyphCache).current == 3000);
+
+  kProbeValue = 1000;
+  MemoryStats::Usage usage = MemoryStats::GetUsage(MemoryStats::kGlyphCache);
+  ASSERT_TRUE(usage.current == 1000);
+  ASSERT_TRUE(usage.peak == 3000);
+  ASSERT_TRUE(MemoryStats::GetTotalUsage() == 1000);
+}
+
+TEST_F(Test, budget_1) {
+  MemoryStats::SetBudget(MemoryStats::kImageCache, 1024);
+  MemoryStats::Add(MemoryStats::kImageCache, 1024);
+  ASSERT_FALSE(MemoryStats::IsOverBudget(MemoryStats::kImageCache));
+
+  MemoryStats::Add(MemoryStats::kImageCache, 1);
+  ASSERT_TRUE(MemoryStats::IsOverBudget(MemoryStats::kImageCache));
+
+  std::ostringstream out;
+  MemoryStats::Dump(out);
+  ASSERT_TRUE(out.str().find("over budget") != std::string::npos);
+}
+
+TEST_F(Test, arena_1) {
+  {
+    Arena arena(1024);
+    arena.Allocate(100);
+    ASSERT_TRUE(MemoryStats::GetUsage(MemoryStats::kArena).current == arena.GetCapacity());
+  }
+
+  ASSERT_TRUE(MemoryStats::GetUsage(MemoryStats::kArena).current == 0);
+}
+
+TEST_F(Test, threads_1) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.push_back(std::thread([]() {
+      for (int j = 0; j < 10000; j++) {
+        MemoryStats::Add(MemoryStats::kOther, 16);
+        MemoryStats::Remove(MemoryStats::kOther, 16);
+      }
+    }));
+  }
+  for (std::thread &thread : threads) thread.join();
+
+  MemoryStats::Usage usage = MemoryStats::GetUsage(MemoryStats::kOther);
+  ASSERT_TRUE(usage.current == 0);
+  ASSERT_TRUE(usage.peak >= 16 && usage.peak <= 64);
+}
+
+TEST_F(Test, periodic_dump_1) {
+  const char *filename = "memory-stats-dump.txt";
+  remove(filename);
+
+  MemoryStats::Add(MemoryStats::kBitmap, 4096);
+  ASSERT_TRUE(MemoryStats::StartPeriodicDump(10, filename));
+  ASSERT_FALSE(MemoryStats::StartPeriodicDump(10, filename));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  MemoryStats::StopPeriodicDump();
+
+  std::ifstream file(filename);
+  std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  ASSERT_TRUE(content.find("bitmap") != std::string::npos);
+
+  remove(filename);
+}
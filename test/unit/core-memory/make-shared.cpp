@@ -0,0 +1,151 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "make-shared.hpp"
+
+#include "skland/core/memory.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace skland;
+using namespace skland::core;
+
+static std::atomic<size_t> kAllocationCount(0);
+
+static std::atomic<size_t> kDeallocationCount(0);
+
+void *operator new(size_t size) {
+  kAllocationCount++;
+  void *p = malloc(size);
+  if (nullptr == p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  if (nullptr != p) kDeallocationCount++;
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  operator delete(p);
+}
+
+template<typename Base>
+class Node : public Base {
+
+ public:
+
+  explicit Node(int value)
+      : value_(value) {
+    kLiveCount++;
+  }
+
+  virtual ~Node() {
+    kLiveCount--;
+  }
+
+  int value() const { return value_; }
+
+  static int kLiveCount;
+
+ private:
+
+  int value_;
+
+};
+
+template<typename Base>
+int Node<Base>::kLiveCount = 0;
+
+typedef Node<SPCountedBase> AtomicNode;
+typedef Node<PlainSPCountedBase> PlainNode;
+
+MakeSharedTest::MakeSharedTest() {
+
+}
+
+MakeSharedTest::~MakeSharedTest() {
+
+}
+
+TEST_F(MakeSharedTest, allocation_1) {
+  size_t count = kAllocationCount;
+  {
+    SharedPtr<AtomicNode> ptr = MakeShared<AtomicNode>(1);
+    ASSERT_TRUE(kAllocationCount - count == 1);
+    ASSERT_TRUE(ptr->value() == 1 && ptr.use_count() == 1);
+  }
+  ASSERT_TRUE(AtomicNode::kLiveCount == 0);
+
+  count = kAllocationCount;
+  {
+    SharedPtr<AtomicNode> ptr(new AtomicNode(2));
+    ASSERT_TRUE(kAllocationCount - count == 2);
+  }
+  ASSERT_TRUE(AtomicNode::kLiveCount == 0);
+}
+
+TEST_F(MakeSharedTest, not_shared_1) {
+  // The counter is only created when the object is shared
+  size_t count = kAllocationCount;
+  AtomicNode *node = new AtomicNode(1);
+  ASSERT_TRUE(kAllocationCount - count == 1);
+  ASSERT_TRUE(node->use_count() == 0 && node->weak_count() == 0);
+  delete node;
+}
+
+TEST_F(MakeSharedTest, weak_ptr_1) {
+  size_t count = kDeallocationCount;
+  WeakPtr<AtomicNode> weak_ptr;
+  {
+    SharedPtr<AtomicNode> ptr = MakeShared<AtomicNode>(1);
+    weak_ptr = ptr;
+    ASSERT_TRUE(weak_ptr.Lock()->value() == 1);
+  }
+
+  // The object is destroyed but the memory block is kept for the weak pointer
+  ASSERT_TRUE(AtomicNode::kLiveCount == 0);
+  ASSERT_TRUE(kDeallocationCount == count);
+  ASSERT_TRUE(!weak_ptr.Lock());
+
+  weak_ptr.Reset();
+  ASSERT_TRUE(kDeallocationCount - count == 1);
+}
+
+TEST_F(MakeSharedTest, plain_1) {
+  SharedPtr<PlainNode> ptr1 = MakeShared<PlainNode>(1);
+  SharedPtr<PlainNode> ptr2 = ptr1;
+  WeakPtr<PlainNode> weak_ptr(ptr2);
+
+  ASSERT_TRUE(ptr1.use_count() == 2 && ptr1.weak_count() == 1);
+
+  ptr1.Reset();
+  ptr2 = MakeShared<PlainNode>(2);
+  ASSERT_TRUE(PlainNode::kLiveCount == 1);
+  ASSERT_TRUE(!weak_ptr.Lock());
+}
+
+TEST_F(MakeSharedTest, move_assignment_1) {
+  SharedPtr<PlainNode> ptr1 = MakeShared<PlainNode>(1);
+  SharedPtr<PlainNode> ptr2 = MakeShared<PlainNode>(2);
+
+  ptr1 = std::move(ptr2);
+  ASSERT_TRUE(PlainNode::kLiveCount == 1);
+  ASSERT_TRUE(ptr1->value() == 2 && !ptr2);
+}
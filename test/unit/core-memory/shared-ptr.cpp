@@ -18,6 +18,12 @@
 
 #include "skland/core/memory.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
 using namespace skland;
 using namespace skland::core;
 
@@ -35,6 +41,44 @@ class RefObject : public SPCountedBase {
 
 };
 
+/**
+ * @brief A shared object used in benchmark
+ */
+template<typename Base>
+class CountedValue : public Base {
+
+ public:
+
+  explicit CountedValue(int value)
+      : value_(value) {}
+
+  virtual ~CountedValue() {}
+
+  int value() const { return value_; }
+
+ private:
+
+  int value_;
+
+};
+
+typedef CountedValue<SPCountedBase> AtomicValue;
+typedef CountedValue<PlainSPCountedBase> PlainValue;
+
+/**
+ * @brief A plain struct compared with std::shared_ptr
+ */
+struct Value {
+
+  explicit Value(int v)
+      : value_(v) {}
+
+  int value() const { return value_; }
+
+  int value_;
+
+};
+
 SharedPtrTest::SharedPtrTest() {
 
 }
@@ -135,3 +179,86 @@ TEST_F(SharedPtrTest, unique_1) {
 
   ASSERT_TRUE(shared_ptr1.IsUnique());
 }
+
+TEST_F(SharedPtrTest, concurrent_construct_1) {
+  const int loops = 1000;
+  const int threads = 4;
+
+  // Wrap the same raw pointer in several threads, all SharedPtrs must use the
+  // same counter
+  for (int i = 0; i < loops; ++i) {
+    AtomicValue *obj = new AtomicValue(i);
+    std::atomic_bool start(false);
+    std::vector<SharedPtr<AtomicValue> > ptrs(threads);
+    std::vector<std::thread> workers;
+
+    for (int j = 0; j < threads; ++j) {
+      workers.push_back(std::thread([obj, &start, &ptrs, j]() {
+        while (!start) std::this_thread::yield();
+        ptrs[j].Reset(obj);
+      }));
+    }
+    start = true;
+    for (std::thread &worker : workers) worker.join();
+
+    ASSERT_TRUE(obj->use_count() == threads);
+  }
+}
+
+/**
+ * @brief Create, copy and destroy shared objects in a loop
+ */
+template<typename Ptr, typename Make>
+static long RunBenchmark(Make make, int loops, int copies) {
+  typedef std::chrono::steady_clock Clock;
+  long sum = 0;
+
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < loops; ++i) {
+    Ptr ptr = make(i);
+    for (int j = 0; j < copies; ++j) {
+      Ptr copy = ptr;
+      sum += copy->value();
+    }
+  }
+  long us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+  EXPECT_TRUE(sum > 0);
+  return us;
+}
+
+TEST_F(SharedPtrTest, benchmark_1) {
+  const int loops = 1000000;
+  const int copies = 8;
+
+  // libstdc++ uses plain counters in std::shared_ptr until a thread is
+  // created, start one to compare with the atomic counters
+  std::thread([]() {}).join();
+
+  long new_atomic = RunBenchmark<SharedPtr<AtomicValue> >([](int i) {
+    return SharedPtr<AtomicValue>(new AtomicValue(i + 1));
+  }, loops, copies);
+
+  long make_atomic = RunBenchmark<SharedPtr<AtomicValue> >([](int i) {
+    return MakeShared<AtomicValue>(i + 1);
+  }, loops, copies);
+
+  long make_plain = RunBenchmark<SharedPtr<PlainValue> >([](int i) {
+    return MakeShared<PlainValue>(i + 1);
+  }, loops, copies);
+
+  long std_new = RunBenchmark<std::shared_ptr<Value> >([](int i) {
+    return std::shared_ptr<Value>(new Value(i + 1));
+  }, loops, copies);
+
+  long std_make = RunBenchmark<std::shared_ptr<Value> >([](int i) {
+    return std::make_shared<Value>(i + 1);
+  }, loops, copies);
+
+  std::cout << loops << " objects, " << copies << " copies each:" << std::endl
+            << "  SharedPtr(new), atomic: " << new_atomic << " us" << std::endl
+            << "  MakeShared, atomic: " << make_atomic << " us" << std::endl
+            << "  MakeShared, plain: " << make_plain << " us" << std::endl
+            << "  std::shared_ptr(new): " << std_new << " us" << std::endl
+            << "  std::make_shared: " << std_make << " us" << std::endl;
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/core/mpsc-queue.hpp>
+
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace skland;
+using namespace skland::core;
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+class Item : public MPSCNode {
+
+ public:
+
+  Item() = default;
+
+  Item(int producer, int id)
+      : producer_(producer), id_(id) {}
+
+  virtual ~Item() = default;
+
+  int producer() const { return producer_; }
+
+  int id() const { return id_; }
+
+  void Set(int producer, int id) {
+    producer_ = producer;
+    id_ = id;
+  }
+
+ private:
+
+  int producer_ = 0;
+
+  int id_ = 0;
+
+};
+
+TEST_F(Test, push_pop_1) {
+  MPSCQueue<Item> queue;
+  Item item1(0, 1);
+  Item item2(0, 2);
+  Item item3(0, 3);
+
+  ASSERT_TRUE(queue.IsEmpty());
+  ASSERT_TRUE(queue.Pop() == nullptr);
+
+  queue.Push(&item1);
+  queue.Push(&item2);
+  ASSERT_TRUE(!queue.IsEmpty());
+  ASSERT_TRUE(queue.Pop() == &item1);
+
+  queue.Push(&item3);
+  ASSERT_TRUE(queue.Pop() == &item2);
+  ASSERT_TRUE(queue.Pop() == &item3);
+  ASSERT_TRUE(queue.Pop() == nullptr);
+  ASSERT_TRUE(queue.IsEmpty());
+
+  // Nodes can be pushed again after popped
+  queue.Push(&item1);
+  ASSERT_TRUE(queue.Pop() == &item1);
+  ASSERT_TRUE(queue.IsEmpty());
+}
+
+TEST_F(Test, multi_producers_1) {
+  const int producers = 4;
+  const int count = 20000;
+
+  MPSCQueue<Item> queue;
+  std::vector<std::unique_ptr<Item[]> > items;
+  for (int i = 0; i < producers; ++i) {
+    items.push_back(std::unique_ptr<Item[]>(new Item[count]));
+  }
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < producers; ++i) {
+    Item *array = items[i].get();
+    threads.push_back(std::thread([&queue, array, i, count]() {
+      for (int j = 0; j < count; ++j) {
+        array[j].Set(i, j);
+        queue.Push(&array[j]);
+      }
+    }));
+  }
+
+  // Nodes from the same producer come out in order
+  std::vector<int> next_ids(producers, 0);
+  int popped = 0;
+  while (popped < producers * count) {
+    Item *item = queue.Pop();
+    if (nullptr == item) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_TRUE(item->id() == next_ids[item->producer()]);
+    next_ids[item->producer()]++;
+    popped++;
+  }
+
+  for (auto &thread : threads) thread.join();
+
+  ASSERT_TRUE(queue.IsEmpty());
+  for (int i = 0; i < producers; ++i) {
+    ASSERT_TRUE(next_ids[i] == count);
+  }
+}
+
+/**
+ * @brief Push preallocated items in producer threads and pop all of them
+ * @return The time in microseconds
+ */
+template<typename Push, typename Pop>
+static long RunBenchmark(int producers, int count, Push push, Pop pop) {
+  typedef std::chrono::steady_clock Clock;
+
+  std::vector<std::unique_ptr<Item[]> > items;
+  for (int i = 0; i < producers; ++i) {
+    items.push_back(std::unique_ptr<Item[]>(new Item[count]));
+  }
+
+  Clock::time_point start = Clock::now();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < producers; ++i) {
+    Item *array = items[i].get();
+    threads.push_back(std::thread([&push, array, count]() {
+      for (int j = 0; j < count; ++j) push(&array[j]);
+    }));
+  }
+
+  int popped = 0;
+  while (popped < producers * count) {
+    if (pop()) popped++;
+  }
+
+  long us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+  for (auto &thread : threads) thread.join();
+  return us;
+}
+
+TEST_F(Test, benchmark_1) {
+  const int total = 2000000;
+  const int producer_counts[] = {1, 2, 4};
+
+  for (int producers : producer_counts) {
+    int count = total / producers;
+
+    MPSCQueue<Item> queue;
+    long lock_free = RunBenchmark(producers, count, [&queue](Item *item) {
+      queue.Push(item);
+    }, [&queue]() {
+      return nullptr != queue.Pop();
+    });
+    ASSERT_TRUE(queue.IsEmpty());
+
+    std::mutex mutex;
+    std::deque<Item *> deque;
+    long locked = RunBenchmark(producers, count, [&mutex, &deque](Item *item) {
+      std::lock_guard<std::mutex> lock(mutex);
+      deque.push_back(item);
+    }, [&mutex, &deque]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (deque.empty()) return false;
+      deque.pop_front();
+      return true;
+    });
+
+    int ops = count * producers;
+    std::cout << producers << " producers, " << ops << " items, MPSCQueue: "
+              << lock_free << " us (" << (lock_free > 0 ? (long long) ops * 1000000 / lock_free : 0)
+              << " ops/s), mutex + std::deque: "
+              << locked << " us (" << (locked > 0 ? (long long) ops * 1000000 / locked : 0)
+              << " ops/s)" << std::endl;
+  }
+}
@@ -6,6 +6,9 @@
 
 #include <skland/core/object.hpp>
 
+#include <cstdlib>
+#include <vector>
+
 using namespace skland;
 
 class TestableObject : public Object {
@@ -32,6 +35,24 @@ class TestableObject : public Object {
 
   inline Object *get_last_child() const { return last_child(); }
 
+  inline Object *get_child_at(int index) const { return GetChildAt(index); }
+
+  inline Object *remove_child(TestableObject *obj) { return RemoveChild(obj); }
+
+  static inline void swap_index(TestableObject *obj1, TestableObject *obj2) { SwapIndex(obj1, obj2); }
+
+  static inline void move_to_first(TestableObject *obj) { MoveToFirst(obj); }
+
+  static inline void move_to_last(TestableObject *obj) { MoveToLast(obj); }
+
+  static inline void move_forward(TestableObject *obj) { MoveForward(obj); }
+
+  static inline void move_backward(TestableObject *obj) { MoveBackward(obj); }
+
+  static inline void insert_sibling_before(TestableObject *src, TestableObject *dst) {
+    InsertSiblingBefore(src, dst);
+  }
+
 };
 
 TestableSubject::~TestableSubject() {
@@ -261,4 +282,70 @@ TEST_F(Test, clear_managed_objects_1) {
   manager.ClearSubjects();
 
   ASSERT_TRUE(manager.subjects_count() == 0);
-}
\ No newline at end of file
+}
+/*
+ * Check GetChildAt() against the linked list after random changes
+ */
+TEST_F(Test, get_child_at_1) {
+  TestableObject parent;
+  std::vector<TestableObject *> children;
+
+  srand(1);
+  for (int i = 0; i < 3000; i++) {
+    int count = static_cast<int>(children.size());
+    TestableObject *obj = count > 0 ? children[rand() % count] : nullptr;
+    TestableObject *obj2 = count > 0 ? children[rand() % count] : nullptr;
+
+    switch (count > 0 ? rand() % 10 : 0) {
+      case 0:
+      case 1: {
+        TestableObject *child = new TestableObject;
+        parent.insert_child(child, count > 0 ? rand() % (count + 1) : 0);
+        children.push_back(child);
+        break;
+      }
+      case 2: {
+        TestableObject *child = new TestableObject;
+        parent.push_back_child(child);
+        children.push_back(child);
+        break;
+      }
+      case 3: {
+        parent.remove_child(obj);
+        for (auto it = children.begin(); it != children.end(); ++it) {
+          if (*it == obj) {
+            children.erase(it);
+            break;
+          }
+        }
+        delete obj;
+        break;
+      }
+      case 4: TestableObject::swap_index(obj, obj2);
+        break;
+      case 5: TestableObject::move_to_first(obj);
+        break;
+      case 6: TestableObject::move_to_last(obj);
+        break;
+      case 7: TestableObject::move_forward(obj);
+        break;
+      case 8: TestableObject::move_backward(obj);
+        break;
+      default: TestableObject::insert_sibling_before(obj, obj2);
+        break;
+    }
+
+    count = static_cast<int>(children.size());
+    ASSERT_TRUE(parent.get_children_count() == children.size());
+
+    Object *expect = parent.get_first_child();
+    for (int j = 0; j < count; j++) {
+      ASSERT_TRUE(parent.get_child_at(j) == expect);
+      expect = static_cast<TestableObject *>(expect)->get_next();
+    }
+    if (count > 0) {
+      ASSERT_TRUE(parent.get_child_at(-1) == parent.get_last_child());
+    }
+    ASSERT_TRUE(parent.get_child_at(count) == nullptr);
+  }
+}
@@ -5,12 +5,31 @@
 #include "test.hpp"
 
 #include <skland/core/rect.hpp>
+#include <skland/core/batch.hpp>
+
+#include <cstdlib>
+#include <vector>
 
 #include "SkRect.h"
 
 using namespace skland;
 using namespace skland::core;
 
+/**
+ * @brief Random rects with small coordinates so many of them intersect, some are empty
+ */
+template<typename T>
+static std::vector<Rect<T> > MakeRandomRects(size_t count) {
+  std::vector<Rect<T> > rects(count);
+  srand(1);
+  for (size_t i = 0; i < count; ++i) {
+    T x = T(rand() % 200 - 50);
+    T y = T(rand() % 200 - 50);
+    rects[i] = Rect<T>::MakeFromXYWH(x, y, T(rand() % 60 - 5), T(rand() % 60 - 5));
+  }
+  return rects;
+}
+
 Test::Test()
     : testing::Test() {
 }
@@ -133,4 +152,64 @@ TEST_F(Test, cast_1) {
   SkRect* sk_rect = reinterpret_cast<SkRect*>(&r);
 
   ASSERT_TRUE(r.l == sk_rect->fLeft && r.r == sk_rect->fRight && r.t == sk_rect->fTop && r.b == sk_rect->fBottom);
-}
\ No newline at end of file
+}
+
+TEST_F(Test, batch_intersect_1) {
+  std::vector<RectF> rects = MakeRandomRects<float>(1027);
+  std::vector<RectI> rects_i(rects.begin(), rects.end());
+  bool results[1027];
+  RectF rect(20.f, 20.f, 80.f, 70.f);
+
+  size_t count = BatchF::Intersect(rect, rects.data(), rects.size(), results);
+  size_t expect = 0;
+  for (size_t i = 0; i < rects.size(); ++i) {
+    ASSERT_TRUE(results[i] == rect.Intersect(rects[i]));
+    expect += results[i];
+  }
+  ASSERT_TRUE(count == expect && count > 0);
+
+  count = BatchI::Intersect(RectI(rect), rects_i.data(), rects_i.size(), results);
+  ASSERT_TRUE(count == expect);
+  for (size_t i = 0; i < rects.size(); ++i) {
+    ASSERT_TRUE(results[i] == RectI(rect).Intersect(rects_i[i]));
+  }
+
+  ASSERT_TRUE(BatchF::Intersect(RectF(), rects.data(), rects.size(), results) == 0);
+}
+
+TEST_F(Test, batch_contain_1) {
+  std::vector<RectF> rects = MakeRandomRects<float>(1025);
+  std::vector<RectI> rects_i(rects.begin(), rects.end());
+  bool results[1025];
+
+  for (int y = 0; y < 100; y += 7) {
+    for (int x = 0; x < 100; x += 7) {
+      size_t count = BatchF::Contain(rects.data(), rects.size(), (float) x, (float) y, results);
+      size_t expect = 0;
+      for (size_t i = 0; i < rects.size(); ++i) {
+        ASSERT_TRUE(results[i] == rects[i].Contain((float) x, (float) y));
+        expect += results[i];
+      }
+      ASSERT_TRUE(count == expect);
+
+      count = BatchI::Contain(rects_i.data(), rects_i.size(), x, y, results);
+      ASSERT_TRUE(count == expect);
+    }
+  }
+}
+
+TEST_F(Test, batch_union_1) {
+  for (size_t n = 0; n < 40; ++n) {
+    std::vector<RectF> rects = MakeRandomRects<float>(n);
+    std::vector<RectI> rects_i(rects.begin(), rects.end());
+
+    std::vector<RectD> rects_d(rects.begin(), rects.end());
+
+    // The generic template is the scalar reference
+    ASSERT_TRUE(BatchF::Union(rects.data(), n) == RectF(Batch<double>::Union(rects_d.data(), n)));
+    ASSERT_TRUE(BatchI::Union(rects_i.data(), n) == RectI(BatchF::Union(rects.data(), n)));
+  }
+
+  RectF empty[] = {RectF(), RectF(5.f, 5.f, 5.f, 10.f)};
+  ASSERT_TRUE(BatchF::Union(empty, 2) == RectF());
+}
@@ -0,0 +1,282 @@
+//
+// Created by zhanggyb on 17-9-20.
+//
+
+#include "queued-signal-test.hpp"
+
+#include <skland/core/sigcxx.hpp>
+
+#include <poll.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace skland;
+using namespace skland::core;
+
+/**
+ * @brief An observer recording queued calls
+ */
+class Receiver : public Trackable {
+
+ public:
+
+  Receiver() = default;
+
+  ~Receiver() final = default;
+
+  void OnValue(int value, SLOT slot) {
+    count_++;
+    sum_ += value;
+    thread_id_ = std::this_thread::get_id();
+  }
+
+  void OnText(const std::string &text, SLOT slot) {
+    count_++;
+    text_ += text;
+  }
+
+  void OnUnbind(int value, SLOT slot) {
+    count_++;
+    UnbindSignal(slot);
+  }
+
+  int count() const { return count_; }
+
+  long sum() const { return sum_; }
+
+  const std::string &text() const { return text_; }
+
+  const std::thread::id &thread_id() const { return thread_id_; }
+
+ private:
+
+  int count_ = 0;
+
+  long sum_ = 0;
+
+  std::string text_;
+
+  std::thread::id thread_id_;
+
+};
+
+/**
+ * @brief Dispatch the queue like an event loop until enough calls are received
+ */
+static void RunUntil(SignalQueue *queue, const Receiver &receiver, int count) {
+  struct pollfd fds;
+  fds.fd = queue->GetFd();
+  fds.events = POLLIN;
+
+  while (receiver.count() < count) {
+    if (poll(&fds, 1, 1000) <= 0) break;
+    queue->Dispatch();
+  }
+}
+
+TEST_F(QueuedSignalTest, queued_1) {
+  SignalQueue queue;
+  Receiver receiver;
+  Signal<int> signal;
+
+  signal.ConnectQueued(&receiver, &Receiver::OnValue, &queue);
+  ASSERT_TRUE(signal.IsConnectedTo(&receiver, &Receiver::OnValue));
+
+  signal.Emit(1);
+  signal.Emit(2);
+  ASSERT_TRUE(receiver.count() == 0);
+
+  ASSERT_TRUE(queue.Dispatch() == 2);
+  ASSERT_TRUE(receiver.count() == 2);
+  ASSERT_TRUE(receiver.sum() == 3);
+  ASSERT_TRUE(queue.Dispatch() == 0);
+}
+
+TEST_F(QueuedSignalTest, copy_arguments_1) {
+  SignalQueue queue;
+  Receiver receiver;
+  Signal<const std::string &> signal;
+
+  signal.ConnectQueued(&receiver, &Receiver::OnText, &queue);
+
+  {
+    std::string text("hello");
+    signal.Emit(text);
+    text = "world";
+    signal.Emit(text);
+  }
+
+  queue.Dispatch();
+  ASSERT_TRUE(receiver.text() == "helloworld");
+}
+
+TEST_F(QueuedSignalTest, thread_1) {
+  SignalQueue queue;
+  Receiver receiver;
+  Signal<int> signal;
+  const int loops = 10000;
+
+  signal.ConnectQueued(&receiver, &Receiver::OnValue, &queue);
+
+  std::thread emitter([&signal, loops]() {
+    for (int i = 0; i < loops; ++i) signal.Emit(i);
+  });
+
+  RunUntil(&queue, receiver, loops);
+  emitter.join();
+
+  long expected = 0;
+  for (int i = 0; i < loops; ++i) expected += i;
+
+  ASSERT_TRUE(receiver.count() == loops);
+  ASSERT_TRUE(receiver.sum() == expected);
+  ASSERT_TRUE(receiver.thread_id() == std::this_thread::get_id());
+}
+
+TEST_F(QueuedSignalTest, destroyed_receiver_1) {
+  SignalQueue queue;
+  Signal<int> signal;
+  Receiver *receiver = new Receiver;
+
+  signal.ConnectQueued(receiver, &Receiver::OnValue, &queue);
+
+  std::thread emitter([&signal]() {
+    for (int i = 0; i < 100; ++i) signal.Emit(i);
+  });
+  emitter.join();
+
+  delete receiver;
+  ASSERT_TRUE(signal.CountConnections() == 0);
+
+  // Pending calls are dropped
+  ASSERT_TRUE(queue.Dispatch() == 100);
+}
+
+TEST_F(QueuedSignalTest, destroyed_receiver_2) {
+  SignalQueue queue;
+  Signal<int> signal;
+  Receiver *receiver = new Receiver;
+  std::atomic<int> emitted(0);
+  std::atomic<bool> stop(false);
+
+  signal.ConnectQueued(receiver, &Receiver::OnValue, &queue);
+
+  std::thread emitter([&signal, &emitted, &stop]() {
+    while (!stop) {
+      signal.Emit(1);
+      emitted++;
+    }
+  });
+
+  // Delete the receiver while the other thread is still emitting
+  while (emitted < 1000) std::this_thread::yield();
+  RunUntil(&queue, *receiver, 100);
+  delete receiver;
+  ASSERT_TRUE(signal.CountConnections() == 0);
+
+  int last = emitted;
+  while (emitted < last + 1000) std::this_thread::yield();
+  stop = true;
+  emitter.join();
+
+  // The calls posted before the receiver was deleted are dropped
+  queue.Dispatch();
+  ASSERT_TRUE(queue.Dispatch() == 0);
+}
+
+TEST_F(QueuedSignalTest, unbind_1) {
+  SignalQueue queue;
+  Receiver receiver;
+  Signal<int> signal;
+
+  signal.ConnectQueued(&receiver, &Receiver::OnUnbind, &queue);
+  signal.Emit(1);
+  signal.Emit(2);
+
+  // The first call disconnects, the second one is dropped
+  queue.Dispatch();
+  ASSERT_TRUE(receiver.count() == 1);
+  ASSERT_TRUE(signal.CountConnections() == 0);
+}
+
+TEST_F(QueuedSignalTest, disconnect_1) {
+  SignalQueue queue;
+  Receiver receiver;
+  Signal<int> signal;
+
+  signal.ConnectQueued(&receiver, &Receiver::OnValue, &queue);
+  signal.Emit(1);
+
+  ASSERT_TRUE(signal.Disconnect(&receiver, &Receiver::OnValue) == 1);
+  queue.Dispatch();
+  ASSERT_TRUE(receiver.count() == 0);
+}
+
+TEST_F(QueuedSignalTest, current_queue_1) {
+  Receiver receiver;
+  Signal<int> signal;
+
+  // No queue in this thread, call directly
+  ASSERT_TRUE(SignalQueue::GetCurrent() == nullptr);
+  signal.ConnectQueued(&receiver, &Receiver::OnValue);
+  signal.Emit(1);
+  ASSERT_TRUE(receiver.count() == 1);
+  signal.DisconnectAll();
+
+  SignalQueue queue;
+  SignalQueue::SetCurrent(&queue);
+  signal.ConnectQueued(&receiver, &Receiver::OnValue);
+  signal.Emit(1);
+  ASSERT_TRUE(receiver.count() == 1);
+  queue.Dispatch();
+  ASSERT_TRUE(receiver.count() == 2);
+  SignalQueue::SetCurrent(nullptr);
+}
+
+TEST_F(QueuedSignalTest, benchmark_1) {
+  typedef std::chrono::steady_clock Clock;
+  const int total = 1000000;
+  const int thread_counts[] = {1, 2, 4};
+
+  for (int threads : thread_counts) {
+    SignalQueue queue;
+    Receiver receiver;
+    // Only one thread emits a signal (see Signal::ConnectQueued()), each thread
+    // has its own
+    std::vector<std::unique_ptr<Signal<int> > > signals;
+    for (int i = 0; i < threads; ++i) {
+      signals.push_back(std::unique_ptr<Signal<int> >(new Signal<int>));
+      signals.back()->ConnectQueued(&receiver, &Receiver::OnValue, &queue);
+    }
+
+    int loops = total / threads;
+
+    Clock::time_point start = Clock::now();
+    std::vector<std::thread> emitters;
+    for (int i = 0; i < threads; ++i) {
+      Signal<int> *signal = signals[i].get();
+      emitters.push_back(std::thread([signal, loops]() {
+        for (int j = 0; j < loops; ++j) signal->Emit(1);
+      }));
+    }
+
+    RunUntil(&queue, receiver, loops * threads);
+    Clock::duration duration = Clock::now() - start;
+
+    for (auto &emitter : emitters) emitter.join();
+
+    ASSERT_TRUE(receiver.count() == loops * threads);
+    ASSERT_TRUE(receiver.sum() == loops * threads);
+
+    long us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    std::cout << threads << " emitting threads, " << loops * threads << " queued emits: "
+              << us << " us, " << (us > 0 ? (long long) loops * threads * 1000000 / us : 0)
+              << " emits/s" << std::endl;
+  }
+}
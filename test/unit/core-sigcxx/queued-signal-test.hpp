@@ -0,0 +1,26 @@
+//
+// Created by zhanggyb on 17-9-20.
+//
+
+#ifndef SKLAND_TEST_CORE_SIGCXX_QUEUED_SIGNAL_TEST_HPP_
+#define SKLAND_TEST_CORE_SIGCXX_QUEUED_SIGNAL_TEST_HPP_
+
+#include <gtest/gtest.h>
+
+class QueuedSignalTest : public testing::Test {
+
+ public:
+
+  QueuedSignalTest() {}
+
+  virtual ~QueuedSignalTest() {}
+
+ protected:
+
+  virtual void SetUp() {}
+
+  virtual void TearDown() {}
+
+};
+
+#endif // SKLAND_TEST_CORE_SIGCXX_QUEUED_SIGNAL_TEST_HPP_
@@ -0,0 +1,158 @@
+//
+// Created by zhanggyb on 17-9-19.
+//
+
+#include "signal-test.hpp"
+
+#include <skland/core/sigcxx.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace skland;
+using namespace skland::core;
+
+/**
+ * @brief An observer counting calls and changing connections in slots
+ */
+class Counter : public Trackable {
+
+ public:
+
+  Counter() = default;
+
+  ~Counter() final = default;
+
+  void OnCount(int value, SLOT slot) {
+    count_++;
+    sum_ += value;
+  }
+
+  void OnUnbind(int, SLOT slot) {
+    count_++;
+    UnbindSignal(slot);
+  }
+
+  void OnUnbindNext(int, SLOT slot) {
+    count_++;
+    if (next_) next_->UnbindAllSignals();
+  }
+
+  void OnEmitAgain(int value, SLOT slot) {
+    count_++;
+    if (value > 0) slot->signal<int>()->Emit(value - 1);
+  }
+
+  void OnDeleteSignal(int, SLOT slot) {
+    count_++;
+    signal_.reset();
+  }
+
+  void set_next(Counter *next) { next_ = next; }
+
+  int count() const { return count_; }
+
+  long sum() const { return sum_; }
+
+  std::unique_ptr<Signal<int> > signal_;
+
+ private:
+
+  int count_ = 0;
+
+  long sum_ = 0;
+
+  Counter *next_ = nullptr;
+
+};
+
+TEST_F(SignalTest, emit_empty_1) {
+  Signal<int> signal;
+  signal.Emit(1);
+  ASSERT_TRUE(signal.CountConnections() == 0);
+}
+
+TEST_F(SignalTest, disconnect_next_1) {
+  Signal<int> signal;
+  Counter counter1, counter2, counter3;
+
+  counter1.set_next(&counter2);
+  signal.Connect(&counter1, &Counter::OnUnbindNext);
+  signal.Connect(&counter2, &Counter::OnCount);
+  signal.Connect(&counter3, &Counter::OnCount);
+
+  signal.Emit(1);
+
+  ASSERT_TRUE(counter1.count() == 1);
+  ASSERT_TRUE(counter2.count() == 0);
+  ASSERT_TRUE(counter3.count() == 1);
+  ASSERT_TRUE(signal.CountConnections() == 2);
+}
+
+TEST_F(SignalTest, disconnect_self_1) {
+  Signal<int> signal;
+  Counter counter1, counter2, counter3;
+
+  signal.Connect(&counter1, &Counter::OnUnbind);
+  signal.Connect(&counter2, &Counter::OnUnbind);
+  signal.Connect(&counter3, &Counter::OnCount);
+
+  signal.Emit(1);
+  signal.Emit(1);
+
+  ASSERT_TRUE(counter1.count() == 1);
+  ASSERT_TRUE(counter2.count() == 1);
+  ASSERT_TRUE(counter3.count() == 2);
+  ASSERT_TRUE(signal.CountConnections() == 1);
+}
+
+/*
+ * Emit the same signal in a slot, and disconnect during the nested emission
+ */
+TEST_F(SignalTest, nested_emit_1) {
+  Signal<int> signal;
+  Counter counter1, counter2, counter3;
+
+  signal.Connect(&counter1, &Counter::OnEmitAgain);
+  signal.Connect(&counter2, &Counter::OnUnbind);
+  signal.Connect(&counter3, &Counter::OnCount);
+
+  signal.Emit(2);
+
+  // 3 nested emissions, counter2 is disconnected in the innermost one
+  ASSERT_TRUE(counter1.count() == 3);
+  ASSERT_TRUE(counter2.count() == 1);
+  ASSERT_TRUE(counter3.count() == 3);
+  ASSERT_TRUE(signal.CountConnections() == 2);
+}
+
+/*
+ * Destroy the signal in a slot
+ */
+TEST_F(SignalTest, delete_signal_1) {
+  Counter counter1, counter2, counter3;
+
+  counter1.signal_.reset(new Signal<int>);
+  counter1.signal_->Connect(&counter2, &Counter::OnCount);
+  counter1.signal_->Connect(&counter1, &Counter::OnDeleteSignal);
+  counter1.signal_->Connect(&counter3, &Counter::OnCount);
+
+  counter1.signal_->Emit(1);
+
+  ASSERT_TRUE(!counter1.signal_);
+  ASSERT_TRUE(counter2.count() == 1);
+  ASSERT_TRUE(counter3.count() == 0);
+  ASSERT_TRUE(counter3.CountSignalBindings() == 0);
+}
+
+TEST_F(SignalTest, chain_1) {
+  Signal<int> signal1;
+  Signal<int> signal2;
+  Counter counter;
+
+  signal1.Connect(signal2);
+  signal2.Connect(&counter, &Counter::OnCount);
+
+  signal1.Emit(3);
+  ASSERT_TRUE(counter.count() == 1 && counter.sum() == 3);
+}
@@ -0,0 +1,26 @@
+//
+// Created by zhanggyb on 17-9-19.
+//
+
+#ifndef SKLAND_TEST_CORE_SIGCXX_SIGNAL_TEST_HPP_
+#define SKLAND_TEST_CORE_SIGCXX_SIGNAL_TEST_HPP_
+
+#include <gtest/gtest.h>
+
+class SignalTest : public testing::Test {
+
+ public:
+
+  SignalTest() {}
+
+  virtual ~SignalTest() {}
+
+ protected:
+
+  virtual void SetUp() {}
+
+  virtual void TearDown() {}
+
+};
+
+#endif // SKLAND_TEST_CORE_SIGCXX_SIGNAL_TEST_HPP_
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/core/slab-allocator.hpp>
+
+#include <vector>
+
+using namespace skland;
+using namespace skland::core;
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+struct Item : public SlabObject<Item> {
+
+  explicit Item(int id)
+      : id(id) {}
+
+  int id;
+  double data[4];
+
+};
+
+struct LargeItem : public Item {
+
+  LargeItem()
+      : Item(0) {}
+
+  double extra[16];
+
+};
+
+TEST_F(Test, allocate_1) {
+  SlabAllocator allocator(sizeof(Item), 64);
+  std::vector<void *> blocks;
+
+  for (int i = 0; i < 1000; i++) {
+    blocks.push_back(allocator.Allocate());
+  }
+
+  ASSERT_TRUE(allocator.GetAllocationCount() == 1000);
+  ASSERT_TRUE(allocator.GetInUseCount() == 1000);
+  ASSERT_TRUE(allocator.GetChunkCount() == 16);  // 1000 / 64 rounded up
+
+  for (void *block : blocks) {
+    ASSERT_TRUE(reinterpret_cast<size_t>(block) % alignof(std::max_align_t) == 0);
+    allocator.Deallocate(block);
+  }
+  blocks.clear();
+
+  ASSERT_TRUE(allocator.GetInUseCount() == 0);
+
+  // Freed blocks are reused, no more chunks
+  for (int i = 0; i < 1000; i++) {
+    blocks.push_back(allocator.Allocate());
+  }
+  ASSERT_TRUE(allocator.GetChunkCount() == 16);
+  ASSERT_TRUE(allocator.GetPeakInUseCount() == 1000);
+
+  for (void *block : blocks) allocator.Deallocate(block);
+}
+
+TEST_F(Test, slab_object_1) {
+  // Allocated from heap before an allocator is set
+  Item *heap_item = new Item(0);
+
+  SlabAllocator allocator(sizeof(Item));
+  Item::SetSlabAllocator(&allocator);
+
+  Item *item = new Item(1);
+  ASSERT_TRUE(allocator.GetAllocationCount() == 1);
+  ASSERT_TRUE(allocator.GetInUseCount() == 1);
+  delete item;
+  ASSERT_TRUE(allocator.GetInUseCount() == 0);
+
+  // Goes back to heap
+  delete heap_item;
+  ASSERT_TRUE(allocator.GetDeallocationCount() == 1);
+
+  // Sub class larger than a block use heap
+  LargeItem *large = new LargeItem;
+  ASSERT_TRUE(allocator.GetAllocationCount() == 1);
+  delete large;
+  ASSERT_TRUE(allocator.GetDeallocationCount() == 1);
+
+  Item::SetSlabAllocator(nullptr);
+}
+
+/*
+ * Objects outliving the allocator release its chunk when deleted
+ */
+TEST_F(Test, slab_object_2) {
+  Item *item = nullptr;
+
+  {
+    SlabAllocator allocator(sizeof(Item), 4);
+    Item::SetSlabAllocator(&allocator);
+
+    std::vector<Item *> items;
+    for (int i = 0; i < 8; i++) items.push_back(new Item(i));
+    item = items.back();
+    items.pop_back();
+    for (Item *p : items) delete p;
+
+    Item::SetSlabAllocator(nullptr);
+    ASSERT_TRUE(allocator.GetInUseCount() == 1);
+  }
+
+  ASSERT_TRUE(item->id == 7);
+  delete item;
+}
+
+/*
+ * Build and tear down 10k objects repeatedly without more chunks
+ */
+TEST_F(Test, churn_1) {
+  const int count = 10000;
+  const int loops = 100;
+
+  SlabAllocator allocator(sizeof(Item), 64);
+  Item::SetSlabAllocator(&allocator);
+
+  std::vector<Item *> items(count, nullptr);
+  for (int loop = 0; loop < loops; loop++) {
+    for (int i = 0; i < count; i++) items[i] = new Item(i);
+    for (int i = 0; i < count; i++) delete items[i];
+  }
+
+  Item::SetSlabAllocator(nullptr);
+
+  ASSERT_TRUE(allocator.GetAllocationCount() == static_cast<size_t>(count * loops));
+  ASSERT_TRUE(allocator.GetChunkCount() == static_cast<size_t>((count + 63) / 64));
+}
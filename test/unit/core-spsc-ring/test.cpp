@@ -0,0 +1,157 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/core/spsc-ring.hpp>
+
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+using namespace skland;
+using namespace skland::core;
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+/**
+ * @brief A small record like the input events passed between threads
+ */
+struct Record {
+
+  int serial;
+
+  float x;
+
+  float y;
+
+};
+
+TEST_F(Test, capacity_1) {
+  SPSCRing<int> ring1(1);
+  SPSCRing<int> ring2(100);
+  SPSCRing<int> ring3(128);
+
+  ASSERT_TRUE(ring1.GetCapacity() == 1);
+  ASSERT_TRUE(ring2.GetCapacity() == 128);
+  ASSERT_TRUE(ring3.GetCapacity() == 128);
+}
+
+TEST_F(Test, push_pop_1) {
+  SPSCRing<Record> ring(4);
+  Record record;
+
+  ASSERT_TRUE(ring.IsEmpty());
+  ASSERT_TRUE(!ring.Pop(&record));
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(ring.Push({i, i * 1.f, i * 2.f}));
+  }
+
+  // Full
+  ASSERT_TRUE(!ring.Push({4, 0.f, 0.f}));
+  ASSERT_TRUE(ring.GetSize() == 4);
+
+  ASSERT_TRUE(ring.Pop(&record) && record.serial == 0 && record.y == 0.f);
+  ASSERT_TRUE(ring.Push({4, 4.f, 8.f}));
+
+  for (int i = 1; i < 5; ++i) {
+    ASSERT_TRUE(ring.Pop(&record));
+    ASSERT_TRUE(record.serial == i && record.x == i * 1.f && record.y == i * 2.f);
+  }
+
+  ASSERT_TRUE(ring.IsEmpty());
+}
+
+TEST_F(Test, thread_1) {
+  const int count = 1000000;
+  SPSCRing<int> ring(256);
+
+  std::thread producer([&ring, count]() {
+    for (int i = 0; i < count; ++i) {
+      while (!ring.Push(i)) std::this_thread::yield();
+    }
+  });
+
+  int value = 0;
+  for (int i = 0; i < count; ++i) {
+    while (!ring.Pop(&value)) std::this_thread::yield();
+    ASSERT_TRUE(value == i);
+  }
+
+  producer.join();
+  ASSERT_TRUE(ring.IsEmpty());
+}
+
+TEST_F(Test, benchmark_1) {
+  typedef std::chrono::steady_clock Clock;
+  const int count = 4000000;
+
+  SPSCRing<int> ring(1024);
+  long long sum = 0;
+
+  Clock::time_point start = Clock::now();
+  std::thread producer1([&ring, count]() {
+    for (int i = 0; i < count; ++i) {
+      while (!ring.Push(i)) std::this_thread::yield();
+    }
+  });
+  int value = 0;
+  for (int i = 0; i < count; ++i) {
+    while (!ring.Pop(&value)) std::this_thread::yield();
+    sum += value;
+  }
+  long lock_free = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  producer1.join();
+
+  std::mutex mutex;
+  std::deque<int> deque;
+  long long locked_sum = 0;
+
+  start = Clock::now();
+  std::thread producer2([&mutex, &deque, count]() {
+    for (int i = 0; i < count; ++i) {
+      std::lock_guard<std::mutex> lock(mutex);
+      deque.push_back(i);
+    }
+  });
+  for (int i = 0; i < count;) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (deque.empty()) continue;
+    locked_sum += deque.front();
+    deque.pop_front();
+    i++;
+  }
+  long locked = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  producer2.join();
+
+  ASSERT_TRUE(sum == locked_sum);
+
+  std::cout << count << " items, SPSCRing: "
+            << lock_free << " us (" << (lock_free > 0 ? (long long) count * 1000000 / lock_free : 0)
+            << " ops/s), mutex + std::deque: "
+            << locked << " us (" << (locked > 0 ? (long long) count * 1000000 / locked : 0)
+            << " ops/s)" << std::endl;
+}
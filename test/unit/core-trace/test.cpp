@@ -6,7 +6,15 @@
 
 #include <skland/core/trace.hpp>
 
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 using namespace skland;
+using namespace skland::core;
 
 Test::Test()
     : testing::Test() {
@@ -48,3 +56,111 @@ TEST_F(Test, constructor_1) {
 
   ASSERT_TRUE(true);
 }
+
+static std::string ReadFile(const char *filename) {
+  std::ifstream file(filename);
+  std::stringstream stream;
+  stream << file.rdbuf();
+  return stream.str();
+}
+
+static int CountOf(const std::string &str, const std::string &pattern) {
+  int count = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1)) {
+    count++;
+  }
+  return count;
+}
+
+TEST_F(Test, legacy_1) {
+  ASSERT_TRUE(Tracer::Start("test-legacy.json"));
+
+  TestCase t;
+  t.TestDepth1();
+
+  Tracer::Stop();
+
+  std::string json = ReadFile("test-legacy.json");
+  ASSERT_TRUE(CountOf(json, "\"ph\":\"B\"") == 3);
+  ASSERT_TRUE(CountOf(json, "\"ph\":\"E\"") == 3);
+  ASSERT_TRUE(json.find("Test depth 3") != std::string::npos);
+  ASSERT_TRUE(json.find("]}") != std::string::npos);
+}
+
+TEST_F(Test, scope_1) {
+  ASSERT_TRUE(Tracer::Start("test-scope.json"));
+  ASSERT_FALSE(Tracer::Start("test-scope.json"));
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.push_back(std::thread([]() {
+      for (int j = 0; j < 1000; j++) {
+        TraceScope scope("frame");
+        Tracer::Counter("count", j);
+      }
+      Tracer::Instant("done");
+    }));
+  }
+  for (auto &thread : threads) thread.join();
+
+  Tracer::Stop();
+
+  std::string json = ReadFile("test-scope.json");
+  ASSERT_TRUE(Tracer::GetDroppedCount() == 0);
+  ASSERT_TRUE(CountOf(json, "\"ph\":\"X\"") == 4000);
+  ASSERT_TRUE(CountOf(json, "\"ph\":\"C\"") == 4000);
+  ASSERT_TRUE(CountOf(json, "\"ph\":\"i\"") == 4);
+  ASSERT_TRUE(json.find("{\"displayTimeUnit\"") == 0);
+}
+
+TEST_F(Test, dropped_1) {
+  ASSERT_TRUE(Tracer::Start("test-dropped.json", 16));
+
+  std::thread thread([]() {
+    for (int i = 0; i < 100; i++) Tracer::Instant("event");
+  });
+  thread.join();
+
+  size_t dropped = Tracer::GetDroppedCount();
+  Tracer::Stop();
+
+  std::string json = ReadFile("test-dropped.json");
+  ASSERT_TRUE(CountOf(json, "\"ph\":\"i\"") + dropped == 100);
+}
+
+/*
+ * The overhead of a span when tracing is disabled and enabled
+ */
+TEST_F(Test, benchmark_1) {
+  typedef std::chrono::steady_clock Clock;
+  const int count = 200000;
+
+  Clock::time_point t0 = Clock::now();
+  for (int i = 0; i < count; i++) {
+    TraceScope scope("disabled");
+  }
+  Clock::time_point t1 = Clock::now();
+
+  ASSERT_TRUE(Tracer::Start("test-benchmark.json", 16384));
+
+  // Record in batches smaller than the ring and flush in between, only the
+  // recording is timed
+  Clock::duration enabled = Clock::duration::zero();
+  for (int i = 0; i < count; i += 10000) {
+    Clock::time_point t2 = Clock::now();
+    for (int j = 0; j < 10000; j++) {
+      TraceScope scope("enabled");
+    }
+    enabled += Clock::now() - t2;
+    Tracer::Flush();
+  }
+
+  Tracer::Stop();
+  ASSERT_TRUE(Tracer::GetDroppedCount() == 0);
+
+  std::cout << "span disabled: "
+            << std::chrono::duration<double, std::nano>(t1 - t0).count() / count << " ns"
+            << ", enabled: "
+            << std::chrono::duration<double, std::nano>(enabled).count() / count << " ns"
+            << std::endl;
+}
@@ -5,6 +5,10 @@
 #include "test.hpp"
 
 #include <skland/core/vector.hpp>
+#include <skland/core/batch.hpp>
+
+#include <cstdlib>
+#include <vector>
 
 using namespace skland::core;
 typedef Vector2<int> vec2i;
@@ -33,3 +37,31 @@ TEST_F(Test, Vector2_2) {
 
   ASSERT_TRUE(v3.x == 3 && v3.y == 3);
 }
+
+TEST_F(Test, batch_contain_1) {
+  std::vector<Vector2<float> > points(1029);
+  std::vector<Vector2<int> > points_i(points.size());
+  bool results[1029];
+
+  srand(1);
+  for (size_t i = 0; i < points.size(); ++i) {
+    points_i[i] = Vector2<int>(rand() % 120 - 10, rand() % 120 - 10);
+    points[i] = points_i[i];
+  }
+
+  Rect<float> rect(10.f, 20.f, 60.f, 90.f);
+  size_t count = Batch<float>::Contain(rect, points.data(), points.size(), results);
+  size_t expect = 0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    ASSERT_TRUE(results[i] == rect.Contain(points[i].x, points[i].y));
+    expect += results[i];
+  }
+  ASSERT_TRUE(count == expect && count > 0);
+
+  Rect<int> rect_i(rect);
+  count = Batch<int>::Contain(rect_i, points_i.data(), points_i.size(), results);
+  ASSERT_TRUE(count == expect);
+  for (size_t i = 0; i < points.size(); ++i) {
+    ASSERT_TRUE(results[i] == rect_i.Contain(points_i[i].x, points_i[i].y));
+  }
+}
@@ -0,0 +1,58 @@
+//
+// Created by zhanggyb on 16-9-19.
+//
+
+#include "test.hpp"
+
+#include <skland/graphic/bitmap.hpp>
+#include <skland/core/memory-stats.hpp>
+
+using namespace skland;
+using namespace skland::graphic;
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+static size_t GetBitmapUsage() {
+  return core::MemoryStats::GetUsage(core::MemoryStats::kBitmap).current;
+}
+
+TEST_F(Test, memory_stats_1) {
+  size_t base = GetBitmapUsage();
+
+  Bitmap *bitmap = new Bitmap;
+  bitmap->AllocateN32Pixels(64, 32);
+  ASSERT_TRUE(GetBitmapUsage() == base + 64 * 4 * 32);
+
+  // Copies share the pixels, which are released with the last one
+  Bitmap copy1(*bitmap);
+  Bitmap copy2;
+  copy2 = *bitmap;
+  ASSERT_TRUE(GetBitmapUsage() == base + 64 * 4 * 32);
+
+  delete bitmap;
+  ASSERT_TRUE(GetBitmapUsage() == base + 64 * 4 * 32);
+
+  copy1 = Bitmap();
+  ASSERT_TRUE(GetBitmapUsage() == base + 64 * 4 * 32);
+
+  copy2.AllocateN32Pixels(16, 16);
+  ASSERT_TRUE(GetBitmapUsage() == base + 16 * 4 * 16);
+}
+
+TEST_F(Test, memory_stats_2) {
+  size_t base = GetBitmapUsage();
+
+  {
+    Bitmap bitmap;
+    bitmap.AllocatePixels(ImageInfo::MakeN32Premul(10, 10));
+    ASSERT_TRUE(GetBitmapUsage() == base + 10 * 4 * 10);
+  }
+
+  ASSERT_TRUE(GetBitmapUsage() == base);
+}
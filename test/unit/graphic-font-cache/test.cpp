@@ -0,0 +1,126 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/graphic/font-cache.hpp>
+#include <skland/graphic/font.hpp>
+#include <skland/graphic/typeface.hpp>
+
+#include <chrono>
+#include <iostream>
+
+using namespace skland;
+using namespace skland::graphic;
+
+static const char *kFamilyName = "Noto Sans CJK SC";
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+/*
+ *
+ */
+TEST_F(Test, typeface_1) {
+  FontCache::Clear();
+  uint64_t miss_count = FontCache::GetMissCount();
+
+  Typeface typeface1(kFamilyName, FontStyle());
+  Typeface typeface2(kFamilyName, FontStyle());
+  Typeface typeface3(kFamilyName, FontStyle(FontStyle::kWeightBold));
+
+  ASSERT_TRUE(typeface1.GetUniqueID() == typeface2.GetUniqueID());
+  ASSERT_TRUE(FontCache::GetMissCount() == miss_count + 2);
+  ASSERT_TRUE(FontCache::GetTypefaceCount() == 2);
+}
+
+/*
+ *
+ */
+TEST_F(Test, font_1) {
+  FontCache::Clear();
+
+  Font font1(kFamilyName, FontStyle(), 12.f);
+  Font font2(kFamilyName, FontStyle(), 12.f);
+  Font font3(kFamilyName, FontStyle(), 14.f);
+
+  ASSERT_TRUE(font1.GetSkTypeface() == font2.GetSkTypeface());
+  ASSERT_TRUE(font1.GetSkTypeface() == font3.GetSkTypeface());
+  ASSERT_TRUE(FontCache::GetFontCount() == 2);
+  ASSERT_TRUE(FontCache::GetTypefaceCount() == 1);
+}
+
+/*
+ *
+ */
+TEST_F(Test, warm_up_1) {
+  FontCache::Clear();
+
+  FontCache::AddWarmUpFont(kFamilyName, FontStyle());
+  FontCache::AddWarmUpFont(kFamilyName, FontStyle(FontStyle::kWeightBold));
+  FontCache::WarmUp();
+
+  // Waits for the background thread if the typeface is still being resolved
+  uint64_t miss_count = FontCache::GetMissCount();
+  Font font(kFamilyName, FontStyle(), 12.f);
+  FontCache::WaitForWarmUp();
+
+  ASSERT_TRUE(FontCache::GetTypefaceCount() == 2);
+  ASSERT_TRUE(FontCache::GetMissCount() <= miss_count + 2);
+}
+
+/*
+ * Cost of constructing the fonts of a label with a cold and a warm cache, and
+ * of resolving the theme fonts in background during startup
+ */
+TEST_F(Test, construct_benchmark_1) {
+  const int count = 100;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; i++) {
+    FontCache::Clear();
+    Font font(kFamilyName, FontStyle(), 12.f);
+  }
+  auto end = std::chrono::steady_clock::now();
+  double cold = std::chrono::duration<double, std::micro>(end - start).count() / count;
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; i++) {
+    Font font(kFamilyName, FontStyle(), 12.f);
+  }
+  end = std::chrono::steady_clock::now();
+  double warm = std::chrono::duration<double, std::micro>(end - start).count() / count;
+
+  FontCache::Clear();
+  start = std::chrono::steady_clock::now();
+  FontCache::AddWarmUpFont(kFamilyName, FontStyle(FontStyle::kWeightBold));
+  FontCache::AddWarmUpFont(kFamilyName, FontStyle());
+  FontCache::WarmUp();
+  end = std::chrono::steady_clock::now();
+  double startup = std::chrono::duration<double, std::micro>(end - start).count();
+  FontCache::WaitForWarmUp();
+
+  std::cout << "Font construction, cold: " << cold << " us, warm: " << warm << " us" << std::endl
+            << "Blocking time of the startup warm-up: " << startup << " us" << std::endl;
+
+  ASSERT_TRUE(warm <= cold);
+}
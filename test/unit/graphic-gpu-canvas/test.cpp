@@ -0,0 +1,320 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/core/rect.hpp>
+#include <skland/graphic/bitmap.hpp>
+#include <skland/graphic/canvas.hpp>
+#include <skland/graphic/gpu-context.hpp>
+#include <skland/graphic/gradient-shader.hpp>
+#include <skland/graphic/image-info.hpp>
+#include <skland/graphic/paint.hpp>
+#include <skland/graphic/path.hpp>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace skland;
+using namespace skland::core;
+using namespace skland::graphic;
+
+static const int kWidth = 800;
+static const int kHeight = 600;
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+/**
+ * @brief A headless EGL context, e.g. Mesa llvmpipe with the surfaceless platform
+ */
+class HeadlessEGL {
+
+ public:
+
+  HeadlessEGL() {
+    PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (get_platform_display)
+      display_ = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (EGL_NO_DISPLAY == display_)
+      display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (EGL_NO_DISPLAY == display_ || !eglInitialize(display_, nullptr, nullptr)) {
+      display_ = EGL_NO_DISPLAY;
+      return;
+    }
+
+    eglBindAPI(EGL_OPENGL_ES_API);
+
+    const EGLint config_attribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+        EGL_NONE
+    };
+    const EGLint context_attribs[] = {
+        EGL_CONTEXT_CLIENT_VERSION, 2,
+        EGL_NONE
+    };
+
+    EGLConfig config = nullptr;
+    EGLint count = 0;
+    if (!eglChooseConfig(display_, config_attribs, &config, 1, &count) || count < 1) return;
+
+    context_ = eglCreateContext(display_, config, EGL_NO_CONTEXT, context_attribs);
+    if (EGL_NO_CONTEXT == context_) return;
+
+    // Skia draws into its own render targets, a surface is needed only if
+    // the surfaceless extension is not supported
+    if (!eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, context_)) {
+      const EGLint pbuffer_attribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+      surface_ = eglCreatePbufferSurface(display_, config, pbuffer_attribs);
+      if (EGL_NO_SURFACE == surface_ || !eglMakeCurrent(display_, surface_, surface_, context_)) {
+        eglDestroyContext(display_, context_);
+        context_ = EGL_NO_CONTEXT;
+      }
+    }
+  }
+
+  ~HeadlessEGL() {
+    if (EGL_NO_DISPLAY == display_) return;
+
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (EGL_NO_SURFACE != surface_) eglDestroySurface(display_, surface_);
+    if (EGL_NO_CONTEXT != context_) eglDestroyContext(display_, context_);
+    eglTerminate(display_);
+  }
+
+  bool IsValid() const {
+    return EGL_NO_CONTEXT != context_;
+  }
+
+  static GPUContext::GLProc GetProc(void *, const char *name) {
+    return reinterpret_cast<GPUContext::GLProc>(eglGetProcAddress(name));
+  }
+
+ private:
+
+  EGLDisplay display_ = EGL_NO_DISPLAY;
+
+  EGLContext context_ = EGL_NO_CONTEXT;
+
+  EGLSurface surface_ = EGL_NO_SURFACE;
+
+};
+
+/**
+ * @brief Create a GPU context, or print why the GL tests are skipped
+ */
+static GPUContext *CreateGPUContext(const HeadlessEGL &egl) {
+  if (!egl.IsValid()) {
+    std::cout << "No headless EGL context, skip GL test" << std::endl;
+    return nullptr;
+  }
+
+  GPUContext *context = GPUContext::CreateGL(HeadlessEGL::GetProc);
+  if (nullptr == context) {
+    std::cout << "Skia GL backend is not available, skip GL test" << std::endl;
+  }
+  return context;
+}
+
+/**
+ * @brief Draw a frame with some hundreds of shapes
+ */
+static void DrawFrame(Canvas *canvas, int frame) {
+  Paint paint;
+  paint.SetAntiAlias(true);
+
+  canvas->Clear(0xFFFFFFFF);
+
+  PointF points[2] = {{0.f, 0.f}, {0.f, (float) kHeight}};
+  uint32_t colors[2] = {0xFFEEEEEE, 0xFF999999};
+  Paint background;
+  background.SetShader(GradientShader::MakeLinear(points, colors, nullptr, 2, Shader::kTileModeClamp));
+  canvas->DrawPaint(background);
+
+  const float radii[] = {6.f, 6.f, 6.f, 6.f, 6.f, 6.f, 6.f, 6.f};
+  Path path;
+  path.AddRoundRect(RectF::MakeFromXYWH(0.f, 0.f, 40.f, 30.f), radii);
+
+  for (int i = 0; i < 300; ++i) {
+    float x = (float) ((i * 37 + frame * 5) % (kWidth - 40));
+    float y = (float) ((i * 53) % (kHeight - 30));
+
+    paint.SetColor(0xFF000000 | (uint32_t) (i * 2654435761u >> 8));
+    canvas->Save();
+    canvas->Translate(x, y);
+    canvas->DrawPath(path, paint);
+    canvas->DrawCircle(20.f, 15.f, 8.f, paint);
+    canvas->Restore();
+  }
+}
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+TEST_F(Test, create_1) {
+  HeadlessEGL egl;
+  std::unique_ptr<GPUContext> context(CreateGPUContext(egl));
+  if (!context) return;
+
+  std::unique_ptr<Canvas> canvas(Canvas::CreateGPU(context.get(), 64, 64));
+  ASSERT_TRUE(canvas);
+
+  Paint paint;
+  paint.SetColor(0xFF00FF00);
+  canvas->Clear(0xFFFF0000);
+  canvas->DrawRect(RectF::MakeFromXYWH(16.f, 16.f, 32.f, 32.f), paint);
+  canvas->Flush();
+
+  std::vector<uint32_t> pixels(64 * 64);
+  Bitmap bitmap;
+  ASSERT_TRUE(bitmap.InstallPixels(ImageInfo::MakeN32Premul(64, 64), pixels.data(), 64 * 4));
+  ASSERT_TRUE(canvas->ReadPixels(&bitmap));
+
+  // Top-down rows in N32, whichever origin the render target has
+  ASSERT_TRUE((pixels[0] & 0x00FFFFFF) != (pixels[32 * 64 + 32] & 0x00FFFFFF));
+  ASSERT_TRUE(pixels[0] == pixels[63 * 64 + 63]);
+  ASSERT_TRUE(context->GetResourceCacheUsage() > 0);
+}
+
+/*
+ * The pixels of an offscreen render target can be drawn on another canvas
+ */
+TEST_F(Test, draw_canvas_1) {
+  HeadlessEGL egl;
+  std::unique_ptr<GPUContext> context(CreateGPUContext(egl));
+  if (!context) return;
+
+  std::unique_ptr<Canvas> source(Canvas::CreateGPU(context.get(), 32, 32));
+  std::unique_ptr<Canvas> target(Canvas::CreateGPU(context.get(), 64, 64));
+  ASSERT_TRUE(source && target);
+
+  source->Clear(0xFF00FF00);
+  target->Clear(0xFFFF0000);
+  target->DrawCanvas(*source, 16.f, 16.f);
+  target->Flush();
+
+  std::vector<uint32_t> pixels(64 * 64);
+  Bitmap bitmap;
+  ASSERT_TRUE(bitmap.InstallPixels(ImageInfo::MakeN32Premul(64, 64), pixels.data(), 64 * 4));
+  ASSERT_TRUE(target->ReadPixels(&bitmap));
+
+  ASSERT_TRUE(pixels[0] != pixels[32 * 64 + 32]);
+  ASSERT_TRUE(pixels[0] == pixels[63 * 64 + 63]);
+}
+
+/*
+ * The GL and raster output of the same scene differ only by anti-aliasing
+ */
+TEST_F(Test, compare_1) {
+  HeadlessEGL egl;
+  std::unique_ptr<GPUContext> context(CreateGPUContext(egl));
+  if (!context) return;
+
+  std::vector<uint32_t> raster_pixels(kWidth * kHeight);
+  std::vector<uint32_t> gl_pixels(kWidth * kHeight);
+
+  Bitmap raster_bitmap;
+  raster_bitmap.InstallPixels(ImageInfo::MakeN32Premul(kWidth, kHeight), raster_pixels.data(), kWidth * 4);
+  Canvas raster_canvas(raster_bitmap);
+  DrawFrame(&raster_canvas, 0);
+  raster_canvas.Flush();
+
+  std::unique_ptr<Canvas> gl_canvas(Canvas::CreateGPU(context.get(), kWidth, kHeight));
+  ASSERT_TRUE(gl_canvas);
+  DrawFrame(gl_canvas.get(), 0);
+  gl_canvas->Flush();
+
+  Bitmap gl_bitmap;
+  gl_bitmap.InstallPixels(ImageInfo::MakeN32Premul(kWidth, kHeight), gl_pixels.data(), kWidth * 4);
+  ASSERT_TRUE(gl_canvas->ReadPixels(&gl_bitmap));
+
+  size_t different = 0;
+  for (size_t i = 0; i < raster_pixels.size(); ++i) {
+    for (int shift = 0; shift < 32; shift += 8) {
+      int a = (raster_pixels[i] >> shift) & 0xFF;
+      int b = (gl_pixels[i] >> shift) & 0xFF;
+      if (abs(a - b) > 8) {
+        different++;
+        break;
+      }
+    }
+  }
+
+  std::cout << "Different pixels: " << different << " of " << raster_pixels.size() << std::endl;
+  ASSERT_TRUE(different < raster_pixels.size() / 20);
+}
+
+TEST_F(Test, benchmark_1) {
+  typedef std::chrono::steady_clock Clock;
+  const int frames = 60;
+
+  HeadlessEGL egl;
+  std::unique_ptr<GPUContext> context(CreateGPUContext(egl));
+  if (!context) return;
+
+  std::vector<uint32_t> pixels(kWidth * kHeight);
+  Bitmap bitmap;
+  bitmap.InstallPixels(ImageInfo::MakeN32Premul(kWidth, kHeight), pixels.data(), kWidth * 4);
+
+  Canvas raster_canvas(bitmap);
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < frames; ++i) {
+    DrawFrame(&raster_canvas, i);
+    raster_canvas.Flush();
+  }
+  Clock::duration raster = Clock::now() - start;
+
+  std::unique_ptr<Canvas> gl_canvas(Canvas::CreateGPU(context.get(), kWidth, kHeight));
+  ASSERT_TRUE(gl_canvas);
+
+  // Warm up shaders and caches
+  DrawFrame(gl_canvas.get(), 0);
+  gl_canvas->Flush();
+  gl_canvas->ReadPixels(&bitmap);
+
+  start = Clock::now();
+  for (int i = 0; i < frames; ++i) {
+    DrawFrame(gl_canvas.get(), i);
+    gl_canvas->Flush();
+  }
+  // Wait for the GPU to finish
+  gl_canvas->ReadPixels(&bitmap);
+  Clock::duration gl = Clock::now() - start;
+
+  std::cout << frames << " frames of " << kWidth << "x" << kHeight
+            << ", raster: " << std::chrono::duration_cast<std::chrono::milliseconds>(raster).count() << " ms"
+            << ", GL: " << std::chrono::duration_cast<std::chrono::milliseconds>(gl).count() << " ms"
+            << std::endl;
+}
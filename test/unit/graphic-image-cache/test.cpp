@@ -0,0 +1,150 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/graphic/image-cache.hpp>
+#include <skland/graphic/bitmap.hpp>
+#include <skland/graphic/canvas.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+
+using namespace skland;
+using namespace skland::core;
+using namespace skland::graphic;
+
+static const std::string kFileName("graphic_image_cache_source.png");
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+/**
+ * @brief Write a 1600x1200 image to load in tests
+ */
+static void WriteSourceImage() {
+  Bitmap bitmap;
+  bitmap.AllocateN32Pixels(1600, 1200, true);
+
+  Canvas canvas(bitmap);
+  canvas.Clear(0xFF3366CC);
+  canvas.Flush();
+
+  bitmap.WriteToFile(kFileName);
+}
+
+/*
+ *
+ */
+TEST_F(Test, load_1) {
+  WriteSourceImage();
+  ImageCache::Clear();
+
+  Bitmap full;
+  ASSERT_TRUE(full.Load(kFileName));
+  ASSERT_TRUE(full.GetWidth() == 1600 && full.GetHeight() == 1200);
+
+  // Scaled down by halves, but not smaller than the target size
+  Bitmap thumbnail;
+  ASSERT_TRUE(thumbnail.Load(kFileName, SizeI(160, 160)));
+  ASSERT_TRUE(thumbnail.GetWidth() == 200 && thumbnail.GetHeight() == 150);
+
+  uint64_t hit_count = ImageCache::GetHitCount();
+  Bitmap again;
+  ASSERT_TRUE(again.Load(kFileName, SizeI(160, 160)));
+  ASSERT_TRUE(ImageCache::GetHitCount() == hit_count + 1);
+  ASSERT_TRUE(ImageCache::GetCount() == 2);
+
+  Bitmap missing;
+  ASSERT_FALSE(missing.Load("graphic_image_cache_missing.png"));
+}
+
+/*
+ *
+ */
+TEST_F(Test, load_async_1) {
+  WriteSourceImage();
+  ImageCache::Clear();
+
+  std::atomic<int> count(0);
+  std::atomic<int> failed(0);
+  uint64_t miss_count = ImageCache::GetMissCount();
+
+  for (int i = 0; i < 20; ++i) {
+    Bitmap::LoadAsync(kFileName, SizeI(100, 100), [&](const Bitmap &bitmap) {
+      if (bitmap.GetWidth() != 100) failed++;
+      count++;
+    });
+  }
+
+  ImageCache::WaitForIdle();
+
+  // Decoded only once
+  ASSERT_TRUE(count == 20 && failed == 0);
+  ASSERT_TRUE(ImageCache::GetMissCount() == miss_count + 1);
+  ASSERT_TRUE(ImageCache::GetPendingCount() == 0);
+}
+
+/*
+ *
+ */
+TEST_F(Test, budget_1) {
+  WriteSourceImage();
+  ImageCache::Clear();
+
+  size_t budget = ImageCache::GetMemoryBudget();
+
+  Bitmap bitmap;
+  ASSERT_TRUE(bitmap.Load(kFileName, SizeI(100, 100)));
+  ASSERT_TRUE(ImageCache::GetMemoryUsage() > 0);
+
+  ImageCache::SetMemoryBudget(1024);
+  ASSERT_TRUE(ImageCache::GetCount() == 0 && ImageCache::GetMemoryUsage() == 0);
+
+  // A bitmap already loaded keeps its pixels
+  ASSERT_TRUE(bitmap.GetWidth() == 100);
+
+  ImageCache::SetMemoryBudget(budget);
+}
+
+/*
+ *
+ */
+TEST_F(Test, thumbnail_benchmark_1) {
+  WriteSourceImage();
+  ImageCache::Clear();
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 20; ++i) {
+    Bitmap::LoadAsync(kFileName, SizeI(64 + i, 64 + i), [](const Bitmap &) {});
+  }
+  auto queued = std::chrono::steady_clock::now();
+  ImageCache::WaitForIdle();
+  auto end = std::chrono::steady_clock::now();
+
+  std::cout << "Queue 20 thumbnails: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(queued - start).count() << " us, "
+            << "decoded in: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms"
+            << std::endl;
+}
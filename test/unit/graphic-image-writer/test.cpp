@@ -0,0 +1,110 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/core/rect.hpp>
+#include <skland/graphic/image-writer.hpp>
+#include <skland/graphic/bitmap.hpp>
+#include <skland/graphic/canvas.hpp>
+#include <skland/graphic/paint.hpp>
+
+#include <chrono>
+#include <iostream>
+
+using namespace skland;
+using namespace skland::core;
+using namespace skland::graphic;
+
+static const std::string kFileNamePrefix("graphic_image_writer_");
+
+/**
+ * @brief Draw something in a bitmap
+ */
+static void Draw(Bitmap &bitmap) {
+  Canvas canvas(bitmap);
+  canvas.Clear(0x7F0000FF);
+
+  Paint paint;
+  paint.SetColor(0xFFFF0000);
+  canvas.DrawRect(RectF::MakeFromXYWH(0.f, 0.f, (float) bitmap.GetWidth(), (float) bitmap.GetHeight()).Inset(50.f), paint);
+  canvas.Flush();
+}
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+/*
+ *
+ */
+TEST_F(Test, write_1) {
+  Bitmap bitmap;
+  bitmap.AllocateN32Pixels(400, 300);
+  Draw(bitmap);
+
+  ImageWriter writer(bitmap);
+  ASSERT_TRUE(writer.GetWidth() == 400 && writer.GetHeight() == 300);
+
+  // The snapshot is not affected by drawing on the bitmap again
+  Canvas canvas(bitmap);
+  canvas.Clear(0xFF000000);
+  canvas.Flush();
+
+  ASSERT_TRUE(writer.Write(kFileNamePrefix + "write_1.png"));
+  ASSERT_TRUE(writer.Write(kFileNamePrefix + "write_1.jpg"));
+  ASSERT_TRUE(writer.Write(kFileNamePrefix + "write_1.exr"));
+  ASSERT_TRUE(writer.Write(kFileNamePrefix + "write_1.img", ImageWriter::kFormatPNG));
+
+  std::cout << std::endl
+            << "Check image files: " << kFileNamePrefix << "write_1.*"
+            << std::endl
+            << std::endl;
+}
+
+/*
+ *
+ */
+TEST_F(Test, write_2) {
+  Bitmap bitmap;
+  ASSERT_FALSE(ImageWriter(bitmap).Write(kFileNamePrefix + "write_2.png"));
+}
+
+/*
+ *
+ */
+TEST_F(Test, snapshot_benchmark_1) {
+  Bitmap bitmap;
+  bitmap.AllocateN32Pixels(3840, 2160);
+  Draw(bitmap);
+
+  auto start = std::chrono::steady_clock::now();
+  ImageWriter writer(bitmap);
+  auto snapshot = std::chrono::steady_clock::now();
+  ASSERT_TRUE(writer.Write(kFileNamePrefix + "snapshot_benchmark_1.png"));
+  auto end = std::chrono::steady_clock::now();
+
+  std::cout << "Snapshot of 3840x2160: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(snapshot - start).count() << " us, "
+            << "encoding: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end - snapshot).count() << " ms"
+            << std::endl;
+}
@@ -0,0 +1,239 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/core/point.hpp>
+#include <skland/graphic/gradient-shader.hpp>
+#include <skland/graphic/paint.hpp>
+#include <skland/graphic/paint-cache.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace skland;
+using namespace skland::core;
+using namespace skland::graphic;
+
+static std::atomic<size_t> kAllocationCount(0);
+
+void *operator new(size_t size) {
+  kAllocationCount++;
+  void *p = malloc(size);
+  if (nullptr == p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+TEST_F(Test, shader_intern_1) {
+  PaintCache::Clear();
+
+  PointF points[2] = {{0.f, 0.f}, {0.f, 24.f}};
+  uint32_t colors1[2] = {0xFFEEEEEE, 0xFFCCCCCC};
+  uint32_t colors2[2] = {0xFFEEEEEE, 0xFFBBBBBB};
+  float pos[2] = {0.f, 1.f};
+
+  Shader shader1 = GradientShader::MakeLinear(points, colors1, pos, 2, Shader::kTileModeClamp);
+  Shader shader2 = GradientShader::MakeLinear(points, colors1, pos, 2, Shader::kTileModeClamp);
+  Shader shader3 = GradientShader::MakeLinear(points, colors2, pos, 2, Shader::kTileModeClamp);
+  Shader shader4 = GradientShader::MakeLinear(points, colors1, nullptr, 2, Shader::kTileModeClamp);
+  Shader shader5 = GradientShader::MakeRadial(points[1], 24.f, colors1, pos, 2, Shader::kTileModeClamp);
+
+  ASSERT_TRUE(shader1 == shader2);
+  ASSERT_TRUE(shader1 != shader3);
+  ASSERT_TRUE(shader1 != shader4);
+  ASSERT_TRUE(shader1 != shader5);
+  ASSERT_TRUE(PaintCache::GetShaderCount() == 4);
+}
+
+TEST_F(Test, shader_capacity_1) {
+  PaintCache::Clear();
+  size_t capacity = PaintCache::GetCapacity();
+  PaintCache::SetCapacity(4);
+
+  PointF points[2] = {{0.f, 0.f}, {0.f, 24.f}};
+  uint32_t colors[2] = {0xFFEEEEEE, 0xFFCCCCCC};
+
+  Shader first = GradientShader::MakeLinear(points, colors, nullptr, 2, Shader::kTileModeClamp);
+  for (int i = 0; i < 10; ++i) {
+    points[1].y = 25.f + i;
+    GradientShader::MakeLinear(points, colors, nullptr, 2, Shader::kTileModeClamp);
+  }
+  ASSERT_TRUE(PaintCache::GetShaderCount() == 4);
+
+  // The first one was evicted, a new shader is created
+  points[1].y = 24.f;
+  Shader again = GradientShader::MakeLinear(points, colors, nullptr, 2, Shader::kTileModeClamp);
+  ASSERT_TRUE(first != again);
+  ASSERT_TRUE(first);
+
+  PaintCache::SetCapacity(capacity);
+}
+
+TEST_F(Test, paint_intern_1) {
+  PaintCache::Clear();
+
+  Paint paint1;
+  paint1.SetAntiAlias(true);
+  paint1.SetColor(0xFF336699);
+
+  Paint paint2;
+  paint2.SetAntiAlias(true);
+  paint2.SetColor(0xFF336699);
+
+  Paint paint3(paint2);
+  paint3.SetStrokeWidth(2.f);
+
+  std::shared_ptr<const Paint> interned1 = PaintCache::Intern(paint1);
+  std::shared_ptr<const Paint> interned2 = PaintCache::Intern(paint2);
+  std::shared_ptr<const Paint> interned3 = PaintCache::Intern(paint3);
+
+  ASSERT_TRUE(interned1 == interned2);
+  ASSERT_TRUE(*interned1 == *interned2);
+  ASSERT_TRUE(interned1 != interned3);
+  ASSERT_TRUE(interned1->GetColor() == paint1.GetColor());
+  ASSERT_TRUE(PaintCache::GetPaintCount() == 2);
+}
+
+TEST_F(Test, paint_intern_2) {
+  PaintCache::Clear();
+
+  PointF points[2] = {{0.f, 0.f}, {0.f, 24.f}};
+  uint32_t colors[2] = {0xFFEEEEEE, 0xFFCCCCCC};
+
+  // Paints built in different frames with the same gradient intern to one
+  Paint paint1;
+  paint1.SetShader(GradientShader::MakeLinear(points, colors, nullptr, 2, Shader::kTileModeClamp));
+  Paint paint2;
+  paint2.SetShader(GradientShader::MakeLinear(points, colors, nullptr, 2, Shader::kTileModeClamp));
+
+  ASSERT_TRUE(paint1.GetHash() == paint2.GetHash());
+  ASSERT_TRUE(PaintCache::Intern(paint1) == PaintCache::Intern(paint2));
+}
+
+/*
+ * The paint table is bounded, and handles outlive the entries
+ */
+TEST_F(Test, paint_capacity_1) {
+  PaintCache::Clear();
+  size_t capacity = PaintCache::GetCapacity();
+  PaintCache::SetCapacity(4);
+
+  Paint paint;
+  paint.SetColor(0xFF000000);
+  Paint first_paint(paint);
+  std::shared_ptr<const Paint> first = PaintCache::Intern(paint);
+
+  for (uint32_t i = 1; i < 10; ++i) {
+    paint.SetColor(0xFF000000 + i);
+    PaintCache::Intern(paint);
+  }
+  ASSERT_TRUE(PaintCache::GetPaintCount() == 4);
+
+  // The first one was evicted but the handle is still valid
+  ASSERT_TRUE(*first == first_paint);
+  ASSERT_TRUE(PaintCache::Intern(first_paint) != first);
+
+  // Recently used paints are kept
+  paint.SetColor(0xFF000009);
+  Paint last_paint(paint);
+  std::shared_ptr<const Paint> last = PaintCache::Intern(paint);
+  for (uint32_t i = 20; i < 22; ++i) {
+    paint.SetColor(0xFF000000 + i);
+    PaintCache::Intern(paint);
+  }
+  ASSERT_TRUE(PaintCache::Intern(last_paint) == last);
+
+  PaintCache::Clear();
+  ASSERT_TRUE(PaintCache::GetPaintCount() == 0);
+  ASSERT_TRUE(*last == last_paint);
+
+  PaintCache::SetCapacity(capacity);
+}
+
+/**
+ * @brief Count allocations per frame to draw a title bar like gradient
+ */
+TEST_F(Test, allocation_1) {
+  const int frames = 100;
+  PointF points[2] = {{0.f, 0.f}, {0.f, 24.f}};
+  uint32_t colors[2] = {0xFFEEEEEE, 0xFFCCCCCC};
+  float pos[2] = {0.f, 1.f};
+  uint32_t hash = 0;
+
+  PaintCache::Clear();
+
+  // Before: a shader and a paint are created in every frame
+  size_t capacity = PaintCache::GetCapacity();
+  PaintCache::SetCapacity(0);
+  size_t start = kAllocationCount;
+  for (int i = 0; i < frames; ++i) {
+    Paint paint;
+    paint.SetAntiAlias(true);
+    paint.SetShader(GradientShader::MakeLinear(points, colors, pos, 2, Shader::kTileModeClamp));
+    hash += paint.GetHash();
+  }
+  size_t before = kAllocationCount - start;
+  PaintCache::SetCapacity(capacity);
+
+  // After: the shader and paint are interned
+  start = kAllocationCount;
+  for (int i = 0; i < frames; ++i) {
+    Paint paint;
+    paint.SetAntiAlias(true);
+    paint.SetShader(GradientShader::MakeLinear(points, colors, pos, 2, Shader::kTileModeClamp));
+    hash += PaintCache::Intern(paint)->GetHash();
+  }
+  size_t after = kAllocationCount - start;
+
+  // After, with the interned paint kept by the view
+  start = kAllocationCount;
+  std::shared_ptr<const Paint> interned;
+  for (int i = 0; i < frames; ++i) {
+    if (!interned) {
+      Paint paint;
+      paint.SetAntiAlias(true);
+      paint.SetShader(GradientShader::MakeLinear(points, colors, pos, 2, Shader::kTileModeClamp));
+      interned = PaintCache::Intern(paint);
+    }
+    hash += interned->GetHash();
+  }
+  size_t kept = kAllocationCount - start;
+
+  std::cout << "Allocations per frame, new shader: " << (double) before / frames
+            << ", interned shader: " << (double) after / frames
+            << ", kept interned paint: " << (double) kept / frames
+            << " (" << hash << ")" << std::endl;
+
+  ASSERT_TRUE(after < before);
+  ASSERT_TRUE(kept < after);
+  ASSERT_TRUE(PaintCache::GetShaderCount() == 1);
+  ASSERT_TRUE(PaintCache::GetPaintCount() == 1);
+}
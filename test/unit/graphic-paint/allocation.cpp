@@ -0,0 +1,75 @@
+/*
+ * Copyright 2017 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include "skland/graphic/paint.hpp"
+#include "skland/graphic/path.hpp"
+#include "skland/graphic/matrix.hpp"
+#include "skland/graphic/shader.hpp"
+
+#include <cstdlib>
+#include <new>
+
+using namespace skland;
+using namespace skland::core;
+using namespace skland::graphic;
+
+static size_t kAllocationCount = 0;
+
+void *operator new(size_t size) {
+  kAllocationCount++;
+  void *p = malloc(size);
+  if (nullptr == p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  free(p);
+}
+
+/*
+ * Simulate what an OnDraw() does with the value types on stack
+ */
+static void DrawFrame(int i) {
+  Paint paint;
+  paint.SetAntiAlias(true);
+  paint.SetColor(0xFF000000 | i);
+  paint.SetStrokeWidth(1.f);
+
+  Paint copy(paint);
+  copy.SetStyle(Paint::kStyleStroke);
+
+  Path path;
+  Matrix matrix;
+  Shader shader;
+}
+
+TEST_F(Test, no_heap_allocation_1) {
+  DrawFrame(0);  // warm up
+
+  size_t count = kAllocationCount;
+  for (int i = 0; i < 100; i++) {
+    DrawFrame(i);
+  }
+
+  // Was 6 allocations per frame when each object allocated its Private
+  ASSERT_TRUE(kAllocationCount == count);
+}
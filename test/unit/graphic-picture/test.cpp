@@ -0,0 +1,186 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/core/rect.hpp>
+#include <skland/graphic/bitmap.hpp>
+#include <skland/graphic/canvas.hpp>
+#include <skland/graphic/paint.hpp>
+#include <skland/graphic/path.hpp>
+#include <skland/graphic/picture.hpp>
+#include <skland/graphic/picture-recorder.hpp>
+#include <skland/graphic/raster-thread.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace skland;
+using namespace skland::core;
+using namespace skland::graphic;
+
+static const int kWidth = 800;
+static const int kHeight = 600;
+
+/**
+ * @brief Draw a frame with some hundreds of shapes
+ */
+static void DrawFrame(Canvas *canvas, int frame) {
+  Paint paint;
+  paint.SetAntiAlias(true);
+
+  canvas->Clear(0xFFFFFFFF);
+
+  const float radii[] = {6.f, 6.f, 6.f, 6.f, 6.f, 6.f, 6.f, 6.f};
+  Path path;
+  path.AddRoundRect(RectF::MakeFromXYWH(0.f, 0.f, 40.f, 30.f), radii);
+
+  for (int i = 0; i < 300; ++i) {
+    float x = (float) ((i * 37 + frame * 5) % (kWidth - 40));
+    float y = (float) ((i * 53) % (kHeight - 30));
+
+    paint.SetColor(0xFF000000 | (uint32_t) (i * 2654435761u >> 8));
+    canvas->Save();
+    canvas->Translate(x, y);
+    canvas->DrawPath(path, paint);
+    canvas->DrawCircle(20.f, 15.f, 8.f, paint);
+    canvas->Restore();
+  }
+}
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+/*
+ *
+ */
+TEST_F(Test, record_1) {
+  PictureRecorder recorder;
+  ASSERT_TRUE(recorder.GetRecordingCanvas() == nullptr);
+
+  Canvas *canvas = recorder.BeginRecording(RectF::MakeFromXYWH(0.f, 0.f, (float) kWidth, (float) kHeight));
+  ASSERT_TRUE(recorder.GetRecordingCanvas() == canvas);
+  DrawFrame(canvas, 0);
+
+  Picture picture = recorder.FinishRecording();
+  ASSERT_TRUE(recorder.GetRecordingCanvas() == nullptr);
+  ASSERT_FALSE(picture.IsEmpty());
+  ASSERT_TRUE(picture.GetCommandCount() > 300);
+  ASSERT_TRUE(picture.GetCullRect().width() == kWidth);
+
+  std::cout << "Commands: " << picture.GetCommandCount()
+            << ", memory: " << picture.GetMemorySize() << " bytes" << std::endl;
+
+  Picture empty;
+  ASSERT_TRUE(empty.IsEmpty());
+}
+
+/*
+ *
+ */
+TEST_F(Test, playback_1) {
+  Bitmap direct;
+  direct.AllocateN32Pixels(kWidth, kHeight);
+  Canvas direct_canvas(direct);
+  DrawFrame(&direct_canvas, 1);
+  direct_canvas.Flush();
+
+  PictureRecorder recorder;
+  DrawFrame(recorder.BeginRecording(RectF::MakeFromXYWH(0.f, 0.f, (float) kWidth, (float) kHeight)), 1);
+  Picture picture = recorder.FinishRecording();
+
+  Bitmap played;
+  played.AllocateN32Pixels(kWidth, kHeight);
+  Canvas played_canvas(played);
+
+  RasterThread raster_thread;
+  raster_thread.Submit(picture, &played_canvas);
+  raster_thread.Wait();
+  ASSERT_TRUE(raster_thread.GetPendingCount() == 0);
+
+  // The two images should be identical
+  direct.WriteToFile("graphic_picture_playback_1_direct.png");
+  played.WriteToFile("graphic_picture_playback_1_played.png");
+
+  std::cout << std::endl
+            << "Check image files: graphic_picture_playback_1_*.png"
+            << std::endl
+            << std::endl;
+}
+
+/*
+ *
+ */
+TEST_F(Test, pipeline_benchmark_1) {
+  typedef std::chrono::steady_clock Clock;
+  const int frames = 60;
+
+  // Two buffers, one being rasterized while the next frame is recorded
+  Bitmap buffers[2];
+  buffers[0].AllocateN32Pixels(kWidth, kHeight);
+  buffers[1].AllocateN32Pixels(kWidth, kHeight);
+  Canvas canvas0(buffers[0]);
+  Canvas canvas1(buffers[1]);
+  Canvas *canvases[2] = {&canvas0, &canvas1};
+
+  // Draw on the main thread
+  Clock::duration serial_latency(0);
+  auto start = Clock::now();
+  for (int i = 0; i < frames; ++i) {
+    auto frame_start = Clock::now();
+    DrawFrame(canvases[i % 2], i);
+    canvases[i % 2]->Flush();
+    serial_latency += Clock::now() - frame_start;
+  }
+  auto serial = Clock::now() - start;
+
+  // Record on the main thread, rasterize on the raster thread
+  RasterThread raster_thread;
+  PictureRecorder recorder;
+  Clock::duration pipelined_latency(0);
+  start = Clock::now();
+  for (int i = 0; i < frames; ++i) {
+    auto frame_start = Clock::now();
+
+    DrawFrame(recorder.BeginRecording(RectF::MakeFromXYWH(0.f, 0.f, (float) kWidth, (float) kHeight)), i);
+    Picture picture = recorder.FinishRecording();
+
+    // Do not get more than one frame ahead of the raster thread
+    while (raster_thread.GetPendingCount() > 1) std::this_thread::yield();
+    raster_thread.Submit(picture, canvases[i % 2]);
+
+    pipelined_latency += Clock::now() - frame_start;
+  }
+  raster_thread.Wait();
+  auto pipelined = Clock::now() - start;
+
+  using std::chrono::microseconds;
+  using std::chrono::duration_cast;
+
+  std::cout << "Serial: " << frames * 1e6 / duration_cast<microseconds>(serial).count() << " fps, "
+            << "main thread " << duration_cast<microseconds>(serial_latency).count() / frames << " us/frame"
+            << std::endl
+            << "Pipelined: " << frames * 1e6 / duration_cast<microseconds>(pipelined).count() << " fps, "
+            << "main thread " << duration_cast<microseconds>(pipelined_latency).count() / frames << " us/frame"
+            << std::endl;
+}
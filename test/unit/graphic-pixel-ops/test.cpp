@@ -0,0 +1,237 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <skland/graphic/pixel-ops.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace skland;
+using namespace skland::graphic;
+
+typedef void (*Kernel)(const uint32_t *, uint32_t *, size_t);
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+/**
+ * @brief Run a kernel with every supported implementation and compare the result with the scalar one
+ */
+static bool CompareWithScalar(Kernel kernel, const std::vector<uint32_t> &src) {
+  std::vector<uint32_t> expect(src.size());
+  std::vector<uint32_t> result(src.size());
+
+  PixelOps::SetImplementation(PixelOps::kImplementationScalar);
+  kernel(src.data(), expect.data(), src.size());
+
+  for (int i = PixelOps::kImplementationSSE2; i < PixelOps::kImplementationCount; ++i) {
+    PixelOps::Implementation implementation = static_cast<PixelOps::Implementation>(i);
+    if (!PixelOps::SetImplementation(implementation)) continue;
+
+    // Odd offsets and lengths exercise the unaligned heads and the tails
+    for (size_t offset = 0; offset < 3; ++offset) {
+      size_t count = src.size() - offset * 7;
+      std::fill(result.begin(), result.end(), 0);
+      kernel(src.data() + offset, result.data() + offset, count);
+      if (!std::equal(expect.begin() + offset, expect.begin() + offset + count, result.begin() + offset)) {
+        std::cerr << PixelOps::GetImplementationName(implementation) << " differs from scalar" << std::endl;
+        return false;
+      }
+    }
+
+    // In place
+    result = src;
+    kernel(result.data(), result.data(), result.size());
+    if (result != expect) {
+      std::cerr << PixelOps::GetImplementationName(implementation) << " differs from scalar in place" << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief All 65536 combinations of a color channel and alpha
+ */
+static std::vector<uint32_t> MakeChannelAlphaPixels() {
+  std::vector<uint32_t> pixels(65536);
+  for (uint32_t a = 0; a < 256; ++a) {
+    for (uint32_t c = 0; c < 256; ++c) {
+      pixels[a * 256 + c] = (a << 24) | (c << 16) | ((255 - c) << 8) | (c ^ 0x5A);
+    }
+  }
+  return pixels;
+}
+
+/*
+ *
+ */
+TEST_F(Test, premultiply_1) {
+  ASSERT_TRUE(CompareWithScalar(PixelOps::Premultiply, MakeChannelAlphaPixels()));
+
+  uint32_t pixel = 0x80FF4000;
+  PixelOps::Premultiply(&pixel, &pixel, 1);
+  ASSERT_TRUE(pixel == 0x80802000);
+}
+
+/*
+ *
+ */
+TEST_F(Test, unpremultiply_1) {
+  ASSERT_TRUE(CompareWithScalar(PixelOps::Unpremultiply, MakeChannelAlphaPixels()));
+
+  uint32_t pixels[] = {0x80802000, 0x00123456, 0xFF123456};
+  PixelOps::Unpremultiply(pixels, pixels, 3);
+  ASSERT_TRUE(pixels[0] == 0x80FF4000);
+  ASSERT_TRUE(pixels[1] == 0);
+  ASSERT_TRUE(pixels[2] == 0xFF123456);
+}
+
+/*
+ *
+ */
+TEST_F(Test, premultiply_round_trip_1) {
+  std::vector<uint32_t> pixels(256 * 256);
+  std::vector<uint32_t> result(pixels.size());
+
+  for (uint32_t c = 0; c < 256; ++c) {
+    for (uint32_t a = 0; a < 256; ++a) {
+      pixels[c * 256 + a] = (a << 24) | (c * 0x010101);
+    }
+  }
+
+  PixelOps::SetImplementation(PixelOps::kImplementationScalar);
+  PixelOps::Premultiply(pixels.data(), result.data(), result.size());
+  PixelOps::Unpremultiply(result.data(), result.data(), result.size());
+
+  // Opaque pixels survive a round trip unchanged
+  for (uint32_t c = 0; c < 256; ++c) {
+    ASSERT_TRUE(result[c * 256 + 255] == pixels[c * 256 + 255]);
+  }
+}
+
+/*
+ *
+ */
+TEST_F(Test, swap_rb_1) {
+  std::vector<uint32_t> pixels(1027);
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<uint32_t>(i * 2654435761u);
+  }
+  ASSERT_TRUE(CompareWithScalar(PixelOps::SwapRB, pixels));
+
+  uint32_t pixel = 0x11223344;
+  PixelOps::SwapRB(&pixel, &pixel, 1);
+  ASSERT_TRUE(pixel == 0x11443322);
+}
+
+/*
+ *
+ */
+TEST_F(Test, fill_1) {
+  for (int i = 0; i < PixelOps::kImplementationCount; ++i) {
+    if (!PixelOps::SetImplementation(static_cast<PixelOps::Implementation>(i))) continue;
+
+    for (size_t count = 0; count < 67; ++count) {
+      std::vector<uint32_t> pixels(count + 2, 0);
+      PixelOps::Fill(pixels.data() + 1, 0xFF336699, count);
+      ASSERT_TRUE(pixels.front() == 0 && pixels.back() == 0);
+      for (size_t j = 1; j <= count; ++j) {
+        ASSERT_TRUE(pixels[j] == 0xFF336699);
+      }
+    }
+  }
+}
+
+/*
+ *
+ */
+TEST_F(Test, blend_src_over_1) {
+  std::vector<uint32_t> src(65536);
+  std::vector<uint32_t> dst(65536);
+  std::vector<uint32_t> expect(65536);
+  std::vector<uint32_t> result(65536);
+
+  // All combinations of source channel, source alpha and destination channel
+  for (uint32_t sa = 0; sa < 256; ++sa) {
+    for (uint32_t s = 0; s < 256; ++s) {
+      for (uint32_t d = 0; d < 256; ++d) {
+        src[s * 256 + d] = (sa << 24) | (s << 16) | (s << 8) | s;
+        dst[s * 256 + d] = (d << 24) | (d << 16) | ((255 - d) << 8) | d;
+      }
+    }
+
+    PixelOps::SetImplementation(PixelOps::kImplementationScalar);
+    expect = dst;
+    PixelOps::BlendSrcOver(src.data(), expect.data(), expect.size());
+
+    for (int i = PixelOps::kImplementationSSE2; i < PixelOps::kImplementationCount; ++i) {
+      if (!PixelOps::SetImplementation(static_cast<PixelOps::Implementation>(i))) continue;
+      result = dst;
+      PixelOps::BlendSrcOver(src.data(), result.data(), result.size() - 3);
+      ASSERT_TRUE(std::equal(result.begin(), result.end() - 3, expect.begin()));
+    }
+  }
+
+  uint32_t pixel = 0xFF0000FF;
+  uint32_t over = 0x80800000;
+  PixelOps::BlendSrcOver(&over, &pixel, 1);
+  ASSERT_TRUE(pixel == 0xFF80007F);
+}
+
+/*
+ *
+ */
+TEST_F(Test, benchmark_1) {
+  const size_t count = 1920 * 1080;
+  const int loops = 20;
+  std::vector<uint32_t> src(count);
+  std::vector<uint32_t> dst(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    src[i] = static_cast<uint32_t>(i * 2654435761u);
+  }
+
+  for (int i = 0; i < PixelOps::kImplementationCount; ++i) {
+    PixelOps::Implementation implementation = static_cast<PixelOps::Implementation>(i);
+    if (!PixelOps::SetImplementation(implementation)) continue;
+
+    const char *names[] = {"Premultiply", "Unpremultiply", "SwapRB", "BlendSrcOver"};
+    Kernel kernels[] = {PixelOps::Premultiply, PixelOps::Unpremultiply, PixelOps::SwapRB, PixelOps::BlendSrcOver};
+
+    for (int k = 0; k < 4; ++k) {
+      auto start = std::chrono::steady_clock::now();
+      for (int j = 0; j < loops; ++j) {
+        kernels[k](src.data(), dst.data(), count);
+      }
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      std::cout << PixelOps::GetImplementationName(implementation) << " " << names[k] << ": "
+                << count * sizeof(uint32_t) * loops / elapsed.count() / 1e9 << " GB/s" << std::endl;
+    }
+  }
+
+  ASSERT_TRUE(true);
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/graphic/text-layout.hpp>
+#include <skland/graphic/text-box.hpp>
+#include <skland/graphic/font.hpp>
+#include <skland/graphic/paint.hpp>
+#include <skland/graphic/canvas.hpp>
+#include <skland/graphic/bitmap.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace skland;
+using namespace skland::core;
+using namespace skland::graphic;
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+/*
+ *
+ */
+TEST_F(Test, layout_1) {
+  Font font(Typeface::kNormal, 12.f);
+  std::string text("Hello World!");
+
+  TextLayout layout(text.c_str(), text.length(), font);
+  ASSERT_TRUE(layout.GetGlyphCount() == (int) text.length());
+  ASSERT_TRUE(layout.CountLines() == 1);
+  ASSERT_TRUE(layout.GetWidth() > 0.f);
+  ASSERT_TRUE(layout.GetHeight() > 0.f);
+
+  TextLayout scaled(text.c_str(), text.length(), font, 0.f, 2.f);
+  ASSERT_FLOAT_EQ(scaled.GetWidth(), layout.GetWidth() * 2.f);
+}
+
+/*
+ *
+ */
+TEST_F(Test, line_break_1) {
+  Font font(Typeface::kNormal, 12.f);
+  std::string text("The quick brown fox jumps over the lazy dog");
+
+  TextLayout one_line(text.c_str(), text.length(), font);
+  float box_width = one_line.GetWidth() / 3.f;
+
+  TextLayout layout(text.c_str(), text.length(), font, box_width);
+  ASSERT_TRUE(layout.CountLines() >= 3);
+  ASSERT_TRUE(layout.GetWidth() <= box_width);
+  ASSERT_FLOAT_EQ(layout.GetHeight(), one_line.GetHeight() * layout.CountLines());
+}
+
+/*
+ *
+ */
+TEST_F(Test, cache_1) {
+  Font font(Typeface::kNormal, 12.f);
+  TextLayoutCache::Clear();
+
+  std::shared_ptr<const TextLayout> layout1 = TextLayoutCache::Get("Hello", font);
+  std::shared_ptr<const TextLayout> layout2 = TextLayoutCache::Get("Hello", font);
+  std::shared_ptr<const TextLayout> layout3 = TextLayoutCache::Get("Hello", font, 0.f, 2.f);
+
+  ASSERT_TRUE(layout1 == layout2);
+  ASSERT_TRUE(layout1 != layout3);
+  ASSERT_TRUE(TextLayoutCache::GetCount() == 2);
+
+  // Shrink the budget to keep only the most recently used layout
+  TextLayoutCache::SetMemoryBudget(layout3->GetMemorySize() + 64);
+  ASSERT_TRUE(TextLayoutCache::GetCount() == 1);
+  ASSERT_TRUE(TextLayoutCache::GetMemoryUsage() <= TextLayoutCache::GetMemoryBudget());
+
+  // Evicted layouts are still valid while referenced
+  ASSERT_TRUE(layout1->GetGlyphCount() == 5);
+
+  TextLayoutCache::SetMemoryBudget(4 * 1024 * 1024);
+  TextLayoutCache::Clear();
+  ASSERT_TRUE(TextLayoutCache::GetCount() == 0);
+}
+
+/*
+ * '\n' starts a new line and is not drawn
+ */
+TEST_F(Test, hard_break_1) {
+  Font font(Typeface::kNormal, 12.f);
+  std::string text("Hello\nWorld\n\nSkland");
+
+  TextLayout one_line("Hello", 5, font);
+  TextLayout layout(text.c_str(), text.length(), font);
+  ASSERT_TRUE(layout.CountLines() == 4);
+  ASSERT_TRUE(layout.GetGlyphCount() == (int) text.length() - 3);
+  ASSERT_FLOAT_EQ(layout.GetHeight(), one_line.GetHeight() * 4);
+
+  // Breaks in a box still wrap
+  TextLayout wrapped(text.c_str(), text.length(), font, one_line.GetWidth() / 2.f);
+  ASSERT_TRUE(wrapped.CountLines() > 4);
+}
+
+/*
+ * Line spacing of a layout created with a paint
+ */
+TEST_F(Test, spacing_1) {
+  Paint paint;
+  paint.SetTextSize(12.f);
+  std::string text("Hello\nWorld");
+
+  TextLayout single(text.c_str(), text.length(), paint);
+  TextLayout double_spaced(text.c_str(), text.length(), paint, 0.f, 2.f, 0.f);
+  float font_height = single.GetHeight() / 2.f;
+
+  ASSERT_TRUE(double_spaced.CountLines() == 2);
+  ASSERT_FLOAT_EQ(double_spaced.GetHeight(), font_height * 3.f);
+}
+
+/*
+ * Repaint 2000 labels through TextBox, the texts are shaped only in the first frame
+ */
+TEST_F(Test, text_box_1) {
+  const int count = 2000;
+  const int frames = 10;
+
+  Bitmap bitmap;
+  bitmap.AllocateN32Pixels(800, 600);
+  Canvas canvas(bitmap);
+
+  Font font(Typeface::kNormal, 12.f);
+  std::vector<std::string> texts;
+  for (int i = 0; i < count; i++) {
+    texts.push_back("Label " + std::to_string(i));
+  }
+
+  Paint paint;
+  paint.SetAntiAlias(true);
+  paint.SetColor(0xFF333333);
+  paint.SetFont(font);
+  paint.SetTextSize(font.GetSize());
+
+  TextLayoutCache::Clear();
+  uint64_t misses = TextLayoutCache::GetMissCount();
+  uint64_t hits = TextLayoutCache::GetHitCount();
+
+  for (int frame = 0; frame < frames; frame++) {
+    for (int i = 0; i < count; i++) {
+      RectF rect = RectF::MakeFromXYWH((i % 8) * 100.f, (i / 8 % 25) * 24.f, 100.f, 24.f);
+      TextBox text_box;
+      text_box.SetBox(rect);
+      text_box.SetSpacingAlign(TextBox::kSpacingAlignCenter);
+      text_box.SetText(texts[i].c_str(), texts[i].length(), paint);
+      text_box.Draw(canvas);
+      ASSERT_TRUE(text_box.CountLines() == 1);
+    }
+  }
+  canvas.Flush();
+
+  // Draw() and CountLines() of a text box share one lookup
+  ASSERT_TRUE(TextLayoutCache::GetMissCount() - misses == count);
+  ASSERT_TRUE(TextLayoutCache::GetHitCount() - hits == count * (frames - 1));
+  ASSERT_TRUE(TextLayoutCache::GetCount() == count);
+  TextLayoutCache::Clear();
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/gui/animation.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace skland;
+using namespace skland::gui;
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+class Observer : public core::Trackable {
+
+ public:
+
+  Observer()
+      : finished_count(0), changed_count(0) {}
+
+  virtual ~Observer() {}
+
+  void OnFinished(__SLOT__) {
+    finished_count++;
+  }
+
+  void OnChanged(const core::ColorF & /* color */, __SLOT__) {
+    changed_count++;
+  }
+
+  int finished_count;
+
+  int changed_count;
+
+};
+
+static const uint64_t kMillisecond = 1000000;
+
+/*
+ *
+ */
+TEST_F(Test, ease_1) {
+  for (int i = kEasingLinear; i <= kEasingInOutCubic; i++) {
+    EasingCurve curve = static_cast<EasingCurve>(i);
+    ASSERT_FLOAT_EQ(Animation::Ease(curve, 0.f), 0.f);
+    ASSERT_FLOAT_EQ(Animation::Ease(curve, 1.f), 1.f);
+
+    float last = 0.f;
+    for (int j = 1; j <= 100; j++) {
+      float value = Animation::Ease(curve, j / 100.f);
+      ASSERT_TRUE(value >= last);
+      last = value;
+    }
+  }
+
+  ASSERT_FLOAT_EQ(Animation::Ease(kEasingInOutQuad, 0.5f), 0.5f);
+  ASSERT_FLOAT_EQ(Animation::Ease(kEasingInOutCubic, 0.5f), 0.5f);
+}
+
+/*
+ *
+ */
+TEST_F(Test, value_animation_1) {
+  Observer observer;
+  OpacityAnimation animation;
+  animation.SetRange(0.f, 1.f);
+  animation.SetDuration(100);
+  animation.SetEasingCurve(kEasingLinear);
+  animation.finished().Connect(&observer, &Observer::OnFinished);
+
+  animation.Start();
+  ASSERT_TRUE(animation.IsRunning());
+  ASSERT_TRUE(Animation::GetRunningCount() == 1);
+
+  // The animation begins at the first frame
+  Animation::Tick(1000 * kMillisecond);
+  ASSERT_FLOAT_EQ(animation.GetValue(), 0.f);
+
+  Animation::Tick(1050 * kMillisecond);
+  ASSERT_FLOAT_EQ(animation.GetValue(), 0.5f);
+
+  Animation::Tick(1100 * kMillisecond);
+  ASSERT_FLOAT_EQ(animation.GetValue(), 1.f);
+  ASSERT_FALSE(animation.IsRunning());
+  ASSERT_TRUE(observer.finished_count == 1);
+  ASSERT_TRUE(Animation::GetRunningCount() == 0);
+}
+
+/*
+ *
+ */
+TEST_F(Test, value_animation_2) {
+  Observer observer;
+  ColorAnimation animation;
+  animation.SetRange(core::ColorF(1.f, 1.f, 1.f), core::ColorF(1.f, 1.f, 1.f));
+  animation.SetDuration(100);
+  animation.changed().Connect(&observer, &Observer::OnChanged);
+
+  animation.Start();
+  for (int i = 0; i <= 10; i++) {
+    Animation::Tick((2000 + i * 10) * kMillisecond);
+  }
+
+  // The value changes only once from the default color
+  ASSERT_TRUE(observer.changed_count == 1);
+  ASSERT_FALSE(animation.IsRunning());
+}
+
+/*
+ *
+ */
+TEST_F(Test, geometry_interpolate_1) {
+  core::RectF from = core::RectF::MakeFromXYWH(0.f, 0.f, 100.f, 100.f);
+  core::RectF to = core::RectF::MakeFromXYWH(100.f, 50.f, 200.f, 100.f);
+
+  core::RectF half = Interpolate(from, to, 0.5f);
+  ASSERT_FLOAT_EQ(half.left, 50.f);
+  ASSERT_FLOAT_EQ(half.top, 25.f);
+  ASSERT_FLOAT_EQ(half.width(), 150.f);
+  ASSERT_FLOAT_EQ(half.height(), 100.f);
+}
+
+/*
+ *
+ */
+TEST_F(Test, tick_benchmark_1) {
+  const int count = 500;
+  const int frames = 1000;
+
+  std::vector<OpacityAnimation *> animations;
+  for (int i = 0; i < count; i++) {
+    OpacityAnimation *animation = new OpacityAnimation;
+    animation->SetRange(0.f, 1.f);
+    animation->SetDuration(static_cast<unsigned int>(200 + i));
+    animation->SetLoopCount(-1);
+    animation->Start();
+    animations.push_back(animation);
+  }
+  ASSERT_TRUE(Animation::GetRunningCount() == count);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < frames; i++) {
+    Animation::Tick(static_cast<uint64_t>(i) * 16666667);
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double us = std::chrono::duration<double, std::micro>(end - start).count();
+  std::cout << count << " animations: " << us / frames << " us per frame" << std::endl;
+
+  for (size_t i = 0; i < animations.size(); i++) {
+    delete animations[i];
+  }
+  ASSERT_TRUE(Animation::GetRunningCount() == 0);
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/gui/chrome-path-cache.hpp>
+#include <skland/gui/theme.hpp>
+#include <skland/graphic/canvas.hpp>
+#include <skland/graphic/paint.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace skland;
+using namespace skland::gui;
+using graphic::Canvas;
+using graphic::Paint;
+using graphic::Path;
+
+static size_t kAllocationCount = 0;
+
+void *operator new(size_t size) {
+  kAllocationCount++;
+  void *p = malloc(size == 0 ? 1 : size);
+  if (nullptr == p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+/*
+ *
+ */
+TEST_F(Test, get_1) {
+  ChromePathCache cache;
+
+  const Path &inner = cache.Get(ChromePathCache::kShapeWindowInner, 640, 480, 1, false);
+  ASSERT_FALSE(inner.IsEmpty());
+  ASSERT_FLOAT_EQ(inner.GetBounds().width(), 640.f);
+  ASSERT_TRUE(cache.GetBuildCount() == 1);
+
+  const Path &inner2 = cache.Get(ChromePathCache::kShapeWindowInner, 640, 480, 1, false);
+  ASSERT_TRUE(&inner == &inner2);
+  ASSERT_TRUE(cache.GetBuildCount() == 1);
+
+  // The key changes
+  const Path &scaled = cache.Get(ChromePathCache::kShapeWindowInner, 640, 480, 2, false);
+  ASSERT_FLOAT_EQ(scaled.GetBounds().width(), 1280.f);
+  ASSERT_TRUE(cache.GetBuildCount() == 2);
+
+  cache.Get(ChromePathCache::kShapeWindowInner, 640, 480, 2, true);
+  ASSERT_TRUE(cache.GetBuildCount() == 3);
+}
+
+/*
+ * A steady-state repaint of the window frame must not touch the heap
+ */
+TEST_F(Test, zero_allocation_1) {
+  Theme::Load();
+
+  ChromePathCache cache;
+  std::vector<unsigned char> pixels(640 * 480 * 4);
+  Canvas canvas(pixels.data(), 640, 480);
+  const core::ColorF background(0.93f, 0.93f, 0.93f, 1.f);
+  const core::ColorF outline(0.f, 0.f, 0.f, 0.5f);
+
+  Paint glyph_paint;
+  glyph_paint.SetAntiAlias(true);
+  glyph_paint.SetStyle(Paint::kStyleStroke);
+  glyph_paint.SetStrokeWidth(1.5f);
+
+  // Warm up: build the paths and let the canvas allocate what it keeps
+  for (int i = 0; i < 2; i++) {
+    cache.DrawShadow(&canvas, 600, 440, 1, true);
+    cache.DrawInner(&canvas, background, 640, 480, 1, false);
+    cache.DrawOutline(&canvas, outline, 640, 480, 1);
+    for (int glyph = 0; glyph < ChromePathCache::kGlyphCount; glyph++) {
+      canvas.DrawPath(ChromePathCache::GetGlyph(static_cast<ChromePathCache::Glyph>(glyph)), glyph_paint);
+    }
+  }
+
+  size_t count = kAllocationCount;
+  for (int i = 0; i < 100; i++) {
+    cache.DrawShadow(&canvas, 600, 440, 1, true);
+    cache.DrawInner(&canvas, background, 640, 480, 1, false);
+    cache.DrawOutline(&canvas, outline, 640, 480, 1);
+    for (int glyph = 0; glyph < ChromePathCache::kGlyphCount; glyph++) {
+      canvas.DrawPath(ChromePathCache::GetGlyph(static_cast<ChromePathCache::Glyph>(glyph)), glyph_paint);
+    }
+  }
+  size_t allocations = kAllocationCount - count;
+
+  ASSERT_TRUE(allocations == 0);
+  ASSERT_TRUE(cache.GetBuildCount() == 2);
+}
+
+/*
+ * Glyphs are built once and shared by all caches
+ */
+TEST_F(Test, glyph_1) {
+  for (int glyph = 0; glyph < ChromePathCache::kGlyphCount; glyph++) {
+    const Path &path = ChromePathCache::GetGlyph(static_cast<ChromePathCache::Glyph>(glyph));
+    ASSERT_FALSE(path.IsEmpty());
+    ASSERT_TRUE(&path == &ChromePathCache::GetGlyph(static_cast<ChromePathCache::Glyph>(glyph)));
+  }
+
+  const core::RectF bounds = ChromePathCache::GetGlyph(ChromePathCache::kGlyphMaximize).GetBounds();
+  ASSERT_FLOAT_EQ(bounds.width(), 8.f);
+  ASSERT_FLOAT_EQ(bounds.center_x(), 0.f);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/gui/application.hpp>
+#include <skland/gui/image-exporter.hpp>
+#include <skland/graphic/bitmap.hpp>
+
+using namespace skland;
+using namespace skland::gui;
+using namespace skland::core;
+using namespace skland::graphic;
+
+class ExportWatcher : public Trackable {
+ public:
+
+  ExportWatcher()
+      : count_(0), success_(false) {}
+
+  virtual ~ExportWatcher() {}
+
+  void OnFinished(bool success, __SLOT__) {
+    count_++;
+    success_ = success;
+    Application::Exit();
+  }
+
+  int count() const { return count_; }
+
+  bool success() const { return success_; }
+
+ private:
+
+  int count_;
+  bool success_;
+
+};
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+/*
+ *
+ */
+TEST_F(Test, export_1) {
+  int argc = 1;
+  char argv1[] = "export_1";  // to avoid compile warning
+  char *argv[] = {argv1};
+
+  Application app(argc, argv);
+
+  Bitmap bitmap;
+  bitmap.AllocateN32Pixels(1920, 1080);
+
+  ImageExporter exporter;
+  ExportWatcher watcher;
+  exporter.finished().Connect(&watcher, &ExportWatcher::OnFinished);
+
+  ASSERT_TRUE(exporter.Start(bitmap, "gui_image_exporter_export_1.png"));
+  ASSERT_TRUE(exporter.IsRunning());
+  ASSERT_FALSE(exporter.Start(bitmap, "gui_image_exporter_export_1.png"));
+
+  int result = app.Run();
+
+  ASSERT_TRUE(result == 0);
+  ASSERT_TRUE(watcher.count() == 1);
+  ASSERT_TRUE(watcher.success());
+  ASSERT_FALSE(exporter.IsRunning());
+}
@@ -0,0 +1,387 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/gui/list-view.hpp>
+#include <skland/gui/grid-view.hpp>
+#include <skland/gui/abstract-list-model.hpp>
+#include <skland/gui/mouse-event.hpp>
+#include <skland/gui/key-event.hpp>
+#include <skland/gui/context.hpp>
+
+#include <skland/graphic/canvas.hpp>
+
+#include "SkCanvas.h"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace skland;
+using namespace skland::gui;
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+class ItemView : public AbstractView {
+
+ public:
+
+  ItemView()
+      : AbstractView(100, 24), index(-1) {}
+
+  int index;
+
+  /**
+   * @brief The device clip bounds when this view was drawn last time
+   */
+  SkIRect clip = SkIRect::MakeEmpty();
+
+ protected:
+
+  virtual ~ItemView() {}
+
+  virtual void OnConfigureGeometry(const RectF &old_geometry,
+                                   const RectF &new_geometry) override {
+    RequestSaveGeometry(new_geometry);
+  }
+
+  virtual void OnSaveGeometry(const RectF &old_geometry,
+                              const RectF &new_geometry) override {}
+
+  virtual void OnMouseEnter(MouseEvent *event) override { event->Ignore(); }
+
+  virtual void OnMouseLeave() override {}
+
+  virtual void OnMouseMove(MouseEvent *event) override { event->Ignore(); }
+
+  virtual void OnMouseDown(MouseEvent *event) override { event->Ignore(); }
+
+  virtual void OnMouseUp(MouseEvent *event) override { event->Ignore(); }
+
+  virtual void OnKeyDown(KeyEvent *event) override { event->Ignore(); }
+
+  virtual void OnKeyUp(KeyEvent *event) override { event->Ignore(); }
+
+  virtual void OnDraw(const Context &context) override {
+    clip = context.canvas()->GetSkCanvas()->getDeviceClipBounds();
+  }
+
+};
+
+/**
+ * @brief An item view with a sub view
+ */
+class NestedItemView : public ItemView {
+
+ public:
+
+  NestedItemView()
+      : ItemView(), child(new ItemView) {
+    PushBackChild(child);
+  }
+
+  ItemView *child;
+
+ protected:
+
+  virtual ~NestedItemView() {}
+
+};
+
+/**
+ * @brief A grid view to test the hit test
+ */
+class TestGridView : public GridView {
+
+ public:
+
+  TestGridView(int width, int height)
+      : GridView(width, height) {}
+
+  int HitTest(int x, int y) const { return GetIndexAt(x, y); }
+
+ protected:
+
+  virtual ~TestGridView() {}
+
+};
+
+/**
+ * @brief A list view which can be drawn in test
+ */
+class DrawableListView : public ListView {
+
+ public:
+
+  DrawableListView(int width, int height)
+      : ListView(width, height) {}
+
+  void DrawOn(graphic::Canvas *canvas) {
+    OnDraw(Context(nullptr, canvas));
+  }
+
+  AbstractView *GetChild(int index) const { return GetChildAt(index); }
+
+ protected:
+
+  virtual ~DrawableListView() {}
+
+};
+
+class ListModel : public AbstractListModel {
+
+ public:
+
+  explicit ListModel(int count, bool nested = false)
+      : count(count), nested(nested), created(0), bound(0) {}
+
+  virtual ~ListModel() {}
+
+  virtual int GetCount() const override { return count; }
+
+  virtual AbstractView *CreateView(int type) override {
+    created++;
+    return nested ? new NestedItemView : new ItemView;
+  }
+
+  virtual void BindView(AbstractView *view, int index) override {
+    bound++;
+    static_cast<ItemView *>(view)->index = index;
+  }
+
+  void SetCount(int new_count) {
+    count = new_count;
+    NotifyChanged();
+  }
+
+  int count;
+  bool nested;
+  int created;
+  int bound;
+
+};
+
+/*
+ * Only visible items and overscan have views
+ */
+TEST_F(Test, realize_1) {
+  ListModel model(1000);
+  ListView *list = new ListView(200, 240);
+  list->SetItemHeight(24);
+  list->SetOverscan(2);
+  list->SetModel(&model);
+
+  // 10 visible rows and 2 overscan rows below
+  ASSERT_TRUE(list->GetFirstIndex() == 0);
+  ASSERT_TRUE(list->GetViewCount() == 12);
+  ASSERT_TRUE(model.created == 12);
+
+  list->ScrollTo(24 * 100);
+  ASSERT_TRUE(list->GetFirstIndex() == 98);
+  ASSERT_TRUE(list->GetViewCount() == 14);
+  ASSERT_TRUE(static_cast<ItemView *>(list->GetViewAt(100))->index == 100);
+  ASSERT_TRUE(list->GetViewAt(100)->GetY() == 0);
+
+  // Views are recycled
+  ASSERT_TRUE(model.created == 14);
+
+  list->ScrollTo(24 * 1000);
+  ASSERT_TRUE(list->GetScrollOffset() == list->GetMaximalScrollOffset());
+  ASSERT_TRUE(list->GetFirstIndex() + list->GetViewCount() == 1000);
+
+  model.SetCount(5);
+  ASSERT_TRUE(list->GetScrollOffset() == 0);
+  ASSERT_TRUE(list->GetViewCount() == 5);
+  ASSERT_TRUE(list->GetRecycledCount() + list->GetViewCount() == model.created);
+
+  list->Destroy();
+}
+
+/*
+ * Item views partly scrolled out are clipped by the list
+ */
+TEST_F(Test, clip_1) {
+  ListModel model(100);
+  DrawableListView *list = new DrawableListView(200, 240);
+  list->SetItemHeight(24);
+  list->SetOverscan(0);
+  list->SetModel(&model);
+  list->ScrollTo(12);
+
+  ItemView *top = static_cast<ItemView *>(list->GetViewAt(0));
+  ItemView *bottom = static_cast<ItemView *>(list->GetViewAt(10));
+  ASSERT_TRUE(top->GetY() == -12);
+  ASSERT_TRUE(bottom->GetY() + bottom->GetHeight() > 240);
+
+  // The canvas is larger than the list
+  std::vector<unsigned char> pixels(300 * 300 * 4);
+  graphic::Canvas canvas(pixels.data(), 300, 300);
+  list->DrawOn(&canvas);
+
+  ASSERT_TRUE(top->clip == SkIRect::MakeLTRB(0, 0, 200, 240));
+  ASSERT_TRUE(bottom->clip == SkIRect::MakeLTRB(0, 0, 200, 240));
+
+  // The clip is restored after drawing
+  ASSERT_TRUE(canvas.GetSkCanvas()->getDeviceClipBounds() == SkIRect::MakeWH(300, 300));
+
+  list->Destroy();
+}
+
+/*
+ * Sub views in item views are drawn with the clip of the list
+ */
+TEST_F(Test, clip_2) {
+  ListModel model(100, true);
+  DrawableListView *list = new DrawableListView(200, 240);
+  list->SetItemHeight(24);
+  list->SetOverscan(0);
+  list->SetModel(&model);
+  list->ScrollTo(12);
+
+  std::vector<unsigned char> pixels(300 * 300 * 4);
+  graphic::Canvas canvas(pixels.data(), 300, 300);
+  list->DrawOn(&canvas);
+
+  NestedItemView *top = static_cast<NestedItemView *>(list->GetViewAt(0));
+  ASSERT_TRUE(top->clip == SkIRect::MakeLTRB(0, 0, 200, 240));
+  ASSERT_TRUE(top->child->clip == SkIRect::MakeLTRB(0, 0, 200, 240));
+
+  list->Destroy();
+}
+
+/*
+ * Children of the list are kept in index order when scrolling back
+ */
+TEST_F(Test, order_1) {
+  ListModel model(100);
+  DrawableListView *list = new DrawableListView(200, 240);
+  list->SetItemHeight(24);
+  list->SetOverscan(2);
+  list->SetModel(&model);
+  list->ScrollTo(24 * 50);
+  list->ScrollTo(24 * 40);
+
+  for (int i = 0; i < list->GetViewCount(); i++) {
+    ASSERT_TRUE(list->GetChild(i) == list->GetViewAt(list->GetFirstIndex() + i));
+  }
+
+  list->Destroy();
+}
+
+/*
+ * Cells are hit by the cell width but not the width of grid
+ */
+TEST_F(Test, grid_hit_1) {
+  ListModel model(1000);
+  TestGridView *grid = new TestGridView(300, 200);
+  grid->SetCellSize(96, 100);
+  grid->SetModel(&model);
+
+  // 3 columns, the cell 2 is in [192, 288)
+  ASSERT_TRUE(grid->HitTest(195, 10) == 2);
+  ASSERT_TRUE(grid->HitTest(95, 110) == 3);
+  ASSERT_TRUE(grid->HitTest(290, 10) == -1);
+
+  grid->Destroy();
+}
+
+TEST_F(Test, grid_1) {
+  ListModel model(1000);
+  GridView *grid = new GridView(400, 200);
+  grid->SetCellSize(100, 100);
+  grid->SetOverscan(0);
+  grid->SetModel(&model);
+
+  // 4 columns x 2 rows
+  ASSERT_TRUE(grid->GetViewCount() == 8);
+  ASSERT_TRUE(grid->GetViewAt(5)->GetX() == 100);
+  ASSERT_TRUE(grid->GetViewAt(5)->GetY() == 100);
+
+  grid->ScrollToIndex(41);
+  ASSERT_TRUE(grid->GetFirstIndex() == 40);
+
+  grid->Destroy();
+}
+
+/*
+ * Benchmark: scroll through a 1M-row model and compare with a 1k-row model
+ */
+TEST_F(Test, scroll_benchmark_1) {
+  typedef std::chrono::steady_clock Clock;
+
+  const int steps = 100000;
+  double ns_per_step[2] = {0.0, 0.0};
+  const int counts[2] = {1000, 1000000};
+
+  for (int i = 0; i < 2; i++) {
+    ListModel model(counts[i]);
+    ListView *list = new ListView(400, 600);
+    list->SetModel(&model);
+
+    int max = list->GetMaximalScrollOffset();
+    int offset = 0;
+    int distance = 7;  // not aligned to item height
+
+    Clock::time_point start = Clock::now();
+    for (int step = 0; step < steps; step++) {
+      offset += distance;
+      if (offset > max || offset < 0) {
+        distance = -distance;
+        offset += 2 * distance;
+      }
+      list->ScrollTo(offset);
+    }
+    Clock::time_point end = Clock::now();
+
+    ns_per_step[i] = std::chrono::duration<double, std::nano>(end - start).count() / steps;
+
+    std::cout << "Scroll " << counts[i] << " rows: "
+              << ns_per_step[i] << " ns per step, "
+              << model.created << " views created, "
+              << model.bound << " binds" << std::endl;
+
+    ASSERT_TRUE(list->GetViewCount() <= 600 / 24 + 1 + 2 * list->GetOverscan());
+
+    list->Destroy();
+  }
+
+  // Jump across the whole 1M-row model
+  ListModel model(1000000);
+  ListView *list = new ListView(400, 600);
+  list->SetModel(&model);
+
+  Clock::time_point start = Clock::now();
+  for (int step = 0; step < 1000; step++) {
+    list->ScrollToIndex((step * 7919) % 1000000);
+  }
+  Clock::time_point end = Clock::now();
+
+  std::cout << "Random jumps in 1000000 rows: "
+            << std::chrono::duration<double, std::nano>(end - start).count() / 1000
+            << " ns per jump, " << model.created << " views created" << std::endl;
+
+  ASSERT_TRUE(model.created <= 2 * (600 / 24 + 1 + 2 * list->GetOverscan()));
+
+  list->Destroy();
+}
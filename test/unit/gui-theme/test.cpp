@@ -0,0 +1,121 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/gui/theme.hpp>
+
+#include "SkPixmap.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+using namespace skland;
+using namespace skland::gui;
+
+static const char *kBundleFile = "test-theme.skt";
+static const char *kSourceFile = "test-theme.txt";
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+  remove(kBundleFile);
+  remove(kSourceFile);
+}
+
+TEST_F(Test, compile_1) {
+  Theme::Load("dark");
+  uint32_t background = Theme::GetData().window.active.background.colors[0].argb();
+  size_t title_bar_colors = Theme::GetData().title_bar.active.background.colors.size();
+  std::vector<uint32_t> shadow(static_cast<const uint32_t *>(Theme::GetShadowPixmap()->addr()),
+                               static_cast<const uint32_t *>(Theme::GetShadowPixmap()->addr())
+                                   + Theme::kShadowImageWidth * Theme::kShadowImageHeight);
+
+  ASSERT_TRUE(Theme::Compile("dark", kBundleFile));
+
+  Theme::Load("light");
+  Theme::Load(kBundleFile);
+  ASSERT_TRUE(Theme::GetData().window.active.background.colors[0].argb() == background);
+  ASSERT_TRUE(Theme::GetData().title_bar.active.background.colors.size() == title_bar_colors);
+
+  // The shadow is used in place, not regenerated
+  const uint32_t *pixels = static_cast<const uint32_t *>(Theme::GetShadowPixmap()->addr());
+  ASSERT_TRUE(std::equal(shadow.begin(), shadow.end(), pixels));
+
+  Theme::Load("light");
+}
+
+TEST_F(Test, source_1) {
+  std::ofstream(kSourceFile) << "# A text theme\n"
+                                "base = dark\n"
+                                "name = Ocean\n"
+                                "title_bar.active.background = 0xFF102030@0 0xFF405060@1\n"
+                                "default_font = Noto Sans CJK SC, 700, 14\n"
+                                "shadow.radius = 30\n";
+
+  ASSERT_TRUE(Theme::Compile(kSourceFile, kBundleFile));
+
+  Theme::Load(kBundleFile);
+  const Theme::Data &data = Theme::GetData();
+  ASSERT_TRUE(data.name == "Ocean");
+  ASSERT_TRUE(data.title_bar.active.background.colors.size() == 2);
+  ASSERT_TRUE(data.title_bar.active.background.colors[1].argb() == 0xFF405060);
+  ASSERT_FLOAT_EQ(data.default_font.GetSize(), 14.f);
+  ASSERT_TRUE(Theme::GetShadowRadius() == 30);
+
+  Theme::Load("light");
+  ASSERT_TRUE(Theme::GetShadowRadius() == 33);
+}
+
+TEST_F(Test, invalid_1) {
+  std::ofstream(kSourceFile) << "window.active.background = not-a-color\n";
+  ASSERT_FALSE(Theme::Compile(kSourceFile, kBundleFile));
+
+  // Not a bundle, falls back to the default theme
+  std::ofstream(kBundleFile) << "garbage";
+  Theme::Load(kBundleFile);
+  ASSERT_TRUE(Theme::GetData().name == "Light");
+}
+
+TEST_F(Test, benchmark_1) {
+  ASSERT_TRUE(Theme::Compile("light", kBundleFile));
+
+  const int count = 20;
+  double builtin = 0.0, bundle = 0.0;
+
+  for (int i = 0; i < count; i++) {
+    // Loading the builtin theme after a bundle generates the shadow image again
+    auto t0 = std::chrono::steady_clock::now();
+    Theme::Load("light");
+    auto t1 = std::chrono::steady_clock::now();
+    Theme::Load(kBundleFile);
+    auto t2 = std::chrono::steady_clock::now();
+
+    builtin += std::chrono::duration<double, std::micro>(t1 - t0).count();
+    bundle += std::chrono::duration<double, std::micro>(t2 - t1).count();
+  }
+
+  std::cout << "builtin theme with generated shadow: " << builtin / count << " us" << std::endl;
+  std::cout << "compiled bundle: " << bundle / count << " us" << std::endl;
+
+  Theme::Load("light");
+}
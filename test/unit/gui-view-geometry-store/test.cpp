@@ -0,0 +1,287 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "test.hpp"
+
+#include <skland/gui/abstract-view.hpp>
+#include <skland/gui/view-geometry-store.hpp>
+#include <skland/gui/mouse-event.hpp>
+#include <skland/gui/key-event.hpp>
+
+#include <chrono>
+#include <iostream>
+
+using namespace skland;
+using namespace skland::gui;
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+class TestView : public AbstractView {
+
+ public:
+
+  TestView(int width, int height)
+      : AbstractView(width, height) {}
+
+  void AddSubView(AbstractView *view) {
+    PushBackChild(view);
+  }
+
+ protected:
+
+  virtual ~TestView() {}
+
+  virtual void OnConfigureGeometry(const RectF &old_geometry,
+                                   const RectF &new_geometry) override {
+    RequestSaveGeometry(new_geometry);
+  }
+
+  virtual void OnSaveGeometry(const RectF &old_geometry,
+                              const RectF &new_geometry) override {}
+
+  virtual void OnMouseEnter(MouseEvent *event) override { event->Ignore(); }
+
+  virtual void OnMouseLeave() override {}
+
+  virtual void OnMouseMove(MouseEvent *event) override { event->Ignore(); }
+
+  virtual void OnMouseDown(MouseEvent *event) override { event->Ignore(); }
+
+  virtual void OnMouseUp(MouseEvent *event) override { event->Ignore(); }
+
+  virtual void OnKeyDown(KeyEvent *event) override { event->Ignore(); }
+
+  virtual void OnKeyUp(KeyEvent *event) override { event->Ignore(); }
+
+  virtual void OnDraw(const Context &context) override {}
+
+};
+
+/**
+ * @brief Build a tree with 1 + groups * (1 + leaves) views
+ *
+ * Each group is a 1000 x 100 row, leaves are 10 x 10 cells in the row.
+ */
+static TestView *BuildTree(int groups, int leaves) {
+  TestView *root = new TestView(1000, groups * 100);
+
+  for (int i = 0; i < groups; i++) {
+    TestView *group = new TestView(1000, 100);
+    root->AddSubView(group);
+    group->MoveTo(0, i * 100);
+
+    for (int j = 0; j < leaves; j++) {
+      TestView *leaf = new TestView(10, 10);
+      group->AddSubView(leaf);
+      leaf->MoveTo((j % 100) * 10, i * 100 + (j / 100) * 10);
+    }
+  }
+
+  return root;
+}
+
+TEST_F(Test, build_1) {
+  TestView *root = BuildTree(2, 3);
+  ViewGeometryStore store;
+
+  store.AddRoot(root);
+  store.Sync();
+
+  ASSERT_TRUE(store.GetCount() == 9);
+  ASSERT_TRUE(store.GetViewAt(0) == root);
+  ASSERT_TRUE(store.GetSubtreeEndAt(0) == 9);
+  ASSERT_TRUE(store.GetSubtreeEndAt(1) == 5);
+  ASSERT_TRUE(store.GetSubtreeEndAt(5) == 9);
+  ASSERT_TRUE(store.IndexOf(store.GetViewAt(6)) == 6);
+
+  // Geometry changes are written in place
+  AbstractView *leaf = store.GetViewAt(6);
+  leaf->MoveTo(500, 150);
+  ASSERT_TRUE(store.IsValid());
+  ASSERT_TRUE(store.GetGeometryAt(6) == leaf->GetGeometry());
+
+  // Structure changes invalidate the store
+  static_cast<TestView *>(store.GetViewAt(1))->AddSubView(new TestView(10, 10));
+  ASSERT_FALSE(store.IsValid());
+  ASSERT_TRUE(store.IndexOf(leaf) == -1);
+
+  store.Sync();
+  ASSERT_TRUE(store.GetCount() == 10);
+  ASSERT_TRUE(store.IndexOf(leaf) == 7);
+
+  store.RemoveRoot(root);
+  root->Destroy();
+}
+
+TEST_F(Test, hit_test_1) {
+  TestView *root = BuildTree(10, 100);
+  ViewGeometryStore store;
+  store.AddRoot(root);
+
+  AbstractView *view = store.HitTest(25.f, 305.f);
+  ASSERT_TRUE(view != nullptr);
+  ASSERT_TRUE(view->GetX() == 20 && view->GetY() == 300);
+
+  // In a group but not in any leaf
+  view = store.HitTest(25.f, 350.f);
+  ASSERT_TRUE(view == store.GetViewAt(1 + 3 * 101));
+
+  ASSERT_TRUE(store.HitTest(-1.f, -1.f) == nullptr);
+
+  store.RemoveRoot(root);
+  root->Destroy();
+}
+
+TEST_F(Test, occlusion_1) {
+  TestView *root = BuildTree(2, 3);
+  ViewGeometryStore store;
+  store.AddRoot(root);
+  store.Sync();
+
+  // group 0 is above group 1, move a leaf of group 1 under group 0
+  AbstractView *group0 = store.GetViewAt(1);
+  AbstractView *leaf = store.GetViewAt(6);
+  leaf->MoveTo(50, 50);
+
+  ASSERT_FALSE(store.IsOccludedAt(6));
+
+  group0->SetOpaque(true);
+  ASSERT_TRUE(store.IsOpaqueAt(1));
+  ASSERT_TRUE(store.IsOccludedAt(6));
+
+  // Never occluded by itself or its parent
+  ASSERT_FALSE(store.IsOccludedAt(1));
+  ASSERT_FALSE(store.IsOccludedAt(2));
+
+  // Sub views cover the parent
+  store.GetViewAt(7)->SetOpaque(true);
+  store.GetViewAt(7)->Resize(1000, 100);
+  store.GetViewAt(7)->MoveTo(0, 100);
+  ASSERT_TRUE(store.IsOccludedAt(5));
+
+  std::vector<core::RectF> rects;
+  ASSERT_TRUE(store.CollectOpaque(core::RectF::MakeFromXYWH(0.f, 0.f, 1000.f, 150.f), &rects) == 2);
+  ASSERT_TRUE(rects[1] == core::RectF::MakeFromXYWH(0.f, 100.f, 1000.f, 50.f));
+
+  // The flag survives a rebuild
+  store.Invalidate();
+  store.Sync();
+  ASSERT_TRUE(store.IsOccludedAt(6));
+
+  store.RemoveRoot(root);
+  root->Destroy();
+}
+
+/*
+ * Only visible opaque views are collected as occluders
+ */
+TEST_F(Test, occlusion_2) {
+  TestView *root = BuildTree(2, 3);
+  ViewGeometryStore store;
+  store.AddRoot(root);
+  store.Sync();
+  ASSERT_TRUE(store.GetOccluderCount() == 0);
+
+  AbstractView *leaf = store.GetViewAt(6);
+  leaf->MoveTo(50, 50);
+  store.GetViewAt(2)->SetOpaque(true);
+  store.GetViewAt(3)->SetOpaque(true);
+  ASSERT_TRUE(store.GetOccluderCount() == 2);
+
+  // Geometry changes do not need to rebuild the occluders
+  store.GetViewAt(2)->Resize(1000, 1000);
+  ASSERT_TRUE(store.IsOccludedAt(6));
+
+  store.SetVisibleAt(1, false);
+  ASSERT_TRUE(store.GetOccluderCount() == 0);
+  ASSERT_FALSE(store.IsOccludedAt(6));
+
+  store.RemoveRoot(root);
+  root->Destroy();
+}
+
+/*
+ * Benchmark: cull and hit test on a 50k-view tree
+ */
+TEST_F(Test, traversal_benchmark_1) {
+  typedef std::chrono::steady_clock Clock;
+
+  TestView *root = BuildTree(50, 999);  // 50001 views
+  ViewGeometryStore store;
+  store.AddRoot(root);
+
+  Clock::time_point start = Clock::now();
+  store.Sync();
+  Clock::time_point end = Clock::now();
+  ASSERT_TRUE(store.GetCount() == 50001);
+
+  std::cout << "Build " << store.GetCount() << " views: "
+            << std::chrono::duration<double, std::micro>(end - start).count()
+            << " us" << std::endl;
+
+  const int loops = 100;
+  const core::RectF clip = core::RectF::MakeFromXYWH(100.f, 1000.f, 400.f, 600.f);
+  std::vector<AbstractView *> culled;
+  std::vector<AbstractView *> expected;
+
+  // Reading the geometry through each view
+  start = Clock::now();
+  for (int loop = 0; loop < loops; loop++) {
+    expected.clear();
+    for (int i = 0; i < store.GetCount(); i++) {
+      AbstractView *view = store.GetViewAt(i);
+      if (view->IsVisible() && clip.Intersect(view->GetGeometry()))
+        expected.push_back(view);
+    }
+  }
+  end = Clock::now();
+  double view_us = std::chrono::duration<double, std::micro>(end - start).count() / loops;
+
+  start = Clock::now();
+  for (int loop = 0; loop < loops; loop++) {
+    store.Cull(clip, &culled);
+  }
+  end = Clock::now();
+  double store_us = std::chrono::duration<double, std::micro>(end - start).count() / loops;
+
+  ASSERT_TRUE(culled == expected);
+
+  std::cout << "Cull " << culled.size() << " of " << store.GetCount() << " views: "
+            << view_us << " us through views, "
+            << store_us << " us in store" << std::endl;
+
+  start = Clock::now();
+  AbstractView *hit = nullptr;
+  for (int loop = 0; loop < loops * 100; loop++) {
+    hit = store.HitTest(static_cast<float>(loop % 1000), static_cast<float>(loop % 5000));
+  }
+  end = Clock::now();
+  ASSERT_TRUE(nullptr != hit);
+
+  std::cout << "Hit test: "
+            << std::chrono::duration<double, std::nano>(end - start).count() / (loops * 100)
+            << " ns" << std::endl;
+
+  store.RemoveRoot(root);
+  root->Destroy();
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2016 Freeman Zhang <zhanggyb@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <skland/gui/view-slab.hpp>
+#include <skland/gui/abstract-view.hpp>
+#include <skland/gui/anchor.hpp>
+#include <skland/gui/mouse-event.hpp>
+#include <skland/gui/key-event.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace skland;
+using namespace skland::gui;
+
+static size_t kAllocationCount = 0;
+
+void *operator new(size_t size) {
+  kAllocationCount++;
+  void *p = malloc(size == 0 ? 1 : size);
+  if (nullptr == p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+Test::Test()
+    : testing::Test() {
+}
+
+Test::~Test() {
+
+}
+
+class TestView : public AbstractView {
+
+ public:
+
+  TestView()
+      : AbstractView(10, 10) {}
+
+  void AddSubView(AbstractView *view) {
+    PushBackChild(view);
+  }
+
+ protected:
+
+  virtual ~TestView() {}
+
+  virtual void OnConfigureGeometry(const RectF &old_geometry,
+                                   const RectF &new_geometry) override {
+    RequestSaveGeometry(new_geometry);
+  }
+
+  virtual void OnSaveGeometry(const RectF &old_geometry,
+                              const RectF &new_geometry) override {}
+
+  virtual void OnMouseEnter(MouseEvent *event) override { event->Ignore(); }
+
+  virtual void OnMouseLeave() override {}
+
+  virtual void OnMouseMove(MouseEvent *event) override { event->Ignore(); }
+
+  virtual void OnMouseDown(MouseEvent *event) override { event->Ignore(); }
+
+  virtual void OnMouseUp(MouseEvent *event) override { event->Ignore(); }
+
+  virtual void OnKeyDown(KeyEvent *event) override { event->Ignore(); }
+
+  virtual void OnKeyUp(KeyEvent *event) override { event->Ignore(); }
+
+  virtual void OnDraw(const Context &context) override {}
+
+};
+
+/**
+ * @brief Build a tree with a root and the given count of children, anchor
+ * each child to the root, then destroy it
+ * @return Count of heap allocations
+ */
+static size_t BuildAndDestroy(int count) {
+  size_t start = kAllocationCount;
+
+  TestView *root = new TestView;
+  std::vector<std::pair<Anchor *, Anchor *>> anchors;
+  anchors.reserve(count);
+
+  for (int i = 0; i < count; i++) {
+    TestView *view = new TestView;
+    root->AddSubView(view);
+    anchors.push_back(Anchor::MakePair(i, root, view));
+  }
+
+  for (auto &pair : anchors) delete pair.first;
+  root->Destroy();
+
+  return kAllocationCount - start;
+}
+
+/*
+ * The slabs are not used unless a ViewSlab object is alive
+ */
+TEST_F(Test, opt_in_1) {
+  size_t heap = BuildAndDestroy(1000);
+
+  size_t slab = 0;
+  {
+    ViewSlab view_slab;
+
+    // Warm up: allocate the chunks
+    BuildAndDestroy(1000);
+    size_t view_chunks = view_slab.GetViewAllocator().GetChunkCount();
+
+    slab = BuildAndDestroy(1000);
+
+    ASSERT_TRUE(view_slab.GetViewAllocator().GetAllocationCount() == 2002);
+    ASSERT_TRUE(view_slab.GetEventHandlerAllocator().GetAllocationCount() == 2002);
+    ASSERT_TRUE(view_slab.GetAnchorAllocator().GetAllocationCount() == 4000);
+
+    ASSERT_TRUE(view_slab.GetViewAllocator().GetInUseCount() == 0);
+    ASSERT_TRUE(view_slab.GetEventHandlerAllocator().GetInUseCount() == 0);
+    ASSERT_TRUE(view_slab.GetAnchorAllocator().GetInUseCount() == 0);
+
+    // Blocks are reused
+    ASSERT_TRUE(view_slab.GetViewAllocator().GetChunkCount() == view_chunks);
+  }
+
+  // 2 private structures per view and 2 anchors per child come from slabs
+  ASSERT_TRUE(heap - slab >= 1001 * 2 + 1000 * 2);
+
+  // Back to heap
+  ASSERT_TRUE(BuildAndDestroy(1000) == heap);
+}
+
+/*
+ * Views outliving the slab, or created before it, are destroyed safely
+ */
+TEST_F(Test, lifetime_1) {
+  TestView *before = new TestView;
+  TestView *after = nullptr;
+
+  {
+    ViewSlab view_slab;
+    after = new TestView;
+    before->Destroy();
+
+    ASSERT_TRUE(view_slab.GetViewAllocator().GetInUseCount() == 1);
+    ASSERT_TRUE(view_slab.GetViewAllocator().GetDeallocationCount() == 0);
+  }
+
+  after->Destroy();
+}